@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @struct AirtimeBudgetConfig
+ * @brief Duty-cycle limit enforced by an AirtimeBudget.
+ *
+ * Defaults: EU868 sub-band g/g1 (868.0-868.6 MHz), 1% duty cycle. Credit
+ * accrues at dutyCyclePpm microseconds of airtime per second of wall time,
+ * up to burstUs; the default burst (36 s) is the allowance of one hour.
+ */
+struct AirtimeBudgetConfig
+{
+  uint32_t dutyCyclePpm = 10000;  ///< Allowed fraction of time on air, in parts per million (10000 = 1%).
+  uint64_t burstUs = 36000000;    ///< Maximum credit, in microseconds of airtime.
+  uint64_t initialUs = 36000000;  ///< Credit available at the first call.
+};
+
+/**
+ * @class AirtimeBudget
+ * @brief Token bucket of transmit airtime.
+ *
+ * Time is passed in explicitly (milliseconds, wrap-safe), so the bucket is
+ * driven by a fake clock in tests. Credit is kept in nanoseconds so that
+ * refills of a few milliseconds are not lost to rounding. Not thread safe.
+ */
+class AirtimeBudget
+{
+ public:
+  explicit AirtimeBudget(const AirtimeBudgetConfig &config = AirtimeBudgetConfig());
+
+  /**
+   * @brief Airtime that could be spent now, in microseconds.
+   */
+  uint64_t availableUs(uint32_t currentTimestampMs) const;
+
+  /**
+   * @brief Spends 'airtimeUs' if the credit allows it.
+   * @return false (nothing spent) if the frame would exceed the duty cycle.
+   */
+  bool tryConsume(uint32_t airtimeUs, uint32_t currentTimestampMs);
+
+  /**
+   * @brief Milliseconds until 'airtimeUs' becomes affordable (0 if it already is).
+   */
+  uint32_t waitTimeMs(uint64_t airtimeUs, uint32_t currentTimestampMs) const;
+
+  /**
+   * @brief Total airtime spent, in microseconds.
+   */
+  uint64_t consumedUs() const { return consumedUs_; }
+
+  const AirtimeBudgetConfig &config() const { return config_; }
+
+ private:
+  AirtimeBudgetConfig config_;
+  uint64_t creditNs_;
+  uint64_t consumedUs_ = 0;
+  uint32_t lastRefillMs_ = 0;
+  bool started_ = false;
+
+  /**
+   * @brief Credit at 'currentTimestampMs', in nanoseconds.
+   */
+  uint64_t creditAt(uint32_t currentTimestampMs) const;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "FrameArena.hpp"
+#include "Packet.hpp"
+#include "PacketReassembler.hpp"
+
+/**
+ * @class BatchReceiver
+ * @brief Receive pipeline stage that consumes whole FrameArena batches.
+ *
+ * Parses and validates a batch with PacketParser::parseBatch() and feeds the
+ * valid packets to an owned PacketReassembler, reporting completed messages
+ * through a callback. Scratch storage is sized once for the largest batch,
+ * so steady-state processing only allocates for completed messages.
+ */
+class BatchReceiver
+{
+ public:
+  /**
+   * @brief Called for every completed message.
+   */
+  using MessageCallback = std::function<void(uint32_t sourceId, uint16_t messageId, std::vector<uint8_t> &&message)>;
+
+  /**
+   * @brief Per-receiver counters.
+   */
+  struct Stats
+  {
+    uint64_t framesReceived = 0;
+    uint64_t framesRejected = 0;
+    uint64_t messagesCompleted = 0;
+  };
+
+  BatchReceiver(size_t maxBatchSize, const ReassemblerConfig &config, MessageCallback onMessage);
+
+  /**
+   * @brief Parses, validates and reassembles every frame of the batch.
+   * @return Number of messages completed by this batch.
+   */
+  size_t process(const FrameArena &batch);
+
+  PacketReassembler &reassembler() { return reassembler_; }
+  const Stats &stats() const { return stats_; }
+
+ private:
+  PacketReassembler reassembler_;
+  MessageCallback onMessage_;
+  std::vector<Packet> packets_;
+  std::vector<uint64_t> validMask_;
+  Stats stats_;
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "AirtimeBudget.hpp"
+#include "ITransport.hpp"
+#include "LoRaAirtime.hpp"
+
+/**
+ * @struct BondMemberConfig
+ * @brief Per-radio settings of a BondedTransport.
+ */
+struct BondMemberConfig
+{
+  /**
+   * @brief Modem settings of the radio, for its airtime estimate (replaced by BondedTransport::setModulation()).
+   */
+  LoRaModulation modulation;
+
+  /**
+   * @brief Duty-cycle limit of the radio's sub-band. std::nullopt: no limit.
+   */
+  std::optional<AirtimeBudgetConfig> airtimeBudget;
+};
+
+/**
+ * @class BondedTransport
+ * @brief Bonds several radios (e.g. two SX1262 on different frequencies) into one ITransport.
+ *
+ * Transmit: a frame handed to startTransmit() goes to a free member whose
+ * duty-cycle budget covers it: the one with the shortest time on air for
+ * it, most remaining budget on ties. The transmit-done callback fires as
+ * soon as the frame is on a member, not when it ends, so a TxEngine on top
+ * keeps every radio busy: the chunks of one message are striped across the
+ * members in proportion to their speed and remaining airtime. A slow radio
+ * still takes a frame whenever the faster ones are busy, which maximizes
+ * the throughput of large transfers.
+ *
+ * Receive: frames from every member are delivered through the one receive
+ * callback, so a LinkEndpoint / PacketReassembler on top merges the chunks
+ * of a message whichever radio they arrived on. Sessions are keyed by
+ * (FrameMeta::sourceId, messageId): all radios of a node must report the
+ * same source identity (RadioLibTransport and UartTransport report 0;
+ * LoopbackTransports of one node take the same address).
+ *
+ * setModulation() retunes idle members at once; a member with a frame on
+ * air keeps the new settings pending until its transmission ends, so a
+ * link change never cuts the last LinkAnnouncement short.
+ *
+ * The members' callbacks are taken over by the bond; poll() polls them all.
+ * Members must outlive the bond.
+ *
+ * @code
+ * BondedTransport bond({&radio433, &radio868}, {{}, {sx868, AirtimeBudgetConfig()}});
+ * LinkEndpoint endpoint(bond);
+ * @endcode
+ */
+class BondedTransport : public ITransport
+{
+ public:
+  /**
+   * @brief Counters of one member.
+   */
+  struct MemberStats
+  {
+    uint64_t framesSent = 0;
+    uint64_t framesReceived = 0;
+    uint64_t airtimeUs = 0;  ///< Time on air of the frames started.
+  };
+
+  /**
+   * @brief Bond counters.
+   */
+  struct Stats
+  {
+    uint64_t framesSent = 0;      ///< Frames handed to a member.
+    uint64_t framesReceived = 0;
+    uint64_t framesDeferred = 0;  ///< poll() calls in which the pending frame found no free member.
+    uint64_t radioErrors = 0;     ///< Member startTransmit() refusals (the frame is retried).
+    uint64_t modulationErrors = 0;  ///< Deferred member setModulation() refusals (the member keeps its settings).
+  };
+
+  /**
+   * @param members Transports to bond (at least one).
+   * @param configs Per-member settings, by index (missing entries use BondMemberConfig defaults).
+   */
+  explicit BondedTransport(const std::vector<ITransport *> &members,
+                           const std::vector<BondMemberConfig> &configs = std::vector<BondMemberConfig>());
+  ~BondedTransport() override;
+
+  BondedTransport(const BondedTransport &) = delete;
+  BondedTransport &operator=(const BondedTransport &) = delete;
+
+  /**
+   * @brief Accepts a frame for the next free member.
+   * @return false while the previous frame is still waiting for a member.
+   */
+  bool startTransmit(const uint8_t *frame, size_t length) override;
+
+  /**
+   * @brief Applies the modulation to every member, deferred on a member until its frame has left the air.
+   * @return true if every idle member accepted it (refusals of deferred ones are counted in Stats::modulationErrors).
+   */
+  bool setModulation(const LoRaModulation &modulation) override;
+
+  void poll(uint32_t currentTimestampMs) override;
+
+  /**
+   * @brief Smallest frame size of the members.
+   */
+  size_t maxFrameSize() const override;
+
+  /**
+   * @brief True while a frame is pending or on air on any member.
+   */
+  bool transmitting() const;
+
+  size_t memberCount() const { return members_.size(); }
+  const MemberStats &memberStats(size_t member) const { return members_[member].stats; }
+  const Stats &stats() const { return stats_; }
+
+ private:
+  struct Member
+  {
+    ITransport *transport = nullptr;
+    LoRaModulation modulation;
+    std::optional<AirtimeBudget> budget;
+    bool onAir = false;
+    std::optional<LoRaModulation> pendingModulation;  ///< Applied when the frame on air ends.
+    uint8_t buffer[MAX_PACKET_SIZE];
+    MemberStats stats;
+  };
+
+  std::vector<Member> members_;
+  uint8_t pending_[MAX_PACKET_SIZE];
+  size_t pendingLength_ = 0;
+  Stats stats_;
+
+  /**
+   * @brief Retunes an idle member.
+   */
+  bool applyModulation(Member &member, const LoRaModulation &modulation);
+
+  /**
+   * @brief Starts the pending frame on the best member, if one can take it.
+   */
+  void dispatch(uint32_t currentTimestampMs);
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FrameArena.hpp"
+#include "Packet.hpp"
+
+/**
+ * @struct BulkPacketizerConfig
+ * @brief Sizing of a BulkPacketizer.
+ */
+struct BulkPacketizerConfig
+{
+  size_t threadCount = 0;        ///< Threads packetizing, the caller's included (0: one per core).
+  size_t framesPerTask = 512;    ///< Frames handed to a thread at a time.
+  uint16_t chunkPayloadSize = LORA_MAX_PAYLOAD_SIZE;  ///< Payload bytes per chunk (see PacketSerializer).
+  uint16_t firstMessageId = 1;   ///< ID of the first message; the next ones follow, skipping 0 and 0xFFFF.
+
+  /**
+   * @brief Writes compact frames (PacketSerializer::serializeCompact()) instead of full, padded ones.
+   */
+  bool compactFrames = false;
+};
+
+/**
+ * @class BulkPacketizer
+ * @brief Multi-threaded packetization of large host-side uploads (firmware images, configuration bundles).
+ *
+ * The input is cut into consecutive messages of up to MAX_CHUNKS chunks
+ * (the most a header can count), with consecutive message IDs. Frame i of
+ * the upload therefore has a position known in advance, so ranges of frames
+ * are serialized independently by a pool of worker threads, straight from
+ * the input (a memory-mapped file with packetizeFile()) into the slots of a
+ * preallocated FrameArena, in order. Each frame is built in place: header,
+ * payload copy, padding and CRC over the slot, with no intermediate Packet.
+ * The output is byte-identical to serializing the PacketSerializer chunks of
+ * each message.
+ *
+ * Host only (std::thread). The worker threads live as long as the
+ * packetizer; packetize() may be called from one thread at a time.
+ */
+class BulkPacketizer
+{
+ public:
+  explicit BulkPacketizer(const BulkPacketizerConfig &config = BulkPacketizerConfig());
+  ~BulkPacketizer();
+
+  BulkPacketizer(const BulkPacketizer &) = delete;
+  BulkPacketizer &operator=(const BulkPacketizer &) = delete;
+
+  /**
+   * @brief Frames needed for an upload of 'length' bytes (the FrameArena capacity to provide).
+   */
+  static size_t framesFor(size_t length, size_t chunkPayloadSize = LORA_MAX_PAYLOAD_SIZE);
+
+  /**
+   * @brief Messages an upload of 'length' bytes is cut into.
+   */
+  static size_t messagesFor(size_t length, size_t chunkPayloadSize = LORA_MAX_PAYLOAD_SIZE);
+
+  /**
+   * @brief Packetizes 'data' into 'arena', replacing its content.
+   * @return Frames written, 0 if the input is empty, the chunk size invalid
+   * or the arena smaller than framesFor(length).
+   */
+  size_t packetize(const uint8_t *data, size_t length, FrameArena &arena);
+
+  /**
+   * @brief Memory-maps the file at 'path' and packetizes it (not available on ESP32).
+   * @return Frames written, 0 if the file cannot be mapped or packetize() fails.
+   */
+  size_t packetizeFile(const char *path, FrameArena &arena);
+
+  /**
+   * @brief Threads taking part in packetize(), the caller's included.
+   */
+  size_t threadCount() const { return workers_.size() + 1; }
+
+ private:
+  BulkPacketizerConfig config_;
+  std::vector<std::thread> workers_;
+
+  // Current job, published under mutex_ with a new generation_.
+  const uint8_t *data_ = nullptr;
+  size_t length_ = 0;
+  FrameArena *arena_ = nullptr;
+  size_t frames_ = 0;
+  size_t tasks_ = 0;
+  std::atomic<size_t> nextTask_{0};
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  uint64_t generation_ = 0;
+  size_t busyWorkers_ = 0;
+  bool stopping_ = false;
+
+  void workerLoop();
+
+  /**
+   * @brief Serializes tasks of the current job until none is left.
+   */
+  void runTasks();
+
+  /**
+   * @brief Serializes frames [first, last) of the current job.
+   */
+  void packetizeRange(size_t first, size_t last);
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "LoRaAirtime.hpp"
+#include "Packet.hpp"
+
+/**
+ * @struct SimulatedFrame
+ * @brief A raw frame as delivered by the ChannelSimulator to a receiver.
+ */
+struct SimulatedFrame
+{
+  uint32_t sourceId = 0;     ///< Transmitter that sent the frame.
+  uint32_t timestampMs = 0;  ///< Delivery time on the simulated clock.
+  uint16_t length = 0;       ///< Number of valid bytes in 'bytes'.
+  float snrDb = 0.0f;        ///< SNR measured by the receiver (modulation-aware transmit() only).
+  uint8_t bytes[MAX_PACKET_SIZE];
+};
+
+/**
+ * @struct ChannelModel
+ * @brief Impairments applied by the ChannelSimulator to every transmitted frame.
+ *
+ * Probabilities are independent per frame. Reordering swaps a frame with one
+ * of the next 'reorderWindow' frames still waiting for delivery.
+ *
+ * The SNR fields only apply to the transmit() overload taking a
+ * LoRaModulation: a frame is then also lost with a probability that falls
+ * off steeply with its margin above the demodulation floor of its spreading
+ * factor, 1 / (1 + e^(2 * margin)), i.e. 50 % at the floor and 0.25 % 3 dB above it.
+ */
+struct ChannelModel
+{
+  double lossProbability = 0.0;       ///< Frame never arrives.
+  double corruptProbability = 0.0;    ///< One random bit of the frame is flipped.
+  double bitErrorRate = 0.0;          ///< Per-bit error probability: longer frames are hit more often (one bit flipped).
+  double duplicateProbability = 0.0;  ///< Frame is delivered twice.
+  size_t reorderWindow = 0;           ///< 0 disables reordering.
+  uint32_t latencyMs = 0;             ///< Fixed propagation + processing delay.
+  double snrDb = 10.0;                ///< Mean SNR in a 125 kHz bandwidth (scaled to the frame's bandwidth).
+  double snrJitterDb = 0.0;           ///< Per-frame SNR variation, uniform in +/- snrJitterDb.
+  uint64_t seed = 1;                  ///< PRNG seed, runs are deterministic per seed.
+};
+
+/**
+ * @class ChannelSimulator
+ * @brief Deterministic host-side model of a lossy LoRa channel.
+ *
+ * Transmitters hand serialized frames to transmit(); the receiver side pulls
+ * them with receive() or drain() after loss, corruption, duplication and
+ * reordering have been applied. Used by unit tests and the host benchmarks
+ * to exercise the receive pipeline without radios.
+ */
+class ChannelSimulator
+{
+ public:
+  explicit ChannelSimulator(const ChannelModel &model = ChannelModel());
+
+  /**
+   * @brief Sends one raw frame through the channel.
+   *
+   * @param sourceId Identity of the transmitter.
+   * @param frame Serialized frame bytes.
+   * @param length Frame length (at most MAX_PACKET_SIZE).
+   * @param timestampMs Transmission time on the simulated clock.
+   */
+  void transmit(uint32_t sourceId, const uint8_t *frame, size_t length, uint32_t timestampMs);
+
+  /**
+   * @brief Sends one raw frame with the given modem settings, applying the SNR model as well.
+   */
+  void transmit(uint32_t sourceId, const uint8_t *frame, size_t length, uint32_t timestampMs,
+                const LoRaModulation &modulation);
+
+  /**
+   * @brief Serializes and sends every packet of a split message.
+   *
+   * Consecutive packets are spaced by 'frameIntervalMs' starting at 'startMs'.
+   */
+  void transmitMessage(uint32_t sourceId, const std::vector<Packet> &packets, uint32_t startMs, uint32_t frameIntervalMs = 0);
+
+  /**
+   * @brief Pops the next delivered frame.
+   * @return false when no frame is waiting.
+   */
+  bool receive(SimulatedFrame &frame);
+
+  /**
+   * @brief Pops the next frame if it is due by 'currentTimestampMs' (see ChannelModel::latencyMs).
+   * @return false when no frame is waiting or the next one is still in flight.
+   */
+  bool receive(SimulatedFrame &frame, uint32_t currentTimestampMs);
+
+  /**
+   * @brief Pops every delivered frame in delivery order.
+   */
+  std::vector<SimulatedFrame> drain();
+
+  /**
+   * @brief Number of frames waiting for delivery.
+   */
+  size_t pending() const { return inFlight_.size(); }
+
+  /**
+   * @brief Current impairments; may be changed between frames (e.g. to fade the link).
+   */
+  ChannelModel &model() { return model_; }
+
+  /**
+   * @brief Uniform random number in [0, 1) from the simulator's PRNG.
+   */
+  double uniform();
+
+  /**
+   * @brief Raw 64-bit output of the simulator's PRNG (xorshift64*).
+   */
+  uint64_t nextRandom();
+
+ private:
+  ChannelModel model_;
+  uint64_t state_;
+  std::deque<SimulatedFrame> inFlight_;
+
+  void enqueue(const SimulatedFrame &frame);
+
+  void deliver(uint32_t sourceId, const uint8_t *frame, size_t length, uint32_t timestampMs, float snrDb);
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class Crc16
+ * @brief Modbus CRC-16 kernels (reflected polynomial 0xA001, initial value 0xFFFF, no final XOR).
+ *
+ * All variants are bit-exact with each other and with the reference bitwise
+ * loop; they only differ in how much work they overlap:
+ *   - updateBitwise(): reference implementation, 8 shift/XOR steps per byte.
+ *   - update():        table-driven slice-by-4 (2 KB of const tables). On x86
+ *                      hosts with PCLMULQDQ, long buffers are folded 16 bytes
+ *                      at a time with carry-less multiplication instead.
+ *   - computeMulti():  advances up to MAX_STREAMS independent buffers in
+ *                      lockstep (folding or slice-by-4 steps), so their
+ *                      dependency chains overlap instead of running one after
+ *                      the other. Meant for batches of received frames.
+ */
+class Crc16
+{
+ public:
+  using value_type = uint16_t;
+
+  static constexpr uint16_t POLYNOMIAL = 0xA001;     ///< Reflected form of x^16 + x^15 + x^2 + 1.
+  static constexpr uint16_t INITIAL_VALUE = 0xFFFF;  ///< Modbus initial register value.
+
+  /**
+   * @brief Number of buffers computeMulti() interleaves per pass.
+   */
+  static constexpr size_t MAX_STREAMS = 8;
+
+  /**
+   * @brief Buffers at least this long use carry-less multiply folding when available.
+   */
+  static constexpr size_t FOLD_THRESHOLD = 128;
+
+  /**
+   * @brief Reference bit-serial update.
+   */
+  static uint16_t updateBitwise(uint16_t crc, const uint8_t *data, size_t length);
+
+  /**
+   * @brief Continues a CRC over 'length' more bytes.
+   */
+  static uint16_t update(uint16_t crc, const uint8_t *data, size_t length);
+
+  /**
+   * @brief Turns a register into the CRC value. Modbus has no final XOR.
+   * Present so that protocol profiles can use Crc16 and Crc32 interchangeably.
+   */
+  static constexpr uint16_t finalize(uint16_t crc) { return crc; }
+
+  /**
+   * @brief CRC of a whole buffer, starting from INITIAL_VALUE.
+   */
+  static uint16_t compute(const uint8_t *data, size_t length) { return update(INITIAL_VALUE, data, length); }
+
+  /**
+   * @brief Computes the CRCs of 'count' independent buffers.
+   *
+   * Buffers are processed in groups of MAX_STREAMS, interleaved step by step
+   * up to the shortest length of the group, then finished one by one.
+   *
+   * @param data Array of 'count' buffer pointers
+   * @param lengths Array of 'count' buffer lengths
+   * @param count Number of buffers
+   * @param crcs Output array of 'count' CRCs (each starting from INITIAL_VALUE)
+   */
+  static void computeMulti(const uint8_t *const *data, const size_t *lengths, size_t count, uint16_t *crcs);
+
+  /**
+   * @brief True when update() can use the carry-less multiply folding path on this CPU.
+   */
+  static bool hasFolding();
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class Crc32
+ * @brief IEEE 802.3 CRC-32 (reflected polynomial 0xEDB88320, initial value and final XOR 0xFFFFFFFF).
+ *
+ * Checksum for protocol profiles with large frames, where a 16-bit CRC no
+ * longer gives enough protection. Same interface as Crc16: update() continues
+ * a running register, finalize() turns the register into the transmitted value.
+ * Uses a single 1 KB table to stay small on the ESP32.
+ */
+class Crc32
+{
+ public:
+  using value_type = uint32_t;
+
+  static constexpr uint32_t POLYNOMIAL = 0xEDB88320;     ///< Reflected form of the IEEE 802.3 polynomial.
+  static constexpr uint32_t INITIAL_VALUE = 0xFFFFFFFF;  ///< Initial register value.
+
+  /**
+   * @brief Continues a CRC over 'length' more bytes (register form, not finalized).
+   */
+  static uint32_t update(uint32_t crc, const uint8_t *data, size_t length);
+
+  /**
+   * @brief Turns a register into the CRC value (final XOR).
+   */
+  static constexpr uint32_t finalize(uint32_t crc) { return crc ^ 0xFFFFFFFF; }
+
+  /**
+   * @brief CRC of a whole buffer.
+   */
+  static uint32_t compute(const uint8_t *data, size_t length) { return finalize(update(INITIAL_VALUE, data, length)); }
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Packet.hpp"
+
+/**
+ * @brief Distance between two frame slots in a FrameArena.
+ * MAX_PACKET_SIZE rounded up so that every slot starts on a 64-byte boundary
+ * relative to the arena base.
+ */
+constexpr size_t FRAME_SLOT_SIZE = (MAX_PACKET_SIZE + 63) & ~static_cast<size_t>(63);
+
+/**
+ * @brief Number of 64-bit words needed for a bitmask covering 'frames' frames.
+ */
+constexpr size_t batchMaskWords(size_t frames)
+{
+  return (frames + 63) / 64;
+}
+
+/**
+ * @struct FrameMeta
+ * @brief Reception metadata attached to every raw frame in a FrameArena.
+ */
+struct FrameMeta
+{
+  uint32_t sourceId = 0;     ///< Transmitter / gateway identity (see PacketReassembler::processPacket).
+  uint32_t timestampMs = 0;  ///< Reception time.
+  uint16_t length = 0;       ///< Number of valid bytes in the slot.
+  float rssi = 0.0f;         ///< Received signal strength in dBm (0 if unknown).
+  float snr = 0.0f;          ///< Signal-to-noise ratio in dB (0 if unknown).
+};
+
+/**
+ * @class FrameArena
+ * @brief Preallocated batch of raw frames.
+ *
+ * Holds up to capacity() frames in fixed-size slots of one contiguous
+ * allocation, plus their metadata in a parallel array. Receive front-ends
+ * fill the arena in place and hand the whole batch to the parser, so the
+ * steady state performs no allocation and frames of a batch are adjacent in
+ * memory.
+ */
+class FrameArena
+{
+ public:
+  explicit FrameArena(size_t capacity)
+      : capacity_(capacity), count_(0), storage_(capacity * FRAME_SLOT_SIZE), meta_(capacity)
+  {
+  }
+
+  /**
+   * @brief Raw bytes of frame slot 'index' (FRAME_SLOT_SIZE bytes available).
+   */
+  uint8_t *slot(size_t index) { return storage_.data() + index * FRAME_SLOT_SIZE; }
+  const uint8_t *slot(size_t index) const { return storage_.data() + index * FRAME_SLOT_SIZE; }
+
+  FrameMeta &meta(size_t index) { return meta_[index]; }
+  const FrameMeta &meta(size_t index) const { return meta_[index]; }
+
+  /**
+   * @brief Appends a copy of a frame.
+   * @return false if the arena is full or the frame does not fit a slot.
+   */
+  bool push(const uint8_t *frame, size_t length, const FrameMeta &meta)
+  {
+    if (count_ >= capacity_ || length > MAX_PACKET_SIZE)
+      return false;
+    std::memcpy(slot(count_), frame, length);
+    meta_[count_] = meta;
+    meta_[count_].length = static_cast<uint16_t>(length);
+    count_++;
+    return true;
+  }
+
+  /**
+   * @brief Marks the first 'count' slots as filled (used by in-place receivers).
+   */
+  void setSize(size_t count) { count_ = count < capacity_ ? count : capacity_; }
+
+  void clear() { count_ = 0; }
+
+  size_t size() const { return count_; }
+  size_t capacity() const { return capacity_; }
+  bool full() const { return count_ == capacity_; }
+
+ private:
+  size_t capacity_;
+  size_t count_;
+  std::vector<uint8_t> storage_;
+  std::vector<FrameMeta> meta_;
+};
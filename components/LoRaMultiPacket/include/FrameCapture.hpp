@@ -0,0 +1,211 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "FrameArena.hpp"
+
+/**
+ * @name Capture File Format
+ * @brief Append-only binary capture of raw received frames (little endian).
+ *
+ * ```
+ * +--------------------+---------------------------------+------------------+
+ * | CaptureFileHeader  | record, record, ... (append)    | index + footer   |
+ * +--------------------+---------------------------------+------------------+
+ * record = CaptureRecordHeader + 'length' raw frame bytes
+ * ```
+ *
+ * Records are written as frames arrive, so a capture cut short by a reset
+ * or power loss is still readable by scanning. The index (one entry every
+ * 'indexStride' records) and the footer are appended by CaptureWriter::finish().
+ * @{
+ */
+#pragma pack(push, 1)
+
+/**
+ * @brief Start of every capture file. Total size: 16 bytes.
+ */
+struct CaptureFileHeader
+{
+  char magic[8];             ///< CAPTURE_FILE_MAGIC
+  uint16_t version;          ///< CAPTURE_FORMAT_VERSION
+  uint16_t recordHeaderSize; ///< sizeof(CaptureRecordHeader), lets readers skip unknown fields
+  uint32_t reserved;
+};
+
+/**
+ * @brief Prefix of every captured frame. Total size: 14 bytes.
+ */
+struct CaptureRecordHeader
+{
+  uint32_t timestampMs;  ///< Reception time.
+  uint32_t sourceId;     ///< Transmitter / gateway identity.
+  int16_t rssiDeci;      ///< RSSI in 0.1 dBm.
+  int16_t snrDeci;       ///< SNR in 0.1 dB.
+  uint16_t length;       ///< Raw frame bytes that follow.
+};
+
+/**
+ * @brief Sparse index entry: file offset of every 'indexStride'-th record.
+ */
+struct CaptureIndexEntry
+{
+  uint64_t offset;
+  uint32_t timestampMs;
+};
+
+/**
+ * @brief Last bytes of a finished capture. Total size: 32 bytes.
+ */
+struct CaptureFooter
+{
+  uint64_t indexOffset;   ///< File offset of the first CaptureIndexEntry.
+  uint64_t recordCount;   ///< Number of records in the file.
+  uint32_t indexEntries;  ///< Number of CaptureIndexEntry items.
+  uint32_t indexStride;   ///< Records between two index entries.
+  char magic[8];          ///< CAPTURE_FOOTER_MAGIC
+};
+
+#pragma pack(pop)
+
+constexpr char CAPTURE_FILE_MAGIC[8] = {'L', 'M', 'P', 'C', 'A', 'P', '\r', '\n'};
+constexpr char CAPTURE_FOOTER_MAGIC[8] = {'L', 'M', 'P', 'I', 'D', 'X', '\r', '\n'};
+constexpr uint16_t CAPTURE_FORMAT_VERSION = 1;
+/** @} */
+
+/**
+ * @class CaptureWriter
+ * @brief Appends received frames to a capture stream.
+ *
+ * Output goes through a byte sink so the same writer serves a file on the
+ * host, a SPIFFS/SD file or a UART stream on the ESP32. Each record is
+ * emitted with a single sink call.
+ */
+class CaptureWriter
+{
+ public:
+  /**
+   * @brief Receives the encoded bytes. Returns false on I/O error.
+   */
+  using Sink = std::function<bool(const uint8_t *data, size_t length)>;
+
+  /**
+   * @param sink Destination of the capture bytes
+   * @param indexStride Records between two index entries (0 disables the index)
+   */
+  explicit CaptureWriter(Sink sink, uint32_t indexStride = 256);
+
+  /**
+   * @brief Writes the file header. Must be called once before any record.
+   */
+  bool begin();
+
+  /**
+   * @brief Appends one frame.
+   */
+  bool write(const uint8_t *frame, size_t length, const FrameMeta &meta);
+
+  /**
+   * @brief Appends every frame of a batch.
+   */
+  bool writeBatch(const FrameArena &batch);
+
+  /**
+   * @brief Appends the index and footer. No record may be written afterwards.
+   */
+  bool finish();
+
+  uint64_t recordCount() const { return recordCount_; }
+  uint64_t bytesWritten() const { return offset_; }
+
+ private:
+  Sink sink_;
+  uint32_t indexStride_;
+  uint64_t offset_ = 0;
+  uint64_t recordCount_ = 0;
+  std::vector<CaptureIndexEntry> index_;
+
+  bool emit(const void *data, size_t length);
+};
+
+/**
+ * @struct CaptureRecord
+ * @brief Zero-copy view of one record of a capture.
+ */
+struct CaptureRecord
+{
+  FrameMeta meta;         ///< Metadata, with length = frame length.
+  const uint8_t *frame;   ///< Points into the capture buffer / mapping.
+};
+
+/**
+ * @class CaptureReader
+ * @brief Sequential and indexed reader over a capture held in memory.
+ *
+ * openFile() maps the capture read-only with mmap() (POSIX hosts) so replay
+ * touches the page cache directly; openBuffer() reads a capture already in
+ * memory. Records are returned as views into that memory.
+ */
+class CaptureReader
+{
+ public:
+  CaptureReader() = default;
+  ~CaptureReader();
+
+  CaptureReader(const CaptureReader &) = delete;
+  CaptureReader &operator=(const CaptureReader &) = delete;
+
+  /**
+   * @brief Memory-maps a capture file (not available on ESP32).
+   */
+  bool openFile(const char *path);
+
+  /**
+   * @brief Reads a capture from a caller-owned buffer that outlives the reader.
+   */
+  bool openBuffer(const uint8_t *data, size_t size);
+
+  void close();
+
+  /**
+   * @brief Returns the next record, false at the end of the capture.
+   * A truncated trailing record (capture cut short) ends the iteration.
+   */
+  bool next(CaptureRecord &record);
+
+  /**
+   * @brief Restarts iteration at the first record.
+   */
+  void rewind();
+
+  /**
+   * @brief Positions the iterator at or before the first record with timestamp >= timestampMs.
+   * Uses the index when present, otherwise scans from the start.
+   */
+  void seek(uint32_t timestampMs);
+
+  /**
+   * @brief True when the capture ends with a valid index footer.
+   */
+  bool hasIndex() const { return footer_ != nullptr; }
+
+  /**
+   * @brief Record count from the footer, or counted by scanning when there is none.
+   */
+  uint64_t recordCount();
+
+ private:
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+  size_t recordsEnd_ = 0;  ///< End of the record area (index offset or file size).
+  size_t cursor_ = 0;
+  uint16_t recordHeaderSize_ = 0;
+  const CaptureFooter *footer_ = nullptr;
+  void *mapping_ = nullptr;
+  size_t mappingSize_ = 0;
+
+  bool parseLayout();
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "FrameArena.hpp"
+#include "ITransport.hpp"
+#include "Packet.hpp"
+
+/**
+ * @struct RelayConfig
+ * @brief Forwarding policy and state sizing of a FrameRelay.
+ */
+struct RelayConfig
+{
+  /**
+   * @brief Frames that already went through this many relays are not forwarded again (at most PACKET_MAX_HOPS).
+   */
+  uint8_t maxHops = 3;
+
+  /**
+   * @brief (source, messageId) flows tracked for deduplication. When all are
+   * in use, the least recently active flow is forgotten.
+   */
+  size_t flowCount = 8;
+
+  /**
+   * @brief A flow with no frame for this long is forgotten.
+   */
+  uint32_t flowTimeoutMs = 30000;
+
+  /**
+   * @brief Frames waiting for the downlink. A frame arriving when the queue is full is dropped.
+   */
+  size_t queueFrames = 8;
+
+  /**
+   * @brief Forward PACKET_FLAG_CONTROL frames. Off by default: link
+   * announcements describe one hop's modulation, not the next one's.
+   */
+  bool forwardControl = false;
+};
+
+/**
+ * @class FrameRelay
+ * @brief Cut-through forwarding of frames between two links, without reassembly.
+ *
+ * Each frame received on the uplink is validated (PacketParser /
+ * PacketValidator), deduplicated on (sourceId, messageId, chunkIndex),
+ * stamped with one more hop (PACKET_HOPS_MASK, CRC recomputed) and queued
+ * for the downlink, in the layout it arrived in (compact or full). The next
+ * poll() starts it, so a relay adds about one frame time per hop instead of
+ * a whole message: chunks are forwarded while the sender is still sending
+ * the rest of the message.
+ *
+ * State is small and fixed: a 256-bit chunk bitmap per tracked flow and a
+ * queue of queueFrames frames, all allocated at construction.
+ *
+ * Uplink and downlink may be the same half-duplex transport (single-radio
+ * relay). The relay installs its callbacks on both; poll() must be called
+ * from the task that owns them.
+ */
+class FrameRelay
+{
+ public:
+  /**
+   * @brief What happened to a received frame.
+   */
+  enum class Verdict
+  {
+    Forwarded,  ///< Queued for the downlink.
+    Duplicate,  ///< (source, messageId, chunkIndex) already forwarded.
+    Invalid,    ///< Failed parsing / validation.
+    HopLimit,   ///< Already went through maxHops relays.
+    Control,    ///< Control frame, not forwarded (see RelayConfig::forwardControl).
+    QueueFull,  ///< Downlink queue full.
+  };
+
+  /**
+   * @brief Optional tap on every received frame (telemetry, PacketLog, latency measurements).
+   */
+  using FrameObserver = std::function<void(const Packet &packet, const FrameMeta &meta, Verdict verdict)>;
+
+  /**
+   * @brief Relay counters.
+   */
+  struct Stats
+  {
+    uint64_t framesReceived = 0;
+    uint64_t framesForwarded = 0;  ///< Frames whose transmission on the downlink completed.
+    uint64_t duplicates = 0;
+    uint64_t invalid = 0;
+    uint64_t hopLimit = 0;
+    uint64_t control = 0;
+    uint64_t queueDrops = 0;
+    uint64_t flowsEvicted = 0;     ///< Active flows forgotten to make room for a new one.
+    uint64_t radioErrors = 0;      ///< startTransmit() refusals (the frame is retried).
+    uint64_t residenceMsTotal = 0; ///< Sum over started frames of (transmit start - reception).
+    uint32_t residenceMsMax = 0;
+  };
+
+  /**
+   * @param uplink Link frames are received from. Must outlive the relay.
+   * @param downlink Link frames are forwarded to (may be the uplink). Must outlive the relay.
+   */
+  FrameRelay(ITransport &uplink, ITransport &downlink, const RelayConfig &config = RelayConfig());
+  ~FrameRelay();
+
+  FrameRelay(const FrameRelay &) = delete;
+  FrameRelay &operator=(const FrameRelay &) = delete;
+
+  /**
+   * @brief Handles a received frame. Installed as the uplink's receive callback;
+   * public for applications that dispatch frames themselves.
+   */
+  Verdict onFrame(const uint8_t *frame, size_t length, const FrameMeta &meta);
+
+  /**
+   * @brief Services both transports and starts the next queued frame.
+   */
+  void poll(uint32_t currentTimestampMs);
+
+  void setFrameObserver(FrameObserver observer) { observer_ = std::move(observer); }
+
+  /**
+   * @brief True when no frame is queued or on air.
+   */
+  bool idle() const { return queued_ == 0 && !transmitting_; }
+
+  /**
+   * @brief Frames waiting for the downlink (the one on air included).
+   */
+  size_t queuedFrames() const { return queued_; }
+
+  const Stats &stats() const { return stats_; }
+
+ private:
+  struct Flow
+  {
+    bool active = false;
+    uint32_t sourceId = 0;
+    uint16_t messageId = 0;
+    uint16_t totalChunks = 0;
+    uint32_t lastSeenMs = 0;
+    std::bitset<256> forwarded;
+  };
+
+  struct QueuedFrame
+  {
+    uint8_t bytes[MAX_PACKET_SIZE];
+    uint16_t length = 0;
+    uint32_t receivedMs = 0;
+  };
+
+  ITransport &uplink_;
+  ITransport &downlink_;
+  RelayConfig config_;
+  FrameObserver observer_;
+  Stats stats_;
+
+  std::vector<Flow> flows_;
+  std::vector<QueuedFrame> queue_;
+  size_t head_ = 0;
+  size_t queued_ = 0;
+  bool transmitting_ = false;
+
+  Flow &flowFor(uint32_t sourceId, uint16_t messageId, uint16_t totalChunks, uint32_t currentTimestampMs);
+  Verdict classify(const uint8_t *frame, size_t length, const FrameMeta &meta, Packet &packet);
+  void onTransmitDone();
+};
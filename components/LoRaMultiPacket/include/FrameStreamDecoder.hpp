@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "Packet.hpp"
+#include "PacketView.hpp"
+
+/**
+ * @class FrameStreamDecoder
+ * @brief Incremental decoder of compact frames from an unframed byte stream (UART LoRa modules).
+ *
+ * Modules such as the EByte E220 output received data as a plain byte
+ * stream, read in fragments of arbitrary size (a UART DMA ring, a driver
+ * buffer). Frames are located by header plausibility and confirmed by their
+ * CRC:
+ *   - candidates are found with memchr() on the protocol version byte, so
+ *     garbage is skipped at memory speed;
+ *   - a candidate whose header fails PacketValidator::plausibleHeader() or
+ *     whose CRC does not match is abandoned one byte later, so the decoder
+ *     resynchronizes on the next real frame right after a corrupted one.
+ *
+ * Frames lying entirely inside a fragment are returned as PacketViews into
+ * the fragment itself, with no copy. Only a frame split across two fragments
+ * is gathered into a small internal buffer (at most MAX_TX_PACKET_SIZE bytes).
+ *
+ * Usage, single thread:
+ * @code
+ * decoder.push(data, length);
+ * while (auto view = decoder.next()) { ... }   // until std::nullopt, before the next push()
+ * @endcode
+ */
+class FrameStreamDecoder
+{
+ public:
+  /**
+   * @brief Decoder counters.
+   */
+  struct Stats
+  {
+    uint64_t bytesReceived = 0;   ///< Bytes handed to push().
+    uint64_t framesDecoded = 0;   ///< Frames returned by next().
+    uint64_t framesCopied = 0;    ///< Of which gathered across two fragments.
+    uint64_t bytesDiscarded = 0;  ///< Bytes skipped while looking for a frame (noise, corrupted frames, flush()).
+    uint64_t crcErrors = 0;       ///< Plausible headers whose CRC did not match.
+  };
+
+  /**
+   * @brief Hands the next fragment of the stream to the decoder.
+   *
+   * The fragment must stay valid, unchanged, until next() has returned
+   * std::nullopt; views returned from it are valid until the next push().
+   */
+  void push(const uint8_t *data, size_t length);
+
+  /**
+   * @brief Returns the next frame of the stream, or std::nullopt once the current fragment is exhausted.
+   *
+   * A view of a frame split across fragments lives in the decoder and is
+   * only valid until the following call to next().
+   */
+  std::optional<PacketView> next();
+
+  /**
+   * @brief Abandons a partially received frame (the line went idle: its end will never come).
+   *
+   * Only the stalled candidate is given up: the bytes held behind it are
+   * scanned again, and the complete frames among them are returned by
+   * next(), to be called until std::nullopt before the next push(). Bytes
+   * that cannot start a frame are discarded.
+   */
+  void flush();
+
+  /**
+   * @brief Bytes held while waiting for the rest of a possible frame.
+   */
+  size_t pendingBytes() const { return carryEnd_ - carryHead_ - carryEmitted_; }
+
+  const Stats &stats() const { return stats_; }
+
+  /**
+   * @brief Forgets all buffered bytes and counters.
+   */
+  void reset();
+
+ private:
+  const uint8_t *input_ = nullptr;
+  size_t inputLength_ = 0;
+  size_t inputPos_ = 0;
+
+  // Start of a frame that crosses a fragment boundary.
+  uint8_t carry_[MAX_TX_PACKET_SIZE];
+  size_t carryHead_ = 0;
+  size_t carryEnd_ = 0;
+  size_t carryFromInput_ = 0;  ///< Trailing carry bytes taken from the current fragment.
+  size_t carryEmitted_ = 0;    ///< Length of the frame at the carry head returned by the last next().
+  bool flushing_ = false;      ///< Rescanning the carry after flush(): no more bytes for it.
+
+  Stats stats_;
+
+  std::optional<PacketView> nextFromCarry();
+  bool topUpCarry(size_t needed);
+  void advanceCarry(size_t count);
+  void dropCarryByte();
+  void clearCarry();
+  void stash(size_t from);
+};
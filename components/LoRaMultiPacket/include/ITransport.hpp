@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "FrameArena.hpp"
+#include "RadioTransmitter.hpp"
+
+/**
+ * @class ITransport
+ * @brief Radio-agnostic frame link: send frames, receive frames with metadata.
+ *
+ * Extends RadioTransmitter (so a TxEngine can drive it directly) with the
+ * receive direction and completion callbacks. Transports do their work in
+ * poll(), called periodically from a single task; both callbacks are
+ * invoked from poll() on that task, never from an interrupt:
+ * - the receive callback gets every raw frame with its FrameMeta
+ *   (reception time, source, RSSI/SNR when the radio reports them);
+ * - the transmit-done callback reports the end of the frame passed to
+ *   startTransmit(); the next frame may be started after finishTransmit().
+ *
+ * Implementations: RadioLibTransport (SX1262 and other RadioLib modules),
+ * UartTransport (serial LoRa modules such as the EByte E220) and
+ * LoopbackTransport (in-process, for host tests and benchmarks).
+ * BondedTransport combines several of them into one link.
+ * LinkEndpoint builds the full message API on top of any of them.
+ */
+class ITransport : public RadioTransmitter
+{
+ public:
+  using ReceiveCallback = std::function<void(const uint8_t *frame, size_t length, const FrameMeta &meta)>;
+  using TransmitDoneCallback = std::function<void()>;
+
+  /**
+   * @brief Services the link: reports completed transmissions and delivers received frames.
+   * @param currentTimestampMs Current time, stamped on received frames.
+   */
+  virtual void poll(uint32_t currentTimestampMs) = 0;
+
+  /**
+   * @brief Largest frame the transport can carry.
+   */
+  virtual size_t maxFrameSize() const { return MAX_PACKET_SIZE; }
+
+  void setReceiveCallback(ReceiveCallback callback) { onReceive_ = std::move(callback); }
+  void setTransmitDoneCallback(TransmitDoneCallback callback) { onTransmitDone_ = std::move(callback); }
+
+ protected:
+  /**
+   * @brief Hands a received frame to the receive callback (implementations, from poll()).
+   */
+  void deliverFrame(const uint8_t *frame, size_t length, const FrameMeta &meta)
+  {
+    if (onReceive_)
+      onReceive_(frame, length, meta);
+  }
+
+  /**
+   * @brief Reports the end of the frame on air (implementations, from poll()).
+   */
+  void transmitDone()
+  {
+    if (onTransmitDone_)
+      onTransmitDone_();
+  }
+
+ private:
+  ReceiveCallback onReceive_;
+  TransmitDoneCallback onTransmitDone_;
+};
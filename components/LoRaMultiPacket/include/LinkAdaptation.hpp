@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "LoRaAirtime.hpp"
+#include "Packet.hpp"
+
+/**
+ * @struct LinkProfile
+ * @brief One rung of the link adaptation ladder: modulation and chunk size.
+ */
+struct LinkProfile
+{
+  uint8_t spreadingFactor = 9;
+  uint32_t bandwidthHz = 125000;
+  uint8_t codingRate = 7;                           ///< 4/x denominator, 5..8.
+  uint16_t chunkPayloadSize = LORA_MAX_PAYLOAD_SIZE;  ///< Payload bytes per chunk for new messages.
+
+  /**
+   * @brief 'base' with this profile's spreading factor, bandwidth and coding rate.
+   */
+  LoRaModulation modulation(const LoRaModulation &base = LoRaModulation()) const;
+
+  bool operator==(const LinkProfile &other) const;
+  bool operator!=(const LinkProfile &other) const { return !(*this == other); }
+};
+
+/**
+ * @struct LinkSample
+ * @brief Link quality observed for one transmitted frame.
+ *
+ * Produced by the receiver (radio.getSNR() / getRSSI() of each frame, and
+ * frames found missing) and fed back to the sender's controller by the
+ * application, e.g. in periodic status messages or acknowledgements.
+ */
+struct LinkSample
+{
+  bool delivered = true;
+  float snrDb = 0.0f;     ///< Measured in the bandwidth of the frame. Ignored if not delivered.
+  float rssiDbm = 0.0f;
+};
+
+/**
+ * @struct LinkAdaptationConfig
+ * @brief Ladder and thresholds of a LinkAdaptationController.
+ */
+struct LinkAdaptationConfig
+{
+  /**
+   * @brief Profiles ordered from fastest to most robust. The last one is the
+   * fallback both ends return to when the link goes silent.
+   */
+  std::vector<LinkProfile> ladder = {
+      {7, 250000, 5, LORA_MAX_PAYLOAD_SIZE},
+      {7, 125000, 5, LORA_MAX_PAYLOAD_SIZE},
+      {8, 125000, 5, LORA_MAX_PAYLOAD_SIZE},
+      {9, 125000, 7, 192},
+      {10, 125000, 7, 128},
+      {11, 125000, 8, 96},
+      {12, 125000, 8, 64},
+  };
+
+  size_t initialIndex = 3;          ///< Rung used at start-up.
+  size_t windowSize = 16;           ///< Samples kept in the rolling window.
+  size_t minSamples = 8;            ///< Samples needed since the last change before deciding again.
+  float marginDb = 5.0f;            ///< SNR headroom required above the demodulation floor.
+  float maxLossRate = 0.2f;         ///< Above this loss rate, step one rung towards robustness.
+  uint32_t stepUpHoldMs = 5000;     ///< Minimum time between two steps towards speed.
+  uint32_t feedbackTimeoutMs = 15000;  ///< Without feedback for this long, fall back to the last rung.
+};
+
+/**
+ * @class LinkAdaptationController
+ * @brief ADR-style rate adaptation from a rolling window of link samples.
+ *
+ * Each decision compares the mean SNR of the window, corrected for the
+ * bandwidth of every candidate rung, with the demodulation floor of its
+ * spreading factor plus marginDb:
+ * - the loss rate above maxLossRate, or no margin on the current rung:
+ *   move immediately to the first rung with margin (at least one step);
+ * - margin on a faster rung: move one step faster, at most every stepUpHoldMs;
+ * - no feedback for feedbackTimeoutMs: fall back to the last rung.
+ * The window is cleared after every change, so each rung is judged on its
+ * own samples. Time is passed in explicitly; not thread safe.
+ */
+class LinkAdaptationController
+{
+ public:
+  explicit LinkAdaptationController(const LinkAdaptationConfig &config = LinkAdaptationConfig());
+
+  /**
+   * @brief Adds the outcome of one frame sent with the current profile.
+   */
+  void onFeedback(const LinkSample &sample, uint32_t currentTimestampMs);
+
+  /**
+   * @brief Runs the decision rules.
+   * @return The new profile when the controller changed rung.
+   */
+  std::optional<LinkProfile> update(uint32_t currentTimestampMs);
+
+  size_t currentIndex() const { return index_; }
+  const LinkProfile &current() const { return config_.ladder[index_]; }
+
+  /**
+   * @brief Loss rate of the samples in the window (0 when empty).
+   */
+  float lossRate() const;
+
+  /**
+   * @brief SNR (dB) a frame needs to be demodulated at this spreading factor (SX126x datasheet).
+   */
+  static float requiredSnrDb(uint8_t spreadingFactor);
+
+ private:
+  LinkAdaptationConfig config_;
+  size_t index_;
+  std::deque<LinkSample> window_;
+  uint32_t lastFeedbackMs_ = 0;
+  uint32_t lastChangeMs_ = 0;
+  bool started_ = false;
+
+  /**
+   * @brief SNR margin (dB) the window's mean SNR would have on rung 'index'.
+   */
+  float marginOn(size_t index, float meanSnrDb) const;
+
+  std::optional<LinkProfile> moveTo(size_t index, uint32_t currentTimestampMs);
+};
+
+/**
+ * @class LinkAnnouncement
+ * @brief In-band signalling of a link profile change.
+ *
+ * Announcements are single-chunk messages with PACKET_FLAG_CONTROL, sent with
+ * the old settings just before the sender switches (see
+ * TxEngine::requestLinkChange()). Payload layout (little endian):
+ *   [0] 'L'  [1] spreadingFactor  [2] codingRate  [3..6] bandwidthHz  [7..8] chunkPayloadSize
+ */
+class LinkAnnouncement
+{
+ public:
+  static constexpr size_t SIZE = 9;
+  static constexpr uint8_t TYPE = 'L';
+
+  /**
+   * @brief Message ID carried by announcement frames.
+   */
+  static constexpr uint16_t MESSAGE_ID = 0xFFFF;
+
+  static void encode(const LinkProfile &profile, uint8_t *out);
+
+  /**
+   * @brief Decodes an announcement.
+   * @return std::nullopt if 'packet' is not a valid link announcement.
+   */
+  static std::optional<LinkProfile> decode(const Packet &packet);
+};
+
+/**
+ * @brief Outcome of LinkFollower::onPacket().
+ */
+enum class LinkEvent : uint8_t
+{
+  None,     ///< Application data: pass the packet on to the reassembler.
+  Control,  ///< Link control frame, nothing to do.
+  Changed,  ///< The sender switched: retune the radio to LinkFollower::current().
+};
+
+/**
+ * @class LinkFollower
+ * @brief Receiver side of link adaptation: tracks the sender's announced profile.
+ *
+ * If nothing valid is received for fallbackAfterMs, the follower reverts to
+ * the fallback profile, which must be the last rung of the sender's ladder
+ * so that both ends meet again after missed announcements.
+ */
+class LinkFollower
+{
+ public:
+  LinkFollower(const LinkProfile &initial, const LinkProfile &fallback, uint32_t fallbackAfterMs);
+
+  /**
+   * @brief Handles a validated packet.
+   */
+  LinkEvent onPacket(const Packet &packet, uint32_t currentTimestampMs);
+
+  /**
+   * @brief Applies the silence timeout.
+   * @return true if the follower fell back (retune to current()).
+   */
+  bool checkTimeout(uint32_t currentTimestampMs);
+
+  const LinkProfile &current() const { return current_; }
+
+ private:
+  LinkProfile current_;
+  LinkProfile fallback_;
+  uint32_t fallbackAfterMs_;
+  uint32_t lastHeardMs_ = 0;
+  bool heard_ = false;
+};
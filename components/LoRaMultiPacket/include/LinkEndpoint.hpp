@@ -0,0 +1,158 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "FrameArena.hpp"
+#include "ITransport.hpp"
+#include "Packet.hpp"
+#include "PacketReassembler.hpp"
+#include "TxEngine.hpp"
+
+/**
+ * @struct LinkEndpointConfig
+ * @brief Configuration of a LinkEndpoint.
+ */
+struct LinkEndpointConfig
+{
+  TxEngineConfig tx;
+  ReassemblerConfig reassembler;
+
+  /**
+   * @brief Interval between two PacketReassembler::pruneStalled() passes.
+   */
+  uint32_t pruneIntervalMs = 1000;
+};
+
+/**
+ * @class LinkEndpoint
+ * @brief Message-level API over any ITransport: send() whole messages, get whole messages back.
+ *
+ * Wires the library's pieces to one transport: outgoing messages go through
+ * a TxEngine (chunking, scheduling, double buffering, optional duty cycle),
+ * received frames are parsed, validated and reassembled by a
+ * PacketReassembler, and stalled sessions are pruned periodically. Control
+ * frames (PACKET_FLAG_CONTROL, e.g. LinkAnnouncement) bypass reassembly and
+ * go to the onControl() callback. With a TDMA slot plan (tx.tdma), received
+ * TdmaBeacons also synchronize the engine's TdmaSchedule.
+ *
+ * Transfers can resume across a restart of the receiver: with a
+ * ReassemblyJournal attached to reassembler(), requestMissingChunks() sends a
+ * ChunkRequest for every restored message, and a sender configured with
+ * tx.retainedMessages answers it by sending only the chunks listed.
+ *
+ * When the transport carries frames shorter than MAX_TX_PACKET_SIZE (an
+ * E220 sub-packet, see UartTransport), chunks are sized to fit and sent as
+ * compact frames.
+ *
+ * **Threading:** send() may be called from any task; poll() and the
+ * callbacks, which it invokes, run on a single task.
+ *
+ * @code
+ * LoopbackTransport a(1), b(2);
+ * LoopbackTransport::connect(a, b);
+ * LinkEndpoint alice(a), bob(b);
+ * bob.onMessage([](uint32_t source, uint16_t id, std::vector<uint8_t> &&message) { ... });
+ * alice.send(std::vector<uint8_t>(1000, 0x42));
+ * for (uint32_t now = 0; !alice.idle(); now++) { alice.poll(now); bob.poll(now); }
+ * @endcode
+ */
+class LinkEndpoint
+{
+ public:
+  /**
+   * @brief Called for every completed message.
+   */
+  using MessageCallback = std::function<void(uint32_t sourceId, uint16_t messageId, std::vector<uint8_t> &&message)>;
+
+  /**
+   * @brief Called for every valid control frame.
+   */
+  using ControlCallback = std::function<void(const Packet &packet, const FrameMeta &meta)>;
+
+  /**
+   * @brief Endpoint counters.
+   */
+  struct Stats
+  {
+    uint64_t framesReceived = 0;    ///< Frames delivered by the transport.
+    uint64_t framesRejected = 0;    ///< Frames failing parse / validation.
+    uint64_t controlFrames = 0;     ///< Valid frames with PACKET_FLAG_CONTROL.
+    uint64_t messagesReceived = 0;  ///< Messages completed by the reassembler.
+    uint64_t sessionsPruned = 0;    ///< Stalled reassembly sessions dropped.
+    uint64_t chunkRequests = 0;     ///< ChunkRequests received.
+    uint64_t chunkResends = 0;      ///< ChunkRequests answered with a partial resend.
+    TxEngine::Stats tx;
+  };
+
+  /**
+   * @param transport Link used in both directions. Must outlive the endpoint.
+   */
+  explicit LinkEndpoint(ITransport &transport, const LinkEndpointConfig &config = LinkEndpointConfig());
+  ~LinkEndpoint();
+
+  LinkEndpoint(const LinkEndpoint &) = delete;
+  LinkEndpoint &operator=(const LinkEndpoint &) = delete;
+
+  /**
+   * @brief Queues a message. Non-blocking, any task.
+   * @return The message ID assigned to the message, or std::nullopt if the
+   * TxEngine refused it (queue full, empty or too large).
+   */
+  std::optional<uint16_t> send(std::vector<uint8_t> &&message, const TxOptions &options = TxOptions());
+
+  /**
+   * @brief Copying overload of send().
+   */
+  std::optional<uint16_t> send(const uint8_t *data, size_t length, const TxOptions &options = TxOptions());
+
+  void onMessage(MessageCallback callback) { onMessage_ = std::move(callback); }
+  void onControl(ControlCallback callback) { onControl_ = std::move(callback); }
+
+  /**
+   * @brief Services the transport, the TxEngine and the reassembler. Single task.
+   */
+  void poll(uint32_t currentTimestampMs);
+
+  /**
+   * @brief Asks the senders for the missing chunks of every message being reassembled.
+   *
+   * Typically called once after PacketReassembler::attachJournal() restored
+   * the messages interrupted by a restart. A message whose bitmap does not
+   * fit one transport frame is asked for in several requests, each covering
+   * a range of its chunks. poll() task only.
+   *
+   * @return Number of ChunkRequests queued.
+   */
+  size_t requestMissingChunks();
+
+  /**
+   * @brief True when nothing is queued or on air.
+   */
+  bool idle() const { return engine_.idle(); }
+
+  TxEngine &engine() { return engine_; }
+  PacketReassembler &reassembler() { return reassembler_; }
+
+  Stats stats() const;
+
+ private:
+  ITransport &transport_;
+  TxEngine engine_;
+  PacketReassembler reassembler_;
+  MessageCallback onMessage_;
+  ControlCallback onControl_;
+  Stats stats_;
+
+  uint16_t maxChunkPayloadSize_;  ///< Largest chunk fitting the transport's frames.
+  uint32_t pruneIntervalMs_;
+  std::optional<uint32_t> lastPruneMs_;
+  std::atomic<uint16_t> nextMessageId_{1};
+
+  uint16_t allocateMessageId();
+  void onFrame(const uint8_t *frame, size_t length, const FrameMeta &meta);
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @struct LoRaModulation
+ * @brief LoRa modem settings that determine time on air.
+ *
+ * Defaults match RadioLib's SX126x begin() defaults (SF9, 125 kHz, 4/7,
+ * 8 preamble symbols, explicit header, CRC on).
+ */
+struct LoRaModulation
+{
+  uint8_t spreadingFactor = 9;      ///< 5..12.
+  uint32_t bandwidthHz = 125000;
+  uint8_t codingRate = 7;           ///< Denominator of the 4/x coding rate, 5..8 (as in RadioLib).
+  uint16_t preambleLength = 8;      ///< Programmed preamble symbols.
+  bool explicitHeader = true;
+  bool crcEnabled = true;
+
+  /**
+   * @brief Low data rate optimization. std::nullopt: automatic, enabled when
+   * the symbol time reaches 16 ms (as RadioLib does).
+   */
+  std::optional<bool> lowDataRateOptimize;
+};
+
+/**
+ * @class LoRaAirtime
+ * @brief Static utility class computing LoRa time on air.
+ *
+ * Implements the SX126x datasheet formula (section 6.1.4), including the
+ * SF5/SF6 preamble and header variants, in integer arithmetic.
+ */
+class LoRaAirtime
+{
+ public:
+  /**
+   * @brief Duration of one symbol in microseconds.
+   */
+  static uint32_t symbolTimeUs(const LoRaModulation &modulation);
+
+  /**
+   * @brief Number of symbols of a frame, in quarter symbols (the preamble adds .25).
+   */
+  static uint32_t frameQuarterSymbols(const LoRaModulation &modulation, size_t payloadBytes);
+
+  /**
+   * @brief Time on air of a frame carrying 'payloadBytes' bytes, in microseconds (rounded up).
+   */
+  static uint32_t timeOnAirUs(const LoRaModulation &modulation, size_t payloadBytes);
+
+  /**
+   * @brief True if low data rate optimization is in effect for these settings.
+   */
+  static bool lowDataRateOptimize(const LoRaModulation &modulation);
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "ChannelSimulator.hpp"
+#include "ITransport.hpp"
+
+/**
+ * @class LoopbackTransport
+ * @brief In-process ITransport: frames go straight to a connected peer.
+ *
+ * Each transport receives through its own ChannelSimulator, so the inbound
+ * direction can be given loss, corruption, duplication, reordering and
+ * latency. A transmission completes at the sender's next poll(), or, with
+ * setSimulateAirtime(), once the frame's LoRa time on air (current
+ * modulation()) has elapsed on the poll clock, the frame reaching the peer
+ * at that moment. Received frames are delivered by the receiver's poll()
+ * once their latency has elapsed, stamped with the sender's address as
+ * FrameMeta::sourceId.
+ *
+ * The two ends may be polled from different threads (the inbound queue is
+ * locked); each end must be polled from a single thread.
+ */
+class LoopbackTransport : public ITransport
+{
+ public:
+  /**
+   * @param address Identity of this end, seen by the peer as FrameMeta::sourceId.
+   * @param inbound Impairments of the frames this end receives.
+   */
+  explicit LoopbackTransport(uint32_t address, const ChannelModel &inbound = ChannelModel());
+
+  LoopbackTransport(const LoopbackTransport &) = delete;
+  LoopbackTransport &operator=(const LoopbackTransport &) = delete;
+
+  /**
+   * @brief Connects two ends to each other. Both must outlive the link.
+   */
+  static void connect(LoopbackTransport &a, LoopbackTransport &b);
+
+  bool startTransmit(const uint8_t *frame, size_t length) override;
+  bool setModulation(const LoRaModulation &modulation) override;
+  void poll(uint32_t currentTimestampMs) override;
+
+  uint32_t address() const { return address_; }
+
+  /**
+   * @brief Makes each transmission last its time on air (LoRaAirtime, rounded up to whole ms).
+   */
+  void setSimulateAirtime(bool enabled) { simulateAirtime_ = enabled; }
+
+  /**
+   * @brief Modem settings last applied with setModulation() (used by the channel's SNR model).
+   */
+  const LoRaModulation &modulation() const { return modulation_; }
+
+  /**
+   * @brief Frames handed to startTransmit() and accepted.
+   */
+  uint64_t framesSent() const { return framesSent_; }
+
+ private:
+  uint32_t address_;
+  LoopbackTransport *peer_ = nullptr;
+  LoRaModulation modulation_;
+  bool modulationSet_ = false;
+  bool simulateAirtime_ = false;
+
+  std::mutex mutex_;  ///< Guards inbound_, written by the peer's startTransmit().
+  ChannelSimulator inbound_;
+
+  // Owner thread state.
+  bool transmitting_ = false;
+  uint32_t transmitEndMs_ = 0;
+  uint32_t now_ = 0;
+  uint64_t framesSent_ = 0;
+  std::vector<SimulatedFrame> received_;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "MpscQueue.hpp"
+
+class MessageBufferPool;
+
+/**
+ * @class MessageLease
+ * @brief Move-only handle to one buffer of a MessageBufferPool.
+ *
+ * The buffer goes back to its pool when the lease is destroyed or
+ * release() is called, from any thread. The pool must outlive its leases.
+ */
+class MessageLease
+{
+ public:
+  MessageLease() = default;
+  ~MessageLease() { release(); }
+
+  MessageLease(MessageLease &&other) noexcept { *this = std::move(other); }
+  MessageLease &operator=(MessageLease &&other) noexcept;
+
+  MessageLease(const MessageLease &) = delete;
+  MessageLease &operator=(const MessageLease &) = delete;
+
+  uint8_t *data() { return data_; }
+  const uint8_t *data() const { return data_; }
+
+  /**
+   * @brief Bytes of the buffer holding the message.
+   */
+  size_t size() const { return size_; }
+
+  /**
+   * @brief Sets the message length (clamped to capacity()).
+   */
+  void resize(size_t size) { size_ = size < capacity_ ? size : capacity_; }
+
+  size_t capacity() const { return capacity_; }
+
+  /**
+   * @brief True when the lease holds a buffer.
+   */
+  explicit operator bool() const { return data_ != nullptr; }
+
+  /**
+   * @brief Returns the buffer to the pool early. The lease becomes empty.
+   */
+  void release();
+
+ private:
+  friend class MessageBufferPool;
+
+  MessageLease(MessageBufferPool *pool, uint32_t index, uint8_t *data, size_t capacity)
+      : pool_(pool), index_(index), data_(data), capacity_(capacity)
+  {
+  }
+
+  MessageBufferPool *pool_ = nullptr;
+  uint32_t index_ = 0;
+  uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+};
+
+/**
+ * @class MessageBufferPool
+ * @brief Fixed set of equally sized message buffers handed out as leases.
+ *
+ * All buffers are allocated once at construction. The free list is an
+ * MpscQueue: acquire() must be called from a single thread (the receive
+ * path), while leases may be released from any number of application
+ * threads, without locks or allocation on either side.
+ */
+class MessageBufferPool
+{
+ public:
+  /**
+   * @param bufferCount Number of buffers.
+   * @param bufferCapacity Bytes per buffer (the largest message the pool can hold).
+   */
+  MessageBufferPool(size_t bufferCount, size_t bufferCapacity);
+
+  MessageBufferPool(const MessageBufferPool &) = delete;
+  MessageBufferPool &operator=(const MessageBufferPool &) = delete;
+
+  /**
+   * @brief Takes a free buffer. Single consumer only.
+   * @return An empty lease when every buffer is in use.
+   */
+  MessageLease acquire();
+
+  /**
+   * @brief Buffers currently free.
+   */
+  size_t available() const { return available_.load(std::memory_order_relaxed); }
+
+  size_t bufferCount() const { return bufferCount_; }
+  size_t bufferCapacity() const { return bufferCapacity_; }
+
+ private:
+  friend class MessageLease;
+
+  size_t bufferCount_;
+  size_t bufferCapacity_;
+  std::unique_ptr<uint8_t[]> storage_;
+  MpscQueue<uint32_t> free_;
+  std::atomic<size_t> available_;
+
+  void release(uint32_t index);
+};
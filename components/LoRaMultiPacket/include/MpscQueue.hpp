@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @class MpscQueue
+ * @brief Bounded lock-free multi-producer / single-consumer ring queue.
+ *
+ * Based on Dmitry Vyukov's bounded MPMC queue: every slot carries a sequence
+ * number that tells producers and the consumer whether the slot is free or
+ * holds data for the current lap, so no locks are taken on either side.
+ * Producers claim slots with a CAS on the tail; the single consumer owns the
+ * head and never contends.
+ *
+ * Slots are preallocated once; push() never allocates and fails (returns
+ * false) when the queue is full so that callers can apply backpressure.
+ *
+ * @tparam T Element type. Must be default constructible and move assignable.
+ */
+template <typename T>
+class MpscQueue
+{
+ public:
+  /**
+   * @param capacity Number of slots, rounded up to the next power of two.
+   */
+  explicit MpscQueue(size_t capacity)
+      : mask_(roundUpPowerOfTwo(capacity) - 1),
+        slots_(new Slot[mask_ + 1])
+  {
+    for (size_t i = 0; i <= mask_; i++)
+    {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    tail_.store(0, std::memory_order_relaxed);
+    head_ = 0;
+  }
+
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+
+  /**
+   * @brief Enqueues an element. Safe to call from any number of threads.
+   * @return false if the queue is full.
+   */
+  template <typename U>
+  bool push(U &&value)
+  {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      Slot &slot = slots_[pos & mask_];
+      size_t seq = slot.sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0)
+      {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          slot.value = std::forward<U>(value);
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+      {
+        return false;  // Full: the consumer has not released this slot yet.
+      }
+      else
+      {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Dequeues an element. Must only be called from the consumer thread.
+   * @return false if the queue is empty.
+   */
+  bool pop(T &out)
+  {
+    Slot &slot = slots_[head_ & mask_];
+    size_t seq = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(head_ + 1) < 0)
+    {
+      return false;
+    }
+    out = std::move(slot.value);
+    slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    head_++;
+    return true;
+  }
+
+  /**
+   * @brief Number of slots in the ring.
+   */
+  size_t capacity() const { return mask_ + 1; }
+
+ private:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static size_t roundUpPowerOfTwo(size_t n)
+  {
+    size_t p = 1;
+    while (p < n)
+      p <<= 1;
+    return p;
+  }
+
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Producers and consumer indices live on separate cache lines.
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+  alignas(CACHE_LINE_SIZE) size_t head_;
+};
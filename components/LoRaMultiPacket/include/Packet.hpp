@@ -1,28 +1,11 @@
 #pragma once
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 
-/**
- * @brief Maximum raw packet size assumed for transmit buffers (including header and CRC).
- * Many LoRa modules have a FIFO limit (e.g., 256 bytes for SX127x).
- */
-constexpr size_t MAX_PACKET_SIZE = 255;
-
-/**
- * @brief Reserved bytes for future use or driver overhead.
- */
-constexpr size_t RESERVED_BYTES = 0;
-
-/**
- * @brief Size of the Cyclic Redundancy Check (CRC) suffix in bytes.
- */
-constexpr size_t CRC_SIZE = sizeof(uint16_t);
-
-/**
- * @brief The maximum size available for the packet logic after reservations.
- */
-constexpr size_t MAX_TX_PACKET_SIZE = MAX_PACKET_SIZE - RESERVED_BYTES;
+#include "Crc16.hpp"
+#include "Crc32.hpp"
 
 /**
  * @name Packet Flags
@@ -32,6 +15,20 @@ constexpr size_t MAX_TX_PACKET_SIZE = MAX_PACKET_SIZE - RESERVED_BYTES;
 constexpr uint8_t PACKET_FLAG_SOM = 0x01;      ///< Start of Message: This packet is the first chunk.
 constexpr uint8_t PACKET_FLAG_EOM = 0x02;      ///< End of Message: This packet is the last chunk.
 constexpr uint8_t PACKET_FLAG_ACK_REQ = 0x04;  ///< Acknowledgement Requested (optional feature).
+constexpr uint8_t PACKET_FLAG_CONTROL = 0x08;  ///< Link management frame (e.g. LinkAnnouncement), not application data.
+
+/**
+ * @brief Upper nibble of the flags: number of relays the frame went through (see FrameRelay).
+ * 0 for frames heard from their sender; ignored by the validator.
+ */
+constexpr uint8_t PACKET_HOPS_MASK = 0xF0;
+constexpr uint8_t PACKET_HOPS_SHIFT = 4;
+constexpr uint8_t PACKET_MAX_HOPS = PACKET_HOPS_MASK >> PACKET_HOPS_SHIFT;
+
+/**
+ * @brief Hop count stored in a flags byte.
+ */
+constexpr uint8_t packetHops(uint8_t flags) { return static_cast<uint8_t>(flags >> PACKET_HOPS_SHIFT); }
 /** @} */
 
 #pragma pack(push, 1)  // Ensure no compiler padding is inserted between fields
@@ -77,16 +74,124 @@ struct PacketHeader
   uint8_t protocolVersion = 1;
 };
 
+/**
+ * @brief Header layout for profiles whose frames carry more than 255 payload bytes
+ * or whose messages need more than 255 chunks. Same fields, 16-bit counters.
+ * Total size: 10 bytes.
+ */
+struct WidePacketHeader
+{
+  uint16_t messageId = 1;       ///< See PacketHeader::messageId.
+  uint16_t totalChunks = 0;     ///< See PacketHeader::totalChunks.
+  uint16_t chunkIndex = 0;      ///< See PacketHeader::chunkIndex.
+  uint16_t payloadSize = 0;     ///< See PacketHeader::payloadSize.
+  uint8_t flags = 0;            ///< See PacketHeader::flags.
+  uint8_t protocolVersion = 1;  ///< See PacketHeader::protocolVersion.
+};
+
+#pragma pack(pop)
+
+/**
+ * @struct ProtocolProfile
+ * @brief Compile-time description of the frame geometry used on one radio.
+ *
+ * Every size used by BasicPacket, BasicPacketSerializer, BasicPacketParser,
+ * BasicPacketValidator and BasicPacketReassembler is derived from the
+ * profile, so each radio gets exactly sized buffers and chunking with no
+ * runtime cost, and several profiles can coexist in the same binary.
+ *
+ * @tparam FrameSize     Largest frame the radio accepts (e.g. 255 for the SX127x/SX126x FIFO).
+ * @tparam HeaderT       Header layout (PacketHeader or WidePacketHeader).
+ * @tparam ChecksumT     CRC implementation (Crc16 or Crc32).
+ * @tparam ReservedBytes Bytes of the frame kept free for the driver.
+ */
+template <size_t FrameSize, typename HeaderT = PacketHeader, typename ChecksumT = Crc16, size_t ReservedBytes = 0>
+struct ProtocolProfile
+{
+  using Header = HeaderT;
+  using Checksum = ChecksumT;
+  using Crc = typename ChecksumT::value_type;
+
+  static constexpr size_t FRAME_SIZE = FrameSize;
+  static constexpr size_t RESERVED_BYTES = ReservedBytes;
+  static constexpr size_t HEADER_SIZE = sizeof(HeaderT);
+  static constexpr size_t CRC_SIZE = sizeof(Crc);
+
+  /**
+   * @brief Bytes of the frame available to the packet (header + payload + CRC).
+   */
+  static constexpr size_t PACKET_SIZE = FrameSize - ReservedBytes;
+
+  /**
+   * @brief Payload bytes per chunk.
+   */
+  static constexpr size_t MAX_PAYLOAD_SIZE = PACKET_SIZE - HEADER_SIZE - CRC_SIZE;
+
+  /**
+   * @brief Largest number of chunks the header can describe.
+   */
+  static constexpr size_t MAX_CHUNKS = static_cast<decltype(HeaderT::totalChunks)>(~0u);
+
+  static_assert(FrameSize > ReservedBytes + sizeof(HeaderT) + sizeof(Crc),
+                "Frame too small for header and CRC");
+  static_assert(MAX_PAYLOAD_SIZE <= static_cast<decltype(HeaderT::payloadSize)>(~0u),
+                "Payload size does not fit the header's payloadSize field, use WidePacketHeader");
+};
+
+/**
+ * @brief Profile of the original protocol: 255-byte frames (SX127x / SX126x FIFO), Modbus CRC-16.
+ */
+using DefaultProfile = ProtocolProfile<255>;
+
+/**
+ * @brief EByte E220 modules split transmissions into sub-packets of 32, 64, 128 or 200 bytes;
+ * sizing frames to the configured sub-packet avoids an extra over-the-air sub-packet per chunk.
+ */
+template <size_t SubPacketSize>
+using E220Profile = ProtocolProfile<SubPacketSize>;
+
+/**
+ * @brief Large frames (radios / links beyond the 255-byte FIFO) with 16-bit counters and CRC-32.
+ */
+template <size_t FrameSize>
+using WideFrameProfile = ProtocolProfile<FrameSize, WidePacketHeader, Crc32>;
+
+/**
+ * @brief Maximum raw packet size assumed for transmit buffers (including header and CRC).
+ * Many LoRa modules have a FIFO limit (e.g., 256 bytes for SX127x).
+ */
+constexpr size_t MAX_PACKET_SIZE = DefaultProfile::FRAME_SIZE;
+
+/**
+ * @brief Reserved bytes for future use or driver overhead.
+ */
+constexpr size_t RESERVED_BYTES = DefaultProfile::RESERVED_BYTES;
+
+/**
+ * @brief Size of the Cyclic Redundancy Check (CRC) suffix in bytes.
+ */
+constexpr size_t CRC_SIZE = DefaultProfile::CRC_SIZE;
+
+/**
+ * @brief The maximum size available for the packet logic after reservations.
+ */
+constexpr size_t MAX_TX_PACKET_SIZE = DefaultProfile::PACKET_SIZE;
+
 /**
  * @brief Size of the packet header in bytes.
  */
-constexpr size_t HEADER_SIZE = sizeof(PacketHeader);
+constexpr size_t HEADER_SIZE = DefaultProfile::HEADER_SIZE;
 
 /**
  * @brief Maximum bytes available for actual data payload per packet.
  * Calculated as: Total Available - Header - CRC.
  */
-constexpr size_t LORA_MAX_PAYLOAD_SIZE = MAX_TX_PACKET_SIZE - HEADER_SIZE - CRC_SIZE;
+constexpr size_t LORA_MAX_PAYLOAD_SIZE = DefaultProfile::MAX_PAYLOAD_SIZE;
+
+/**
+ * @brief A subset of the chunks of a default-profile message: bit i is chunk i.
+ */
+using ChunkSet = std::bitset<DefaultProfile::MAX_CHUNKS + 1>;
 
 /**
  * @brief Padding byte value used to fill unused space in the final packet's payload.
@@ -95,26 +200,43 @@ constexpr size_t LORA_MAX_PAYLOAD_SIZE = MAX_TX_PACKET_SIZE - HEADER_SIZE - CRC_
  */
 constexpr uint8_t PAYLOAD_PADDING_BYTE = 0xFF;
 
+/**
+ * @brief Logs the fields of a packet (shared by every BasicPacket::printPacket()).
+ */
+void printPacketFields(uint32_t messageId, uint32_t flags, uint32_t totalChunks, uint32_t chunkIndex,
+                       uint32_t payloadSize, uint32_t protocolVersion, const uint8_t *payload,
+                       size_t payloadCapacity, uint32_t crc, size_t crcSize);
+
+#pragma pack(push, 1)
+
 /**
  * @brief Fixed-size container for payload data.
  */
-struct PacketPayload
+template <size_t Size>
+struct BasicPacketPayload
 {
-  uint8_t data[LORA_MAX_PAYLOAD_SIZE];
+  uint8_t data[Size];
 };
 
 /**
  * @brief The complete Over-The-Air (OTA) packet structure.
  * This structure maps directly to the byte array sent to the LoRa modem.
+ *
+ * @tparam Profile Frame geometry (see ProtocolProfile).
  */
-struct Packet
+template <typename Profile>
+struct BasicPacket
 {
-  PacketHeader header;    ///< Metadata for transport.
-  PacketPayload payload;  ///< Application data segment.
-  uint16_t crc;           ///< Error detection checksum.
+  using Header = typename Profile::Header;
+  using Payload = BasicPacketPayload<Profile::MAX_PAYLOAD_SIZE>;
+  using Crc = typename Profile::Crc;
+
+  Header header;    ///< Metadata for transport.
+  Payload payload;  ///< Application data segment.
+  Crc crc;          ///< Error detection checksum.
 
   /**
-   * @brief Calculates the CRC-16 of the packet and updates the 'crc' field.
+   * @brief Calculates the CRC of the packet and updates the 'crc' field.
    *
    * **CRC Scope:** Covers the full header + only valid payload bytes (respects payloadSize).
    * Padding bytes in the payload buffer are explicitly excluded from CRC calculation.
@@ -123,7 +245,7 @@ struct Packet
    * strategy. A bit flip in unused padding does not cause a false CRC failure. The CRC protects
    * the semantic message content, not transport artifacts used to fit hardware constraints.
    *
-   * Algorithm: Modbus CRC-16 (polynomial 0xA001, initial value 0xFFFF).
+   * Algorithm: Profile::Checksum (default: Modbus CRC-16, polynomial 0xA001, initial value 0xFFFF).
    *
    * Formula: CRC(header || payload[0..payloadSize-1])
    */
@@ -131,8 +253,42 @@ struct Packet
 
   /**
    * @brief Prints a human-readable summary of the packet to the log output.
-   * Useful for debugging transmission logic.
+   * Useful for debugging transmission logic. Logs synchronously; on the
+   * real-time RX/TX path use PacketLog::record() and format later instead.
    */
   void printPacket();
 };
-#pragma pack(pop)
\ No newline at end of file
+
+#pragma pack(pop)
+
+template <typename Profile>
+void BasicPacket<Profile>::calculateCRC()
+{
+  using Checksum = typename Profile::Checksum;
+
+  // CRC covers: full header + only valid payload bytes (exclude padding)
+  // This decouples integrity checking from physical layout and padding strategy
+  const uint8_t *headerPtr = reinterpret_cast<const uint8_t *>(&this->header);
+  Crc value = Checksum::update(Checksum::INITIAL_VALUE, headerPtr, Profile::HEADER_SIZE);
+  value = Checksum::update(value, this->payload.data, this->header.payloadSize);
+
+  this->crc = Checksum::finalize(value);
+}
+
+template <typename Profile>
+void BasicPacket<Profile>::printPacket()
+{
+  printPacketFields(this->header.messageId, this->header.flags, this->header.totalChunks, this->header.chunkIndex,
+                    this->header.payloadSize, this->header.protocolVersion, this->payload.data,
+                    Profile::MAX_PAYLOAD_SIZE, this->crc, Profile::CRC_SIZE);
+}
+
+/**
+ * @brief Packet and payload of the default profile.
+ */
+using PacketPayload = BasicPacketPayload<LORA_MAX_PAYLOAD_SIZE>;
+using Packet = BasicPacket<DefaultProfile>;
+
+static_assert(sizeof(Packet) == MAX_TX_PACKET_SIZE, "Packet must map 1:1 onto the frame");
+
+extern template struct BasicPacket<DefaultProfile>;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
@@ -8,7 +9,7 @@
 #include "PacketValidator.hpp"
 
 /**
- * @class PacketDeserializer
+ * @class BasicPacketDeserializer
  * @brief Extracts payload data from validated Packet structures.
  *
  * Converts Packet structures into their payload data, respecting the logical
@@ -20,8 +21,11 @@
  *   2. Extract only the valid payload bytes (up to header.payloadSize)
  *   3. Return vector containing the actual payload data
  *   4. Padding bytes are automatically excluded
+ *
+ * @tparam Profile Frame geometry (see ProtocolProfile). PacketDeserializer uses DefaultProfile.
  */
-class PacketDeserializer
+template <typename Profile>
+class BasicPacketDeserializer
 {
  public:
   /**
@@ -35,5 +39,35 @@ class PacketDeserializer
    * @param packet The validated packet to extract from
    * @return Vector containing the extracted payload bytes (payloadSize bytes)
    */
-  static std::vector<uint8_t> deserialize(const Packet &packet);
-};
\ No newline at end of file
+  static std::vector<uint8_t> deserialize(const BasicPacket<Profile> &packet);
+
+  /**
+   * @brief Same as deserialize(), with the payload vector allocated from 'resource'.
+   */
+  static std::pmr::vector<uint8_t> deserialize(const BasicPacket<Profile> &packet, std::pmr::memory_resource &resource);
+};
+
+template <typename Profile>
+std::vector<uint8_t> BasicPacketDeserializer<Profile>::deserialize(const BasicPacket<Profile> &packet)
+{
+  std::vector<uint8_t> payload;
+
+  // Extract only valid payload bytes (up to payloadSize), excluding padding
+  const uint8_t *payloadStart = packet.payload.data;
+  payload.insert(payload.end(), payloadStart,
+                 payloadStart + packet.header.payloadSize);
+
+  return payload;
+}
+
+template <typename Profile>
+std::pmr::vector<uint8_t> BasicPacketDeserializer<Profile>::deserialize(const BasicPacket<Profile> &packet,
+                                                                       std::pmr::memory_resource &resource)
+{
+  const uint8_t *payloadStart = packet.payload.data;
+  return std::pmr::vector<uint8_t>(payloadStart, payloadStart + packet.header.payloadSize, &resource);
+}
+
+using PacketDeserializer = BasicPacketDeserializer<DefaultProfile>;
+
+extern template class BasicPacketDeserializer<DefaultProfile>;
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "MpscQueue.hpp"
+#include "Packet.hpp"
+
+/**
+ * @brief Payload bytes kept by each PacketLogRecord (the rest is truncated).
+ */
+constexpr size_t PACKET_LOG_PAYLOAD_BYTES = 16;
+
+/**
+ * @brief Where in the pipeline a packet was logged.
+ */
+enum class PacketLogEvent : uint8_t
+{
+  Tx = 0,           ///< Packet handed to the radio.
+  Rx = 1,           ///< Frame received and parsed.
+  RxRejected = 2,   ///< Frame received but rejected (CRC, header or length).
+  Retransmit = 3,   ///< Chunk sent again.
+};
+
+#pragma pack(push, 1)
+
+/**
+ * @brief Fixed-size binary log entry. Total size: 32 bytes.
+ *
+ * Holds everything printPacket() shows except the payload tail, so the hot
+ * path only copies a few words and the formatting happens later, off the
+ * real-time path (PacketLog::format()) or on a host (tools/packet_log_decode).
+ */
+struct PacketLogRecord
+{
+  uint32_t timestampMs;                        ///< Caller-supplied time.
+  PacketLogEvent event;                        ///< See PacketLogEvent.
+  uint8_t sequence;                            ///< Wrapping record counter in ring order; gaps reveal dropped records.
+  uint8_t payloadBytes;                        ///< Valid bytes in 'payload' (<= PACKET_LOG_PAYLOAD_BYTES).
+  PacketHeader header;                         ///< Header as seen on the wire.
+  uint16_t crc;                                ///< Stored CRC.
+  uint8_t payload[PACKET_LOG_PAYLOAD_BYTES];   ///< First payload bytes.
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(PacketLogRecord) == 32, "PacketLogRecord is part of the host decoder format");
+
+/**
+ * @class PacketLog
+ * @brief Deferred packet logging through a bounded lock-free ring.
+ *
+ * record() is meant for the TX/RX hot path: it fills a PacketLogRecord and
+ * pushes it into an MpscQueue, without formatting, allocating or locking.
+ * When the ring is full the record is dropped and counted instead of
+ * blocking the caller.
+ *
+ * A single consumer (a low-priority task, or the main loop when idle) calls
+ * drain() and either formats the records with format() or forwards the raw
+ * 32-byte records to a UART / file for decoding on a host. drain() numbers
+ * the records in the order they sit in the ring, skipping one number per
+ * dropped record, so concurrent producers never make sequence numbers go
+ * backwards.
+ */
+class PacketLog
+{
+ public:
+  /**
+   * @brief Receives drained records, in push order per producer.
+   */
+  using Sink = std::function<void(const PacketLogRecord &record)>;
+
+  /**
+   * @param capacity Ring slots, rounded up to the next power of two.
+   */
+  explicit PacketLog(size_t capacity = 64);
+
+  /**
+   * @brief Logs a packet. Safe to call from any number of producer threads.
+   * @return false if the ring was full and the record was dropped.
+   */
+  bool record(const Packet &packet, uint32_t timestampMs, PacketLogEvent event);
+
+  /**
+   * @brief Logs a raw serialized frame without parsing it (e.g. a frame that failed validation).
+   * Missing header / CRC bytes of a short frame are logged as zero.
+   */
+  bool record(const uint8_t *frame, size_t length, uint32_t timestampMs, PacketLogEvent event);
+
+  /**
+   * @brief Pops up to 'maxRecords' records into the sink. Single consumer only.
+   * @return Number of records drained.
+   */
+  size_t drain(const Sink &sink, size_t maxRecords = SIZE_MAX);
+
+  /**
+   * @brief Records dropped because the ring was full.
+   */
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  size_t capacity() const { return queue_.capacity(); }
+
+  /**
+   * @brief Formats a record as one text line (NUL terminated, truncated to 'size').
+   * Format: "<ts> ms #<seq> <EVENT> id=<id> chunk=<idx+1>/<total> len=<n> flags=0x<ff> v<ver> crc=0x<crc> | <hex>"
+   * @return Characters written, excluding the terminator.
+   */
+  static size_t format(const PacketLogRecord &record, char *buffer, size_t size);
+
+  /**
+   * @brief Writes 'length' bytes as space separated upper-case hex ("0A FF ...").
+   * Uses a nibble table instead of one printf per byte.
+   * @return Characters written, excluding the terminator (buffer is always terminated when size > 0).
+   */
+  static size_t formatHex(const uint8_t *data, size_t length, char *buffer, size_t size);
+
+  /**
+   * @brief Short name of an event ("TX", "RX", ...).
+   */
+  static const char *eventName(PacketLogEvent event);
+
+ private:
+  MpscQueue<PacketLogRecord> queue_;
+  std::atomic<uint32_t> dropped_{0};
+  std::atomic<uint32_t> pendingDrops_{0};  ///< Drops not yet carried by a queued record.
+  uint8_t sequence_ = 0;                   ///< Next sequence number, consumer only.
+
+  bool push(PacketLogRecord &record);
+};
@@ -1,27 +1,35 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <optional>
 
+#include "FrameArena.hpp"
 #include "Packet.hpp"
 #include "PacketValidator.hpp"
 
 /**
- * @class PacketParser
+ * @class BasicPacketParser
  * @brief Parses raw packet buffers into validated Packet structures.
  *
  * Converts raw byte buffers from the LoRa radio into Packet structures
  * with validation. This is the first step in the reception pipeline.
  *
  * **Workflow:**
- *   1. Check buffer size (minimum: HEADER_SIZE + PAYLOAD_SIZE + CRC_SIZE)
- *   2. Parse buffer into Packet structure (memcpy)
- *   3. Call PacketValidator::validate() to verify integrity
+ *   1. Check buffer size: a full frame (HEADER_SIZE + PAYLOAD_SIZE + CRC_SIZE) or a
+ *      compact one (HEADER_SIZE + payloadSize + CRC_SIZE, see serializeCompact())
+ *   2. Parse buffer into Packet structure (memcpy; compact frames are padded)
+ *   3. Call BasicPacketValidator::validate() to verify integrity
  *   4. Return validated Packet on success, nullopt on failure
+ *
+ * @tparam Profile Frame geometry (see ProtocolProfile).
  */
-class PacketParser
+template <typename Profile>
+class BasicPacketParser
 {
  public:
+  using PacketType = BasicPacket<Profile>;
+
   /**
    * @brief Parses and validates a raw packet buffer.
    *
@@ -38,9 +46,73 @@ class PacketParser
    * @param length Length of the buffer in bytes
    * @return Validated Packet if all checks pass, std::nullopt on failure
    */
-  static std::optional<Packet> parse(const uint8_t *buffer, size_t length);
+  static std::optional<PacketType> parse(const uint8_t *buffer, size_t length);
 
- private:
+ protected:
   static constexpr size_t MIN_PACKET_SIZE =
-      HEADER_SIZE + sizeof(PacketPayload) + CRC_SIZE;
+      Profile::HEADER_SIZE + Profile::MAX_PAYLOAD_SIZE + Profile::CRC_SIZE;
+};
+
+template <typename Profile>
+std::optional<typename BasicPacketParser<Profile>::PacketType> BasicPacketParser<Profile>::parse(const uint8_t *buffer, size_t length)
+{
+  // Step 1: Validate buffer size
+  if (buffer == nullptr || length < Profile::HEADER_SIZE + Profile::CRC_SIZE)
+  {
+    return std::nullopt;
+  }
+
+  // Step 2: Parse buffer into Packet structure
+  PacketType packet;
+  if (length >= MIN_PACKET_SIZE)
+  {
+    std::memcpy(&packet, buffer, sizeof(PacketType));
+  }
+  else
+  {
+    // Compact frame: the CRC follows the valid payload bytes.
+    std::memcpy(&packet.header, buffer, Profile::HEADER_SIZE);
+    size_t payloadSize = packet.header.payloadSize;
+    if (length != Profile::HEADER_SIZE + payloadSize + Profile::CRC_SIZE)
+    {
+      return std::nullopt;
+    }
+    std::memcpy(packet.payload.data, buffer + Profile::HEADER_SIZE, payloadSize);
+    std::memset(packet.payload.data + payloadSize, PAYLOAD_PADDING_BYTE, Profile::MAX_PAYLOAD_SIZE - payloadSize);
+    std::memcpy(&packet.crc, buffer + Profile::HEADER_SIZE + payloadSize, Profile::CRC_SIZE);
+  }
+
+  // Step 3: Validate packet integrity via PacketValidator
+  auto validationError = BasicPacketValidator<Profile>::validate(packet);
+  if (validationError.has_value())
+  {
+    return std::nullopt;
+  }
+
+  // Step 4: Return validated packet
+  return packet;
+}
+
+extern template class BasicPacketParser<DefaultProfile>;
+
+/**
+ * @class PacketParser
+ * @brief Parser of the default profile, plus the batched receive path.
+ */
+class PacketParser : public BasicPacketParser<DefaultProfile>
+{
+ public:
+  /**
+   * @brief Parses and validates every frame of a received batch.
+   *
+   * Applies the same checks as parse() to each frame of the arena. Bit i of
+   * 'validMask' is set when packets[i] holds a validated packet; slots of
+   * rejected frames are left unspecified.
+   *
+   * @param frames Batch of raw frames (e.g. filled by a UDP or radio front-end)
+   * @param packets Output array with room for frames.size() packets
+   * @param validMask Output bitmask with batchMaskWords(frames.size()) words
+   * @return Number of valid packets in the batch
+   */
+  static size_t parseBatch(const FrameArena &frames, Packet *packets, uint64_t *validMask);
 };
@@ -1,11 +1,111 @@
+#pragma once
+
+#include <algorithm>
 #include <cstdint>
+#include <cstddef>
+#include <cstring>
 #include <map>
+#include <memory_resource>
 #include <optional>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include "MessageBufferPool.hpp"
 #include "Packet.hpp"
+#include "PacketDeserializer.hpp"
+#include "ReassemblyJournal.hpp"
+
+/**
+ * @struct ReassemblerConfig
+ * @brief Tuning knobs for a PacketReassembler instance.
+ *
+ * The adaptive timeout keeps, per session, an EWMA of the gap between
+ * received chunks (normalized per chunk index, so lost chunks do not inflate
+ * it) and its mean deviation, in the style of the TCP RTO estimator.
+ * A session is considered stalled once the silence since its last received
+ * chunk exceeds the time in which the missing chunks could still plausibly
+ * arrive:
+ *
+ *   allowedSilence = (gap + 4 * deviation) * (min(remainingChunks, maxLossBurst) + 1)
+ *
+ * clamped to [minTimeoutMs, maxTimeoutMs].
+ */
+struct ReassemblerConfig
+{
+  /**
+   * @brief Gap estimate assumed for a session before a second chunk has been seen.
+   */
+  uint32_t initialGapMs = 1000;
+
+  /**
+   * @brief Number of consecutive missing chunks tolerated before a session is declared stalled.
+   */
+  uint8_t maxLossBurst = 4;
+
+  /**
+   * @brief Lower bound for the allowed silence of a session.
+   */
+  uint32_t minTimeoutMs = 250;
+
+  /**
+   * @brief Upper bound for the allowed silence of a session.
+   */
+  uint32_t maxTimeoutMs = 60000;
+
+  /**
+   * @brief Maximum number of concurrent messages (sequences) allowed to prevent DoS/Memory exhaustion.
+   */
+  size_t maxConcurrentMessages = 10;
+
+  /**
+   * @brief Fewest chunks of a message journaled by an attached ReassemblyJournal.
+   *
+   * Shorter messages are cheaper to resend whole than to write to flash.
+   */
+  size_t journalMinChunks = 8;
+};
+
+/**
+ * @struct ReassemblerResources
+ * @brief Memory resources used by a PacketReassembler instance.
+ *
+ * Session metadata (small, touched on every packet) and message bodies
+ * (large, written once per chunk) come from separate resources. Bodies can
+ * be tiered by size: messages of at least largeMessageThreshold bytes go to
+ * largeChunks (typically a PsramResource), smaller and control messages stay
+ * in 'chunks' (internal RAM). The resources must outlive the reassembler
+ * and, like the reassembler itself, need not be thread safe.
+ */
+struct ReassemblerResources
+{
+  /**
+   * @brief Session table nodes and per-chunk state.
+   */
+  std::pmr::memory_resource *sessions = std::pmr::get_default_resource();
+
+  /**
+   * @brief Message bodies below largeMessageThreshold.
+   */
+  std::pmr::memory_resource *chunks = std::pmr::get_default_resource();
+
+  /**
+   * @brief Message bodies of at least largeMessageThreshold bytes (nullptr: use 'chunks').
+   */
+  std::pmr::memory_resource *largeChunks = nullptr;
+
+  /**
+   * @brief Body size, in bytes, from which largeChunks is used.
+   *
+   * The body of a message is reserved once its chunk size is known (its
+   * first non-final chunk), at totalChunks * chunk size bytes, so that is
+   * the size compared here.
+   */
+  size_t largeMessageThreshold = 4096;
+};
+
 /**
- * @class PacketReassembler
+ * @class BasicPacketReassembler
  * @brief Manages the reconstruction of split messages from individual Packet chunks.
  *
  * This class handles:
@@ -13,21 +113,84 @@
  * - Out-of-order packet insertion.
  * - Reassembly of complete messages.
  * - Timeout-based cleanup of incomplete stale messages.
+ *
+ * Messages may use any chunk size chosen by the sender (see
+ * BasicPacketSerializer): the first non-final chunk fixes it for the
+ * session, and chunks that disagree with it (a non-final chunk of another
+ * size, or a final chunk larger than it) are rejected.
+ *
+ * With a ReassemblyJournal attached, every received chunk is also written to
+ * persistent storage, so that the messages interrupted by a restart are
+ * restored by the next attachJournal() and only their missing chunks
+ * (pendingMessages(), see ChunkRequest) have to be sent again.
+ *
+ * @tparam Profile Frame geometry (see ProtocolProfile). PacketReassembler uses DefaultProfile.
  */
-class PacketReassembler
+template <typename Profile>
+class BasicPacketReassembler
 {
  public:
+  using PacketType = BasicPacket<Profile>;
+
+  BasicPacketReassembler() = default;
+
+  /**
+   * @brief Creates a reassembler with a custom configuration.
+   */
+  explicit BasicPacketReassembler(const ReassemblerConfig &config);
+
+  /**
+   * @brief Creates a reassembler that allocates from the given memory resources.
+   */
+  BasicPacketReassembler(const ReassemblerConfig &config, const ReassemblerResources &resources);
+
   /**
    * @brief Processes an incoming packet and attempts to reassemble the full message.
    *
    * If the packet completes a sequence, the full payload is returned.
    * If the sequence is still incomplete, std::nullopt is returned.
+   * Control frames (PACKET_FLAG_CONTROL, e.g. LinkAnnouncement) are link
+   * management, not messages: they are ignored.
+   *
+   * Sessions are keyed by (sourceId, messageId), so transmitters that reuse
+   * the same message IDs do not collide as long as the caller can tell them
+   * apart (e.g. gateway address or node ID). Single-link users can ignore it.
    *
    * @param packet The valid packet received from the network.
    * @param currentTimestampMs A distinct timestamp (e.g., millis) to track timeout.
+   * @param sourceId Identity of the transmitter the packet was received from.
    * @return std::optional<std::vector<uint8_t>> The complete reassembled payload if finished.
    */
-  std::optional<std::vector<uint8_t>> processPacket(const Packet &packet, uint32_t currentTimestampMs);
+  std::optional<std::vector<uint8_t>> processPacket(const PacketType &packet, uint32_t currentTimestampMs, uint32_t sourceId = 0);
+
+  /**
+   * @brief Same as processPacket(), but a completed message is written into a buffer leased from 'pool'.
+   *
+   * Steady-state delivery performs no heap allocation and the message is
+   * copied once, from the stored chunks into the application's buffer. If
+   * the pool is exhausted or the message exceeds its buffer capacity, the
+   * completed message is dropped and counted in undeliveredMessages().
+   *
+   * @return A lease holding the message (lease.size() bytes) if finished.
+   */
+  std::optional<MessageLease> processPacketInto(const PacketType &packet, uint32_t currentTimestampMs,
+                                                MessageBufferPool &pool, uint32_t sourceId = 0);
+
+  /**
+   * @brief Same as processPacket(), but a completed message is written into a caller-supplied buffer.
+   *
+   * If the message exceeds 'capacity' it is dropped and counted in undeliveredMessages().
+   *
+   * @return The message length if this packet completed a message.
+   */
+  std::optional<size_t> processPacketInto(const PacketType &packet, uint32_t currentTimestampMs,
+                                          uint8_t *output, size_t capacity, uint32_t sourceId = 0);
+
+  /**
+   * @brief Same as processPacket(), with the completed message allocated from 'resource'.
+   */
+  std::optional<std::pmr::vector<uint8_t>> processPacketInto(const PacketType &packet, uint32_t currentTimestampMs,
+                                                             std::pmr::memory_resource &resource, uint32_t sourceId = 0);
 
   /**
    * @brief Removes incomplete messages that have exceeded the timeout duration.
@@ -39,16 +202,129 @@ class PacketReassembler
    */
   void prune(uint32_t currentTimestampMs, uint32_t timeoutMs);
 
+  /**
+   * @brief Removes incomplete messages for which no further progress is plausible.
+   *
+   * Unlike prune(), the deadline is derived per session from its observed
+   * inter-chunk arrival times (see ReassemblerConfig), so dead short messages
+   * are freed quickly while slow but alive large transfers are kept.
+   *
+   * @param currentTimestampMs The current system time.
+   * @return Number of sessions removed.
+   */
+  size_t pruneStalled(uint32_t currentTimestampMs);
+
+  /**
+   * @brief Returns the number of messages currently being reassembled.
+   */
+  size_t pendingSessions() const { return sessions_.size(); }
+
+  /**
+   * @brief A message being reassembled and the chunks it still lacks.
+   */
+  struct PendingMessage
+  {
+    uint32_t sourceId = 0;
+    uint16_t messageId = 0;
+    size_t totalChunks = 0;
+    std::vector<size_t> missingChunks;  ///< Indices, ascending.
+  };
+
+  /**
+   * @brief Lists the messages being reassembled with their missing chunks.
+   */
+  std::vector<PendingMessage> pendingMessages() const;
+
+  /**
+   * @brief Journals reassembly to 'journal' and restores the messages it holds.
+   *
+   * Call once at start-up, before the first packet. Each message found in the
+   * journal becomes a session holding the chunks received before the restart;
+   * it is not declared stalled before maxTimeoutMs, to give the sender time to
+   * answer a ChunkRequest. From then on, new sessions of at least
+   * journalMinChunks chunks are journaled from their first accepted chunk
+   * while the journal has blank slots, and completed, pruned or reset
+   * sessions are retired from it. Retired slots are erased by
+   * ReassemblyJournal::maintain(), never on this path. The journal must use
+   * Profile::MAX_PAYLOAD_SIZE as its chunk stride and outlive the reassembler
+   * (or be detached with nullptr).
+   *
+   * @return Number of sessions restored (0 if the journal was not attached).
+   */
+  size_t attachJournal(ReassemblyJournal *journal, uint32_t currentTimestampMs);
+
+  /**
+   * @brief Completed messages dropped by processPacketInto() (no buffer, or buffer too small).
+   */
+  size_t undeliveredMessages() const { return undeliveredMessages_; }
+
   /**
    * @brief Clears all pending reassembly sessions.
    */
   void reset();
 
  private:
+  using ChunkIndex = decltype(PacketType::Header::chunkIndex);
+  using PayloadLength = decltype(PacketType::Header::payloadSize);
+
   /**
-   * @brief Maximum number of concurrent messages (sequences) allowed to prevent DoS/Memory exhaustion.
+   * @brief Received state of one chunk. The payload itself lives in the session body.
+   */
+  struct ChunkState
+  {
+    PayloadLength size = 0;
+    bool received = false;
+  };
+
+  /**
+   * @brief Contiguous, uninitialized message body: chunk i at offset i * chunkSize.
+   */
+  class MessageBody
+  {
+   public:
+    MessageBody(size_t capacity, std::pmr::memory_resource *resource)
+        : resource_(resource), capacity_(capacity),
+          data_(static_cast<uint8_t *>(resource->allocate(capacity, alignof(std::max_align_t))))
+    {
+    }
+
+    ~MessageBody()
+    {
+      if (data_ != nullptr)
+        resource_->deallocate(data_, capacity_, alignof(std::max_align_t));
+    }
+
+    MessageBody(MessageBody &&other) noexcept
+        : resource_(other.resource_), capacity_(other.capacity_), data_(std::exchange(other.data_, nullptr))
+    {
+    }
+
+    MessageBody(const MessageBody &) = delete;
+    MessageBody &operator=(const MessageBody &) = delete;
+    MessageBody &operator=(MessageBody &&) = delete;
+
+    uint8_t *data() { return data_; }
+    const uint8_t *data() const { return data_; }
+
+   private:
+    std::pmr::memory_resource *resource_;
+    size_t capacity_;
+    uint8_t *data_;
+  };
+
+  /**
+   * @brief Identifies a reassembly session: the same messageId may be in flight from several sources.
    */
-  static constexpr size_t MAX_CONCURRENT_MESSAGES = 10;
+  struct SessionKey
+  {
+    uint32_t sourceId;
+    uint16_t messageId;
+
+    bool operator<(const SessionKey &other) const
+    {
+      return sourceId != other.sourceId ? sourceId < other.sourceId : messageId < other.messageId;
+    }
+  };
 
   /**
    * @brief Keep track of the received chunks for each msgId, with other metadata.
@@ -56,31 +332,568 @@ class PacketReassembler
    */
   struct ReassemblySession
   {
-    uint8_t totalChunks;
+    ChunkIndex totalChunks;
+    PayloadLength chunkSize;  ///< Payload size of the non-final chunks, 0 until one is received.
     uint32_t firstReceivedTime;
     uint32_t chunksReceivedCount;
+
+    /**
+     * @brief Inter-arrival statistics used by pruneStalled().
+     * Gaps are stored in 1/8 ms units to keep the EWMA in integer arithmetic.
+     */
+    uint32_t lastReceivedTime;
+    ChunkIndex lastChunkIndex;
+    uint32_t gapEstimate;
+    uint32_t gapDeviation;
+    bool hasGapSample;
+
+    /**
+     * @brief Restored from the journal, no chunk received since (see attachJournal()).
+     */
+    bool restored;
+
+    /**
+     * @brief Journal slot of the session, std::nullopt when it is not journaled.
+     */
+    std::optional<size_t> journalSlot;
+
+    /**
+     * @brief Per-chunk state, to identify missing gaps (unreceived chunks).
+     */
+    std::pmr::vector<ChunkState> chunks;
+
     /**
-     * @brief Storage for chunks.
-     * Use std::optional to identify missing gaps (unreceived chunks).
+     * @brief Payload bytes, written in place as chunks arrive; reserved once chunkSize is known.
+     * Bodies are not zeroed: only received bytes are ever read back.
      */
-    std::vector<std::optional<Packet>> chunks;
+    std::optional<MessageBody> body;
 
-    ReassemblySession(uint8_t total, uint32_t time)
+    /**
+     * @brief Final chunk received before the body was reserved (it may be shorter than chunkSize).
+     */
+    uint8_t tail[Profile::MAX_PAYLOAD_SIZE];
+
+    ReassemblySession(ChunkIndex total, uint32_t time, std::pmr::memory_resource *stateResource)
         : totalChunks(total),
+          chunkSize(0),
           firstReceivedTime(time),
           chunksReceivedCount(0),
-          chunks(total, std::nullopt)  // Initialize vector with 'empty' slots
+          lastReceivedTime(time),
+          lastChunkIndex(0),
+          gapEstimate(0),
+          gapDeviation(0),
+          hasGapSample(false),
+          restored(false),
+          chunks(total, ChunkState{}, stateResource)  // Initialize vector with 'empty' slots
     {
     }
   };
 
+  ReassemblerConfig config_;
+
+  /**
+   * @brief Map of (Source ID, Message ID) -> Reassembly Session.
+   */
+  using SessionMap = std::pmr::map<SessionKey, ReassemblySession>;
+  SessionMap sessions_;
+
+  /**
+   * @brief Resources for ReassemblySession::body (see ReassemblerResources).
+   */
+  std::pmr::memory_resource *chunkResource_ = std::pmr::get_default_resource();
+  std::pmr::memory_resource *largeChunkResource_ = std::pmr::get_default_resource();
+  size_t largeMessageThreshold_ = SIZE_MAX;
+
+  size_t undeliveredMessages_ = 0;
+
+  ReassemblyJournal *journal_ = nullptr;
+
+  /**
+   * @brief Creates an empty session; its body is reserved by reserveBody().
+   */
+  typename SessionMap::iterator createSession(const SessionKey &key, ChunkIndex totalChunks, uint32_t currentTimestampMs);
+
+  /**
+   * @brief Reserves the body of 'bodySize' bytes in the tier matching that size and moves an early final chunk into it.
+   */
+  void reserveBody(ReassemblySession &session, size_t bodySize);
+
   /**
-   * @brief Map of Message ID -> Reassembly Session.
+   * @brief Where chunk 'chunkIdx' of the session is stored: the body, or the tail for an early final chunk.
+   * @return nullptr if a non-final chunk arrives before the body exists.
    */
-  std::map<uint16_t, ReassemblySession> sessions_;
+  static uint8_t *chunkData(ReassemblySession &session, size_t chunkIdx);
+
+  /**
+   * @brief Removes a session and retires its journal slot.
+   */
+  typename SessionMap::iterator eraseSession(typename SessionMap::iterator it);
+
+  /**
+   * @brief Stores a chunk in its session.
+   * @return The session if the chunk completed it, sessions_.end() otherwise.
+   */
+  typename SessionMap::iterator insertChunk(const PacketType &packet, uint32_t currentTimestampMs, uint32_t sourceId);
 
   /**
    * @brief Internal helper to reconstruct payload from a complete session.
    */
   std::vector<uint8_t> reconstruct(const ReassemblySession &session);
-};
\ No newline at end of file
+
+  /**
+   * @brief Total payload bytes of a complete session.
+   */
+  static size_t messageSize(const ReassemblySession &session);
+
+  /**
+   * @brief Copies the payload of a complete session to 'output' (messageSize() bytes).
+   */
+  static void copyMessage(const ReassemblySession &session, uint8_t *output);
+
+  /**
+   * @brief Feeds a new chunk arrival into the session's gap estimator.
+   */
+  static void updateArrivalStats(ReassemblySession &session, ChunkIndex chunkIdx, uint32_t currentTimestampMs);
+
+  /**
+   * @brief Computes how long the session may stay silent before it is considered stalled.
+   */
+  uint32_t allowedSilence(const ReassemblySession &session) const;
+};
+
+template <typename Profile>
+BasicPacketReassembler<Profile>::BasicPacketReassembler(const ReassemblerConfig &config)
+    : config_(config)
+{
+}
+
+template <typename Profile>
+BasicPacketReassembler<Profile>::BasicPacketReassembler(const ReassemblerConfig &config, const ReassemblerResources &resources)
+    : config_(config),
+      sessions_(resources.sessions),
+      chunkResource_(resources.chunks),
+      largeChunkResource_(resources.largeChunks != nullptr ? resources.largeChunks : resources.chunks),
+      largeMessageThreshold_(resources.largeMessageThreshold)
+{
+}
+
+template <typename Profile>
+typename BasicPacketReassembler<Profile>::SessionMap::iterator
+BasicPacketReassembler<Profile>::insertChunk(const PacketType &packet, uint32_t currentTimestampMs, uint32_t sourceId)
+{
+  // Link management (LinkAnnouncement, TdmaBeacon, ChunkRequest) is not application data.
+  if ((packet.header.flags & PACKET_FLAG_CONTROL) != 0)
+  {
+    return sessions_.end();
+  }
+
+  SessionKey key{sourceId, packet.header.messageId};
+  ChunkIndex chunkIdx = packet.header.chunkIndex;
+  ChunkIndex total = packet.header.totalChunks;
+
+  // Check if a corresponding session exists.
+  auto it = sessions_.find(key);
+
+  // If not
+  if (it == sessions_.end())
+  {
+    // Check if we hit the limit for concurrent sessions
+    if (sessions_.size() >= config_.maxConcurrentMessages)
+    {
+      // Discard package
+      return sessions_.end();
+    }
+
+    // Otherwise create a new session for the newly incoming message.
+    it = createSession(key, total, currentTimestampMs);
+  }
+
+  ReassemblySession &session = it->second;
+
+  // A chunk that disagrees with the session geometry cannot belong to it.
+  if (total != session.totalChunks || chunkIdx >= session.totalChunks ||
+      packet.header.payloadSize > Profile::MAX_PAYLOAD_SIZE)
+  {
+    return sessions_.end();
+  }
+
+  // Every non-final chunk carries the message's chunk size; the final one at most as much.
+  PayloadLength size = packet.header.payloadSize;
+  const ChunkState &last = session.chunks[session.totalChunks - 1];
+  if (chunkIdx + 1 < session.totalChunks)
+  {
+    if (size == 0)
+      return sessions_.end();
+    if (session.chunkSize == 0 && (!last.received || size >= last.size))
+      session.chunkSize = size;
+    if (size != session.chunkSize)
+      return sessions_.end();
+  }
+  else if (session.chunkSize != 0 && size > session.chunkSize)
+  {
+    return sessions_.end();
+  }
+
+  // The body is sized by the real chunk size: reserve it once that is known.
+  if (!session.body.has_value())
+  {
+    if (session.chunkSize != 0)
+      reserveBody(session, static_cast<size_t>(session.totalChunks) * session.chunkSize);
+    else if (session.totalChunks == 1 && size > 0)
+      reserveBody(session, size);
+  }
+
+  // Store the payload in place (or ignore it if was already saved).
+  ChunkState &chunk = session.chunks[chunkIdx];
+  if (!chunk.received)
+  {
+    std::memcpy(chunkData(session, chunkIdx), packet.payload.data, packet.header.payloadSize);
+    chunk.size = packet.header.payloadSize;
+    chunk.received = true;
+    session.chunksReceivedCount++;
+    updateArrivalStats(session, chunkIdx, currentTimestampMs);
+
+    // Journaled from its first accepted chunk: a rejected one must not hold a slot.
+    if (journal_ != nullptr && session.chunksReceivedCount == 1 && !session.journalSlot.has_value() &&
+        session.totalChunks >= config_.journalMinChunks)
+    {
+      session.journalSlot = journal_->open(sourceId, key.messageId, session.totalChunks);
+    }
+
+    // The chunk completing the message is not journaled: the session ends right away.
+    if (session.journalSlot.has_value() && session.chunksReceivedCount < session.totalChunks)
+      journal_->append(*session.journalSlot, chunkIdx, packet.payload.data, packet.header.payloadSize);
+  }
+
+  return session.chunksReceivedCount == session.totalChunks ? it : sessions_.end();
+}
+
+template <typename Profile>
+std::optional<std::vector<uint8_t>> BasicPacketReassembler<Profile>::processPacket(const PacketType &packet, uint32_t currentTimestampMs, uint32_t sourceId)
+{
+  auto it = insertChunk(packet, currentTimestampMs, sourceId);
+
+  // If all the chunks for the session have been received, return the reconstructed payload.
+  if (it == sessions_.end())
+  {
+    return std::nullopt;
+  }
+
+  std::vector<uint8_t> result = reconstruct(it->second);
+  eraseSession(it);
+  return result;
+}
+
+template <typename Profile>
+std::optional<MessageLease> BasicPacketReassembler<Profile>::processPacketInto(const PacketType &packet, uint32_t currentTimestampMs,
+                                                                               MessageBufferPool &pool, uint32_t sourceId)
+{
+  auto it = insertChunk(packet, currentTimestampMs, sourceId);
+  if (it == sessions_.end())
+  {
+    return std::nullopt;
+  }
+
+  size_t size = messageSize(it->second);
+  MessageLease lease = pool.acquire();
+  if (!lease || size > lease.capacity())
+  {
+    undeliveredMessages_++;
+    eraseSession(it);
+    return std::nullopt;
+  }
+
+  copyMessage(it->second, lease.data());
+  lease.resize(size);
+  eraseSession(it);
+  return std::optional<MessageLease>(std::move(lease));
+}
+
+template <typename Profile>
+std::optional<size_t> BasicPacketReassembler<Profile>::processPacketInto(const PacketType &packet, uint32_t currentTimestampMs,
+                                                                         uint8_t *output, size_t capacity, uint32_t sourceId)
+{
+  auto it = insertChunk(packet, currentTimestampMs, sourceId);
+  if (it == sessions_.end())
+  {
+    return std::nullopt;
+  }
+
+  size_t size = messageSize(it->second);
+  if (output == nullptr || size > capacity)
+  {
+    undeliveredMessages_++;
+    eraseSession(it);
+    return std::nullopt;
+  }
+
+  copyMessage(it->second, output);
+  eraseSession(it);
+  return size;
+}
+
+template <typename Profile>
+std::optional<std::pmr::vector<uint8_t>> BasicPacketReassembler<Profile>::processPacketInto(const PacketType &packet, uint32_t currentTimestampMs,
+                                                                                            std::pmr::memory_resource &resource, uint32_t sourceId)
+{
+  auto it = insertChunk(packet, currentTimestampMs, sourceId);
+  if (it == sessions_.end())
+  {
+    return std::nullopt;
+  }
+
+  std::pmr::vector<uint8_t> result(messageSize(it->second), &resource);
+  copyMessage(it->second, result.data());
+  eraseSession(it);
+  return result;
+}
+
+template <typename Profile>
+void BasicPacketReassembler<Profile>::prune(uint32_t currentTimestampMs, uint32_t timeoutMs)
+{
+  auto it = sessions_.begin();
+  while (it != sessions_.end())
+  {
+    if (currentTimestampMs - it->second.firstReceivedTime > timeoutMs)
+    {
+      it = eraseSession(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+template <typename Profile>
+size_t BasicPacketReassembler<Profile>::pruneStalled(uint32_t currentTimestampMs)
+{
+  size_t removed = 0;
+  auto it = sessions_.begin();
+  while (it != sessions_.end())
+  {
+    if (currentTimestampMs - it->second.lastReceivedTime > allowedSilence(it->second))
+    {
+      it = eraseSession(it);
+      removed++;
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  return removed;
+}
+
+template <typename Profile>
+void BasicPacketReassembler<Profile>::reset()
+{
+  auto it = sessions_.begin();
+  while (it != sessions_.end())
+    it = eraseSession(it);
+}
+
+template <typename Profile>
+std::vector<typename BasicPacketReassembler<Profile>::PendingMessage> BasicPacketReassembler<Profile>::pendingMessages() const
+{
+  std::vector<PendingMessage> messages;
+  messages.reserve(sessions_.size());
+  for (const auto &entry : sessions_)
+  {
+    PendingMessage message;
+    message.sourceId = entry.first.sourceId;
+    message.messageId = entry.first.messageId;
+    message.totalChunks = entry.second.totalChunks;
+    for (size_t i = 0; i < entry.second.chunks.size(); i++)
+    {
+      if (!entry.second.chunks[i].received)
+        message.missingChunks.push_back(i);
+    }
+    messages.push_back(std::move(message));
+  }
+  return messages;
+}
+
+template <typename Profile>
+size_t BasicPacketReassembler<Profile>::attachJournal(ReassemblyJournal *journal, uint32_t currentTimestampMs)
+{
+  // Slots of a previous journal mean nothing in this one.
+  for (auto &entry : sessions_)
+    entry.second.journalSlot.reset();
+
+  journal_ = journal != nullptr && journal->chunkStride() == Profile::MAX_PAYLOAD_SIZE ? journal : nullptr;
+  if (journal_ == nullptr)
+    return 0;
+
+  size_t restored = 0;
+  for (const ReassemblyJournal::Record &record : journal_->records())
+  {
+    SessionKey key{record.sourceId, record.messageId};
+    if (record.totalChunks == 0 || record.totalChunks > Profile::MAX_CHUNKS || sessions_.count(key) != 0 ||
+        sessions_.size() >= config_.maxConcurrentMessages)
+    {
+      journal_->retire(record.slot);
+      continue;
+    }
+
+    ChunkIndex total = static_cast<ChunkIndex>(record.totalChunks);
+    ReassemblySession &session = createSession(key, total, currentTimestampMs)->second;
+    session.journalSlot = record.slot;
+    session.restored = true;
+
+    // Any journaled non-final chunk gives the chunk size, and with it the body.
+    for (size_t i = 0; i + 1 < total && session.chunkSize == 0; i++)
+    {
+      std::optional<uint16_t> size = journal_->chunkSize(record.slot, i);
+      if (size.has_value() && *size > 0)
+        session.chunkSize = static_cast<PayloadLength>(*size);
+    }
+    if (session.chunkSize != 0)
+      reserveBody(session, static_cast<size_t>(total) * session.chunkSize);
+
+    for (size_t i = 0; i < total; i++)
+    {
+      std::optional<uint16_t> size = journal_->chunkSize(record.slot, i);
+      bool fits = size.has_value() && (i + 1 < total ? *size == session.chunkSize
+                                                     : session.chunkSize == 0 || *size <= session.chunkSize);
+      uint8_t *data = fits ? chunkData(session, i) : nullptr;
+      if (data == nullptr || !journal_->readChunk(record.slot, i, data, *size))
+        continue;
+      session.chunks[i].size = static_cast<PayloadLength>(*size);
+      session.chunks[i].received = true;
+      session.chunksReceivedCount++;
+      session.lastChunkIndex = static_cast<ChunkIndex>(i);
+    }
+    restored++;
+  }
+  return restored;
+}
+
+template <typename Profile>
+typename BasicPacketReassembler<Profile>::SessionMap::iterator
+BasicPacketReassembler<Profile>::createSession(const SessionKey &key, ChunkIndex totalChunks, uint32_t currentTimestampMs)
+{
+  return sessions_.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                           std::forward_as_tuple(totalChunks, currentTimestampMs, sessions_.get_allocator().resource()))
+      .first;
+}
+
+template <typename Profile>
+void BasicPacketReassembler<Profile>::reserveBody(ReassemblySession &session, size_t bodySize)
+{
+  std::pmr::memory_resource *resource = bodySize >= largeMessageThreshold_ ? largeChunkResource_ : chunkResource_;
+  session.body.emplace(bodySize, resource);
+
+  const ChunkState &last = session.chunks[session.totalChunks - 1];
+  if (session.totalChunks > 1 && last.received)
+  {
+    std::memcpy(session.body->data() + static_cast<size_t>(session.totalChunks - 1) * session.chunkSize, session.tail,
+                last.size);
+  }
+}
+
+template <typename Profile>
+uint8_t *BasicPacketReassembler<Profile>::chunkData(ReassemblySession &session, size_t chunkIdx)
+{
+  if (session.body.has_value())
+    return session.body->data() + chunkIdx * session.chunkSize;
+  return chunkIdx + 1 == session.totalChunks ? session.tail : nullptr;
+}
+
+template <typename Profile>
+typename BasicPacketReassembler<Profile>::SessionMap::iterator
+BasicPacketReassembler<Profile>::eraseSession(typename SessionMap::iterator it)
+{
+  if (journal_ != nullptr && it->second.journalSlot.has_value())
+    journal_->retire(*it->second.journalSlot);
+  return sessions_.erase(it);
+}
+
+template <typename Profile>
+std::vector<uint8_t> BasicPacketReassembler<Profile>::reconstruct(const ReassemblySession &session)
+{
+  // Exact size known up front: one allocation, one copy per chunk.
+  std::vector<uint8_t> fullMessage(messageSize(session));
+  copyMessage(session, fullMessage.data());
+  return fullMessage;
+}
+
+template <typename Profile>
+size_t BasicPacketReassembler<Profile>::messageSize(const ReassemblySession &session)
+{
+  size_t size = 0;
+  for (const ChunkState &chunk : session.chunks)
+    size += chunk.size;
+  return size;
+}
+
+template <typename Profile>
+void BasicPacketReassembler<Profile>::copyMessage(const ReassemblySession &session, uint8_t *output)
+{
+  // Chunks are stored at chunkSize strides, the final one included: the body is the message.
+  size_t size = messageSize(session);
+  if (size > 0)
+    std::memcpy(output, session.body->data(), size);
+}
+
+template <typename Profile>
+void BasicPacketReassembler<Profile>::updateArrivalStats(ReassemblySession &session, ChunkIndex chunkIdx, uint32_t currentTimestampMs)
+{
+  // The very first chunk only sets the reference point, as does the first
+  // one after a restart: the time spent down says nothing about the link.
+  if (session.chunksReceivedCount <= 1 || session.restored)
+  {
+    session.restored = false;
+    session.lastReceivedTime = currentTimestampMs;
+    session.lastChunkIndex = chunkIdx;
+    return;
+  }
+
+  // Normalize the gap by the index distance so that a burst of lost chunks
+  // does not look like a slow link (chunks are transmitted in index order).
+  uint32_t elapsed = currentTimestampMs - session.lastReceivedTime;
+  uint32_t distance = chunkIdx > session.lastChunkIndex ? chunkIdx - session.lastChunkIndex
+                                                        : session.lastChunkIndex - chunkIdx;
+  int64_t sample = (static_cast<int64_t>(elapsed) * 8) / std::max<uint32_t>(distance, 1);
+
+  if (!session.hasGapSample)
+  {
+    session.gapEstimate = static_cast<uint32_t>(sample);
+    session.gapDeviation = static_cast<uint32_t>(sample / 2);
+    session.hasGapSample = true;
+  }
+  else
+  {
+    // RFC 6298 style estimator: alpha = 1/8, beta = 1/4.
+    int64_t error = sample - static_cast<int64_t>(session.gapEstimate);
+    int64_t absError = error < 0 ? -error : error;
+    session.gapDeviation = static_cast<uint32_t>(static_cast<int64_t>(session.gapDeviation) + (absError - static_cast<int64_t>(session.gapDeviation)) / 4);
+    session.gapEstimate = static_cast<uint32_t>(static_cast<int64_t>(session.gapEstimate) + error / 8);
+  }
+
+  session.lastReceivedTime = currentTimestampMs;
+  session.lastChunkIndex = chunkIdx;
+}
+
+template <typename Profile>
+uint32_t BasicPacketReassembler<Profile>::allowedSilence(const ReassemblySession &session) const
+{
+  if (session.restored)
+    return config_.maxTimeoutMs;
+
+  uint64_t gapMs = session.hasGapSample
+                       ? (static_cast<uint64_t>(session.gapEstimate) + 4ull * session.gapDeviation) / 8
+                       : config_.initialGapMs;
+
+  uint32_t remaining = session.totalChunks - session.chunksReceivedCount;
+  uint64_t tolerated = std::min<uint32_t>(remaining, config_.maxLossBurst) + 1;
+
+  uint64_t silence = gapMs * tolerated;
+  silence = std::max<uint64_t>(silence, config_.minTimeoutMs);
+  silence = std::min<uint64_t>(silence, config_.maxTimeoutMs);
+  return static_cast<uint32_t>(silence);
+}
+
+using PacketReassembler = BasicPacketReassembler<DefaultProfile>;
+
+extern template class BasicPacketReassembler<DefaultProfile>;
@@ -1,27 +1,64 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "Packet.hpp"
 
 /**
- * @class PacketSerializer
+ * @class BasicPacketSerializer
  * @brief Static utility class for converting between raw data buffers and Packet structures.
  * * This class handles the segmentation of large data arrays into smaller LoRa-compatible
  * packets (splitting) and the serialization of Packet structures into raw byte arrays
  * for transmission.
+ *
+ * **Chunk size:** every chunk of a message carries 'chunkSize' payload bytes
+ * except the last, which carries the remainder. The sender chooses it per
+ * message (default: Profile::MAX_PAYLOAD_SIZE); it travels as the payloadSize
+ * of the non-final chunks, so receivers need no configuration. Smaller chunks
+ * cost more headers but, sent as compact frames (serializeCompact()), are
+ * shorter on air and survive high bit-error rates more often.
+ *
+ * @tparam Profile Frame geometry (see ProtocolProfile). PacketSerializer uses DefaultProfile.
  */
-class PacketSerializer
+template <typename Profile>
+class BasicPacketSerializer
 {
  public:
+  using PacketType = BasicPacket<Profile>;
+
   /**
    * @brief Serializes a Packet structure into a raw byte buffer.
    * * Copies the header, payload, and CRC into a contiguous memory block
    * ready for hardware transmission.
    * * @param packet The source Packet object.
-   * @param buffer The destination buffer. Must be at least MAX_PACKET_SIZE bytes.
+   * @param buffer The destination buffer. Must be at least Profile::PACKET_SIZE bytes.
    */
-  static void serialize(const Packet &packet, uint8_t *buffer);
+  static void serialize(const PacketType &packet, uint8_t *buffer);
+
+  /**
+   * @brief Serializes a packet without its padding: header, payloadSize payload bytes, CRC.
+   *
+   * BasicPacketParser::parse() accepts both layouts (they are identical for
+   * full chunks).
+   *
+   * @param buffer The destination buffer. Must be at least compactSize(packet) bytes.
+   * @return Number of bytes written (compactSize(packet)).
+   */
+  static size_t serializeCompact(const PacketType &packet, uint8_t *buffer);
+
+  /**
+   * @brief Length of the compact frame of 'packet'.
+   */
+  static constexpr size_t compactSize(const PacketType &packet)
+  {
+    return Profile::HEADER_SIZE + packet.header.payloadSize + Profile::CRC_SIZE;
+  }
 
   /**
    * @brief Splits a raw data buffer into a vector of Packets.
@@ -30,15 +67,258 @@ class PacketSerializer
    * * @param data Pointer to the source data.
    * @param length Length of the source data in bytes.
    * @param packetNumberStart The Message ID to assign to these packets (default: 1).
+   * @param chunkSize Payload bytes per chunk, 1..Profile::MAX_PAYLOAD_SIZE (see class description).
    * @return std::vector<Packet> A list of ready-to-send packets.
    */
-  static std::vector<Packet> splitBufferToPackets(const uint8_t *data, size_t length, uint16_t packetNumberStart = 1);
+  static std::vector<PacketType> splitBufferToPackets(const uint8_t *data, size_t length, uint16_t packetNumberStart = 1,
+                                                      size_t chunkSize = Profile::MAX_PAYLOAD_SIZE);
 
   /**
    * @brief Convenience overload for std::vector input.
    * * @param data The source data vector.
    * @param packetNumberStart The Message ID to assign to these packets (default: 1).
+   * @param chunkSize Payload bytes per chunk (see splitBufferToPackets()).
    * @return std::vector<Packet> A list of ready-to-send packets.
    */
-  static std::vector<Packet> splitVectorToPackets(const std::vector<uint8_t> &data, uint16_t packetNumberStart = 1);
-};
\ No newline at end of file
+  static std::vector<PacketType> splitVectorToPackets(const std::vector<uint8_t> &data, uint16_t packetNumberStart = 1,
+                                                      size_t chunkSize = Profile::MAX_PAYLOAD_SIZE);
+
+  /**
+   * @brief Same as splitBufferToPackets(), with the packet vector allocated from 'resource'.
+   */
+  static std::pmr::vector<PacketType> splitBufferToPackets(const uint8_t *data, size_t length, uint16_t packetNumberStart,
+                                                           std::pmr::memory_resource &resource,
+                                                           size_t chunkSize = Profile::MAX_PAYLOAD_SIZE);
+
+  /**
+   * @brief Builds the single packet 'chunkIndex' of a message, as splitBufferToPackets() would.
+   *
+   * Lets transmit paths serialize one frame at a time instead of splitting
+   * the whole message up front.
+   *
+   * @param data Pointer to the whole message.
+   * @param length Length of the message in bytes (at least 1).
+   * @param messageId The Message ID of the message.
+   * @param chunkIndex Index of the chunk, below chunksFor(length, chunkSize).
+   * @param chunkSize Payload bytes per chunk (see splitBufferToPackets()).
+   */
+  static PacketType chunkPacket(const uint8_t *data, size_t length, uint16_t messageId, size_t chunkIndex,
+                                size_t chunkSize = Profile::MAX_PAYLOAD_SIZE);
+
+  /**
+   * @brief Number of chunks needed to carry a message of 'length' bytes.
+   */
+  static constexpr size_t chunksFor(size_t length, size_t chunkSize = Profile::MAX_PAYLOAD_SIZE)
+  {
+    return (length + chunkSize - 1) / chunkSize;
+  }
+
+  /**
+   * @brief True if 'chunkSize' is a usable chunk size for a message of 'length' bytes.
+   */
+  static constexpr bool validChunkSize(size_t length, size_t chunkSize)
+  {
+    return chunkSize > 0 && chunkSize <= Profile::MAX_PAYLOAD_SIZE && chunksFor(length, chunkSize) <= Profile::MAX_CHUNKS;
+  }
+
+  /**
+   * @brief Smallest chunk size that keeps a message of 'length' bytes within Profile::MAX_CHUNKS chunks.
+   */
+  static constexpr size_t minChunkSize(size_t length)
+  {
+    return length > Profile::MAX_CHUNKS ? (length + Profile::MAX_CHUNKS - 1) / Profile::MAX_CHUNKS : 1;
+  }
+
+  /**
+   * @brief Number of chunks needed to carry a T.
+   */
+  template <typename T>
+  static constexpr size_t chunksFor()
+  {
+    return chunksFor(sizeof(T));
+  }
+
+  /**
+   * @brief Payload bytes of chunk 'index' of a message of 'size' bytes.
+   */
+  static constexpr size_t chunkPayloadSize(size_t size, size_t index, size_t chunkSize = Profile::MAX_PAYLOAD_SIZE)
+  {
+    return size - index * chunkSize < chunkSize ? size - index * chunkSize : chunkSize;
+  }
+
+  /**
+   * @brief Splits a fixed-layout object into packets without heap allocation.
+   *
+   * Same packets as splitBufferToPackets() on the bytes of 'value', but the
+   * chunk count, offsets, payload sizes and flags are compile-time constants
+   * and the result is a std::array sized for T.
+   *
+   * @tparam T Trivially copyable type (sent with the sender's byte order and layout).
+   * @param value The object to send.
+   * @param messageId The Message ID to assign to these packets.
+   */
+  template <typename T>
+  static std::array<PacketType, chunksFor<T>()> split(const T &value, uint16_t messageId = 1)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "split<T>() sends the object representation of T");
+    static_assert(chunksFor<T>() <= Profile::MAX_CHUNKS, "T needs more chunks than the header can describe");
+    return splitChunks<T>(reinterpret_cast<const uint8_t *>(&value), messageId,
+                          std::make_index_sequence<chunksFor<T>()>{});
+  }
+
+ private:
+  /**
+   * @brief Appends the packets of 'data' to 'result' (any vector-like container of PacketType).
+   */
+  template <typename Container>
+  static void splitInto(Container &result, const uint8_t *data, size_t length, uint16_t packetNumberStart,
+                        size_t chunkSize);
+
+  template <typename T, size_t... I>
+  static std::array<PacketType, sizeof...(I)> splitChunks(const uint8_t *bytes, uint16_t messageId, std::index_sequence<I...>)
+  {
+    return {{makeChunk<I, sizeof...(I), sizeof(T)>(bytes, messageId)...}};
+  }
+
+  /**
+   * @brief Builds chunk I of N of a Size-byte message.
+   */
+  template <size_t I, size_t N, size_t Size>
+  static PacketType makeChunk(const uint8_t *bytes, uint16_t messageId)
+  {
+    constexpr size_t offset = I * Profile::MAX_PAYLOAD_SIZE;
+    constexpr size_t payloadSize = chunkPayloadSize(Size, I);
+    constexpr uint8_t flags = (I == 0 ? PACKET_FLAG_SOM : 0) | (I == N - 1 ? PACKET_FLAG_EOM : 0);
+
+    PacketType packet{};
+    packet.header.messageId = messageId;
+    packet.header.totalChunks = static_cast<decltype(packet.header.totalChunks)>(N);
+    packet.header.chunkIndex = static_cast<decltype(packet.header.chunkIndex)>(I);
+    packet.header.payloadSize = static_cast<decltype(packet.header.payloadSize)>(payloadSize);
+    packet.header.flags = flags;
+
+    std::memcpy(packet.payload.data, bytes + offset, payloadSize);
+    if (payloadSize < Profile::MAX_PAYLOAD_SIZE)
+    {
+      std::memset(packet.payload.data + payloadSize, PAYLOAD_PADDING_BYTE, Profile::MAX_PAYLOAD_SIZE - payloadSize);
+    }
+
+    packet.calculateCRC();
+    return packet;
+  }
+};
+
+template <typename Profile>
+void BasicPacketSerializer<Profile>::serialize(const PacketType &packet, uint8_t *buffer)
+{
+  // Copy header
+  std::memcpy(buffer, &packet.header, Profile::HEADER_SIZE);
+  // Copy payload (full fixed payload size)
+  std::memcpy(buffer + Profile::HEADER_SIZE, &packet.payload, Profile::MAX_PAYLOAD_SIZE);
+  // Copy CRC
+  std::memcpy(buffer + Profile::HEADER_SIZE + Profile::MAX_PAYLOAD_SIZE, &packet.crc,
+              Profile::CRC_SIZE);
+}
+
+template <typename Profile>
+size_t BasicPacketSerializer<Profile>::serializeCompact(const PacketType &packet, uint8_t *buffer)
+{
+  size_t payloadSize = packet.header.payloadSize;
+  std::memcpy(buffer, &packet.header, Profile::HEADER_SIZE);
+  std::memcpy(buffer + Profile::HEADER_SIZE, packet.payload.data, payloadSize);
+  std::memcpy(buffer + Profile::HEADER_SIZE + payloadSize, &packet.crc, Profile::CRC_SIZE);
+  return compactSize(packet);
+}
+
+template <typename Profile>
+std::vector<typename BasicPacketSerializer<Profile>::PacketType>
+BasicPacketSerializer<Profile>::splitBufferToPackets(const uint8_t *data, size_t length, uint16_t packetNumberStart,
+                                                     size_t chunkSize)
+{
+  std::vector<PacketType> result;
+  splitInto(result, data, length, packetNumberStart, chunkSize);
+  return result;
+}
+
+template <typename Profile>
+std::pmr::vector<typename BasicPacketSerializer<Profile>::PacketType>
+BasicPacketSerializer<Profile>::splitBufferToPackets(const uint8_t *data, size_t length, uint16_t packetNumberStart,
+                                                     std::pmr::memory_resource &resource, size_t chunkSize)
+{
+  std::pmr::vector<PacketType> result(&resource);
+  splitInto(result, data, length, packetNumberStart, chunkSize);
+  return result;
+}
+
+template <typename Profile>
+template <typename Container>
+void BasicPacketSerializer<Profile>::splitInto(Container &result, const uint8_t *data, size_t length, uint16_t packetNumberStart,
+                                               size_t chunkSize)
+{
+  if (data == nullptr || length == 0 || !validChunkSize(length, chunkSize))
+    return;
+
+  size_t totalChunks = chunksFor(length, chunkSize);
+  result.reserve(totalChunks);
+  for (size_t chunkIndex = 0; chunkIndex < totalChunks; chunkIndex++)
+  {
+    result.push_back(chunkPacket(data, length, packetNumberStart, chunkIndex, chunkSize));
+  }
+}
+
+template <typename Profile>
+typename BasicPacketSerializer<Profile>::PacketType
+BasicPacketSerializer<Profile>::chunkPacket(const uint8_t *data, size_t length, uint16_t messageId, size_t chunkIndex,
+                                            size_t chunkSize)
+{
+  using ChunkCount = decltype(PacketType::Header::totalChunks);
+  using PayloadLength = decltype(PacketType::Header::payloadSize);
+  constexpr size_t maxPayload = Profile::MAX_PAYLOAD_SIZE;
+
+  size_t totalChunks = chunksFor(length, chunkSize);
+  size_t offset = chunkIndex * chunkSize;
+
+  PacketType packet{};
+  packet.header.messageId = messageId;
+  packet.header.totalChunks = static_cast<ChunkCount>(totalChunks);
+  packet.header.chunkIndex = static_cast<ChunkCount>(chunkIndex);
+
+  PayloadLength payloadSize = static_cast<PayloadLength>(chunkPayloadSize(length, chunkIndex, chunkSize));
+  packet.header.payloadSize = payloadSize;
+
+  std::memcpy(packet.payload.data, data + offset, payloadSize);
+
+  // Fill remaining bytes with padding (all 1s) if payload is not full
+  if (payloadSize < maxPayload)
+  {
+    std::memset(packet.payload.data + payloadSize, PAYLOAD_PADDING_BYTE,
+                maxPayload - payloadSize);
+  }
+
+  // Set flags using defined constants.
+  uint8_t flags = 0;
+  if (chunkIndex == 0)
+  {
+    flags |= PACKET_FLAG_SOM;
+  }
+  if (chunkIndex == totalChunks - 1) // chunkIndex is 0-based.
+  {
+    flags |= PACKET_FLAG_EOM;
+  }
+  packet.header.flags = flags;
+
+  packet.calculateCRC();
+  return packet;
+}
+
+template <typename Profile>
+std::vector<typename BasicPacketSerializer<Profile>::PacketType>
+BasicPacketSerializer<Profile>::splitVectorToPackets(const std::vector<uint8_t> &data, uint16_t packetNumberStart,
+                                                     size_t chunkSize)
+{
+  return splitBufferToPackets(data.empty() ? nullptr : data.data(), data.size(), packetNumberStart, chunkSize);
+}
+
+using PacketSerializer = BasicPacketSerializer<DefaultProfile>;
+
+extern template class BasicPacketSerializer<DefaultProfile>;
@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 
+#include "FrameArena.hpp"
 #include "Packet.hpp"
 
 /**
@@ -18,7 +19,7 @@ struct ValidationError
     INVALID_PROTOCOL_VERSION,   ///< Protocol version not supported
     INVALID_TOTAL_CHUNKS,       ///< totalChunks == 0 or exceeds MAX (255)
     INVALID_CHUNK_INDEX,        ///< chunkIndex >= totalChunks
-    INVALID_PAYLOAD_SIZE,       ///< payloadSize > LORA_MAX_PAYLOAD_SIZE or (not last chunk && payloadSize != LORA_MAX_PAYLOAD_SIZE)
+    INVALID_PAYLOAD_SIZE,       ///< payloadSize > max payload size or (not last chunk && payloadSize == 0)
     INVALID_MESSAGE_ID,         ///< messageId == 0 (reserved)
     CRC_MISMATCH,               ///< CRC validation failed
     INVALID_SOM_FLAG,           ///< SOM flag not set on chunk 0
@@ -32,7 +33,7 @@ struct ValidationError
 };
 
 /**
- * @class PacketValidator
+ * @class BasicPacketValidator
  * @brief Validates packet integrity without performing deserialization.
  *
  * Performs multi-stage validation:
@@ -45,35 +46,41 @@ struct ValidationError
  *
  * **Note:** This class performs validation only. The PacketDeserializer
  * class calls these validation APIs and performs the actual deserialization.
+ *
+ * @tparam Profile Frame geometry (see ProtocolProfile).
  */
-class PacketValidator
+template <typename Profile>
+class BasicPacketValidator
 {
  public:
+  using PacketType = BasicPacket<Profile>;
+  using Header = typename Profile::Header;
+
   /**
    * @brief Validates a deserialized packet.
    *
    * Performs comprehensive integrity checks:
    *   - Header fields are within valid ranges
    *   - Message ID is non-zero
-   *   - CRC-16 matches calculated value (covers header + valid payload only)
+   *   - CRC matches calculated value (covers header + valid payload only)
    *   - SOM flag is set if this is chunk 0
    *   - EOM flag is set if this is the last chunk
    *
    * @param packet The packet to validate
    * @return std::nullopt if valid, ValidationError details if invalid
    */
-  static std::optional<ValidationError> validate(const Packet &packet);
+  static std::optional<ValidationError> validate(const PacketType &packet);
 
- private:
+ protected:
   static constexpr size_t MIN_PACKET_SIZE =
-      HEADER_SIZE + sizeof(PacketPayload) + CRC_SIZE;
+      Profile::HEADER_SIZE + Profile::MAX_PAYLOAD_SIZE + Profile::CRC_SIZE;
   static constexpr uint8_t SUPPORTED_PROTOCOL_VERSION = 1;
 
   /**
    * @brief Validates header fields for sanity.
    */
   static std::optional<ValidationError> validateHeader(
-      const PacketHeader &header);
+      const Header &header);
 
   /**
    * @brief Validates CRC against calculated value.
@@ -81,12 +88,197 @@ class PacketValidator
    * CRC calculation respects the protocol design: covers header + valid payload,
    * explicitly excludes padding bytes.
    */
-  static std::optional<ValidationError> validateCRC(const Packet &packet,
-                                                    uint16_t receivedCrc);
+  static std::optional<ValidationError> validateCRC(const PacketType &packet,
+                                                    typename Profile::Crc receivedCrc);
 
   /**
    * @brief Validates SOM/EOM flag consistency.
    */
   static std::optional<ValidationError> validateFlags(
-      const PacketHeader &header);
+      const Header &header);
+};
+
+template <typename Profile>
+std::optional<ValidationError> BasicPacketValidator<Profile>::validate(const PacketType &packet)
+{
+  // Validate header
+  auto headerErr = validateHeader(packet.header);
+  if (headerErr.has_value())
+    return headerErr;
+
+  // Validate flags
+  auto flagErr = validateFlags(packet.header);
+  if (flagErr.has_value())
+    return flagErr;
+
+  // Validate CRC
+  auto crcErr = validateCRC(packet, packet.crc);
+  if (crcErr.has_value())
+    return crcErr;
+
+  return std::nullopt;
+}
+
+template <typename Profile>
+std::optional<ValidationError> BasicPacketValidator<Profile>::validateHeader(
+    const Header &header)
+{
+  // Check protocol version
+  if (header.protocolVersion != SUPPORTED_PROTOCOL_VERSION)
+  {
+    return ValidationError(
+        ValidationError::Type::INVALID_PROTOCOL_VERSION,
+        "Protocol version " + std::to_string(header.protocolVersion) +
+            " not supported (expected " +
+            std::to_string(SUPPORTED_PROTOCOL_VERSION) + ")");
+  }
+
+  // Check message ID (0 is reserved)
+  if (header.messageId == 0)
+  {
+    return ValidationError(ValidationError::Type::INVALID_MESSAGE_ID,
+                           "Message ID cannot be 0 (reserved value)");
+  }
+
+  // Check totalChunks
+  if (header.totalChunks == 0)
+  {
+    return ValidationError(ValidationError::Type::INVALID_TOTAL_CHUNKS,
+                           "totalChunks must be >= 1");
+  }
+
+  // Check chunkIndex within bounds
+  if (header.chunkIndex >= header.totalChunks)
+  {
+    return ValidationError(
+        ValidationError::Type::INVALID_CHUNK_INDEX,
+        "chunkIndex (" + std::to_string(header.chunkIndex) +
+            ") >= totalChunks (" + std::to_string(header.totalChunks) + ")");
+  }
+
+  // Check payloadSize within bounds
+  if (header.payloadSize > Profile::MAX_PAYLOAD_SIZE)
+  {
+    return ValidationError(
+        ValidationError::Type::INVALID_PAYLOAD_SIZE,
+        "payloadSize (" + std::to_string(header.payloadSize) +
+            ") > max payload size (" +
+            std::to_string(Profile::MAX_PAYLOAD_SIZE) + ")");
+  }
+
+  // Logical check: a non-final chunk carries the message's chunk size, never 0.
+  // Whether all chunks of a message agree on it is checked by the reassembler.
+  bool isLastChunk = (header.chunkIndex == header.totalChunks - 1);
+  if (!isLastChunk && header.payloadSize == 0)
+  {
+    return ValidationError(
+        ValidationError::Type::INVALID_PAYLOAD_SIZE,
+        "Non-final chunk must carry the message's chunk size, got 0 bytes");
+  }
+
+  return std::nullopt;
+}
+
+template <typename Profile>
+std::optional<ValidationError> BasicPacketValidator<Profile>::validateFlags(
+    const Header &header)
+{
+  bool isFirstChunk = (header.chunkIndex == 0);
+  bool isLastChunk = (header.chunkIndex == header.totalChunks - 1);
+
+  bool hasSOM = (header.flags & PACKET_FLAG_SOM) != 0;
+  bool hasEOM = (header.flags & PACKET_FLAG_EOM) != 0;
+
+  // First chunk must have SOM flag
+  if (isFirstChunk && !hasSOM)
+  {
+    return ValidationError(ValidationError::Type::INVALID_SOM_FLAG,
+                           "Chunk 0 must have SOM (Start of Message) flag set");
+  }
+
+  // Non-first chunk must not have SOM flag
+  if (!isFirstChunk && hasSOM)
+  {
+    return ValidationError(
+        ValidationError::Type::INVALID_SOM_FLAG,
+        "Only chunk 0 can have SOM (Start of Message) flag");
+  }
+
+  // Last chunk must have EOM flag
+  if (isLastChunk && !hasEOM)
+  {
+    return ValidationError(ValidationError::Type::INVALID_EOM_FLAG,
+                           "Final chunk must have EOM (End of Message) flag set");
+  }
+
+  // Non-last chunk must not have EOM flag
+  if (!isLastChunk && hasEOM)
+  {
+    return ValidationError(
+        ValidationError::Type::INVALID_EOM_FLAG,
+        "Only the final chunk can have EOM (End of Message) flag");
+  }
+
+  return std::nullopt;
+}
+
+template <typename Profile>
+std::optional<ValidationError> BasicPacketValidator<Profile>::validateCRC(
+    const PacketType &packet, typename Profile::Crc receivedCrc)
+{
+  // Create a copy to calculate CRC
+  PacketType tempPacket = packet;
+  tempPacket.crc = 0;  // Clear CRC field before calculation
+  tempPacket.calculateCRC();
+
+  // Compare calculated CRC with received CRC
+  if (tempPacket.crc != receivedCrc)
+  {
+    return ValidationError(
+        ValidationError::Type::CRC_MISMATCH,
+        "CRC mismatch: expected 0x" + std::string(4, '0') + ", received 0x" +
+            std::string(4, '0'));
+  }
+
+  return std::nullopt;
+}
+
+extern template class BasicPacketValidator<DefaultProfile>;
+
+/**
+ * @class PacketValidator
+ * @brief Validator of the default profile, plus the batched receive path.
+ *
+ * The batch kernels work on FrameArena slots and the compact PacketHeader
+ * byte layout, so they are only provided for DefaultProfile.
+ */
+class PacketValidator : public BasicPacketValidator<DefaultProfile>
+{
+ public:
+  /**
+   * @brief Runs the header and flag checks of validate() on a whole batch of raw frames.
+   *
+   * Checks frame length, protocol version, message ID, chunk bounds, payload
+   * size and SOM/EOM consistency for every frame of the arena at once. The
+   * headers are first gathered into a structure-of-arrays layout, 64 frames
+   * at a time, and checked branch-free with AVX2 or SSE2 when the CPU
+   * supports it (scalar fallback otherwise, e.g. on ESP32). No error strings
+   * are built, so garbage frames cost a few instructions each.
+   *
+   * The CRC is NOT verified: bit i of 'crcCandidates' is set when frame i
+   * passed every other check and still needs its CRC verified.
+   *
+   * @param frames Batch of raw frames
+   * @param crcCandidates Output bitmask with batchMaskWords(frames.size()) words
+   * @return Number of frames flagged for CRC verification
+   */
+  static size_t validateBatch(const FrameArena &frames, uint64_t *crcCandidates);
+
+  /**
+   * @brief Header and flag checks of validate() on a serialized header (HEADER_SIZE bytes).
+   *
+   * Builds no error strings and does not look at the CRC: meant for locating
+   * frame candidates in a byte stream (see FrameStreamDecoder).
+   */
+  static bool plausibleHeader(const uint8_t *header);
 };
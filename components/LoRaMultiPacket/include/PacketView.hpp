@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Packet.hpp"
+
+/**
+ * @struct PacketView
+ * @brief Non-owning view of a validated compact frame (header, payloadSize bytes, CRC).
+ *
+ * Points into the buffer the frame was found in (e.g. a UART DMA ring, see
+ * FrameStreamDecoder); valid only as long as that buffer. Fields are read
+ * straight from the frame bytes, so no Packet is built unless toPacket() is
+ * called.
+ */
+struct PacketView
+{
+  const uint8_t *frame = nullptr;  ///< First byte of the header.
+  size_t length = 0;               ///< HEADER_SIZE + payloadSize + CRC_SIZE.
+
+  PacketHeader header() const
+  {
+    PacketHeader header;
+    std::memcpy(&header, frame, HEADER_SIZE);
+    return header;
+  }
+
+  uint16_t messageId() const { return static_cast<uint16_t>(frame[0] | (frame[1] << 8)); }
+  uint8_t totalChunks() const { return frame[offsetof(PacketHeader, totalChunks)]; }
+  uint8_t chunkIndex() const { return frame[offsetof(PacketHeader, chunkIndex)]; }
+  uint8_t flags() const { return frame[offsetof(PacketHeader, flags)]; }
+
+  const uint8_t *payload() const { return frame + HEADER_SIZE; }
+  size_t payloadSize() const { return frame[offsetof(PacketHeader, payloadSize)]; }
+
+  /**
+   * @brief Copies the frame into a Packet (padding filled with PAYLOAD_PADDING_BYTE), e.g. for PacketReassembler.
+   */
+  Packet toPacket() const
+  {
+    Packet packet;
+    std::memcpy(&packet.header, frame, HEADER_SIZE);
+    std::memcpy(packet.payload.data, payload(), payloadSize());
+    std::memset(packet.payload.data + payloadSize(), PAYLOAD_PADDING_BYTE, LORA_MAX_PAYLOAD_SIZE - payloadSize());
+    std::memcpy(&packet.crc, frame + HEADER_SIZE + payloadSize(), CRC_SIZE);
+    return packet;
+  }
+};
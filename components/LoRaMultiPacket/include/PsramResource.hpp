@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @class PsramResource
+ * @brief std::pmr::memory_resource that allocates from external PSRAM on ESP32 targets.
+ *
+ * Memory comes from heap_caps_aligned_alloc() with MALLOC_CAP_SPIRAM. When
+ * the board has no PSRAM or it is full, the allocation falls back to
+ * internal RAM so that reassembly degrades instead of failing; such
+ * allocations are counted in fallbackAllocations(). Host builds have no
+ * PSRAM and always use the regular heap.
+ *
+ * Intended as the ReassemblerResources::largeChunks tier: message bodies are
+ * written once, sequentially per chunk, and read once on delivery, which
+ * suits the cached external RAM. Thread safe.
+ */
+class PsramResource : public std::pmr::memory_resource
+{
+ public:
+  /**
+   * @brief True when the target has PSRAM mapped into the heap.
+   */
+  static bool available();
+
+  /**
+   * @brief Allocations served by PSRAM.
+   */
+  size_t psramAllocations() const { return psramAllocations_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Allocations that fell back to internal RAM (every allocation on host builds).
+   */
+  size_t fallbackAllocations() const { return fallbackAllocations_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<size_t> psramAllocations_{0};
+  std::atomic<size_t> fallbackAllocations_{0};
+
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ITransport.hpp"
+
+/**
+ * @class RadioLibTransport
+ * @brief ITransport over a half-duplex RadioLib module (SX1262, SX1276, ...).
+ *
+ * Header-only, like RadioLibTransmitter, so the library itself does not
+ * depend on RadioLib. The radio's DIO1 interrupt (TX done or RX done) only
+ * sets a flag through onInterrupt(); poll() then reads the radio's IRQ
+ * status (PhysicalLayer::checkIrq(), RadioLib 7) to tell the two apart,
+ * finishes the transmission or reads the received frame with its RSSI and
+ * SNR, and puts the radio back in receive mode. A frame received just
+ * before startTransmit() is read out before the transmission reuses the
+ * radio's buffer, so a late RX-done can neither end the new frame early
+ * nor be lost.
+ *
+ * @code
+ * RadioLibTransport<SX1262> transport(radio);
+ * void IRAM_ATTR onDio1() { transport.onInterrupt(); }
+ * radio.setDio1Action(onDio1);
+ * transport.begin();
+ * @endcode
+ */
+namespace radiolib_detail
+{
+/**
+ * @brief Parameter type of Radio::checkIrq() (RadioLibIrqType_t), found without including RadioLib.
+ */
+template <typename Result, typename Layer, typename Irq>
+Irq irqTypeOf(Result (Layer::*)(Irq));
+}  // namespace radiolib_detail
+
+template <typename Radio>
+class RadioLibTransport : public ITransport
+{
+ public:
+  explicit RadioLibTransport(Radio &radio) : radio_(radio) {}
+
+  /**
+   * @brief Enters continuous receive mode.
+   * @return false if the radio refused.
+   */
+  bool begin() { return radio_.startReceive() == 0; }  // RADIOLIB_ERR_NONE
+
+  /**
+   * @brief DIO1 interrupt: TX done or RX done. ISR safe.
+   */
+  void onInterrupt() { interrupt_.store(true, std::memory_order_release); }
+
+  bool startTransmit(const uint8_t *frame, size_t length) override
+  {
+    if (transmitting_)
+      return false;
+
+    // An RX-done not polled yet: take its frame now, the transmission overwrites the radio's buffer.
+    if (interrupt_.exchange(false, std::memory_order_acquire) && irqSet(IRQ_RX_DONE))
+    {
+      receiveFrame(lastPollMs_);
+      if (transmitting_)
+        return false;  // The receive callback transmitted (e.g. a FrameRelay).
+    }
+    if (radio_.startTransmit(frame, length) != 0)
+      return false;
+    transmitting_ = true;
+    return true;
+  }
+
+  void finishTransmit() override
+  {
+    radio_.finishTransmit();
+    radio_.startReceive();
+  }
+
+  bool setModulation(const LoRaModulation &modulation) override
+  {
+    return radio_.setSpreadingFactor(modulation.spreadingFactor) == 0 &&
+           radio_.setBandwidth(static_cast<float>(modulation.bandwidthHz) / 1000.0f) == 0 &&
+           radio_.setCodingRate(modulation.codingRate) == 0;
+  }
+
+  void poll(uint32_t currentTimestampMs) override
+  {
+    lastPollMs_ = currentTimestampMs;
+    if (!interrupt_.exchange(false, std::memory_order_acquire))
+      return;
+
+    if (transmitting_)
+    {
+      // Only the radio knows which event raised DIO1.
+      if (irqSet(IRQ_TX_DONE))
+      {
+        transmitting_ = false;
+        transmitDone();  // Receive mode resumes in finishTransmit().
+      }
+      return;
+    }
+
+    if (irqSet(IRQ_RX_DONE))
+      receiveFrame(currentTimestampMs);
+    radio_.startReceive();
+  }
+
+ private:
+  using Irq = decltype(radiolib_detail::irqTypeOf(&Radio::checkIrq));
+  static constexpr Irq IRQ_TX_DONE = static_cast<Irq>(0);  // RADIOLIB_IRQ_TX_DONE
+  static constexpr Irq IRQ_RX_DONE = static_cast<Irq>(1);  // RADIOLIB_IRQ_RX_DONE
+
+  Radio &radio_;
+  std::atomic<bool> interrupt_{false};
+  bool transmitting_ = false;
+  uint32_t lastPollMs_ = 0;
+  uint8_t buffer_[MAX_PACKET_SIZE];
+
+  bool irqSet(Irq irq) { return radio_.checkIrq(irq) > 0; }
+
+  /**
+   * @brief Reads the frame the radio received and delivers it.
+   */
+  void receiveFrame(uint32_t currentTimestampMs)
+  {
+    size_t length = radio_.getPacketLength();
+    if (length > 0 && length <= sizeof(buffer_) && radio_.readData(buffer_, length) == 0)
+    {
+      FrameMeta meta;
+      meta.timestampMs = currentTimestampMs;
+      meta.length = static_cast<uint16_t>(length);
+      meta.rssi = radio_.getRSSI();
+      meta.snr = radio_.getSNR();
+      deliverFrame(buffer_, length, meta);
+    }
+  }
+};
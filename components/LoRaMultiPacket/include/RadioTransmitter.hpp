@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "LoRaAirtime.hpp"
+
+/**
+ * @class RadioTransmitter
+ * @brief Non-blocking transmit side of a radio, as driven by TxEngine.
+ *
+ * startTransmit() hands a frame to the radio and returns while it is on air;
+ * the end of the transmission is reported by the radio's TX-done interrupt,
+ * which the application forwards to TxEngine::onTransmitDone().
+ */
+class RadioTransmitter
+{
+ public:
+  virtual ~RadioTransmitter() = default;
+
+  /**
+   * @brief Starts transmitting a frame and returns immediately.
+   * @return false if the radio refused the frame.
+   */
+  virtual bool startTransmit(const uint8_t *frame, size_t length) = 0;
+
+  /**
+   * @brief Cleans up after a completed transmission, before the next startTransmit().
+   */
+  virtual void finishTransmit() {}
+
+  /**
+   * @brief Retunes the modem (spreading factor, bandwidth, coding rate). Called between frames.
+   * @return false if the radio does not support or refused the settings.
+   */
+  virtual bool setModulation(const LoRaModulation &modulation)
+  {
+    (void)modulation;
+    return false;
+  }
+};
+
+/**
+ * @class RadioLibTransmitter
+ * @brief RadioTransmitter over a RadioLib module (SX1262, SX1276, ...).
+ *
+ * Header-only so that the library itself does not depend on RadioLib:
+ *
+ * @code
+ * RadioLibTransmitter<SX1262> transmitter(radio);
+ * radio.setPacketSentAction(onTxDoneIsr);   // calls engine.onTransmitDone()
+ * @endcode
+ */
+template <typename Radio>
+class RadioLibTransmitter : public RadioTransmitter
+{
+ public:
+  explicit RadioLibTransmitter(Radio &radio) : radio_(radio) {}
+
+  bool startTransmit(const uint8_t *frame, size_t length) override
+  {
+    return radio_.startTransmit(frame, length) == 0;  // RADIOLIB_ERR_NONE
+  }
+
+  void finishTransmit() override { radio_.finishTransmit(); }
+
+  bool setModulation(const LoRaModulation &modulation) override
+  {
+    return radio_.setSpreadingFactor(modulation.spreadingFactor) == 0 &&
+           radio_.setBandwidth(static_cast<float>(modulation.bandwidthHz) / 1000.0f) == 0 &&
+           radio_.setCodingRate(modulation.codingRate) == 0;
+  }
+
+ private:
+  Radio &radio_;
+};
@@ -0,0 +1,337 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "Packet.hpp"
+
+/**
+ * @class JournalStorage
+ * @brief Byte-addressed persistent medium behind a ReassemblyJournal.
+ *
+ * Modelled on NOR flash: erase() sets whole erase blocks to 0xFF and
+ * write() may only clear bits of erased bytes, so the journal never
+ * rewrites a byte it has written since the last erase.
+ */
+class JournalStorage
+{
+ public:
+  virtual ~JournalStorage() = default;
+
+  /**
+   * @brief Usable bytes (0 when the storage could not be opened).
+   */
+  virtual size_t size() const = 0;
+
+  /**
+   * @brief Granularity of erase(): offsets and lengths passed to it are multiples of this.
+   */
+  virtual size_t eraseBlockSize() const = 0;
+
+  virtual bool read(size_t offset, void *data, size_t length) const = 0;
+  virtual bool write(size_t offset, const void *data, size_t length) = 0;
+
+  /**
+   * @brief Sets [offset, offset + length) to 0xFF.
+   */
+  virtual bool erase(size_t offset, size_t length) = 0;
+
+  /**
+   * @brief Pushes written bytes to the medium (no-op where writes are immediate).
+   */
+  virtual void sync() {}
+};
+
+/**
+ * @class MmapJournalStorage
+ * @brief JournalStorage in a file mapped with mmap() (POSIX hosts).
+ *
+ * Writes land in the page cache, so they survive a crash or restart of the
+ * process immediately; sync() (msync) bounds what a power failure can lose.
+ * Not available on ESP32: open() returns false.
+ */
+class MmapJournalStorage : public JournalStorage
+{
+ public:
+  MmapJournalStorage() = default;
+  ~MmapJournalStorage() override;
+
+  MmapJournalStorage(const MmapJournalStorage &) = delete;
+  MmapJournalStorage &operator=(const MmapJournalStorage &) = delete;
+
+  /**
+   * @brief Opens (or creates, filled with 0xFF) a journal file of 'size' bytes.
+   *
+   * An existing file keeps its content; a shorter one is extended with 0xFF bytes.
+   */
+  bool open(const char *path, size_t size);
+  void close();
+
+  size_t size() const override { return size_; }
+  size_t eraseBlockSize() const override { return 4096; }
+  bool read(size_t offset, void *data, size_t length) const override;
+  bool write(size_t offset, const void *data, size_t length) override;
+  bool erase(size_t offset, size_t length) override;
+  void sync() override;
+
+ private:
+  uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * @class PartitionJournalStorage
+ * @brief JournalStorage in a data partition of the ESP32's SPI flash.
+ *
+ * Add a partition to the table, e.g.
+ * `journal, data, 0x40, , 256K` (subtype 0x40 is free for applications),
+ * and open it by label. Writes go straight to flash. Host builds have no
+ * partitions: open() returns false.
+ */
+class PartitionJournalStorage : public JournalStorage
+{
+ public:
+  /**
+   * @brief Finds the data partition labelled 'label'.
+   */
+  bool open(const char *label);
+
+  size_t size() const override { return size_; }
+  size_t eraseBlockSize() const override { return eraseBlockSize_; }
+  bool read(size_t offset, void *data, size_t length) const override;
+  bool write(size_t offset, const void *data, size_t length) override;
+  bool erase(size_t offset, size_t length) override;
+
+ private:
+  const void *partition_ = nullptr;  ///< esp_partition_t
+  size_t size_ = 0;
+  size_t eraseBlockSize_ = 4096;
+};
+
+/**
+ * @class ReassemblyJournal
+ * @brief Persists partially received messages, chunk by chunk, so that reassembly survives a restart.
+ *
+ * The storage is divided into fixed slots of whole erase blocks, one per
+ * message being reassembled. Each slot holds (little endian):
+ *
+ * ```
+ * [0..3]   state: 0xFFFFFFFF free, SLOT_ACTIVE, 0 retired
+ * [4..7]   sourceId  [8..9] messageId  [10..11] totalChunks  [12..15] 0xFF
+ * [16..]   uint16 payload size of every chunk, 0xFFFF while missing
+ * [..]     payloads, chunk i at payloadOffset + i * chunkStride
+ * ```
+ *
+ * Every byte is written at most once between two erases, and always in an
+ * order that commits it last: the slot header before its state, a payload
+ * before its size entry. An interrupted write thus leaves at worst a chunk
+ * that is still missing. open() only takes blank slots; retired ones are
+ * erased by maintain(), to be called from an idle task: erasing a slot
+ * takes a flash sector erase per erase block (hundreds of ms for a 64 KB
+ * slot on the ESP32), which must stay off the receive path.
+ *
+ * Used through BasicPacketReassembler::attachJournal(), from the task
+ * receiving frames. maintain() may run on another task at the same time;
+ * nothing else is thread safe.
+ */
+class ReassemblyJournal
+{
+ public:
+  /**
+   * @brief A message found in the journal.
+   */
+  struct Record
+  {
+    size_t slot = 0;
+    uint32_t sourceId = 0;
+    uint16_t messageId = 0;
+    uint16_t totalChunks = 0;
+  };
+
+  static constexpr uint32_t SLOT_ACTIVE = 0x4C4D504Au;
+  static constexpr uint16_t MISSING = 0xFFFF;
+
+  /**
+   * @param storage Persistent medium. Must outlive the journal.
+   * @param chunkStride Largest chunk payload (the reassembler profile's MAX_PAYLOAD_SIZE).
+   * @param maxChunks Largest number of chunks of a journaled message.
+   */
+  explicit ReassemblyJournal(JournalStorage &storage, size_t chunkStride = LORA_MAX_PAYLOAD_SIZE,
+                             size_t maxChunks = DefaultProfile::MAX_CHUNKS);
+
+  /**
+   * @brief Messages the journal can hold at once (0 if the storage is too small for one slot).
+   */
+  size_t slotCount() const { return slotCount_; }
+
+  size_t slotSize() const { return slotSize_; }
+  size_t chunkStride() const { return chunkStride_; }
+  size_t maxChunks() const { return maxChunks_; }
+
+  /**
+   * @brief Messages currently journaled.
+   */
+  size_t activeSlots() const;
+
+  /**
+   * @brief Slots waiting for maintain() before they can be reused.
+   */
+  size_t retiredSlots() const;
+
+  /**
+   * @brief Every message currently journaled (after a restart: the ones interrupted).
+   */
+  std::vector<Record> records() const;
+
+  /**
+   * @brief Payload size of a journaled chunk, std::nullopt if it is missing.
+   */
+  std::optional<uint16_t> chunkSize(size_t slot, size_t chunkIndex) const;
+
+  /**
+   * @brief Reads 'size' payload bytes of a journaled chunk into 'output'.
+   */
+  bool readChunk(size_t slot, size_t chunkIndex, uint8_t *output, size_t size) const;
+
+  /**
+   * @brief Starts journaling a message.
+   * @return Its slot, std::nullopt if no slot is blank (see maintain()), the
+   * message has too many chunks or the storage failed. Never erases.
+   */
+  std::optional<size_t> open(uint32_t sourceId, uint16_t messageId, uint16_t totalChunks);
+
+  /**
+   * @brief Journals one chunk of the message in 'slot' (written once: a chunk already journaled is kept).
+   */
+  bool append(size_t slot, size_t chunkIndex, const uint8_t *payload, uint16_t size);
+
+  /**
+   * @brief Ends journaling of the message in 'slot' (completed or dropped).
+   */
+  void retire(size_t slot);
+
+  /**
+   * @brief Erases up to 'maxSlots' retired slots, making them blank for open().
+   *
+   * Blocks for the flash erases: call it from an idle or low-priority task,
+   * never from the one receiving frames.
+   *
+   * @return Slots erased.
+   */
+  size_t maintain(size_t maxSlots = SIZE_MAX);
+
+  /**
+   * @brief Flushes the storage (see JournalStorage::sync()).
+   */
+  void sync() { storage_.sync(); }
+
+  /**
+   * @brief Storage reads / writes / erases that failed.
+   */
+  uint64_t storageErrors() const { return storageErrors_.load(std::memory_order_relaxed); }
+
+ private:
+  enum class SlotState : uint8_t
+  {
+    Free,     ///< Erased, ready for open().
+    Active,
+    Retired,  ///< Needs an erase (maintain()) before reuse.
+    Erasing,  ///< Being erased by maintain().
+  };
+
+  static constexpr size_t SLOT_HEADER_SIZE = 16;
+
+  JournalStorage &storage_;
+  size_t chunkStride_;
+  size_t maxChunks_;
+  size_t payloadOffset_;
+  size_t slotSize_;
+  size_t slotCount_;
+  mutable std::mutex mutex_;  ///< Guards states_ against maintain().
+  std::vector<SlotState> states_;
+  std::atomic<uint64_t> storageErrors_{0};
+
+  size_t slotOffset(size_t slot) const { return slot * slotSize_; }
+  size_t sizeEntryOffset(size_t slot, size_t chunkIndex) const { return slotOffset(slot) + SLOT_HEADER_SIZE + 2 * chunkIndex; }
+
+  /**
+   * @brief Writes to the storage, counting failures.
+   */
+  bool writeAt(size_t offset, const void *data, size_t length);
+
+  /**
+   * @brief Erases a slot, last block first so that its state word goes last.
+   */
+  bool eraseSlot(size_t slot);
+
+  SlotState state(size_t slot) const;
+  void setState(size_t slot, SlotState state);
+
+  /**
+   * @brief True if a slot marked free really is blank (no interrupted open()).
+   */
+  bool headerErased(size_t slot) const;
+};
+
+/**
+ * @class ChunkRequest
+ * @brief Asks the sender of a message for the chunks the receiver is missing.
+ *
+ * Single-chunk control frame (PACKET_FLAG_CONTROL, LinkAnnouncement::MESSAGE_ID)
+ * sent, typically, for each message restored from a ReassemblyJournal after
+ * a restart. Payload layout (little endian):
+ *   [0] 'R'  [1..2] messageId  [3] totalChunks  [4] firstChunk  [5..] missing-chunk bitmap,
+ *   bit (i % 8) of byte i / 8 set if chunk firstChunk + i is missing
+ *
+ * The bitmap covers chunkCount chunks from firstChunk on, so a request too
+ * large for the transport's frames is sent as several, each covering a
+ * range of the message (see maxChunksFor()). The sender answers each with
+ * TxEngine::resendChunks() (LinkEndpoint does so).
+ *
+ * Requests carry no address: every sender in range that retains a message
+ * with this ID answers. Senders check totalChunks too, but two senders
+ * retaining same-sized messages under the same ID both resend, and on
+ * transports without a source identity the receiver cannot tell them apart.
+ */
+struct ChunkRequest
+{
+  static constexpr uint8_t TYPE = 'R';
+  static constexpr size_t BITMAP_OFFSET = 5;
+  static constexpr size_t MAX_SIZE = BITMAP_OFFSET + (DefaultProfile::MAX_CHUNKS + 7) / 8;
+
+  uint16_t messageId = 0;
+  uint8_t totalChunks = 0;
+  uint8_t firstChunk = 0;   ///< First chunk covered by the bitmap.
+  uint16_t chunkCount = 0;  ///< Chunks covered by the bitmap (0: up to totalChunks).
+  ChunkSet missing;         ///< Missing chunks, by index in the message.
+
+  /**
+   * @brief Chunks covered by the bitmap.
+   */
+  size_t coveredChunks() const;
+
+  /**
+   * @brief Payload bytes of the encoded request.
+   */
+  size_t encodedSize() const { return BITMAP_OFFSET + (coveredChunks() + 7) / 8; }
+
+  /**
+   * @brief Writes encodedSize() bytes to 'out'.
+   */
+  void encode(uint8_t *out) const;
+
+  /**
+   * @brief Most chunks one request can cover in a payload of 'maxPayloadSize' bytes (0 if none).
+   */
+  static size_t maxChunksFor(size_t maxPayloadSize);
+
+  /**
+   * @brief Decodes a request.
+   * @return std::nullopt if 'packet' is not a valid chunk request.
+   */
+  static std::optional<ChunkRequest> decode(const Packet &packet);
+};
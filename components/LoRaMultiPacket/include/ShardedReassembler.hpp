@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "MpscQueue.hpp"
+#include "Packet.hpp"
+#include "PacketReassembler.hpp"
+
+/**
+ * @struct ShardedReassemblerConfig
+ * @brief Sizing of a ShardedReassembler.
+ */
+struct ShardedReassemblerConfig
+{
+  size_t shardCount = 1;          ///< Number of worker threads / session tables.
+  size_t queueCapacity = 4096;    ///< Ingress frames buffered per shard.
+  uint32_t pruneIntervalMs = 1000;  ///< How often (in frame time) each shard calls pruneStalled().
+
+  /**
+   * @brief Configuration of each shard's PacketReassembler.
+   * A gateway tracks many transmitters at once, hence the larger session table.
+   */
+  ReassemblerConfig reassembler = []
+  {
+    ReassemblerConfig config;
+    config.maxConcurrentMessages = 1024;
+    return config;
+  }();
+};
+
+/**
+ * @class ShardedReassembler
+ * @brief Multi-threaded, multi-source reassembly engine for host gateways.
+ *
+ * Raw frames are routed by a hash of (sourceId, messageId) to one of N
+ * shards. Each shard owns a lock-free MPSC ingress queue, a worker thread
+ * and a private PacketReassembler, so all chunks of a message are handled by
+ * the same thread and no session state is shared between cores.
+ *
+ * The worker parses and validates the frame (PacketParser), reassembles it
+ * and invokes the completion callback on the worker thread. The callback
+ * must therefore be thread safe when more than one shard is configured.
+ *
+ * **Threading:** submit() may be called concurrently from any number of
+ * ingest threads. start()/stop() must be called from a single owner thread.
+ */
+class ShardedReassembler
+{
+ public:
+  /**
+   * @brief Called for every completed message, on the owning shard's worker thread.
+   */
+  using MessageCallback = std::function<void(uint32_t sourceId, uint16_t messageId, std::vector<uint8_t> &&message)>;
+
+  /**
+   * @brief Per-engine counters, aggregated over all shards.
+   */
+  struct Stats
+  {
+    uint64_t framesSubmitted = 0;  ///< Frames accepted by submit().
+    uint64_t framesDropped = 0;    ///< Frames refused because a shard queue was full.
+    uint64_t framesRejected = 0;   ///< Frames that failed parsing/validation.
+    uint64_t messagesCompleted = 0;
+  };
+
+  ShardedReassembler(const ShardedReassemblerConfig &config, MessageCallback onMessage);
+  ~ShardedReassembler();
+
+  ShardedReassembler(const ShardedReassembler &) = delete;
+  ShardedReassembler &operator=(const ShardedReassembler &) = delete;
+
+  /**
+   * @brief Spawns one worker thread per shard.
+   */
+  void start();
+
+  /**
+   * @brief Processes every frame already submitted, then joins the workers.
+   */
+  void stop();
+
+  /**
+   * @brief Routes a raw frame to its shard.
+   *
+   * The frame is copied into the shard's ingress queue; the caller's buffer
+   * can be reused immediately.
+   *
+   * @param sourceId Identity of the transmitter (or gateway) the frame came from.
+   * @param frame Raw frame bytes as received from the radio.
+   * @param length Frame length in bytes.
+   * @param timestampMs Reception time.
+   * @return false if the frame was dropped (invalid length or shard queue full).
+   */
+  bool submit(uint32_t sourceId, const uint8_t *frame, size_t length, uint32_t timestampMs);
+
+  /**
+   * @brief Blocks until every submitted frame has been processed.
+   */
+  void flush() const;
+
+  /**
+   * @brief Returns the shard a (sourceId, messageId) pair is routed to.
+   */
+  size_t shardFor(uint32_t sourceId, uint16_t messageId) const;
+
+  Stats stats() const;
+
+ private:
+  struct IngressFrame
+  {
+    uint32_t sourceId;
+    uint32_t timestampMs;
+    uint16_t length;
+    uint8_t bytes[MAX_PACKET_SIZE];
+  };
+
+  struct Shard
+  {
+    explicit Shard(const ShardedReassemblerConfig &config)
+        : queue(config.queueCapacity), reassembler(config.reassembler)
+    {
+    }
+
+    MpscQueue<IngressFrame> queue;
+    PacketReassembler reassembler;  ///< Only touched by the worker thread.
+    std::thread worker;
+    uint32_t lastPruneMs = 0;
+
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> processed{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> rejected{0};
+    std::atomic<uint64_t> completed{0};
+  };
+
+  ShardedReassemblerConfig config_;
+  MessageCallback onMessage_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<bool> running_{false};
+
+  void workerLoop(Shard &shard);
+  void handleFrame(Shard &shard, const IngressFrame &frame);
+};
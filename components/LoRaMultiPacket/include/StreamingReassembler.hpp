@@ -0,0 +1,393 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Packet.hpp"
+
+/**
+ * @struct StreamingReassemblerConfig
+ * @brief Sizing of a StreamingReassembler.
+ */
+struct StreamingReassemblerConfig
+{
+  /**
+   * @brief Chunks buffered per message ahead of the next in-order one
+   * (the reordering the link may introduce). Chunks further ahead are dropped.
+   */
+  size_t windowChunks = 16;
+
+  /**
+   * @brief Messages streamed in parallel. New messages are discarded while all slots are busy.
+   */
+  size_t maxConcurrentMessages = 4;
+};
+
+/**
+ * @class BasicStreamingReassembler
+ * @brief Reassembles messages as in-order byte streams instead of whole buffers.
+ *
+ * Instead of returning a message once all its chunks have arrived, the data
+ * callback is invoked with every byte range that becomes contiguous with
+ * what was already delivered: an in-order chunk is passed on immediately,
+ * straight from the packet, and a chunk that fills a gap releases the run of
+ * buffered chunks behind it in one call. Consumers can write to flash or
+ * forward downstream while the transfer is running, and memory is bounded by
+ * the out-of-order window (windowChunks chunks per message, allocated once
+ * at construction) rather than by the message size.
+ *
+ * A chunk that never arrives stalls its stream: prune() then ends the
+ * session and reports through the abort callback how many bytes were
+ * delivered. Chunk size rules are those of PacketReassembler. A free slot
+ * remembers the message it last completed until it is reused, so late
+ * duplicates of that message do not start a new stream.
+ *
+ * @tparam Profile Frame geometry (see ProtocolProfile).
+ */
+template <typename Profile>
+class BasicStreamingReassembler
+{
+ public:
+  using PacketType = BasicPacket<Profile>;
+
+  /**
+   * @brief Receives the next 'length' bytes of a message, starting at byte 'offset'.
+   * 'complete' is set on the message's last range. 'data' is only valid during the call.
+   */
+  using DataCallback = std::function<void(uint32_t sourceId, uint16_t messageId, size_t offset, const uint8_t *data,
+                                          size_t length, bool complete)>;
+
+  /**
+   * @brief Reports a session ended by prune() after 'deliveredBytes' bytes.
+   */
+  using AbortCallback = std::function<void(uint32_t sourceId, uint16_t messageId, size_t deliveredBytes)>;
+
+  /**
+   * @brief Reassembler counters.
+   */
+  struct Stats
+  {
+    uint64_t messagesCompleted = 0;
+    uint64_t messagesAborted = 0;     ///< Sessions ended by prune().
+    uint64_t messagesDiscarded = 0;   ///< New messages refused because every slot was busy.
+    uint64_t bytesDelivered = 0;
+    uint64_t chunksOutOfWindow = 0;   ///< Chunks too far ahead of the stream, dropped.
+    uint64_t chunksRejected = 0;      ///< Chunks disagreeing with their session's geometry.
+    uint64_t chunksDuplicate = 0;
+    uint64_t controlFrames = 0;       ///< PACKET_FLAG_CONTROL frames, ignored (link management).
+  };
+
+  explicit BasicStreamingReassembler(const StreamingReassemblerConfig &config, DataCallback onData,
+                                     AbortCallback onAbort = AbortCallback())
+      : window_(config.windowChunks > 0 ? config.windowChunks : 1),
+        onData_(std::move(onData)),
+        onAbort_(std::move(onAbort)),
+        sessions_(config.maxConcurrentMessages)
+  {
+    for (Session &session : sessions_)
+    {
+      session.ring.reset(new uint8_t[window_ * Profile::MAX_PAYLOAD_SIZE]);
+      session.present.assign(window_, false);
+    }
+  }
+
+  BasicStreamingReassembler(const BasicStreamingReassembler &) = delete;
+  BasicStreamingReassembler &operator=(const BasicStreamingReassembler &) = delete;
+
+  /**
+   * @brief Processes a validated packet, invoking the data callback for any range it releases.
+   *
+   * @param packet The valid packet received from the network.
+   * @param currentTimestampMs Reception time (prune() measures inactivity from it).
+   * @param sourceId Identity of the transmitter the packet was received from.
+   * @return false if the packet was dropped (control frame, duplicate, out of window, bad geometry, no free slot).
+   */
+  bool processPacket(const PacketType &packet, uint32_t currentTimestampMs, uint32_t sourceId = 0)
+  {
+    const auto &header = packet.header;
+    if ((header.flags & PACKET_FLAG_CONTROL) != 0)
+    {
+      stats_.controlFrames++;
+      return false;
+    }
+    size_t total = header.totalChunks;
+    size_t index = header.chunkIndex;
+    size_t size = header.payloadSize;
+    bool isFinal = index + 1 == total;
+
+    Session *session = find(sourceId, header.messageId);
+    if (session == nullptr)
+    {
+      if (recentlyCompleted(sourceId, header.messageId))
+      {
+        stats_.chunksDuplicate++;
+        return false;
+      }
+      if (total == 1)
+      {
+        deliver(sourceId, header.messageId, 0, packet.payload.data, size, true);
+        stats_.messagesCompleted++;
+        return true;
+      }
+      session = start(sourceId, header.messageId, total);
+      if (session == nullptr)
+      {
+        stats_.messagesDiscarded++;
+        return false;
+      }
+    }
+
+    if (total != session->totalChunks || !acceptSize(*session, size, isFinal))
+    {
+      stats_.chunksRejected++;
+      return false;
+    }
+    if (index < session->nextIndex)
+    {
+      stats_.chunksDuplicate++;
+      return false;
+    }
+    session->lastActivityMs = currentTimestampMs;
+
+    if (index == session->nextIndex)
+    {
+      // In order: passed on straight from the packet.
+      deliver(sourceId, header.messageId, session->deliveredBytes, packet.payload.data, size, isFinal);
+      session->deliveredBytes += size;
+      session->nextIndex++;
+      if (isFinal)
+      {
+        finish(*session);
+        return true;
+      }
+      drain(*session);
+      return true;
+    }
+
+    if (isFinal)
+    {
+      if (session->tailPresent)
+      {
+        stats_.chunksDuplicate++;
+        return false;
+      }
+      std::memcpy(session->tail, packet.payload.data, size);
+      session->tailSize = size;
+      session->tailPresent = true;
+      return true;
+    }
+
+    if (index >= session->nextIndex + window_)
+    {
+      stats_.chunksOutOfWindow++;
+      return false;
+    }
+    size_t slot = index % window_;
+    if (session->present[slot])
+    {
+      stats_.chunksDuplicate++;
+      return false;
+    }
+    std::memcpy(session->ring.get() + slot * session->chunkSize, packet.payload.data, size);
+    session->present[slot] = true;
+    return true;
+  }
+
+  /**
+   * @brief Ends sessions that received nothing for more than 'idleTimeoutMs' (reported to the abort callback).
+   * @return Number of sessions ended.
+   */
+  size_t prune(uint32_t currentTimestampMs, uint32_t idleTimeoutMs)
+  {
+    size_t removed = 0;
+    for (Session &session : sessions_)
+    {
+      if (!session.active || currentTimestampMs - session.lastActivityMs <= idleTimeoutMs)
+        continue;
+      session.active = false;
+      stats_.messagesAborted++;
+      removed++;
+      if (onAbort_)
+        onAbort_(session.sourceId, session.messageId, session.deliveredBytes);
+    }
+    return removed;
+  }
+
+  /**
+   * @brief Returns the number of messages currently being streamed.
+   */
+  size_t pendingSessions() const
+  {
+    size_t count = 0;
+    for (const Session &session : sessions_)
+      count += session.active ? 1 : 0;
+    return count;
+  }
+
+  /**
+   * @brief Chunks currently held out of order, over all sessions.
+   */
+  size_t bufferedChunks() const
+  {
+    size_t count = 0;
+    for (const Session &session : sessions_)
+    {
+      if (!session.active)
+        continue;
+      for (bool present : session.present)
+        count += present ? 1 : 0;
+      count += session.tailPresent ? 1 : 0;
+    }
+    return count;
+  }
+
+  const Stats &stats() const { return stats_; }
+
+  /**
+   * @brief Ends every session without invoking the abort callback.
+   */
+  void reset()
+  {
+    for (Session &session : sessions_)
+    {
+      session.active = false;
+      session.completed = false;
+    }
+  }
+
+ private:
+  struct Session
+  {
+    bool active = false;
+    bool completed = false;  ///< Free slot whose last message completed: late duplicates are ignored.
+    uint32_t sourceId = 0;
+    uint16_t messageId = 0;
+    uint32_t lastActivityMs = 0;
+    size_t totalChunks = 0;
+    size_t chunkSize = 0;  ///< Fixed by the first non-final chunk, 0 until then.
+    size_t nextIndex = 0;  ///< First chunk not yet delivered.
+    size_t deliveredBytes = 0;
+    std::unique_ptr<uint8_t[]> ring;  ///< windowChunks slots of chunkSize bytes, slot = index % windowChunks.
+    std::vector<bool> present;
+    uint8_t tail[Profile::MAX_PAYLOAD_SIZE];  ///< Final chunk, kept apart: it may be shorter.
+    size_t tailSize = 0;
+    bool tailPresent = false;
+  };
+
+  size_t window_;
+  DataCallback onData_;
+  AbortCallback onAbort_;
+  std::vector<Session> sessions_;
+  Stats stats_;
+
+  Session *find(uint32_t sourceId, uint16_t messageId)
+  {
+    for (Session &session : sessions_)
+    {
+      if (session.active && session.sourceId == sourceId && session.messageId == messageId)
+        return &session;
+    }
+    return nullptr;
+  }
+
+  Session *start(uint32_t sourceId, uint16_t messageId, size_t totalChunks)
+  {
+    for (Session &session : sessions_)
+    {
+      if (session.active)
+        continue;
+      session.active = true;
+      session.completed = false;
+      session.sourceId = sourceId;
+      session.messageId = messageId;
+      session.totalChunks = totalChunks;
+      session.chunkSize = 0;
+      session.nextIndex = 0;
+      session.deliveredBytes = 0;
+      session.present.assign(window_, false);
+      session.tailPresent = false;
+      return &session;
+    }
+    return nullptr;
+  }
+
+  bool acceptSize(Session &session, size_t size, bool isFinal)
+  {
+    if (isFinal)
+      return session.chunkSize == 0 || size <= session.chunkSize;
+    if (session.chunkSize == 0)
+    {
+      if (session.tailPresent && session.tailSize > size)
+        return false;
+      session.chunkSize = size;
+    }
+    return size == session.chunkSize;
+  }
+
+  void deliver(uint32_t sourceId, uint16_t messageId, size_t offset, const uint8_t *data, size_t length, bool complete)
+  {
+    stats_.bytesDelivered += length;
+    if (onData_)
+      onData_(sourceId, messageId, offset, data, length, complete);
+  }
+
+  /**
+   * @brief Delivers the buffered chunks that have become contiguous, one call per run of adjacent slots.
+   */
+  void drain(Session &session)
+  {
+    size_t finalIndex = session.totalChunks - 1;
+    while (session.nextIndex < finalIndex)
+    {
+      size_t first = session.nextIndex % window_;
+      size_t count = 0;
+      while (session.nextIndex + count < finalIndex && first + count < window_ && session.present[first + count])
+      {
+        session.present[first + count] = false;
+        count++;
+      }
+      if (count == 0)
+        return;
+
+      size_t length = count * session.chunkSize;
+      deliver(session.sourceId, session.messageId, session.deliveredBytes,
+              session.ring.get() + first * session.chunkSize, length, false);
+      session.deliveredBytes += length;
+      session.nextIndex += count;
+    }
+
+    if (session.tailPresent)
+    {
+      deliver(session.sourceId, session.messageId, session.deliveredBytes, session.tail, session.tailSize, true);
+      session.deliveredBytes += session.tailSize;
+      finish(session);
+    }
+  }
+
+  bool recentlyCompleted(uint32_t sourceId, uint16_t messageId) const
+  {
+    for (const Session &session : sessions_)
+    {
+      if (session.completed && session.sourceId == sourceId && session.messageId == messageId)
+        return true;
+    }
+    return false;
+  }
+
+  void finish(Session &session)
+  {
+    session.active = false;
+    session.completed = true;
+    stats_.messagesCompleted++;
+  }
+};
+
+/**
+ * @brief Streaming reassembler of the default profile.
+ */
+using StreamingReassembler = BasicStreamingReassembler<DefaultProfile>;
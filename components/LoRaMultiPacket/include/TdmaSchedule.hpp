@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "LoRaAirtime.hpp"
+#include "Packet.hpp"
+
+/**
+ * @struct TdmaConfig
+ * @brief Slot plan of a node sharing a channel by time division.
+ *
+ * Every node of the network must use the same slotCount and slot length
+ * (slotMs, or the same modulation / framesPerSlot / guardMs when it is
+ * derived); each node owns a disjoint set of slots.
+ */
+struct TdmaConfig
+{
+  uint8_t slotCount = 4;  ///< Slots per superframe, 1..32.
+  uint32_t slotMask = 1;  ///< Slots owned by this node (bit i = slot i).
+
+  /**
+   * @brief Full frames that fit in one slot when slotMs is derived from the airtime.
+   */
+  uint8_t framesPerSlot = 1;
+
+  /**
+   * @brief Idle time left at the end of every slot: absorbs clock error
+   * between nodes and the radio turnaround. No frame may end inside it.
+   */
+  uint32_t guardMs = 10;
+
+  /**
+   * @brief Slot length. 0: framesPerSlot times the time on air of a
+   * MAX_TX_PACKET_SIZE frame, plus guardMs, at the modulation given at
+   * construction. The length never changes afterwards (every node must
+   * agree on it): with link adaptation, set it explicitly, sized for the
+   * most robust rung (TxEngine refuses link profiles whose frames would not
+   * fit).
+   */
+  uint32_t slotMs = 0;
+
+  /**
+   * @brief Beacon period of the network's time master. 0: this node follows
+   * beacons (or is synchronized by the application, e.g. from GNSS time).
+   */
+  uint32_t beaconIntervalMs = 0;
+
+  /**
+   * @brief A follower stops transmitting this long after its last
+   * synchronization, as its clock may have drifted out of its slots. 0: never.
+   */
+  uint32_t holdoverMs = 60000;
+};
+
+/**
+ * @class TdmaBeacon
+ * @brief In-band time reference of a TDMA network.
+ *
+ * Single-chunk control frame (PACKET_FLAG_CONTROL, LinkAnnouncement::MESSAGE_ID)
+ * sent by the time master. Payload layout (little endian):
+ *   [0] 'T'  [1..4] network time (ms) at the start of the transmission
+ */
+class TdmaBeacon
+{
+ public:
+  static constexpr size_t SIZE = 5;
+  static constexpr uint8_t TYPE = 'T';
+
+  static void encode(uint32_t networkTimeMs, uint8_t *out);
+
+  /**
+   * @brief Decodes a beacon.
+   * @return The network time it carries, std::nullopt if 'packet' is not a beacon.
+   */
+  static std::optional<uint32_t> decode(const Packet &packet);
+};
+
+/**
+ * @class TdmaSchedule
+ * @brief Decides when this node may transmit on a time-divided channel.
+ *
+ * The network time is divided into superframes of slotCount slots. A
+ * frame may start only in a slot the node owns, and only if its time on air
+ * ends guardMs before the end of the slot; otherwise it waits for the next
+ * owned slot. A frame too long for any slot never goes out (fitsSlot()):
+ * it would run into the next node's slot. Whole multi-chunk
+ * messages therefore go out in the node's slots without colliding with the
+ * other nodes, where unsynchronized (ALOHA) senders lose a message whenever
+ * any one of its chunks overlaps another transmission.
+ *
+ * Network time is the local clock plus an offset. The time master
+ * (beaconIntervalMs > 0) is its own reference and broadcasts TdmaBeacons;
+ * followers synchronize on each beacon received (onBeacon()) or on an
+ * external reference such as GNSS time (synchronize()), and do not transmit
+ * until they are synchronized. All nodes see the 32-bit network time wrap at
+ * the same instant, so slots stay aligned across it.
+ *
+ * Time is passed in explicitly (milliseconds, wrap-safe). Not thread safe:
+ * owned by the TX task (see TxEngineConfig::tdma).
+ */
+class TdmaSchedule
+{
+ public:
+  /**
+   * @param modulation Modem settings, used to derive the slot length and the beacon's time on air.
+   */
+  explicit TdmaSchedule(const TdmaConfig &config, const LoRaModulation &modulation = LoRaModulation());
+
+  /**
+   * @brief Sets the network time to 'networkTimeMs' at local time 'currentTimestampMs'.
+   */
+  void synchronize(uint32_t currentTimestampMs, uint32_t networkTimeMs);
+
+  /**
+   * @brief Synchronizes on a received beacon (ignored by the time master).
+   *
+   * @param currentTimestampMs Reception time, taken at the end of the frame (RX done).
+   * @param frameLength Length of the received frame, to add its time on air.
+   * @return true if 'packet' was a beacon.
+   */
+  bool onBeacon(const Packet &packet, uint32_t currentTimestampMs, size_t frameLength);
+
+  /**
+   * @brief True when the node may use its slots.
+   */
+  bool synchronized(uint32_t currentTimestampMs) const;
+
+  uint32_t networkTimeMs(uint32_t currentTimestampMs) const { return currentTimestampMs + offsetMs_; }
+
+  /**
+   * @brief Slot the network is in at 'currentTimestampMs'.
+   */
+  uint8_t slotAt(uint32_t currentTimestampMs) const;
+
+  bool ownsSlot(uint8_t slot) const { return slot < config_.slotCount && (config_.slotMask >> slot) & 1u; }
+
+  /**
+   * @brief True if a frame of 'airtimeUs' fits in one slot, guard time included.
+   */
+  bool fitsSlot(uint32_t airtimeUs) const;
+
+  /**
+   * @brief Milliseconds until a frame of 'airtimeUs' may start (0: now).
+   * Unsynchronized followers get one slot length, to check again later.
+   * UINT32_MAX if the frame can never start (see fitsSlot()).
+   */
+  uint32_t waitTimeMs(uint32_t airtimeUs, uint32_t currentTimestampMs) const;
+
+  /**
+   * @brief Modem settings now in use, for the beacons' time on air (the slot length is kept).
+   */
+  void setModulation(const LoRaModulation &modulation) { modulation_ = modulation; }
+
+  /**
+   * @brief True when the time master should queue its next beacon.
+   */
+  bool beaconDue(uint32_t currentTimestampMs) const;
+
+  /**
+   * @brief Records that a beacon was queued at 'currentTimestampMs'.
+   */
+  void beaconQueued(uint32_t currentTimestampMs);
+
+  bool timeMaster() const { return config_.beaconIntervalMs > 0; }
+  uint32_t slotMs() const { return slotMs_; }
+  uint32_t superframeMs() const { return slotMs_ * config_.slotCount; }
+  uint64_t synchronizations() const { return synchronizations_; }
+  const TdmaConfig &config() const { return config_; }
+
+ private:
+  TdmaConfig config_;
+  LoRaModulation modulation_;
+  uint32_t slotMs_;
+  uint32_t offsetMs_ = 0;
+  bool synced_ = false;
+  uint32_t lastSyncMs_ = 0;
+  std::optional<uint32_t> lastBeaconMs_;
+  uint64_t synchronizations_ = 0;
+};
@@ -0,0 +1,343 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "AirtimeBudget.hpp"
+#include "LinkAdaptation.hpp"
+#include "LoRaAirtime.hpp"
+#include "MpscQueue.hpp"
+#include "Packet.hpp"
+#include "RadioTransmitter.hpp"
+#include "TdmaSchedule.hpp"
+#include "TxScheduler.hpp"
+
+/**
+ * @struct TxEngineConfig
+ * @brief Sizing of a TxEngine.
+ */
+struct TxEngineConfig
+{
+  size_t queueCapacity = 8;      ///< Messages handed over by enqueue() (rounded up to a power of two).
+  size_t maxActiveMessages = 8;  ///< Messages interleaved by the TxScheduler at once.
+
+  /**
+   * @brief Modem settings, used to compute the airtime of each frame.
+   */
+  LoRaModulation modulation;
+
+  /**
+   * @brief Duty-cycle limit. std::nullopt: frames are sent as soon as the radio is free.
+   */
+  std::optional<AirtimeBudgetConfig> airtimeBudget;
+
+  /**
+   * @brief Airtime (us) kept for Critical messages: other frames are held
+   * back rather than leave less than this in the budget.
+   */
+  uint64_t criticalReserveUs = 0;
+
+  /**
+   * @brief Copies of each LinkAnnouncement sent before a link change takes effect.
+   */
+  size_t linkAnnouncementRepeats = 2;
+
+  /**
+   * @brief Sends compact frames (PacketSerializer::serializeCompact()): a chunk
+   * is on air only as long as its payload, so smaller chunk sizes shorten
+   * frames. Every receiver must use BasicPacketParser::parse() or parseBatch().
+   * false: every frame is MAX_TX_PACKET_SIZE bytes, padding included.
+   */
+  bool compactFrames = false;
+
+  /**
+   * @brief Time-division slot plan. std::nullopt: frames go out whenever the radio is free (ALOHA).
+   */
+  std::optional<TdmaConfig> tdma;
+
+  /**
+   * @brief Most recently admitted messages kept, as copies, so that
+   * resendChunks() can send part of them again. 0: none.
+   */
+  size_t retainedMessages = 0;
+
+  /**
+   * @brief Consecutive startTransmit() refusals after which the staged frame
+   * is dropped (Stats::framesDropped) so that the frames behind it still go
+   * out. 0: retry forever.
+   */
+  size_t maxTransmitAttempts = 16;
+};
+
+/**
+ * @class TxEngine
+ * @brief Asynchronous, double-buffered transmit path.
+ *
+ * Messages are queued by enqueue() and sent chunk by chunk, in the order
+ * chosen by a TxScheduler (priority classes, deadlines, round-robin). Two frame
+ * buffers alternate: while frame N is on air from one buffer, poll()
+ * serializes frame N+1 (header, payload, CRC) into the other, so that when
+ * the TX-done interrupt arrives the next startTransmit() is issued
+ * immediately and the inter-frame gap is only the radio's turnaround time.
+ * A staged frame is re-picked only when it must give way (its message
+ * expired or a higher priority message arrived), so preemption costs one
+ * extra serialization and never delays the frame on air.
+ *
+ * With an airtime budget configured, each frame is charged its time on air
+ * (LoRaAirtime) before it starts. A frame the budget cannot cover stays
+ * staged instead of violating the duty cycle; nextTransmitDelayMs() tells
+ * the TX task how long to sleep, and a Critical message arriving meanwhile
+ * overtakes it (using criticalReserveUs if needed).
+ *
+ * With a TDMA slot plan configured, a staged frame likewise waits until it
+ * fits in one of the node's slots (TdmaSchedule). The time master queues a
+ * Critical TdmaBeacon every beaconIntervalMs and stamps it with the network
+ * time right before it goes on air; LinkEndpoint synchronizes followers on it.
+ *
+ * With retainedMessages > 0, the engine keeps copies of the last messages it
+ * admitted: resendChunks() sends only the chunks a receiver reported missing
+ * (ChunkRequest) instead of the whole message again.
+ *
+ * requestLinkChange() switches the link to another LinkProfile: the profile
+ * is first announced in-band (Critical LinkAnnouncement frames with the old
+ * settings), then the radio is retuned between two frames. Messages enqueued
+ * without an explicit TxOptions::chunkPayloadSize use the chunk size of the
+ * link profile current when the TX task admits them.
+ *
+ * A frame the radio refuses maxTransmitAttempts times in a row (e.g. longer
+ * than the transport can carry) is dropped rather than retried forever, so
+ * one bad frame cannot stall everything queued behind it.
+ *
+ * **Threading:**
+ * - enqueue() may be called from any number of tasks; it never blocks and
+ *   returns false when the queue is full (backpressure).
+ * - onTransmitDone() only sets a flag and is safe to call from the radio ISR.
+ * - poll() must be called from a single TX task, typically right after the
+ *   ISR wakes it (e.g. with a task notification).
+ */
+class TxEngine
+{
+ public:
+  /**
+   * @brief Engine counters.
+   */
+  struct Stats
+  {
+    uint64_t messagesQueued = 0;    ///< Messages accepted by enqueue().
+    uint64_t messagesRefused = 0;   ///< Messages refused because the queue was full.
+    uint64_t messagesSent = 0;      ///< Messages whose last frame has been transmitted (link announcements excluded).
+    uint64_t framesSent = 0;        ///< Frames whose transmission completed.
+    uint64_t messagesExpired = 0;   ///< Messages dropped because their deadline passed.
+    uint64_t radioErrors = 0;       ///< startTransmit() failures (the frame is retried) and refused setModulation().
+    uint64_t framesDropped = 0;     ///< Frames given up: maxTransmitAttempts refusals, or too long for a TDMA slot.
+    uint64_t framesTooLong = 0;     ///< Frames dropped because they can never fit in a TDMA slot.
+    uint64_t framesDeferred = 0;    ///< poll() calls in which the staged frame waited for airtime budget.
+    uint64_t airtimeUs = 0;         ///< Time on air of the frames started.
+    uint64_t linkChanges = 0;       ///< Link profiles applied after their announcement.
+    uint64_t slotWaits = 0;         ///< poll() calls in which the staged frame waited for a TDMA slot.
+    uint64_t beaconsSent = 0;       ///< TDMA beacons transmitted (time master only).
+    uint64_t resends = 0;           ///< Partial resends queued by resendChunks().
+  };
+
+  /**
+   * @param radio Transmitter the frames are handed to. Must outlive the engine.
+   */
+  explicit TxEngine(RadioTransmitter &radio, const TxEngineConfig &config = TxEngineConfig());
+
+  TxEngine(const TxEngine &) = delete;
+  TxEngine &operator=(const TxEngine &) = delete;
+
+  /**
+   * @brief Queues a message for transmission. Non-blocking, any task.
+   * @param options Priority class and deadline (see TxScheduler).
+   * @return false if the queue is full or the message is empty / too large for the header.
+   */
+  bool enqueue(std::vector<uint8_t> &&message, uint16_t messageId, const TxOptions &options = TxOptions());
+
+  /**
+   * @brief Copying overload of enqueue().
+   */
+  bool enqueue(const uint8_t *data, size_t length, uint16_t messageId, const TxOptions &options = TxOptions());
+
+  /**
+   * @brief Reports the end of the frame on air. ISR safe.
+   */
+  void onTransmitDone() { txDone_.store(true, std::memory_order_release); }
+
+  /**
+   * @brief Advances the engine: completes the frame on air, starts the staged
+   * frame and stages the following one. TX task only.
+   * @param currentTimestampMs Current time, for message deadlines.
+   */
+  void poll(uint32_t currentTimestampMs);
+
+  /**
+   * @brief Announces 'profile' and switches the radio to it once the announcement is on air. TX task only.
+   *
+   * A request made while another change is being announced replaces any
+   * request still waiting behind it.
+   *
+   * @return false if 'profile' is not a valid profile, or with TDMA if its
+   * frames would not fit in a slot.
+   */
+  bool requestLinkChange(const LinkProfile &profile);
+
+  /**
+   * @brief Queues the given chunks of a retained message again. TX task only.
+   *
+   * The resend keeps the original priority, deadline and chunk size, so the
+   * chunks are identical to those sent the first time. A retained message
+   * with the same ID but another chunk count is someone else's request
+   * (requests carry no address, see ChunkRequest) and is left alone.
+   *
+   * @return false if no retained message has this ID and 'totalChunks',
+   * 'chunks' selects none of its chunks or the queue is full.
+   */
+  bool resendChunks(uint16_t messageId, size_t totalChunks, const ChunkSet &chunks);
+
+  /**
+   * @brief Profile the radio currently uses (the initial one derives from TxEngineConfig::modulation).
+   */
+  const LinkProfile &linkProfile() const { return link_; }
+
+  /**
+   * @brief True while a link change is announced or waiting to be.
+   */
+  bool linkChangePending() const { return announcing_.has_value() || requestedLink_.has_value(); }
+
+  /**
+   * @brief True while a frame is on air.
+   */
+  bool transmitting() const { return onAir_; }
+
+  /**
+   * @brief How long the TX task can sleep before the staged frame fits the
+   * airtime budget and a TDMA slot (0 if it can start now, or if nothing is waiting).
+   */
+  uint32_t nextTransmitDelayMs(uint32_t currentTimestampMs) const;
+
+  /**
+   * @brief Airtime left in the budget, in microseconds (UINT64_MAX without a budget).
+   */
+  uint64_t remainingAirtimeUs(uint32_t currentTimestampMs) const;
+
+  /**
+   * @brief TDMA schedule (to synchronize it on beacons or GNSS time), nullptr without a slot plan. TX task only.
+   */
+  TdmaSchedule *tdma() { return tdma_.has_value() ? &*tdma_ : nullptr; }
+
+  /**
+   * @brief True when nothing is on air, staged or queued.
+   */
+  bool idle() const;
+
+  /**
+   * @brief Counters. TX task only (messagesQueued / messagesRefused are approximate from other tasks).
+   */
+  Stats stats() const;
+
+ private:
+  struct TxMessage
+  {
+    std::vector<uint8_t> data;
+    uint16_t messageId = 0;
+    TxOptions options;
+  };
+
+  RadioTransmitter &radio_;
+  LoRaModulation modulation_;
+  std::optional<AirtimeBudget> budget_;
+  std::optional<TdmaSchedule> tdma_;
+  uint64_t criticalReserveUs_;
+  MpscQueue<TxMessage> queue_;
+  std::atomic<size_t> queued_{0};
+  std::atomic<uint64_t> messagesQueued_{0};
+  std::atomic<uint64_t> messagesRefused_{0};
+  std::atomic<bool> txDone_{false};
+
+  // TX task state.
+  TxScheduler scheduler_;
+  TxMessage incoming_;
+
+  uint8_t buffers_[2][MAX_TX_PACKET_SIZE];
+  size_t stagedBuffer_ = 0;        ///< Buffer holding the staged frame.
+  bool staged_ = false;            ///< A serialized frame is waiting in buffers_[stagedBuffer_].
+  size_t stagedLength_ = 0;        ///< Length of the staged frame.
+  bool compactFrames_;
+  TxChunk stagedChunk_;
+  size_t stagedAttempts_ = 0;      ///< startTransmit() refusals of the staged frame.
+  size_t maxTransmitAttempts_;
+  bool onAir_ = false;
+  TxChunk onAirChunk_;
+
+  uint64_t messagesSent_ = 0;
+  uint64_t framesSent_ = 0;
+  uint64_t radioErrors_ = 0;
+  uint64_t framesDropped_ = 0;
+  uint64_t framesTooLong_ = 0;
+  uint64_t framesDeferred_ = 0;
+  uint64_t airtimeUs_ = 0;
+  uint64_t linkChanges_ = 0;
+  uint64_t slotWaits_ = 0;
+  uint64_t beaconsSent_ = 0;
+  uint64_t resends_ = 0;
+  bool beaconInFlight_ = false;
+
+  // Link adaptation.
+  LinkProfile link_;
+  size_t announcementRepeats_;
+  std::optional<LinkProfile> requestedLink_;  ///< Waiting for the current announcement to finish.
+  std::optional<LinkProfile> announcing_;     ///< Announced, applied when the last copy is on air.
+  size_t announcementsToQueue_ = 0;
+  size_t announcementsInFlight_ = 0;
+
+  // Copies kept for resendChunks(), oldest first.
+  size_t retainLimit_;
+  std::deque<TxMessage> retained_;
+
+  /**
+   * @brief Moves enqueued messages into the scheduler while it has room.
+   */
+  void admit(uint32_t currentTimestampMs);
+
+  /**
+   * @brief Hands pending link announcements to the scheduler.
+   */
+  void queueAnnouncements();
+
+  /**
+   * @brief Hands the time master's next beacon to the scheduler when it is due.
+   */
+  void queueBeacon(uint32_t currentTimestampMs);
+
+  /**
+   * @brief Bookkeeping for a completed frame, or one dropped unsent ('sent' false);
+   * applies the link change after its last announcement.
+   */
+  void onFrameDone(const TxChunk &chunk, bool sent);
+
+  /**
+   * @brief Gives up the staged frame: the rest of its message is still sent.
+   */
+  void dropStaged();
+
+  /**
+   * @brief Serializes the next chunk into the free buffer.
+   * @return false if there is nothing left to send.
+   */
+  bool stageNext(uint32_t currentTimestampMs);
+
+  /**
+   * @brief Serializes stagedChunk_ into the free buffer.
+   */
+  void serializeStaged();
+
+  /**
+   * @brief Airtime the budget must hold before the staged frame may start (its time on air plus any reserve).
+   */
+  uint64_t requiredAirtimeUs() const;
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Packet.hpp"
+
+/**
+ * @brief Priority classes of outgoing messages, most urgent first.
+ */
+enum class TxPriority : uint8_t
+{
+  Critical = 0,  ///< Flight events, alarms: preempt everything else.
+  Normal = 1,    ///< Telemetry and commands.
+  Bulk = 2,      ///< Images, logs, file transfers.
+};
+
+/**
+ * @struct TxOptions
+ * @brief Per-message scheduling parameters.
+ */
+struct TxOptions
+{
+  TxPriority priority = TxPriority::Normal;
+
+  /**
+   * @brief Absolute time (same clock as the scheduler's timestamps) after
+   * which the message is useless. Chunks not yet sent by then are dropped.
+   */
+  std::optional<uint32_t> deadlineMs;
+
+  /**
+   * @brief Sends the chunks with PACKET_FLAG_CONTROL (link management, see LinkAnnouncement).
+   */
+  bool control = false;
+
+  /**
+   * @brief Payload bytes per chunk, fixed for the whole message (see PacketSerializer).
+   * 0: the TxEngine's current link profile chunk size (LORA_MAX_PAYLOAD_SIZE in a bare TxScheduler).
+   */
+  uint16_t chunkPayloadSize = 0;
+
+  /**
+   * @brief Chunks to send, e.g. those a receiver reported missing (see ChunkRequest).
+   * std::nullopt: the whole message.
+   */
+  std::optional<ChunkSet> chunks;
+};
+
+/**
+ * @struct TxChunk
+ * @brief A chunk picked by TxScheduler::next(), ready to be serialized.
+ */
+struct TxChunk
+{
+  Packet packet;
+  uint32_t ticket = 0;  ///< Identifies the message inside the scheduler.
+  TxPriority priority = TxPriority::Normal;
+  bool last = false;    ///< Last chunk of its message (of its TxOptions::chunks subset, if any).
+};
+
+/**
+ * @class TxScheduler
+ * @brief Chooses, frame by frame, which message the next chunk comes from.
+ *
+ * Messages are interleaved at chunk granularity:
+ *   1. the highest priority class with pending chunks wins, so a Critical
+ *      message overtakes a 200-chunk Bulk transfer at the next frame;
+ *   2. within a class, messages with a deadline go earliest-deadline-first,
+ *      ahead of messages without one;
+ *   3. remaining ties are served round-robin.
+ * Messages past their deadline are dropped before any more of their chunks
+ * are picked.
+ *
+ * A picked chunk is provisional until commit() (it went on air) or
+ * requeue() (it was preempted while staged); a message is released when its
+ * last chunk is committed. Not thread safe: owned by the TX task.
+ */
+class TxScheduler
+{
+ public:
+  /**
+   * @param maxMessages Messages held at once (see full()).
+   */
+  explicit TxScheduler(size_t maxMessages = 8);
+
+  /**
+   * @brief Adds a message.
+   * @return The ticket of the message (see TxChunk::ticket), std::nullopt if
+   * the scheduler is full, the message is empty / too large, the chunk size is
+   * invalid or options.chunks selects none of its chunks.
+   */
+  std::optional<uint32_t> add(std::vector<uint8_t> &&data, uint16_t messageId, const TxOptions &options);
+
+  /**
+   * @brief Picks the next chunk to transmit.
+   * @return std::nullopt when no message has chunks left to send.
+   */
+  std::optional<TxChunk> next(uint32_t currentTimestampMs);
+
+  /**
+   * @brief Marks a picked chunk as transmitted.
+   */
+  void commit(const TxChunk &chunk);
+
+  /**
+   * @brief Returns a picked, not transmitted chunk: it will be picked again.
+   */
+  void requeue(const TxChunk &chunk);
+
+  /**
+   * @brief True if a picked chunk should give way: its message expired or a
+   * message of a higher priority class is waiting.
+   */
+  bool shouldPreempt(const TxChunk &chunk, uint32_t currentTimestampMs) const;
+
+  size_t pendingMessages() const { return messages_.size(); }
+  bool empty() const { return messages_.empty(); }
+  bool full() const { return messages_.size() >= maxMessages_; }
+
+  /**
+   * @brief Messages dropped because their deadline passed.
+   */
+  uint64_t expiredMessages() const { return expiredMessages_; }
+
+ private:
+  struct Entry
+  {
+    std::vector<uint8_t> data;
+    uint16_t messageId = 0;
+    TxOptions options;
+    uint32_t ticket = 0;
+    size_t chunkSize = LORA_MAX_PAYLOAD_SIZE;
+    size_t totalChunks = 0;
+    ChunkSet selected;          ///< Chunks to send (TxOptions::chunks, or all of them).
+    size_t selectedChunks = 0;
+    size_t nextChunk = 0;       ///< Index of the next selected chunk to pick.
+    size_t pickedChunks = 0;
+    size_t committedChunks = 0;
+    uint64_t lastServed = 0;    ///< Round-robin order.
+  };
+
+  size_t maxMessages_;
+  std::vector<Entry> messages_;
+  uint32_t nextTicket_ = 1;
+  uint64_t serveCounter_ = 0;
+  uint64_t expiredMessages_ = 0;
+
+  Entry *find(uint32_t ticket);
+  const Entry *find(uint32_t ticket) const;
+
+  /**
+   * @brief Drops expired messages that have no chunk picked but not committed.
+   */
+  void dropExpired(uint32_t currentTimestampMs);
+
+  static bool expired(const Entry &entry, uint32_t currentTimestampMs);
+
+  /**
+   * @brief Moves nextChunk to the first selected chunk at or after it.
+   */
+  static void skipUnselected(Entry &entry);
+
+  /**
+   * @brief Strict ordering of the selection rules above.
+   */
+  static bool before(const Entry &a, const Entry &b, uint32_t currentTimestampMs);
+};
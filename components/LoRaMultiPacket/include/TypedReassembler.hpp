@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+#include "Packet.hpp"
+#include "PacketSerializer.hpp"
+
+/**
+ * @class BasicTypedReassembler
+ * @brief Receive side of BasicPacketSerializer::split<T>(): reassembles chunks directly into a T.
+ *
+ * Everything is sized at compile time from sizeof(T): each session is a
+ * fixed slot holding the object bytes and a bitset of received chunks, so
+ * reception performs no heap allocation and no runtime chunk math. Chunks
+ * whose geometry does not match T (chunk count or payload size of their
+ * index) are rejected, which also filters out messages of other types.
+ *
+ * Like PacketReassembler, sessions are keyed by (sourceId, messageId); when
+ * all slots are busy new messages are discarded until prune() frees a slot.
+ *
+ * @tparam T Trivially copyable message type.
+ * @tparam Profile Frame geometry (see ProtocolProfile).
+ * @tparam MaxConcurrent Number of messages of type T reassembled in parallel.
+ */
+template <typename T, typename Profile = DefaultProfile, size_t MaxConcurrent = 2>
+class BasicTypedReassembler
+{
+  static_assert(std::is_trivially_copyable<T>::value, "T is rebuilt from its object representation");
+  static_assert(std::is_default_constructible<T>::value, "T must be default constructible");
+
+ public:
+  using PacketType = BasicPacket<Profile>;
+  using Serializer = BasicPacketSerializer<Profile>;
+
+  /**
+   * @brief Chunks per T message.
+   */
+  static constexpr size_t CHUNKS = Serializer::template chunksFor<T>();
+
+  /**
+   * @brief Processes a validated packet.
+   *
+   * @param packet The valid packet received from the network.
+   * @param currentTimestampMs A distinct timestamp (e.g., millis) to track timeout.
+   * @param sourceId Identity of the transmitter the packet was received from.
+   * @return The complete object when this packet was its last missing chunk
+   * (never for control frames, PACKET_FLAG_CONTROL).
+   */
+  std::optional<T> processPacket(const PacketType &packet, uint32_t currentTimestampMs, uint32_t sourceId = 0)
+  {
+    const auto &header = packet.header;
+    if ((header.flags & PACKET_FLAG_CONTROL) != 0 || header.totalChunks != CHUNKS || header.chunkIndex >= CHUNKS ||
+        header.payloadSize != Serializer::chunkPayloadSize(sizeof(T), header.chunkIndex))
+    {
+      return std::nullopt;
+    }
+
+    Slot *slot = findSlot(sourceId, header.messageId);
+    if (slot == nullptr)
+    {
+      slot = findFreeSlot();
+      if (slot == nullptr)
+        return std::nullopt;  // All slots busy: discard.
+      slot->active = true;
+      slot->sourceId = sourceId;
+      slot->messageId = header.messageId;
+      slot->firstReceivedTime = currentTimestampMs;
+      slot->received.reset();
+    }
+
+    if (!slot->received.test(header.chunkIndex))
+    {
+      std::memcpy(slot->bytes + static_cast<size_t>(header.chunkIndex) * Profile::MAX_PAYLOAD_SIZE,
+                  packet.payload.data, header.payloadSize);
+      slot->received.set(header.chunkIndex);
+    }
+
+    if (!slot->received.all())
+      return std::nullopt;
+
+    T value;
+    std::memcpy(static_cast<void *>(&value), slot->bytes, sizeof(T));
+    slot->active = false;
+    return value;
+  }
+
+  /**
+   * @brief Frees slots of messages whose first chunk arrived more than 'timeoutMs' ago.
+   */
+  void prune(uint32_t currentTimestampMs, uint32_t timeoutMs)
+  {
+    for (Slot &slot : slots_)
+    {
+      if (slot.active && currentTimestampMs - slot.firstReceivedTime > timeoutMs)
+        slot.active = false;
+    }
+  }
+
+  /**
+   * @brief Returns the number of messages currently being reassembled.
+   */
+  size_t pendingSessions() const
+  {
+    size_t count = 0;
+    for (const Slot &slot : slots_)
+      count += slot.active ? 1 : 0;
+    return count;
+  }
+
+  /**
+   * @brief Clears all pending reassembly sessions.
+   */
+  void reset()
+  {
+    for (Slot &slot : slots_)
+      slot.active = false;
+  }
+
+ private:
+  struct Slot
+  {
+    bool active = false;
+    uint32_t sourceId = 0;
+    uint16_t messageId = 0;
+    uint32_t firstReceivedTime = 0;
+    std::bitset<CHUNKS> received;
+    alignas(T) uint8_t bytes[sizeof(T)];
+  };
+
+  std::array<Slot, MaxConcurrent> slots_{};
+
+  Slot *findSlot(uint32_t sourceId, uint16_t messageId)
+  {
+    for (Slot &slot : slots_)
+    {
+      if (slot.active && slot.sourceId == sourceId && slot.messageId == messageId)
+        return &slot;
+    }
+    return nullptr;
+  }
+
+  Slot *findFreeSlot()
+  {
+    for (Slot &slot : slots_)
+    {
+      if (!slot.active)
+        return &slot;
+    }
+    return nullptr;
+  }
+};
+
+/**
+ * @brief Typed reassembler of the default profile.
+ */
+template <typename T, size_t MaxConcurrent = 2>
+using TypedReassembler = BasicTypedReassembler<T, DefaultProfile, MaxConcurrent>;
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "FrameStreamDecoder.hpp"
+#include "ITransport.hpp"
+#include "LoRaAirtime.hpp"
+#include "Packet.hpp"
+
+/**
+ * @struct UartTransportConfig
+ * @brief Timing and sizing of a UartTransport.
+ */
+struct UartTransportConfig
+{
+  /**
+   * @brief Largest frame written in one go: the module's sub-packet size
+   * (32, 64, 128 or 200 bytes on an E220, see E220Profile), or
+   * MAX_PACKET_SIZE for modules that take a whole frame.
+   */
+  size_t maxFrameSize = MAX_PACKET_SIZE;
+
+  /**
+   * @brief Air settings the module was configured with (air data rate): a
+   * frame is reported as sent after its time on air at these settings.
+   */
+  LoRaModulation modulation;
+
+  /**
+   * @brief Pause after the frame's time on air before it is reported as sent:
+   * UART transfer and the gap the module needs to see frames as separate packets.
+   */
+  uint32_t interFrameGapMs = 20;
+
+  /**
+   * @brief Silence after which a partially received frame is dropped (see FrameStreamDecoder::flush()).
+   */
+  uint32_t rxIdleTimeoutMs = 10;
+};
+
+/**
+ * @class UartTransport
+ * @brief ITransport over a serial LoRa module in transparent mode (EByte E220, ...).
+ *
+ * The module sends whatever is written to its UART and outputs what it
+ * receives, with no framing of its own. Frames are therefore always written
+ * compact (header, payloadSize bytes, CRC; full frames are compacted), and
+ * the received byte stream goes through a FrameStreamDecoder, which finds
+ * frames by header plausibility and CRC and resynchronizes after noise or a
+ * truncated frame. A frame left incomplete for rxIdleTimeoutMs is dropped.
+ *
+ * The UART itself is reached through two non-blocking functions, so the
+ * transport runs unchanged over ESP-IDF's uart_write_bytes() /
+ * uart_read_bytes(..., 0), a POSIX tty or an in-memory pipe in tests.
+ */
+class UartTransport : public ITransport
+{
+ public:
+  /**
+   * @brief Writes 'length' bytes to the UART. Returns false if they could not be queued.
+   */
+  using WriteFn = std::function<bool(const uint8_t *data, size_t length)>;
+
+  /**
+   * @brief Reads up to 'capacity' bytes already received. Returns the number read (0 if none). Must not block.
+   */
+  using ReadFn = std::function<size_t(uint8_t *buffer, size_t capacity)>;
+
+  /**
+   * @brief Receive-side counters.
+   */
+  struct Stats
+  {
+    uint64_t framesReceived = 0;  ///< Frames found in the byte stream and delivered.
+    uint64_t bytesReceived = 0;
+    uint64_t bytesDiscarded = 0;  ///< Noise, corrupted and truncated frames.
+    uint64_t crcErrors = 0;       ///< Plausible headers whose CRC did not match.
+  };
+
+  UartTransport(WriteFn write, ReadFn read, const UartTransportConfig &config = UartTransportConfig());
+
+  bool startTransmit(const uint8_t *frame, size_t length) override;
+  void poll(uint32_t currentTimestampMs) override;
+  size_t maxFrameSize() const override { return config_.maxFrameSize; }
+
+  Stats stats() const;
+
+ private:
+  WriteFn write_;
+  ReadFn read_;
+  UartTransportConfig config_;
+  FrameStreamDecoder decoder_;
+
+  uint32_t now_ = 0;
+  bool transmitting_ = false;
+  uint32_t transmitStartMs_ = 0;
+  uint32_t transmitDurationMs_ = 0;  ///< Time on air of the frame being sent, plus interFrameGapMs.
+
+  uint8_t rx_[128];
+  uint32_t lastByteMs_ = 0;
+
+  /**
+   * @brief Delivers the frames the decoder has found, received at 'timestampMs'.
+   */
+  void deliverDecoded(uint32_t timestampMs);
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "FrameArena.hpp"
+
+#ifdef __linux__
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+/**
+ * @class UdpFrameIngest
+ * @brief Batched UDP receive front-end for host gateways (Linux only).
+ *
+ * LoRa gateways forward every raw frame as one UDP datagram. Instead of one
+ * recvfrom() per frame, receiveBatch() pulls up to a whole FrameArena worth
+ * of datagrams with a single recvmmsg() call, scattering them directly into
+ * the arena slots. The mmsghdr/iovec tables are built once per arena, so the
+ * steady state performs one syscall and no allocation per batch.
+ *
+ * The sender's IPv4 address (host byte order) is used as FrameMeta::sourceId
+ * and every frame of a batch is stamped with the same reception time.
+ */
+class UdpFrameIngest
+{
+ public:
+  UdpFrameIngest() = default;
+  ~UdpFrameIngest();
+
+  UdpFrameIngest(const UdpFrameIngest &) = delete;
+  UdpFrameIngest &operator=(const UdpFrameIngest &) = delete;
+
+  /**
+   * @brief Binds the receive socket.
+   *
+   * @param port UDP port to listen on (0 picks an ephemeral port, see port()).
+   * @param bindAddress IPv4 address to bind to, in dotted notation.
+   * @param receiveBufferBytes Requested SO_RCVBUF size, absorbs bursts between batches.
+   * @return false if the socket could not be created or bound.
+   */
+  bool open(uint16_t port, const char *bindAddress = "0.0.0.0", int receiveBufferBytes = 4 * 1024 * 1024);
+
+  /**
+   * @brief Closes the socket.
+   */
+  void close();
+
+  /**
+   * @brief Receives as many frames as are available, up to the arena capacity.
+   *
+   * Waits up to 'timeoutMs' for the first datagram (-1 waits forever, 0 polls),
+   * then drains whatever is queued without blocking. Datagrams longer than
+   * MAX_PACKET_SIZE are truncated to MAX_PACKET_SIZE and flagged with length 0
+   * so the parser rejects them.
+   *
+   * @param arena Destination batch; cleared before receiving.
+   * @param timestampMs Reception time stamped on every frame of the batch.
+   * @param timeoutMs Maximum time to wait for the first frame.
+   * @return Number of frames received, 0 on timeout, -1 on socket error.
+   */
+  int receiveBatch(FrameArena &arena, uint32_t timestampMs, int timeoutMs);
+
+  /**
+   * @brief Locally bound port (useful after open(0)).
+   */
+  uint16_t port() const { return port_; }
+
+  int fd() const { return fd_; }
+  bool isOpen() const { return fd_ >= 0; }
+
+ private:
+  int fd_ = -1;
+  uint16_t port_ = 0;
+
+  // recvmmsg() tables, rebuilt only when a different arena is used.
+  const FrameArena *boundArena_ = nullptr;
+  std::vector<mmsghdr> messages_;
+  std::vector<iovec> iovecs_;
+  std::vector<sockaddr_in> addresses_;
+
+  void bindArena(FrameArena &arena);
+};
+
+/**
+ * @class UdpFrameSender
+ * @brief Forwards raw frames as UDP datagrams, one frame per datagram (Linux only).
+ *
+ * Counterpart of UdpFrameIngest used by the local sender tool, the loopback
+ * tests and the benchmarks to emulate a gateway. Batches are sent with a
+ * single sendmmsg() call.
+ */
+class UdpFrameSender
+{
+ public:
+  UdpFrameSender() = default;
+  ~UdpFrameSender();
+
+  UdpFrameSender(const UdpFrameSender &) = delete;
+  UdpFrameSender &operator=(const UdpFrameSender &) = delete;
+
+  /**
+   * @brief Creates the socket and sets the destination address.
+   * @return false on socket error or unparsable address.
+   */
+  bool open(const char *destAddress, uint16_t destPort);
+
+  void close();
+
+  /**
+   * @brief Sends one frame.
+   */
+  bool send(const uint8_t *frame, size_t length);
+
+  /**
+   * @brief Sends every frame of the arena.
+   * @return Number of frames handed to the kernel, -1 on socket error.
+   */
+  int sendBatch(const FrameArena &arena);
+
+ private:
+  int fd_ = -1;
+  sockaddr_in dest_{};
+  std::vector<mmsghdr> messages_;
+  std::vector<iovec> iovecs_;
+};
+
+#endif  // __linux__
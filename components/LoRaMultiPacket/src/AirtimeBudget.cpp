@@ -0,0 +1,53 @@
+#include "AirtimeBudget.hpp"
+
+#include <algorithm>
+
+AirtimeBudget::AirtimeBudget(const AirtimeBudgetConfig &config)
+    : config_(config), creditNs_(std::min(config.initialUs, config.burstUs) * 1000)
+{
+}
+
+uint64_t AirtimeBudget::creditAt(uint32_t currentTimestampMs) const
+{
+  if (!started_)
+    return creditNs_;
+
+  // One ms of wall time earns dutyCyclePpm / 1000 us = dutyCyclePpm ns of airtime.
+  uint64_t elapsedMs = static_cast<uint32_t>(currentTimestampMs - lastRefillMs_);
+  uint64_t credit = creditNs_ + elapsedMs * config_.dutyCyclePpm;
+  return std::min(credit, config_.burstUs * 1000);
+}
+
+uint64_t AirtimeBudget::availableUs(uint32_t currentTimestampMs) const
+{
+  return creditAt(currentTimestampMs) / 1000;
+}
+
+bool AirtimeBudget::tryConsume(uint32_t airtimeUs, uint32_t currentTimestampMs)
+{
+  creditNs_ = creditAt(currentTimestampMs);
+  lastRefillMs_ = currentTimestampMs;
+  started_ = true;
+
+  uint64_t costNs = static_cast<uint64_t>(airtimeUs) * 1000;
+  if (costNs > creditNs_)
+    return false;
+
+  creditNs_ -= costNs;
+  consumedUs_ += airtimeUs;
+  return true;
+}
+
+uint32_t AirtimeBudget::waitTimeMs(uint64_t airtimeUs, uint32_t currentTimestampMs) const
+{
+  uint64_t costNs = airtimeUs * 1000;
+  uint64_t credit = creditAt(currentTimestampMs);
+  if (costNs <= credit)
+    return 0;
+  if (config_.dutyCyclePpm == 0 || costNs > config_.burstUs * 1000)
+    return UINT32_MAX;  // Never affordable.
+
+  uint64_t missing = costNs - credit;
+  uint64_t waitMs = (missing + config_.dutyCyclePpm - 1) / config_.dutyCyclePpm;
+  return static_cast<uint32_t>(std::min<uint64_t>(waitMs, UINT32_MAX));
+}
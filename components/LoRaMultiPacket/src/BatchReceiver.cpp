@@ -0,0 +1,51 @@
+#include "BatchReceiver.hpp"
+
+#include <utility>
+
+#include "PacketParser.hpp"
+
+BatchReceiver::BatchReceiver(size_t maxBatchSize, const ReassemblerConfig &config, MessageCallback onMessage)
+    : reassembler_(config),
+      onMessage_(std::move(onMessage)),
+      packets_(maxBatchSize),
+      validMask_(batchMaskWords(maxBatchSize))
+{
+}
+
+size_t BatchReceiver::process(const FrameArena &batch)
+{
+  size_t count = batch.size();
+  if (count > packets_.size())
+  {
+    // Batch larger than the configured maximum: grow once rather than drop frames.
+    packets_.resize(count);
+    validMask_.resize(batchMaskWords(count));
+  }
+
+  size_t valid = PacketParser::parseBatch(batch, packets_.data(), validMask_.data());
+  stats_.framesReceived += count;
+  stats_.framesRejected += count - valid;
+
+  size_t completed = 0;
+  for (size_t w = 0; w < batchMaskWords(count); w++)
+  {
+    uint64_t bits = validMask_[w];
+    while (bits != 0)
+    {
+      size_t i = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+      bits &= bits - 1;
+
+      const FrameMeta &meta = batch.meta(i);
+      auto message = reassembler_.processPacket(packets_[i], meta.timestampMs, meta.sourceId);
+      if (message.has_value())
+      {
+        completed++;
+        if (onMessage_)
+          onMessage_(meta.sourceId, packets_[i].header.messageId, std::move(message.value()));
+      }
+    }
+  }
+
+  stats_.messagesCompleted += completed;
+  return completed;
+}
@@ -0,0 +1,149 @@
+#include "BondedTransport.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+BondedTransport::BondedTransport(const std::vector<ITransport *> &members, const std::vector<BondMemberConfig> &configs)
+    : members_(members.size())
+{
+  for (size_t i = 0; i < members_.size(); i++)
+  {
+    Member &member = members_[i];
+    BondMemberConfig config = i < configs.size() ? configs[i] : BondMemberConfig();
+    member.transport = members[i];
+    member.modulation = config.modulation;
+    if (config.airtimeBudget.has_value())
+      member.budget.emplace(*config.airtimeBudget);
+
+    member.transport->setReceiveCallback([this, i](const uint8_t *frame, size_t length, const FrameMeta &meta) {
+      members_[i].stats.framesReceived++;
+      stats_.framesReceived++;
+      deliverFrame(frame, length, meta);
+    });
+    member.transport->setTransmitDoneCallback([this, i]() {
+      Member &done = members_[i];
+      done.transport->finishTransmit();
+      done.onAir = false;
+      if (done.pendingModulation.has_value())
+      {
+        if (!applyModulation(done, *done.pendingModulation))
+          stats_.modulationErrors++;
+        done.pendingModulation.reset();
+      }
+    });
+  }
+}
+
+BondedTransport::~BondedTransport()
+{
+  for (Member &member : members_)
+  {
+    member.transport->setReceiveCallback(nullptr);
+    member.transport->setTransmitDoneCallback(nullptr);
+  }
+}
+
+bool BondedTransport::startTransmit(const uint8_t *frame, size_t length)
+{
+  if (pendingLength_ != 0 || frame == nullptr || length == 0 || length > maxFrameSize())
+    return false;
+  std::memcpy(pending_, frame, length);
+  pendingLength_ = length;
+  return true;
+}
+
+bool BondedTransport::setModulation(const LoRaModulation &modulation)
+{
+  bool applied = true;
+  for (Member &member : members_)
+  {
+    // Retuning a radio mid-frame would corrupt it: wait for its transmit-done.
+    if (member.onAir)
+      member.pendingModulation = modulation;
+    else if (!applyModulation(member, modulation))
+      applied = false;
+  }
+  return applied;
+}
+
+bool BondedTransport::applyModulation(Member &member, const LoRaModulation &modulation)
+{
+  if (!member.transport->setModulation(modulation))
+    return false;
+  member.modulation = modulation;
+  return true;
+}
+
+void BondedTransport::poll(uint32_t currentTimestampMs)
+{
+  for (Member &member : members_)
+    member.transport->poll(currentTimestampMs);
+  dispatch(currentTimestampMs);
+}
+
+void BondedTransport::dispatch(uint32_t currentTimestampMs)
+{
+  if (pendingLength_ == 0)
+    return;
+
+  // Earliest finish: the free member with the shortest time on air for this frame.
+  Member *best = nullptr;
+  uint32_t bestAirtimeUs = 0;
+  uint64_t bestCreditUs = 0;
+  for (Member &member : members_)
+  {
+    if (member.onAir)
+      continue;
+    uint32_t airtimeUs = LoRaAirtime::timeOnAirUs(member.modulation, pendingLength_);
+    uint64_t creditUs = member.budget.has_value() ? member.budget->availableUs(currentTimestampMs) : UINT64_MAX;
+    if (creditUs < airtimeUs)
+      continue;
+    if (best == nullptr || airtimeUs < bestAirtimeUs || (airtimeUs == bestAirtimeUs && creditUs > bestCreditUs))
+    {
+      best = &member;
+      bestAirtimeUs = airtimeUs;
+      bestCreditUs = creditUs;
+    }
+  }
+  if (best == nullptr)
+  {
+    stats_.framesDeferred++;
+    return;
+  }
+
+  // The member reads its own copy: the pending buffer is reused by the next frame.
+  std::memcpy(best->buffer, pending_, pendingLength_);
+  if (!best->transport->startTransmit(best->buffer, pendingLength_))
+  {
+    stats_.radioErrors++;
+    return;
+  }
+  if (best->budget.has_value())
+    best->budget->tryConsume(bestAirtimeUs, currentTimestampMs);
+  best->onAir = true;
+  best->stats.framesSent++;
+  best->stats.airtimeUs += bestAirtimeUs;
+  stats_.framesSent++;
+  pendingLength_ = 0;
+  transmitDone();
+}
+
+size_t BondedTransport::maxFrameSize() const
+{
+  size_t size = MAX_PACKET_SIZE;
+  for (const Member &member : members_)
+    size = std::min(size, member.transport->maxFrameSize());
+  return size;
+}
+
+bool BondedTransport::transmitting() const
+{
+  if (pendingLength_ != 0)
+    return true;
+  for (const Member &member : members_)
+  {
+    if (member.onAir)
+      return true;
+  }
+  return false;
+}
@@ -0,0 +1,215 @@
+#include "BulkPacketizer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if !defined(ESP_PLATFORM) && (defined(__unix__) || defined(__APPLE__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LMP_BULK_MMAP 1
+#endif
+
+namespace
+{
+using Checksum = DefaultProfile::Checksum;
+
+bool validChunk(size_t chunkPayloadSize)
+{
+  return chunkPayloadSize > 0 && chunkPayloadSize <= LORA_MAX_PAYLOAD_SIZE;
+}
+
+/**
+ * @brief Message ID of the 'index'-th message: consecutive, skipping 0 (invalid) and 0xFFFF (control).
+ */
+uint16_t messageIdAt(uint16_t first, size_t index)
+{
+  size_t start = first == 0 || first == 0xFFFF ? 0 : first - 1u;
+  return static_cast<uint16_t>(1 + (start + index) % 0xFFFE);
+}
+}  // namespace
+
+BulkPacketizer::BulkPacketizer(const BulkPacketizerConfig &config)
+    : config_(config)
+{
+  size_t threads = config.threadCount != 0 ? config.threadCount : std::max(1u, std::thread::hardware_concurrency());
+  if (config_.framesPerTask == 0)
+    config_.framesPerTask = 1;
+  for (size_t i = 1; i < threads; i++)
+    workers_.emplace_back([this] { workerLoop(); });
+}
+
+BulkPacketizer::~BulkPacketizer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &worker : workers_)
+    worker.join();
+}
+
+size_t BulkPacketizer::messagesFor(size_t length, size_t chunkPayloadSize)
+{
+  if (length == 0 || !validChunk(chunkPayloadSize))
+    return 0;
+  size_t messageBytes = DefaultProfile::MAX_CHUNKS * chunkPayloadSize;
+  return (length + messageBytes - 1) / messageBytes;
+}
+
+size_t BulkPacketizer::framesFor(size_t length, size_t chunkPayloadSize)
+{
+  if (length == 0 || !validChunk(chunkPayloadSize))
+    return 0;
+  // Every message but the last one is full: MAX_CHUNKS chunks of chunkPayloadSize bytes.
+  return (length + chunkPayloadSize - 1) / chunkPayloadSize;
+}
+
+size_t BulkPacketizer::packetize(const uint8_t *data, size_t length, FrameArena &arena)
+{
+  size_t frames = framesFor(length, config_.chunkPayloadSize);
+  arena.clear();
+  if (data == nullptr || frames == 0 || frames > arena.capacity())
+    return 0;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    data_ = data;
+    length_ = length;
+    arena_ = &arena;
+    frames_ = frames;
+    tasks_ = (frames + config_.framesPerTask - 1) / config_.framesPerTask;
+    nextTask_.store(0, std::memory_order_relaxed);
+    busyWorkers_ = workers_.size();
+    generation_++;
+  }
+  wake_.notify_all();
+
+  // The caller works too, then waits for the workers still finishing a task.
+  runTasks();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return busyWorkers_ == 0; });
+    arena_ = nullptr;
+  }
+
+  arena.setSize(frames);
+  return frames;
+}
+
+size_t BulkPacketizer::packetizeFile(const char *path, FrameArena &arena)
+{
+#ifdef LMP_BULK_MMAP
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+    return 0;
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+  {
+    ::close(fd);
+    return 0;
+  }
+
+  size_t size = static_cast<size_t>(st.st_size);
+  void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);  // The mapping keeps the file referenced.
+  if (mapping == MAP_FAILED)
+    return 0;
+
+  // Every page is read exactly once, by whichever thread owns its frames.
+  ::madvise(mapping, size, MADV_WILLNEED);
+  size_t frames = packetize(static_cast<const uint8_t *>(mapping), size, arena);
+  ::munmap(mapping, size);
+  return frames;
+#else
+  (void)path;
+  arena.clear();
+  return 0;
+#endif
+}
+
+void BulkPacketizer::workerLoop()
+{
+  uint64_t seen = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+      if (stopping_)
+        return;
+      seen = generation_;
+    }
+
+    runTasks();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      busyWorkers_--;
+    }
+    done_.notify_one();
+  }
+}
+
+void BulkPacketizer::runTasks()
+{
+  while (true)
+  {
+    size_t task = nextTask_.fetch_add(1, std::memory_order_relaxed);
+    if (task >= tasks_)
+      return;
+    size_t first = task * config_.framesPerTask;
+    packetizeRange(first, std::min(frames_, first + config_.framesPerTask));
+  }
+}
+
+void BulkPacketizer::packetizeRange(size_t first, size_t last)
+{
+  const size_t chunkSize = config_.chunkPayloadSize;
+  const size_t messageBytes = DefaultProfile::MAX_CHUNKS * chunkSize;
+
+  for (size_t frame = first; frame < last; frame++)
+  {
+    size_t message = frame / DefaultProfile::MAX_CHUNKS;
+    size_t chunkIndex = frame % DefaultProfile::MAX_CHUNKS;
+    size_t messageOffset = message * messageBytes;
+    size_t messageLength = std::min(messageBytes, length_ - messageOffset);
+    size_t totalChunks = (messageLength + chunkSize - 1) / chunkSize;
+    size_t offset = chunkIndex * chunkSize;
+    size_t payloadSize = std::min(chunkSize, messageLength - offset);
+
+    PacketHeader header;
+    header.messageId = messageIdAt(config_.firstMessageId, message);
+    header.totalChunks = static_cast<uint8_t>(totalChunks);
+    header.chunkIndex = static_cast<uint8_t>(chunkIndex);
+    header.payloadSize = static_cast<uint8_t>(payloadSize);
+    header.flags = static_cast<uint8_t>((chunkIndex == 0 ? PACKET_FLAG_SOM : 0) |
+                                        (chunkIndex + 1 == totalChunks ? PACKET_FLAG_EOM : 0));
+
+    // Header and payload are adjacent in the slot: one CRC pass covers both.
+    uint8_t *slot = arena_->slot(frame);
+    std::memcpy(slot, &header, HEADER_SIZE);
+    std::memcpy(slot + HEADER_SIZE, data_ + messageOffset + offset, payloadSize);
+    uint16_t crc = Checksum::finalize(Checksum::update(Checksum::INITIAL_VALUE, slot, HEADER_SIZE + payloadSize));
+
+    size_t length;
+    if (config_.compactFrames)
+    {
+      std::memcpy(slot + HEADER_SIZE + payloadSize, &crc, CRC_SIZE);
+      length = HEADER_SIZE + payloadSize + CRC_SIZE;
+    }
+    else
+    {
+      std::memset(slot + HEADER_SIZE + payloadSize, PAYLOAD_PADDING_BYTE, LORA_MAX_PAYLOAD_SIZE - payloadSize);
+      std::memcpy(slot + HEADER_SIZE + LORA_MAX_PAYLOAD_SIZE, &crc, CRC_SIZE);
+      length = MAX_TX_PACKET_SIZE;
+    }
+
+    FrameMeta &meta = arena_->meta(frame);
+    meta = FrameMeta();
+    meta.length = static_cast<uint16_t>(length);
+  }
+}
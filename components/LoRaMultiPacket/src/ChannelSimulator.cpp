@@ -0,0 +1,141 @@
+#include "ChannelSimulator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "LinkAdaptation.hpp"
+#include "PacketSerializer.hpp"
+
+ChannelSimulator::ChannelSimulator(const ChannelModel &model)
+    : model_(model),
+      state_(model.seed != 0 ? model.seed : 0x9E3779B97F4A7C15ull)
+{
+}
+
+void ChannelSimulator::transmit(uint32_t sourceId, const uint8_t *frame, size_t length, uint32_t timestampMs)
+{
+  if (frame == nullptr || length == 0 || length > MAX_PACKET_SIZE)
+    return;
+
+  deliver(sourceId, frame, length, timestampMs, static_cast<float>(model_.snrDb));
+}
+
+void ChannelSimulator::transmit(uint32_t sourceId, const uint8_t *frame, size_t length, uint32_t timestampMs,
+                                const LoRaModulation &modulation)
+{
+  if (frame == nullptr || length == 0 || length > MAX_PACKET_SIZE)
+    return;
+
+  // Noise power grows with bandwidth: 250 kHz costs 3 dB of SNR against 125 kHz.
+  double snr = model_.snrDb - 10.0 * std::log10(static_cast<double>(modulation.bandwidthHz) / 125000.0);
+  if (model_.snrJitterDb > 0.0)
+    snr += (2.0 * uniform() - 1.0) * model_.snrJitterDb;
+
+  double margin = snr - LinkAdaptationController::requiredSnrDb(modulation.spreadingFactor);
+  if (uniform() < 1.0 / (1.0 + std::exp(2.0 * margin)))
+    return;
+
+  deliver(sourceId, frame, length, timestampMs, static_cast<float>(snr));
+}
+
+void ChannelSimulator::deliver(uint32_t sourceId, const uint8_t *frame, size_t length, uint32_t timestampMs,
+                               float snrDb)
+{
+  if (uniform() < model_.lossProbability)
+    return;
+
+  SimulatedFrame delivered;
+  delivered.sourceId = sourceId;
+  delivered.timestampMs = timestampMs + model_.latencyMs;
+  delivered.snrDb = snrDb;
+  delivered.length = static_cast<uint16_t>(length);
+  std::memcpy(delivered.bytes, frame, length);
+
+  bool corrupt = uniform() < model_.corruptProbability;
+  if (!corrupt && model_.bitErrorRate > 0.0)
+  {
+    // Probability that at least one of the frame's bits is flipped.
+    corrupt = uniform() < 1.0 - std::pow(1.0 - model_.bitErrorRate, static_cast<double>(length * 8));
+  }
+  if (corrupt)
+  {
+    uint64_t bit = nextRandom() % (length * 8);
+    delivered.bytes[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+  }
+
+  enqueue(delivered);
+
+  if (uniform() < model_.duplicateProbability)
+  {
+    enqueue(delivered);
+  }
+}
+
+void ChannelSimulator::transmitMessage(uint32_t sourceId, const std::vector<Packet> &packets, uint32_t startMs, uint32_t frameIntervalMs)
+{
+  uint8_t buffer[MAX_PACKET_SIZE];
+  uint32_t timestamp = startMs;
+  for (const auto &packet : packets)
+  {
+    PacketSerializer::serialize(packet, buffer);
+    transmit(sourceId, buffer, sizeof(Packet), timestamp);
+    timestamp += frameIntervalMs;
+  }
+}
+
+bool ChannelSimulator::receive(SimulatedFrame &frame)
+{
+  if (inFlight_.empty())
+    return false;
+
+  frame = inFlight_.front();
+  inFlight_.pop_front();
+  return true;
+}
+
+bool ChannelSimulator::receive(SimulatedFrame &frame, uint32_t currentTimestampMs)
+{
+  // Wrap-safe: deliver frames whose delivery time is not in the future.
+  if (inFlight_.empty() || static_cast<int32_t>(currentTimestampMs - inFlight_.front().timestampMs) < 0)
+    return false;
+  return receive(frame);
+}
+
+std::vector<SimulatedFrame> ChannelSimulator::drain()
+{
+  std::vector<SimulatedFrame> frames(inFlight_.begin(), inFlight_.end());
+  inFlight_.clear();
+  return frames;
+}
+
+double ChannelSimulator::uniform()
+{
+  // 53 random mantissa bits -> [0, 1)
+  return static_cast<double>(nextRandom() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+uint64_t ChannelSimulator::nextRandom()
+{
+  state_ ^= state_ >> 12;
+  state_ ^= state_ << 25;
+  state_ ^= state_ >> 27;
+  return state_ * 0x2545F4914F6CDD1Dull;
+}
+
+void ChannelSimulator::enqueue(const SimulatedFrame &frame)
+{
+  inFlight_.push_back(frame);
+
+  if (model_.reorderWindow > 0 && inFlight_.size() > 1)
+  {
+    // Swap the new frame with one of the last 'reorderWindow' frames still in flight.
+    size_t window = std::min(model_.reorderWindow, inFlight_.size() - 1);
+    size_t offset = static_cast<size_t>(nextRandom() % (window + 1));
+    if (offset > 0)
+    {
+      std::swap(inFlight_.back(), inFlight_[inFlight_.size() - 1 - offset]);
+    }
+  }
+}
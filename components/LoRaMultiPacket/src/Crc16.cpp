@@ -0,0 +1,255 @@
+#include "Crc16.hpp"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LMP_CRC_X86 1
+#endif
+
+namespace
+{
+/**
+ * @brief Slice-by-4 lookup tables.
+ * TABLES[k][b] is the CRC contribution of byte b followed by k zero bytes.
+ */
+struct CrcTables
+{
+  uint16_t t[4][256];
+
+  constexpr CrcTables() : t()
+  {
+    for (unsigned b = 0; b < 256; b++)
+    {
+      uint16_t crc = static_cast<uint16_t>(b);
+      for (int j = 0; j < 8; j++)
+        crc = (crc & 1) ? static_cast<uint16_t>((crc >> 1) ^ Crc16::POLYNOMIAL) : static_cast<uint16_t>(crc >> 1);
+      t[0][b] = crc;
+    }
+    for (int k = 1; k < 4; k++)
+    {
+      for (unsigned b = 0; b < 256; b++)
+      {
+        uint16_t prev = t[k - 1][b];
+        t[k][b] = static_cast<uint16_t>((prev >> 8) ^ t[0][prev & 0xFF]);
+      }
+    }
+  }
+};
+
+constexpr CrcTables TABLES{};
+
+inline uint16_t step1(uint16_t crc, uint8_t byte)
+{
+  return static_cast<uint16_t>((crc >> 8) ^ TABLES.t[0][(crc ^ byte) & 0xFF]);
+}
+
+inline uint16_t step4(uint16_t crc, const uint8_t *p)
+{
+  uint16_t x = static_cast<uint16_t>(crc ^ (p[0] | (p[1] << 8)));
+  return static_cast<uint16_t>(TABLES.t[3][x & 0xFF] ^ TABLES.t[2][x >> 8] ^ TABLES.t[1][p[2]] ^ TABLES.t[0][p[3]]);
+}
+
+uint16_t updateSliced(uint16_t crc, const uint8_t *data, size_t length)
+{
+  size_t i = 0;
+  for (; i + 4 <= length; i += 4)
+    crc = step4(crc, data + i);
+  for (; i < length; i++)
+    crc = step1(crc, data[i]);
+  return crc;
+}
+
+#ifdef LMP_CRC_X86
+/**
+ * @brief x^n mod P, with P = x^16 + x^15 + x^2 + 1, as a reflected 64-bit clmul operand.
+ *
+ * In the reflected domain bit j of a 64-bit lane stands for x^(63-j), so a
+ * remainder of degree < 16 occupies bits 48..63.
+ */
+uint64_t foldConstant(unsigned n)
+{
+  uint32_t r = 1;
+  for (unsigned i = 0; i < n; i++)
+  {
+    r <<= 1;
+    if (r & 0x10000)
+      r ^= 0x18005;
+  }
+  uint64_t reflected = 0;
+  for (unsigned d = 0; d < 16; d++)
+  {
+    if (r & (1u << d))
+      reflected |= 1ull << (63 - d);
+  }
+  return reflected;
+}
+
+/**
+ * @brief Folds 16-byte blocks with PCLMULQDQ, then finishes the residue with the tables.
+ *
+ * The 128-bit accumulator A = x^64 * L + H (L = low lane, H = high lane) is
+ * advanced over the next block B as A * x^128 + B = L * x^192 + H * x^128 + B.
+ * A reflected clmul yields the product times x, hence the x^191 / x^127
+ * constants. The folded value is congruent to the consumed prefix modulo P,
+ * so the CRC of its 16 bytes (from a zero register) continues the CRC.
+ */
+__attribute__((target("pclmul,sse2"))) uint16_t updateFolded(uint16_t crc, const uint8_t *data, size_t length)
+{
+  static const __m128i k = _mm_set_epi64x(static_cast<long long>(foldConstant(127)),
+                                          static_cast<long long>(foldConstant(191)));
+
+  // A non-zero register is equivalent to XORing it into the first two message bytes.
+  __m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  acc = _mm_xor_si128(acc, _mm_cvtsi32_si128(crc));
+
+  size_t offset = 16;
+  for (; offset + 16 <= length; offset += 16)
+  {
+    __m128i lo = _mm_clmulepi64_si128(acc, k, 0x00);
+    __m128i hi = _mm_clmulepi64_si128(acc, k, 0x11);
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset));
+    acc = _mm_xor_si128(_mm_xor_si128(lo, hi), block);
+  }
+
+  alignas(16) uint8_t residue[16];
+  _mm_store_si128(reinterpret_cast<__m128i *>(residue), acc);
+  uint16_t folded = updateSliced(0, residue, sizeof(residue));
+  return updateSliced(folded, data + offset, length - offset);
+}
+
+/**
+ * @brief Lockstep variant of updateFolded() for up to Crc16::MAX_STREAMS buffers.
+ *
+ * A single accumulator is bound by the clmul latency; folding several
+ * independent buffers per iteration keeps the multiplier busy.
+ */
+__attribute__((target("pclmul,sse2"))) void computeMultiFolded(const uint8_t *const *data, const size_t *lengths, size_t lanes, uint16_t *crcs)
+{
+  static const __m128i k = _mm_set_epi64x(static_cast<long long>(foldConstant(127)),
+                                          static_cast<long long>(foldConstant(191)));
+
+  size_t common = lengths[0];
+  for (size_t l = 1; l < lanes; l++)
+    common = std::min(common, lengths[l]);
+  common &= ~static_cast<size_t>(15);
+
+  __m128i acc[Crc16::MAX_STREAMS];
+  for (size_t l = 0; l < lanes; l++)
+  {
+    acc[l] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data[l]));
+    acc[l] = _mm_xor_si128(acc[l], _mm_cvtsi32_si128(Crc16::INITIAL_VALUE));
+  }
+
+  for (size_t offset = 16; offset < common; offset += 16)
+  {
+    for (size_t l = 0; l < lanes; l++)
+    {
+      __m128i lo = _mm_clmulepi64_si128(acc[l], k, 0x00);
+      __m128i hi = _mm_clmulepi64_si128(acc[l], k, 0x11);
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data[l] + offset));
+      acc[l] = _mm_xor_si128(_mm_xor_si128(lo, hi), block);
+    }
+  }
+
+  for (size_t l = 0; l < lanes; l++)
+  {
+    alignas(16) uint8_t residue[16];
+    _mm_store_si128(reinterpret_cast<__m128i *>(residue), acc[l]);
+    uint16_t folded = updateSliced(0, residue, sizeof(residue));
+    crcs[l] = updateSliced(folded, data[l] + common, lengths[l] - common);
+  }
+}
+
+bool detectFolding()
+{
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse2");
+}
+#endif  // LMP_CRC_X86
+}  // namespace
+
+uint16_t Crc16::updateBitwise(uint16_t crc, const uint8_t *data, size_t length)
+{
+  for (size_t i = 0; i < length; i++)
+  {
+    crc ^= data[i];
+    for (uint8_t j = 0; j < 8; j++)
+    {
+      if (crc & 0x0001)
+        crc = (crc >> 1) ^ POLYNOMIAL;
+      else
+        crc = crc >> 1;
+    }
+  }
+  return crc;
+}
+
+uint16_t Crc16::update(uint16_t crc, const uint8_t *data, size_t length)
+{
+#ifdef LMP_CRC_X86
+  if (length >= FOLD_THRESHOLD && hasFolding())
+    return updateFolded(crc, data, length);
+#endif
+  return updateSliced(crc, data, length);
+}
+
+void Crc16::computeMulti(const uint8_t *const *data, const size_t *lengths, size_t count, uint16_t *crcs)
+{
+  for (size_t base = 0; base < count; base += MAX_STREAMS)
+  {
+    size_t lanes = std::min(MAX_STREAMS, count - base);
+    const uint8_t *const *ptr = data + base;
+    const size_t *len = lengths + base;
+
+#ifdef LMP_CRC_X86
+    size_t shortest = *std::min_element(len, len + lanes);
+    if (shortest >= 32 && hasFolding())
+    {
+      computeMultiFolded(ptr, len, lanes, crcs + base);
+      continue;
+    }
+#endif
+
+    uint16_t crc[MAX_STREAMS];
+    size_t common = len[0];
+    for (size_t l = 0; l < lanes; l++)
+    {
+      crc[l] = INITIAL_VALUE;
+      common = std::min(common, len[l]);
+    }
+    common &= ~static_cast<size_t>(3);
+
+    // Lockstep over the shared prefix: one slice-by-4 step per lane per
+    // iteration, so MAX_STREAMS independent lookup chains are in flight.
+    if (lanes == MAX_STREAMS)
+    {
+      for (size_t i = 0; i < common; i += 4)
+      {
+        for (size_t l = 0; l < MAX_STREAMS; l++)
+          crc[l] = step4(crc[l], ptr[l] + i);
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < common; i += 4)
+      {
+        for (size_t l = 0; l < lanes; l++)
+          crc[l] = step4(crc[l], ptr[l] + i);
+      }
+    }
+
+    for (size_t l = 0; l < lanes; l++)
+      crcs[base + l] = updateSliced(crc[l], ptr[l] + common, len[l] - common);
+  }
+}
+
+bool Crc16::hasFolding()
+{
+#ifdef LMP_CRC_X86
+  static const bool supported = detectFolding();
+  return supported;
+#else
+  return false;
+#endif
+}
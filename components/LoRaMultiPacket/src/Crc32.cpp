@@ -0,0 +1,29 @@
+#include "Crc32.hpp"
+
+namespace
+{
+struct Crc32Table
+{
+  uint32_t t[256];
+
+  constexpr Crc32Table() : t()
+  {
+    for (uint32_t b = 0; b < 256; b++)
+    {
+      uint32_t crc = b;
+      for (int j = 0; j < 8; j++)
+        crc = (crc & 1) ? (crc >> 1) ^ Crc32::POLYNOMIAL : crc >> 1;
+      t[b] = crc;
+    }
+  }
+};
+
+constexpr Crc32Table TABLE{};
+}  // namespace
+
+uint32_t Crc32::update(uint32_t crc, const uint8_t *data, size_t length)
+{
+  for (size_t i = 0; i < length; i++)
+    crc = (crc >> 8) ^ TABLE.t[(crc ^ data[i]) & 0xFF];
+  return crc;
+}
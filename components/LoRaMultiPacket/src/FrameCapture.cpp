@@ -0,0 +1,281 @@
+#include "FrameCapture.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#if !defined(ESP_PLATFORM) && (defined(__unix__) || defined(__APPLE__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LMP_CAPTURE_MMAP 1
+#endif
+
+namespace
+{
+int16_t toDeci(float value)
+{
+  float scaled = std::round(value * 10.0f);
+  if (scaled > 32767.0f)
+    return 32767;
+  if (scaled < -32768.0f)
+    return -32768;
+  return static_cast<int16_t>(scaled);
+}
+}  // namespace
+
+// ============================================================================
+// CaptureWriter
+// ============================================================================
+
+CaptureWriter::CaptureWriter(Sink sink, uint32_t indexStride)
+    : sink_(std::move(sink)), indexStride_(indexStride)
+{
+}
+
+bool CaptureWriter::begin()
+{
+  CaptureFileHeader header{};
+  std::memcpy(header.magic, CAPTURE_FILE_MAGIC, sizeof(header.magic));
+  header.version = CAPTURE_FORMAT_VERSION;
+  header.recordHeaderSize = sizeof(CaptureRecordHeader);
+  return emit(&header, sizeof(header));
+}
+
+bool CaptureWriter::write(const uint8_t *frame, size_t length, const FrameMeta &meta)
+{
+  if (frame == nullptr || length > MAX_PACKET_SIZE)
+    return false;
+
+  if (indexStride_ != 0 && recordCount_ % indexStride_ == 0)
+  {
+    index_.push_back(CaptureIndexEntry{offset_, meta.timestampMs});
+  }
+
+  // Header and frame go out in one sink call.
+  uint8_t record[sizeof(CaptureRecordHeader) + MAX_PACKET_SIZE];
+  CaptureRecordHeader header;
+  header.timestampMs = meta.timestampMs;
+  header.sourceId = meta.sourceId;
+  header.rssiDeci = toDeci(meta.rssi);
+  header.snrDeci = toDeci(meta.snr);
+  header.length = static_cast<uint16_t>(length);
+  std::memcpy(record, &header, sizeof(header));
+  std::memcpy(record + sizeof(header), frame, length);
+
+  if (!emit(record, sizeof(header) + length))
+    return false;
+  recordCount_++;
+  return true;
+}
+
+bool CaptureWriter::writeBatch(const FrameArena &batch)
+{
+  for (size_t i = 0; i < batch.size(); i++)
+  {
+    if (!write(batch.slot(i), batch.meta(i).length, batch.meta(i)))
+      return false;
+  }
+  return true;
+}
+
+bool CaptureWriter::finish()
+{
+  CaptureFooter footer{};
+  footer.indexOffset = offset_;
+  footer.recordCount = recordCount_;
+  footer.indexEntries = static_cast<uint32_t>(index_.size());
+  footer.indexStride = indexStride_;
+  std::memcpy(footer.magic, CAPTURE_FOOTER_MAGIC, sizeof(footer.magic));
+
+  if (!index_.empty() && !emit(index_.data(), index_.size() * sizeof(CaptureIndexEntry)))
+    return false;
+  return emit(&footer, sizeof(footer));
+}
+
+bool CaptureWriter::emit(const void *data, size_t length)
+{
+  if (!sink_ || !sink_(static_cast<const uint8_t *>(data), length))
+    return false;
+  offset_ += length;
+  return true;
+}
+
+// ============================================================================
+// CaptureReader
+// ============================================================================
+
+CaptureReader::~CaptureReader()
+{
+  close();
+}
+
+bool CaptureReader::openFile(const char *path)
+{
+  close();
+#ifdef LMP_CAPTURE_MMAP
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CaptureFileHeader)))
+  {
+    ::close(fd);
+    return false;
+  }
+
+  void *mapping = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);  // The mapping keeps the file referenced.
+  if (mapping == MAP_FAILED)
+    return false;
+
+  // Replay reads front to back.
+  ::madvise(mapping, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+  mapping_ = mapping;
+  mappingSize_ = static_cast<size_t>(st.st_size);
+  data_ = static_cast<const uint8_t *>(mapping);
+  size_ = mappingSize_;
+  if (!parseLayout())
+  {
+    close();
+    return false;
+  }
+  return true;
+#else
+  (void)path;
+  return false;
+#endif
+}
+
+bool CaptureReader::openBuffer(const uint8_t *data, size_t size)
+{
+  close();
+  data_ = data;
+  size_ = size;
+  if (!parseLayout())
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void CaptureReader::close()
+{
+#ifdef LMP_CAPTURE_MMAP
+  if (mapping_ != nullptr)
+    ::munmap(mapping_, mappingSize_);
+#endif
+  mapping_ = nullptr;
+  mappingSize_ = 0;
+  data_ = nullptr;
+  size_ = 0;
+  recordsEnd_ = 0;
+  cursor_ = 0;
+  footer_ = nullptr;
+}
+
+bool CaptureReader::parseLayout()
+{
+  if (data_ == nullptr || size_ < sizeof(CaptureFileHeader))
+    return false;
+
+  CaptureFileHeader header;
+  std::memcpy(&header, data_, sizeof(header));
+  if (std::memcmp(header.magic, CAPTURE_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != CAPTURE_FORMAT_VERSION || header.recordHeaderSize < sizeof(CaptureRecordHeader))
+    return false;
+  recordHeaderSize_ = header.recordHeaderSize;
+
+  recordsEnd_ = size_;
+  if (size_ >= sizeof(CaptureFileHeader) + sizeof(CaptureFooter))
+  {
+    const auto *footer = reinterpret_cast<const CaptureFooter *>(data_ + size_ - sizeof(CaptureFooter));
+    bool magicOk = std::memcmp(footer->magic, CAPTURE_FOOTER_MAGIC, sizeof(footer->magic)) == 0;
+    uint64_t indexBytes = static_cast<uint64_t>(footer->indexEntries) * sizeof(CaptureIndexEntry);
+    if (magicOk && footer->indexOffset >= sizeof(CaptureFileHeader) &&
+        footer->indexOffset + indexBytes + sizeof(CaptureFooter) == size_)
+    {
+      footer_ = footer;
+      recordsEnd_ = static_cast<size_t>(footer->indexOffset);
+    }
+  }
+
+  cursor_ = sizeof(CaptureFileHeader);
+  return true;
+}
+
+bool CaptureReader::next(CaptureRecord &record)
+{
+  if (cursor_ + recordHeaderSize_ > recordsEnd_)
+    return false;
+
+  CaptureRecordHeader header;
+  std::memcpy(&header, data_ + cursor_, sizeof(header));
+  size_t frameStart = cursor_ + recordHeaderSize_;
+  if (frameStart + header.length > recordsEnd_)
+    return false;  // Truncated tail.
+
+  record.meta.timestampMs = header.timestampMs;
+  record.meta.sourceId = header.sourceId;
+  record.meta.rssi = header.rssiDeci / 10.0f;
+  record.meta.snr = header.snrDeci / 10.0f;
+  record.meta.length = header.length;
+  record.frame = data_ + frameStart;
+
+  cursor_ = frameStart + header.length;
+  return true;
+}
+
+void CaptureReader::rewind()
+{
+  cursor_ = sizeof(CaptureFileHeader);
+}
+
+void CaptureReader::seek(uint32_t timestampMs)
+{
+  rewind();
+
+  if (footer_ != nullptr && footer_->indexEntries > 0)
+  {
+    // Last index entry that starts before the requested time.
+    const auto *entries = reinterpret_cast<const CaptureIndexEntry *>(data_ + footer_->indexOffset);
+    for (uint32_t i = 0; i < footer_->indexEntries; i++)
+    {
+      CaptureIndexEntry entry;
+      std::memcpy(&entry, &entries[i], sizeof(entry));
+      if (entry.timestampMs >= timestampMs)
+        break;
+      cursor_ = static_cast<size_t>(entry.offset);
+    }
+  }
+
+  // Fine positioning inside the stride.
+  size_t position = cursor_;
+  CaptureRecord record;
+  while (next(record))
+  {
+    if (record.meta.timestampMs >= timestampMs)
+      break;
+    position = cursor_;
+  }
+  cursor_ = position;
+}
+
+uint64_t CaptureReader::recordCount()
+{
+  if (footer_ != nullptr)
+    return footer_->recordCount;
+
+  size_t saved = cursor_;
+  rewind();
+  uint64_t count = 0;
+  CaptureRecord record;
+  while (next(record))
+    count++;
+  cursor_ = saved;
+  return count;
+}
@@ -0,0 +1,160 @@
+#include "FrameRelay.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "PacketParser.hpp"
+#include "PacketSerializer.hpp"
+
+FrameRelay::FrameRelay(ITransport &uplink, ITransport &downlink, const RelayConfig &config)
+    : uplink_(uplink),
+      downlink_(downlink),
+      config_(config),
+      flows_(std::max<size_t>(config.flowCount, 1)),
+      queue_(std::max<size_t>(config.queueFrames, 1))
+{
+  config_.maxHops = std::min(config_.maxHops, PACKET_MAX_HOPS);
+  uplink_.setReceiveCallback([this](const uint8_t *frame, size_t length, const FrameMeta &meta) {
+    onFrame(frame, length, meta);
+  });
+  downlink_.setTransmitDoneCallback([this]() { onTransmitDone(); });
+}
+
+FrameRelay::~FrameRelay()
+{
+  uplink_.setReceiveCallback(nullptr);
+  downlink_.setTransmitDoneCallback(nullptr);
+}
+
+FrameRelay::Verdict FrameRelay::onFrame(const uint8_t *frame, size_t length, const FrameMeta &meta)
+{
+  stats_.framesReceived++;
+  Packet packet;
+  Verdict verdict = classify(frame, length, meta, packet);
+  if (observer_ && verdict != Verdict::Invalid)
+    observer_(packet, meta, verdict);
+  return verdict;
+}
+
+FrameRelay::Verdict FrameRelay::classify(const uint8_t *frame, size_t length, const FrameMeta &meta, Packet &packet)
+{
+  auto parsed = PacketParser::parse(frame, length);
+  if (!parsed.has_value())
+  {
+    stats_.invalid++;
+    return Verdict::Invalid;
+  }
+  packet = *parsed;
+  PacketHeader &header = packet.header;
+
+  if ((header.flags & PACKET_FLAG_CONTROL) != 0 && !config_.forwardControl)
+  {
+    stats_.control++;
+    return Verdict::Control;
+  }
+
+  uint8_t hops = packetHops(header.flags);
+  if (hops >= config_.maxHops)
+  {
+    stats_.hopLimit++;
+    return Verdict::HopLimit;
+  }
+
+  Flow &flow = flowFor(meta.sourceId, header.messageId, header.totalChunks, meta.timestampMs);
+  if (flow.forwarded.test(header.chunkIndex))
+  {
+    stats_.duplicates++;
+    return Verdict::Duplicate;
+  }
+
+  if (queued_ == queue_.size())
+  {
+    stats_.queueDrops++;  // Not marked: a later copy may still get through.
+    return Verdict::QueueFull;
+  }
+  flow.forwarded.set(header.chunkIndex);
+
+  // Same layout as received, one more hop.
+  Packet stamped = packet;
+  stamped.header.flags = static_cast<uint8_t>((header.flags & ~PACKET_HOPS_MASK) | ((hops + 1) << PACKET_HOPS_SHIFT));
+  stamped.calculateCRC();
+
+  QueuedFrame &slot = queue_[(head_ + queued_) % queue_.size()];
+  if (length == PacketSerializer::compactSize(stamped))
+  {
+    slot.length = static_cast<uint16_t>(PacketSerializer::serializeCompact(stamped, slot.bytes));
+  }
+  else
+  {
+    PacketSerializer::serialize(stamped, slot.bytes);
+    slot.length = static_cast<uint16_t>(MAX_TX_PACKET_SIZE);
+  }
+  slot.receivedMs = meta.timestampMs;
+  queued_++;
+  return Verdict::Forwarded;
+}
+
+FrameRelay::Flow &FrameRelay::flowFor(uint32_t sourceId, uint16_t messageId, uint16_t totalChunks,
+                                      uint32_t currentTimestampMs)
+{
+  Flow *oldest = nullptr;
+  for (Flow &flow : flows_)
+  {
+    if (flow.active && currentTimestampMs - flow.lastSeenMs > config_.flowTimeoutMs)
+      flow.active = false;
+
+    if (flow.active && flow.sourceId == sourceId && flow.messageId == messageId)
+    {
+      if (flow.totalChunks != totalChunks)
+        flow.forwarded.reset();  // Message ID reused for another message.
+      flow.totalChunks = totalChunks;
+      flow.lastSeenMs = currentTimestampMs;
+      return flow;
+    }
+
+    if (oldest == nullptr || (oldest->active && (!flow.active || flow.lastSeenMs - oldest->lastSeenMs > UINT32_MAX / 2)))
+      oldest = &flow;
+  }
+
+  if (oldest->active)
+    stats_.flowsEvicted++;
+  oldest->active = true;
+  oldest->sourceId = sourceId;
+  oldest->messageId = messageId;
+  oldest->totalChunks = totalChunks;
+  oldest->lastSeenMs = currentTimestampMs;
+  oldest->forwarded.reset();
+  return *oldest;
+}
+
+void FrameRelay::poll(uint32_t currentTimestampMs)
+{
+  uplink_.poll(currentTimestampMs);
+  if (&downlink_ != &uplink_)
+    downlink_.poll(currentTimestampMs);
+
+  if (transmitting_ || queued_ == 0)
+    return;
+
+  QueuedFrame &frame = queue_[head_];
+  if (!downlink_.startTransmit(frame.bytes, frame.length))
+  {
+    stats_.radioErrors++;
+    return;
+  }
+  transmitting_ = true;
+  uint32_t residence = currentTimestampMs - frame.receivedMs;
+  stats_.residenceMsTotal += residence;
+  stats_.residenceMsMax = std::max(stats_.residenceMsMax, residence);
+}
+
+void FrameRelay::onTransmitDone()
+{
+  if (!transmitting_)
+    return;
+  downlink_.finishTransmit();
+  transmitting_ = false;
+  head_ = (head_ + 1) % queue_.size();
+  queued_--;
+  stats_.framesForwarded++;
+}
@@ -0,0 +1,238 @@
+#include "FrameStreamDecoder.hpp"
+
+#include <cstring>
+
+#include "PacketValidator.hpp"
+
+namespace
+{
+constexpr size_t VERSION_OFFSET = offsetof(PacketHeader, protocolVersion);
+constexpr uint8_t PROTOCOL_VERSION = PacketHeader().protocolVersion;
+
+size_t frameLength(const uint8_t *header)
+{
+  return HEADER_SIZE + header[offsetof(PacketHeader, payloadSize)] + CRC_SIZE;
+}
+
+bool crcMatches(const uint8_t *frame, size_t length)
+{
+  using Checksum = DefaultProfile::Checksum;
+  DefaultProfile::Crc received;
+  std::memcpy(&received, frame + length - CRC_SIZE, CRC_SIZE);
+  return Checksum::finalize(Checksum::update(Checksum::INITIAL_VALUE, frame, length - CRC_SIZE)) == received;
+}
+}  // namespace
+
+void FrameStreamDecoder::push(const uint8_t *data, size_t length)
+{
+  input_ = data;
+  inputLength_ = data != nullptr ? length : 0;
+  inputPos_ = 0;
+  carryFromInput_ = 0;
+  stats_.bytesReceived += inputLength_;
+}
+
+std::optional<PacketView> FrameStreamDecoder::next()
+{
+  if (carryEmitted_ > 0)
+  {
+    // Bytes after the returned frame may have been pulled in for an abandoned candidate.
+    size_t consumed = carryEmitted_;
+    carryEmitted_ = 0;
+    advanceCarry(consumed);
+  }
+
+  if (carryEnd_ > carryHead_)
+  {
+    auto view = nextFromCarry();
+    if (view.has_value() || carryEnd_ > carryHead_)
+      return view;  // A frame, or still waiting for more bytes.
+  }
+
+  while (true)
+  {
+    size_t available = inputLength_ - inputPos_;
+    if (available < HEADER_SIZE)
+    {
+      stash(inputPos_);
+      return std::nullopt;
+    }
+
+    // Skip to the next byte that can be a protocol version field.
+    const uint8_t *scan = input_ + inputPos_ + VERSION_OFFSET;
+    const void *hit = std::memchr(scan, PROTOCOL_VERSION, available - VERSION_OFFSET);
+    if (hit == nullptr)
+    {
+      // The last bytes may still start a header whose version byte is in the next fragment.
+      size_t keep = inputLength_ - VERSION_OFFSET;
+      stats_.bytesDiscarded += keep - inputPos_;
+      stash(keep);
+      return std::nullopt;
+    }
+    size_t candidate = static_cast<size_t>(static_cast<const uint8_t *>(hit) - input_) - VERSION_OFFSET;
+    stats_.bytesDiscarded += candidate - inputPos_;
+    inputPos_ = candidate;
+
+    const uint8_t *frame = input_ + inputPos_;
+    if (!PacketValidator::plausibleHeader(frame))
+    {
+      inputPos_++;
+      stats_.bytesDiscarded++;
+      continue;
+    }
+
+    size_t length = frameLength(frame);
+    if (length > inputLength_ - inputPos_)
+    {
+      stash(inputPos_);
+      return std::nullopt;
+    }
+
+    if (crcMatches(frame, length))
+    {
+      inputPos_ += length;
+      stats_.framesDecoded++;
+      return PacketView{frame, length};
+    }
+
+    stats_.crcErrors++;
+    inputPos_++;
+    stats_.bytesDiscarded++;
+  }
+}
+
+std::optional<PacketView> FrameStreamDecoder::nextFromCarry()
+{
+  while (carryEnd_ > carryHead_)
+  {
+    if (!topUpCarry(HEADER_SIZE))
+    {
+      if (!flushing_)
+        return std::nullopt;
+      dropCarryByte();  // After flush(): too short to be a frame, no more bytes will come.
+      continue;
+    }
+
+    const uint8_t *frame = carry_ + carryHead_;
+    if (!PacketValidator::plausibleHeader(frame))
+    {
+      dropCarryByte();
+      continue;
+    }
+
+    size_t length = frameLength(frame);
+    if (!topUpCarry(length))
+    {
+      if (!flushing_)
+        return std::nullopt;
+      dropCarryByte();  // After flush(): another truncated candidate.
+      continue;
+    }
+    frame = carry_ + carryHead_;  // topUpCarry() may have moved the bytes.
+
+    if (crcMatches(frame, length))
+    {
+      carryEmitted_ = length;
+      stats_.framesDecoded++;
+      stats_.framesCopied++;
+      return PacketView{frame, length};
+    }
+
+    stats_.crcErrors++;
+    dropCarryByte();
+  }
+  return std::nullopt;
+}
+
+bool FrameStreamDecoder::topUpCarry(size_t needed)
+{
+  size_t have = carryEnd_ - carryHead_;
+  if (have >= needed)
+    return true;
+
+  if (carryHead_ + needed > sizeof(carry_))
+  {
+    std::memmove(carry_, carry_ + carryHead_, have);
+    carryHead_ = 0;
+    carryEnd_ = have;
+  }
+
+  size_t take = needed - have;
+  size_t available = inputLength_ - inputPos_;
+  if (take > available)
+    take = available;
+  std::memcpy(carry_ + carryEnd_, input_ + inputPos_, take);
+  carryEnd_ += take;
+  inputPos_ += take;
+  carryFromInput_ += take;
+  return have + take >= needed;
+}
+
+void FrameStreamDecoder::dropCarryByte()
+{
+  stats_.bytesDiscarded++;
+  advanceCarry(1);
+}
+
+void FrameStreamDecoder::advanceCarry(size_t count)
+{
+  carryHead_ += count;
+
+  // Once every remaining byte came from the current fragment, scan it in place again.
+  size_t remaining = carryEnd_ - carryHead_;
+  if (remaining <= carryFromInput_)
+  {
+    inputPos_ -= remaining;
+    clearCarry();
+  }
+}
+
+void FrameStreamDecoder::clearCarry()
+{
+  carryHead_ = 0;
+  carryEnd_ = 0;
+  carryFromInput_ = 0;
+  carryEmitted_ = 0;
+  flushing_ = false;
+}
+
+void FrameStreamDecoder::stash(size_t from)
+{
+  // Only reached with an empty carry: the tail is shorter than a frame.
+  size_t length = inputLength_ - from;
+  std::memcpy(carry_, input_ + from, length);
+  carryHead_ = 0;
+  carryEnd_ = length;
+  carryFromInput_ = length;
+  inputPos_ = inputLength_;
+}
+
+void FrameStreamDecoder::flush()
+{
+  carryHead_ += carryEmitted_;
+  carryEmitted_ = 0;
+
+  // The held bytes no longer refer to the fragment, which may be gone by now.
+  input_ = nullptr;
+  inputLength_ = 0;
+  inputPos_ = 0;
+  carryFromInput_ = 0;
+  if (carryEnd_ == carryHead_)
+  {
+    clearCarry();
+    return;
+  }
+
+  // Abandon the stalled candidate only: frames held behind it are returned by next().
+  flushing_ = true;
+  dropCarryByte();
+}
+
+void FrameStreamDecoder::reset()
+{
+  input_ = nullptr;
+  inputLength_ = 0;
+  inputPos_ = 0;
+  clearCarry();
+  stats_ = Stats();
+}
@@ -0,0 +1,211 @@
+#include "LinkAdaptation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+LoRaModulation LinkProfile::modulation(const LoRaModulation &base) const
+{
+  LoRaModulation result = base;
+  result.spreadingFactor = spreadingFactor;
+  result.bandwidthHz = bandwidthHz;
+  result.codingRate = codingRate;
+  return result;
+}
+
+bool LinkProfile::operator==(const LinkProfile &other) const
+{
+  return spreadingFactor == other.spreadingFactor && bandwidthHz == other.bandwidthHz &&
+         codingRate == other.codingRate && chunkPayloadSize == other.chunkPayloadSize;
+}
+
+LinkAdaptationController::LinkAdaptationController(const LinkAdaptationConfig &config)
+    : config_(config), index_(std::min(config.initialIndex, config.ladder.size() - 1))
+{
+}
+
+float LinkAdaptationController::requiredSnrDb(uint8_t spreadingFactor)
+{
+  // SF5: -2.5 dB ... SF12: -20 dB, 2.5 dB per step.
+  return -2.5f * static_cast<float>(spreadingFactor - 4);
+}
+
+void LinkAdaptationController::onFeedback(const LinkSample &sample, uint32_t currentTimestampMs)
+{
+  window_.push_back(sample);
+  if (window_.size() > config_.windowSize)
+    window_.pop_front();
+  lastFeedbackMs_ = currentTimestampMs;
+  if (!started_)
+  {
+    started_ = true;
+    lastChangeMs_ = currentTimestampMs;
+  }
+}
+
+float LinkAdaptationController::lossRate() const
+{
+  if (window_.empty())
+    return 0.0f;
+  size_t lost = std::count_if(window_.begin(), window_.end(), [](const LinkSample &s)
+                              { return !s.delivered; });
+  return static_cast<float>(lost) / static_cast<float>(window_.size());
+}
+
+float LinkAdaptationController::marginOn(size_t index, float meanSnrDb) const
+{
+  // Noise power scales with bandwidth: the same signal on half the bandwidth gains 3 dB.
+  const LinkProfile &now = current();
+  const LinkProfile &candidate = config_.ladder[index];
+  float bandwidthGain = 10.0f * std::log10(static_cast<float>(now.bandwidthHz) / static_cast<float>(candidate.bandwidthHz));
+  return meanSnrDb + bandwidthGain - requiredSnrDb(candidate.spreadingFactor) - config_.marginDb;
+}
+
+std::optional<LinkProfile> LinkAdaptationController::update(uint32_t currentTimestampMs)
+{
+  const size_t last = config_.ladder.size() - 1;
+  if (!started_)
+  {
+    // The silence timeout counts from the first call.
+    started_ = true;
+    lastFeedbackMs_ = currentTimestampMs;
+    lastChangeMs_ = currentTimestampMs;
+    return std::nullopt;
+  }
+
+  if (currentTimestampMs - lastFeedbackMs_ > config_.feedbackTimeoutMs)
+  {
+    lastFeedbackMs_ = currentTimestampMs;  // Do not re-trigger on every call.
+    return moveTo(last, currentTimestampMs);
+  }
+
+  if (window_.size() < config_.minSamples)
+    return std::nullopt;
+
+  float snrSum = 0.0f;
+  size_t delivered = 0;
+  for (const LinkSample &sample : window_)
+  {
+    if (sample.delivered)
+    {
+      snrSum += sample.snrDb;
+      delivered++;
+    }
+  }
+
+  // First rung (fastest) on which the measured SNR leaves the required margin.
+  size_t best = last;
+  if (delivered > 0)
+  {
+    float meanSnr = snrSum / static_cast<float>(delivered);
+    for (size_t i = 0; i < config_.ladder.size(); i++)
+    {
+      if (marginOn(i, meanSnr) >= 0.0f)
+      {
+        best = i;
+        break;
+      }
+    }
+  }
+
+  if (lossRate() > config_.maxLossRate || best > index_)
+  {
+    // Degrading: protect the link now.
+    return moveTo(std::min(std::max(best, index_ + 1), last), currentTimestampMs);
+  }
+
+  if (best < index_ && currentTimestampMs - lastChangeMs_ >= config_.stepUpHoldMs)
+  {
+    // Improving: one careful step at a time.
+    return moveTo(index_ - 1, currentTimestampMs);
+  }
+
+  return std::nullopt;
+}
+
+std::optional<LinkProfile> LinkAdaptationController::moveTo(size_t index, uint32_t currentTimestampMs)
+{
+  if (index == index_)
+    return std::nullopt;
+
+  index_ = index;
+  window_.clear();
+  lastChangeMs_ = currentTimestampMs;
+  return current();
+}
+
+void LinkAnnouncement::encode(const LinkProfile &profile, uint8_t *out)
+{
+  out[0] = TYPE;
+  out[1] = profile.spreadingFactor;
+  out[2] = profile.codingRate;
+  for (size_t i = 0; i < 4; i++)
+    out[3 + i] = static_cast<uint8_t>(profile.bandwidthHz >> (8 * i));
+  out[7] = static_cast<uint8_t>(profile.chunkPayloadSize);
+  out[8] = static_cast<uint8_t>(profile.chunkPayloadSize >> 8);
+}
+
+std::optional<LinkProfile> LinkAnnouncement::decode(const Packet &packet)
+{
+  const auto &header = packet.header;
+  if ((header.flags & PACKET_FLAG_CONTROL) == 0 || header.totalChunks != 1 || header.payloadSize != SIZE ||
+      packet.payload.data[0] != TYPE)
+  {
+    return std::nullopt;
+  }
+
+  const uint8_t *in = packet.payload.data;
+  LinkProfile profile;
+  profile.spreadingFactor = in[1];
+  profile.codingRate = in[2];
+  profile.bandwidthHz = 0;
+  for (size_t i = 0; i < 4; i++)
+    profile.bandwidthHz |= static_cast<uint32_t>(in[3 + i]) << (8 * i);
+  profile.chunkPayloadSize = static_cast<uint16_t>(in[7] | (in[8] << 8));
+
+  if (profile.spreadingFactor < 5 || profile.spreadingFactor > 12 || profile.codingRate < 5 ||
+      profile.codingRate > 8 || profile.bandwidthHz == 0 || profile.chunkPayloadSize == 0 ||
+      profile.chunkPayloadSize > LORA_MAX_PAYLOAD_SIZE)
+  {
+    return std::nullopt;
+  }
+  return profile;
+}
+
+LinkFollower::LinkFollower(const LinkProfile &initial, const LinkProfile &fallback, uint32_t fallbackAfterMs)
+    : current_(initial), fallback_(fallback), fallbackAfterMs_(fallbackAfterMs)
+{
+}
+
+LinkEvent LinkFollower::onPacket(const Packet &packet, uint32_t currentTimestampMs)
+{
+  lastHeardMs_ = currentTimestampMs;
+  heard_ = true;
+
+  if ((packet.header.flags & PACKET_FLAG_CONTROL) == 0)
+    return LinkEvent::None;
+
+  std::optional<LinkProfile> announced = LinkAnnouncement::decode(packet);
+  if (!announced.has_value() || *announced == current_)
+    return LinkEvent::Control;  // Unknown control frame or a repeated announcement.
+
+  current_ = *announced;
+  return LinkEvent::Changed;
+}
+
+bool LinkFollower::checkTimeout(uint32_t currentTimestampMs)
+{
+  if (!heard_)
+  {
+    heard_ = true;
+    lastHeardMs_ = currentTimestampMs;
+    return false;
+  }
+  if (currentTimestampMs - lastHeardMs_ <= fallbackAfterMs_)
+    return false;
+
+  lastHeardMs_ = currentTimestampMs;
+  if (current_ == fallback_)
+    return false;
+  current_ = fallback_;
+  return true;
+}
@@ -0,0 +1,175 @@
+#include "LinkEndpoint.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "LinkAdaptation.hpp"
+#include "PacketParser.hpp"
+#include "ReassemblyJournal.hpp"
+
+namespace
+{
+uint16_t maxChunkFor(const ITransport &transport)
+{
+  size_t frame = std::min(transport.maxFrameSize(), MAX_TX_PACKET_SIZE);
+  return static_cast<uint16_t>(frame - HEADER_SIZE - CRC_SIZE);
+}
+
+TxEngineConfig engineConfigFor(const ITransport &transport, TxEngineConfig config)
+{
+  // Short transport frames: padding would not fit, send compact frames.
+  if (transport.maxFrameSize() < MAX_TX_PACKET_SIZE)
+    config.compactFrames = true;
+  return config;
+}
+}  // namespace
+
+LinkEndpoint::LinkEndpoint(ITransport &transport, const LinkEndpointConfig &config)
+    : transport_(transport),
+      engine_(transport, engineConfigFor(transport, config.tx)),
+      reassembler_(config.reassembler),
+      maxChunkPayloadSize_(maxChunkFor(transport)),
+      pruneIntervalMs_(config.pruneIntervalMs)
+{
+  transport_.setReceiveCallback([this](const uint8_t *frame, size_t length, const FrameMeta &meta) {
+    onFrame(frame, length, meta);
+  });
+  transport_.setTransmitDoneCallback([this]() { engine_.onTransmitDone(); });
+}
+
+LinkEndpoint::~LinkEndpoint()
+{
+  transport_.setReceiveCallback(nullptr);
+  transport_.setTransmitDoneCallback(nullptr);
+}
+
+uint16_t LinkEndpoint::allocateMessageId()
+{
+  // 0 is rejected by the validator, 0xFFFF is reserved for LinkAnnouncement.
+  uint16_t id;
+  do
+  {
+    id = nextMessageId_.fetch_add(1, std::memory_order_relaxed);
+  } while (id == 0 || id == LinkAnnouncement::MESSAGE_ID);
+  return id;
+}
+
+std::optional<uint16_t> LinkEndpoint::send(std::vector<uint8_t> &&message, const TxOptions &options)
+{
+  TxOptions effective = options;
+  if (maxChunkPayloadSize_ < LORA_MAX_PAYLOAD_SIZE &&
+      (effective.chunkPayloadSize == 0 || effective.chunkPayloadSize > maxChunkPayloadSize_))
+  {
+    effective.chunkPayloadSize = maxChunkPayloadSize_;
+  }
+
+  uint16_t messageId = allocateMessageId();
+  if (!engine_.enqueue(std::move(message), messageId, effective))
+    return std::nullopt;
+  return messageId;
+}
+
+std::optional<uint16_t> LinkEndpoint::send(const uint8_t *data, size_t length, const TxOptions &options)
+{
+  if (data == nullptr)
+    return std::nullopt;
+  return send(std::vector<uint8_t>(data, data + length), options);
+}
+
+void LinkEndpoint::poll(uint32_t currentTimestampMs)
+{
+  transport_.poll(currentTimestampMs);
+  engine_.poll(currentTimestampMs);
+
+  if (!lastPruneMs_.has_value())
+  {
+    lastPruneMs_ = currentTimestampMs;
+  }
+  else if (currentTimestampMs - *lastPruneMs_ >= pruneIntervalMs_)
+  {
+    lastPruneMs_ = currentTimestampMs;
+    stats_.sessionsPruned += reassembler_.pruneStalled(currentTimestampMs);
+  }
+}
+
+size_t LinkEndpoint::requestMissingChunks()
+{
+  TxOptions options;
+  options.priority = TxPriority::Critical;
+  options.control = true;
+
+  // One request per range of chunks whose bitmap fits the transport's frames.
+  size_t perRequest = ChunkRequest::maxChunksFor(maxChunkPayloadSize_);
+  if (perRequest == 0)
+    return 0;
+
+  size_t queued = 0;
+  for (const PacketReassembler::PendingMessage &message : reassembler_.pendingMessages())
+  {
+    ChunkRequest request;
+    request.messageId = message.messageId;
+    request.totalChunks = static_cast<uint8_t>(message.totalChunks);
+    for (size_t index : message.missingChunks)
+      request.missing.set(index);
+
+    for (size_t first = 0; first < message.totalChunks; first += perRequest)
+    {
+      request.firstChunk = static_cast<uint8_t>(first);
+      request.chunkCount = static_cast<uint16_t>(std::min(perRequest, message.totalChunks - first));
+      bool anyMissing = false;
+      for (size_t i = first; i < first + request.chunkCount && !anyMissing; i++)
+        anyMissing = request.missing.test(i);
+      if (!anyMissing)
+        continue;
+
+      std::vector<uint8_t> payload(request.encodedSize());
+      request.encode(payload.data());
+      if (engine_.enqueue(std::move(payload), LinkAnnouncement::MESSAGE_ID, options))
+        queued++;
+    }
+  }
+  return queued;
+}
+
+void LinkEndpoint::onFrame(const uint8_t *frame, size_t length, const FrameMeta &meta)
+{
+  stats_.framesReceived++;
+
+  auto packet = PacketParser::parse(frame, length);
+  if (!packet.has_value())
+  {
+    stats_.framesRejected++;
+    return;
+  }
+
+  if ((packet->header.flags & PACKET_FLAG_CONTROL) != 0)
+  {
+    stats_.controlFrames++;
+    if (engine_.tdma() != nullptr)
+      engine_.tdma()->onBeacon(*packet, meta.timestampMs, length);
+    if (auto request = ChunkRequest::decode(*packet))
+    {
+      stats_.chunkRequests++;
+      if (engine_.resendChunks(request->messageId, request->totalChunks, request->missing))
+        stats_.chunkResends++;
+    }
+    if (onControl_)
+      onControl_(*packet, meta);
+    return;
+  }
+
+  auto message = reassembler_.processPacket(*packet, meta.timestampMs, meta.sourceId);
+  if (message.has_value())
+  {
+    stats_.messagesReceived++;
+    if (onMessage_)
+      onMessage_(meta.sourceId, packet->header.messageId, std::move(message.value()));
+  }
+}
+
+LinkEndpoint::Stats LinkEndpoint::stats() const
+{
+  Stats stats = stats_;
+  stats.tx = engine_.stats();
+  return stats;
+}
@@ -0,0 +1,42 @@
+#include "LoRaAirtime.hpp"
+
+#include <algorithm>
+
+uint32_t LoRaAirtime::symbolTimeUs(const LoRaModulation &modulation)
+{
+  return static_cast<uint32_t>((static_cast<uint64_t>(1000000) << modulation.spreadingFactor) / modulation.bandwidthHz);
+}
+
+bool LoRaAirtime::lowDataRateOptimize(const LoRaModulation &modulation)
+{
+  if (modulation.lowDataRateOptimize.has_value())
+    return *modulation.lowDataRateOptimize;
+  return symbolTimeUs(modulation) >= 16000;
+}
+
+uint32_t LoRaAirtime::frameQuarterSymbols(const LoRaModulation &modulation, size_t payloadBytes)
+{
+  const int32_t sf = modulation.spreadingFactor;
+  const int32_t cr = modulation.codingRate - 4;  // 1..4
+  const int32_t crcBits = modulation.crcEnabled ? 16 : 0;
+  const int32_t headerBits = modulation.explicitHeader ? 20 : 0;
+  const bool smallSf = sf < 7;
+
+  // Payload bits beyond the first 8 symbols, and bits carried per block of (cr + 4) symbols.
+  int32_t bits = 8 * static_cast<int32_t>(payloadBytes) + crcBits - 4 * sf + headerBits + (smallSf ? 0 : 8);
+  int32_t bitsPerBlock = 4 * (lowDataRateOptimize(modulation) && !smallSf ? sf - 2 : sf);
+  int32_t blocks = bits > 0 ? (bits + bitsPerBlock - 1) / bitsPerBlock : 0;
+  uint32_t payloadSymbols = 8 + static_cast<uint32_t>(blocks * (cr + 4));
+
+  // Preamble: programmed symbols + 4.25 (SF7..12) or + 6.25 (SF5/6).
+  uint32_t preambleQuarters = 4u * modulation.preambleLength + (smallSf ? 25 : 17);
+  return preambleQuarters + 4 * payloadSymbols;
+}
+
+uint32_t LoRaAirtime::timeOnAirUs(const LoRaModulation &modulation, size_t payloadBytes)
+{
+  uint64_t numerator = (static_cast<uint64_t>(frameQuarterSymbols(modulation, payloadBytes)) * 1000000u)
+                       << modulation.spreadingFactor;
+  uint64_t denominator = 4ull * modulation.bandwidthHz;
+  return static_cast<uint32_t>((numerator + denominator - 1) / denominator);
+}
@@ -0,0 +1,71 @@
+#include "LoopbackTransport.hpp"
+
+LoopbackTransport::LoopbackTransport(uint32_t address, const ChannelModel &inbound)
+    : address_(address), inbound_(inbound)
+{
+}
+
+void LoopbackTransport::connect(LoopbackTransport &a, LoopbackTransport &b)
+{
+  a.peer_ = &b;
+  b.peer_ = &a;
+}
+
+bool LoopbackTransport::startTransmit(const uint8_t *frame, size_t length)
+{
+  if (peer_ == nullptr || transmitting_ || frame == nullptr || length == 0 || length > MAX_PACKET_SIZE)
+    return false;
+
+  uint32_t airtimeMs = 0;
+  if (simulateAirtime_)
+    airtimeMs = (LoRaAirtime::timeOnAirUs(modulation_, length) + 999) / 1000;
+
+  {
+    std::lock_guard<std::mutex> lock(peer_->mutex_);
+    if (modulationSet_)
+      peer_->inbound_.transmit(address_, frame, length, now_ + airtimeMs, modulation_);
+    else
+      peer_->inbound_.transmit(address_, frame, length, now_ + airtimeMs);
+  }
+  transmitting_ = true;
+  transmitEndMs_ = now_ + airtimeMs;
+  framesSent_++;
+  return true;
+}
+
+bool LoopbackTransport::setModulation(const LoRaModulation &modulation)
+{
+  modulation_ = modulation;
+  modulationSet_ = true;
+  return true;
+}
+
+void LoopbackTransport::poll(uint32_t currentTimestampMs)
+{
+  now_ = currentTimestampMs;
+
+  if (transmitting_ && static_cast<int32_t>(currentTimestampMs - transmitEndMs_) >= 0)
+  {
+    transmitting_ = false;
+    transmitDone();
+  }
+
+  // Collect under the lock, deliver without it: callbacks may transmit to the peer.
+  received_.clear();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SimulatedFrame frame;
+    while (inbound_.receive(frame, currentTimestampMs))
+      received_.push_back(frame);
+  }
+
+  for (const SimulatedFrame &frame : received_)
+  {
+    FrameMeta meta;
+    meta.sourceId = frame.sourceId;
+    meta.timestampMs = currentTimestampMs;
+    meta.length = frame.length;
+    meta.snr = frame.snrDb;
+    deliverFrame(frame.bytes, frame.length, meta);
+  }
+}
@@ -0,0 +1,59 @@
+#include "MessageBufferPool.hpp"
+
+#include <utility>
+
+MessageLease &MessageLease::operator=(MessageLease &&other) noexcept
+{
+  if (this != &other)
+  {
+    release();
+    pool_ = std::exchange(other.pool_, nullptr);
+    index_ = other.index_;
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+  }
+  return *this;
+}
+
+void MessageLease::release()
+{
+  if (pool_ != nullptr)
+  {
+    pool_->release(index_);
+  }
+  pool_ = nullptr;
+  data_ = nullptr;
+  size_ = 0;
+  capacity_ = 0;
+}
+
+MessageBufferPool::MessageBufferPool(size_t bufferCount, size_t bufferCapacity)
+    : bufferCount_(bufferCount),
+      bufferCapacity_(bufferCapacity),
+      storage_(new uint8_t[bufferCount * bufferCapacity]),
+      free_(bufferCount),
+      available_(bufferCount)
+{
+  for (uint32_t i = 0; i < bufferCount; i++)
+  {
+    free_.push(i);
+  }
+}
+
+MessageLease MessageBufferPool::acquire()
+{
+  uint32_t index;
+  if (!free_.pop(index))
+    return MessageLease();
+
+  available_.fetch_sub(1, std::memory_order_relaxed);
+  return MessageLease(this, index, storage_.get() + static_cast<size_t>(index) * bufferCapacity_, bufferCapacity_);
+}
+
+void MessageBufferPool::release(uint32_t index)
+{
+  // Never fails: the queue has a slot for every buffer.
+  free_.push(index);
+  available_.fetch_add(1, std::memory_order_relaxed);
+}
@@ -3,7 +3,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
-#include <string>
+
+#include "PacketLog.hpp"
 
 #ifdef ESP_PLATFORM
 #include "esp_log.h"
@@ -13,77 +14,50 @@
 #define ESP_LOGI(tag, format, ...) printf("LOG [%s]: " format "\n", tag, ##__VA_ARGS__)
 #endif
 
-void Packet::calculateCRC()
-{
-  uint16_t crc = 0xFFFF;
-
-  // CRC covers: full header + only valid payload bytes (exclude padding)
-  // This decouples integrity checking from physical layout and padding strategy
-
-  // Process header
-  const uint8_t *headerPtr = reinterpret_cast<const uint8_t *>(&this->header);
-  for (size_t i = 0; i < HEADER_SIZE; i++)
-  {
-    crc ^= headerPtr[i];
-    for (uint8_t j = 0; j < 8; j++)
-    {
-      if (crc & 0x0001)
-	crc = (crc >> 1) ^ 0xA001;
-      else
-	crc = crc >> 1;
-    }
-  }
-
-  // Process only valid payload bytes (up to payloadSize), exclude padding
-  for (size_t i = 0; i < this->header.payloadSize; i++)
-  {
-    crc ^= this->payload.data[i];
-    for (uint8_t j = 0; j < 8; j++)
-    {
-      if (crc & 0x0001)
-	crc = (crc >> 1) ^ 0xA001;
-      else
-	crc = crc >> 1;
-    }
-  }
-
-  this->crc = crc;
-}
+template struct BasicPacket<DefaultProfile>;
 
-void Packet::printPacket()
+void printPacketFields(uint32_t messageId, uint32_t flags, uint32_t totalChunks, uint32_t chunkIndex,
+                       uint32_t payloadSize, uint32_t protocolVersion, const uint8_t *payload,
+                       size_t payloadCapacity, uint32_t crc, size_t crcSize)
 {
   static const char *TAG = "LoRaMultiPacket";
   ESP_LOGI(TAG, "######## HEADER ########");
-  ESP_LOGI(TAG, "Message ID: %u", (unsigned)this->header.messageId);
+  ESP_LOGI(TAG, "Message ID: %u", (unsigned)messageId);
 
   // Decode flags using the new constants
-  bool som = (this->header.flags & PACKET_FLAG_SOM) != 0;
-  bool eom = (this->header.flags & PACKET_FLAG_EOM) != 0;
-  bool ackReq = (this->header.flags & PACKET_FLAG_ACK_REQ) != 0;
-
-  ESP_LOGI(TAG, "Flags: 0x%02X (SOM=%d, EOM=%d, ACKReq=%d)",
-           (unsigned)this->header.flags, som ? 1 : 0, eom ? 1 : 0, ackReq ? 1 : 0);
-
-  ESP_LOGI(TAG, "Total Chunks: %u", (unsigned)this->header.totalChunks);
-  ESP_LOGI(TAG, "Chunk Index (0-based): %u (1-based: %u)", (unsigned)this->header.chunkIndex,
-           (unsigned)(this->header.chunkIndex + 1));
-  ESP_LOGI(TAG, "Payload Size: %u", (unsigned)this->header.payloadSize);
-  ESP_LOGI(TAG, "Protocol Version: %u", (unsigned)this->header.protocolVersion);
+  bool som = (flags & PACKET_FLAG_SOM) != 0;
+  bool eom = (flags & PACKET_FLAG_EOM) != 0;
+  bool ackReq = (flags & PACKET_FLAG_ACK_REQ) != 0;
+  bool control = (flags & PACKET_FLAG_CONTROL) != 0;
+
+  ESP_LOGI(TAG, "Flags: 0x%02X (SOM=%d, EOM=%d, ACKReq=%d, Control=%d, Hops=%u)",
+           (unsigned)flags, som ? 1 : 0, eom ? 1 : 0, ackReq ? 1 : 0, control ? 1 : 0,
+           (unsigned)packetHops(static_cast<uint8_t>(flags)));
+
+  ESP_LOGI(TAG, "Total Chunks: %u", (unsigned)totalChunks);
+  ESP_LOGI(TAG, "Chunk Index (0-based): %u (1-based: %u)", (unsigned)chunkIndex,
+           (unsigned)(chunkIndex + 1));
+  ESP_LOGI(TAG, "Payload Size: %u", (unsigned)payloadSize);
+  ESP_LOGI(TAG, "Protocol Version: %u", (unsigned)protocolVersion);
   ESP_LOGI(TAG, "######## PAYLOAD ########");
 
-  int toPrint = this->header.payloadSize;
-  if (toPrint > (int)LORA_MAX_PAYLOAD_SIZE)
-    toPrint = LORA_MAX_PAYLOAD_SIZE;
+  size_t toPrint = payloadSize;
+  if (toPrint > payloadCapacity)
+    toPrint = payloadCapacity;
 
-  char tmp[8];
-  std::string line;
-  for (int i = 0; i < toPrint; i++)
+  // One table-driven pass per line into a stack buffer instead of one snprintf
+  // and one std::string append per byte. For the RX/TX hot path use PacketLog.
+  constexpr size_t BYTES_PER_LINE = 32;
+  char line[BYTES_PER_LINE * 3 + 1];
+  if (toPrint == 0)
+  {
+    ESP_LOGI(TAG, "<empty>");
+  }
+  for (size_t offset = 0; offset < toPrint; offset += BYTES_PER_LINE)
   {
-    std::snprintf(tmp, sizeof(tmp), "%02X ", this->payload.data[i]);
-    line += tmp;
+    size_t n = toPrint - offset < BYTES_PER_LINE ? toPrint - offset : BYTES_PER_LINE;
+    PacketLog::formatHex(payload + offset, n, line, sizeof(line));
+    ESP_LOGI(TAG, "%s", line);
   }
-  if (line.empty())
-    line = "<empty>";
-  ESP_LOGI(TAG, "%s", line.c_str());
-  ESP_LOGI(TAG, "CRC: 0x%04X", (unsigned)this->crc);
-}
\ No newline at end of file
+  ESP_LOGI(TAG, "CRC: 0x%0*X", (int)(crcSize * 2), (unsigned)crc);
+}
@@ -0,0 +1,134 @@
+#include "PacketLog.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+PacketLog::PacketLog(size_t capacity) : queue_(capacity) {}
+
+bool PacketLog::record(const Packet &packet, uint32_t timestampMs, PacketLogEvent event)
+{
+  PacketLogRecord entry;
+  entry.timestampMs = timestampMs;
+  entry.event = event;
+  entry.header = packet.header;
+  entry.crc = packet.crc;
+  entry.payloadBytes = static_cast<uint8_t>(
+      std::min<size_t>({packet.header.payloadSize, LORA_MAX_PAYLOAD_SIZE, PACKET_LOG_PAYLOAD_BYTES}));
+  std::memcpy(entry.payload, packet.payload.data, entry.payloadBytes);
+  return push(entry);
+}
+
+bool PacketLog::record(const uint8_t *frame, size_t length, uint32_t timestampMs, PacketLogEvent event)
+{
+  PacketLogRecord entry{};
+  entry.timestampMs = timestampMs;
+  entry.event = event;
+  if (frame != nullptr)
+  {
+    std::memcpy(&entry.header, frame, std::min(length, HEADER_SIZE));
+
+    // Stored CRC sits after the fixed-size payload, little endian.
+    constexpr size_t crcOffset = HEADER_SIZE + sizeof(PacketPayload);
+    if (length >= crcOffset + CRC_SIZE)
+      entry.crc = static_cast<uint16_t>(frame[crcOffset] | (frame[crcOffset + 1] << 8));
+
+    size_t available = length > HEADER_SIZE ? length - HEADER_SIZE : 0;
+    entry.payloadBytes = static_cast<uint8_t>(
+        std::min<size_t>({entry.header.payloadSize, available, PACKET_LOG_PAYLOAD_BYTES}));
+    std::memcpy(entry.payload, frame + HEADER_SIZE, entry.payloadBytes);
+  }
+  return push(entry);
+}
+
+bool PacketLog::push(PacketLogRecord &record)
+{
+  // The record carries the drops before it; drain() numbers records in ring order.
+  uint32_t carried = pendingDrops_.exchange(0, std::memory_order_relaxed);
+  record.sequence = static_cast<uint8_t>(carried);
+  if (queue_.push(record))
+    return true;
+  pendingDrops_.fetch_add(carried + 1, std::memory_order_relaxed);
+  dropped_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+size_t PacketLog::drain(const Sink &sink, size_t maxRecords)
+{
+  size_t count = 0;
+  PacketLogRecord entry;
+  while (count < maxRecords && queue_.pop(entry))
+  {
+    entry.sequence = static_cast<uint8_t>(sequence_ + entry.sequence);
+    sequence_ = static_cast<uint8_t>(entry.sequence + 1);
+    if (sink)
+      sink(entry);
+    count++;
+  }
+  return count;
+}
+
+const char *PacketLog::eventName(PacketLogEvent event)
+{
+  switch (event)
+  {
+    case PacketLogEvent::Tx:
+      return "TX";
+    case PacketLogEvent::Rx:
+      return "RX";
+    case PacketLogEvent::RxRejected:
+      return "RX-REJ";
+    case PacketLogEvent::Retransmit:
+      return "RETX";
+  }
+  return "?";
+}
+
+size_t PacketLog::formatHex(const uint8_t *data, size_t length, char *buffer, size_t size)
+{
+  static const char DIGITS[] = "0123456789ABCDEF";
+  if (size == 0)
+    return 0;
+
+  size_t pos = 0;
+  for (size_t i = 0; i < length && pos + 3 < size; i++)
+  {
+    if (i > 0)
+      buffer[pos++] = ' ';
+    buffer[pos++] = DIGITS[data[i] >> 4];
+    buffer[pos++] = DIGITS[data[i] & 0x0F];
+  }
+  buffer[pos] = '\0';
+  return pos;
+}
+
+size_t PacketLog::format(const PacketLogRecord &record, char *buffer, size_t size)
+{
+  if (size == 0)
+    return 0;
+
+  int written = std::snprintf(buffer, size, "%10u ms #%03u %-6s id=%u chunk=%u/%u len=%u flags=0x%02X v%u crc=0x%04X |",
+                              (unsigned)record.timestampMs, (unsigned)record.sequence, eventName(record.event),
+                              (unsigned)record.header.messageId, (unsigned)record.header.chunkIndex + 1,
+                              (unsigned)record.header.totalChunks, (unsigned)record.header.payloadSize,
+                              (unsigned)record.header.flags, (unsigned)record.header.protocolVersion,
+                              (unsigned)record.crc);
+  if (written < 0)
+  {
+    buffer[0] = '\0';
+    return 0;
+  }
+  size_t pos = std::min(static_cast<size_t>(written), size - 1);
+  if (pos + 2 >= size)
+    return pos;
+
+  buffer[pos++] = ' ';
+  size_t shown = std::min<size_t>(record.payloadBytes, PACKET_LOG_PAYLOAD_BYTES);
+  pos += formatHex(record.payload, shown, buffer + pos, size - pos);
+  if (shown < record.header.payloadSize && pos + 4 < size)
+  {
+    std::memcpy(buffer + pos, " ...", 5);
+    pos += 4;
+  }
+  return pos;
+}
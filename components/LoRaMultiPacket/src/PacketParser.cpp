@@ -1,26 +1,67 @@
 #include "PacketParser.hpp"
 
+#include <cstddef>
 #include <cstring>
 
-std::optional<Packet> PacketParser::parse(const uint8_t *buffer, size_t length)
+#include "Crc16.hpp"
+
+template class BasicPacketParser<DefaultProfile>;
+
+size_t PacketParser::parseBatch(const FrameArena &frames, Packet *packets, uint64_t *validMask)
 {
-  // Step 1: Validate buffer size
-  if (buffer == nullptr || length < MIN_PACKET_SIZE)
-  {
-    return std::nullopt;
-  }
+  // Header/flag checks for the whole batch first: garbage never reaches memcpy or CRC.
+  PacketValidator::validateBatch(frames, validMask);
 
-  // Step 2: Parse buffer into Packet structure
-  Packet packet;
-  std::memcpy(&packet, buffer, sizeof(Packet));
+  // CRC of the surviving frames, Crc16::MAX_STREAMS at a time. The CRC input
+  // (header + valid payload) is contiguous in the raw frame, full or compact.
+  constexpr size_t CRC_OFFSET = HEADER_SIZE + sizeof(PacketPayload);
+  const uint8_t *crcData[64];
+  size_t crcLength[64];
+  size_t crcIndex[64];
+  uint16_t crcValue[64];
 
-  // Step 3: Validate packet integrity via PacketValidator
-  auto validationError = PacketValidator::validate(packet);
-  if (validationError.has_value())
+  size_t validCount = 0;
+  for (size_t w = 0; w < batchMaskWords(frames.size()); w++)
   {
-    return std::nullopt;
+    size_t n = 0;
+    for (uint64_t bits = validMask[w]; bits != 0; bits &= bits - 1)
+    {
+      size_t i = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+      const uint8_t *frame = frames.slot(i);
+      crcData[n] = frame;
+      crcLength[n] = HEADER_SIZE + frame[offsetof(PacketHeader, payloadSize)];
+      crcIndex[n] = i;
+      n++;
+    }
+
+    Crc16::computeMulti(crcData, crcLength, n, crcValue);
+
+    for (size_t k = 0; k < n; k++)
+    {
+      const uint8_t *frame = crcData[k];
+      size_t i = crcIndex[k];
+      bool compact = frames.meta(i).length < MIN_PACKET_SIZE;
+      size_t crcOffset = compact ? crcLength[k] : CRC_OFFSET;
+      uint16_t receivedCrc = static_cast<uint16_t>(frame[crcOffset] | (frame[crcOffset + 1] << 8));
+      if (crcValue[k] != receivedCrc)
+      {
+        validMask[w] &= ~(1ull << (i % 64));
+        continue;
+      }
+      if (compact)
+      {
+        std::memcpy(&packets[i], frame, crcLength[k]);
+        std::memset(packets[i].payload.data + (crcLength[k] - HEADER_SIZE), PAYLOAD_PADDING_BYTE,
+                    HEADER_SIZE + LORA_MAX_PAYLOAD_SIZE - crcLength[k]);
+        packets[i].crc = receivedCrc;
+      }
+      else
+      {
+        std::memcpy(&packets[i], frame, sizeof(Packet));
+      }
+      validCount++;
+    }
   }
 
-  // Step 4: Return validated packet
-  return packet;
+  return validCount;
 }
@@ -1,143 +1,219 @@
 #include "PacketValidator.hpp"
 
-std::optional<ValidationError> PacketValidator::validate(const Packet &packet)
-{
-  // Validate header
-  auto headerErr = validateHeader(packet.header);
-  if (headerErr.has_value())
-    return headerErr;
-
-  // Validate flags
-  auto flagErr = validateFlags(packet.header);
-  if (flagErr.has_value())
-    return flagErr;
-
-  // Validate CRC
-  auto crcErr = validateCRC(packet, packet.crc);
-  if (crcErr.has_value())
-    return crcErr;
-
-  return std::nullopt;
-}
+#include <cstddef>
 
-std::optional<ValidationError> PacketValidator::validateHeader(
-    const PacketHeader &header)
-{
-  // Check protocol version
-  if (header.protocolVersion != SUPPORTED_PROTOCOL_VERSION)
-  {
-    return ValidationError(
-        ValidationError::Type::INVALID_PROTOCOL_VERSION,
-        "Protocol version " + std::to_string(header.protocolVersion) +
-            " not supported (expected " +
-            std::to_string(SUPPORTED_PROTOCOL_VERSION) + ")");
-  }
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LMP_BATCH_X86 1
+#endif
 
-  // Check message ID (0 is reserved)
-  if (header.messageId == 0)
-  {
-    return ValidationError(ValidationError::Type::INVALID_MESSAGE_ID,
-                           "Message ID cannot be 0 (reserved value)");
-  }
-
-  // Check totalChunks
-  if (header.totalChunks == 0)
+namespace
+{
+/**
+ * @brief Frames handled per gather/check block (one word of the output mask).
+ */
+constexpr size_t BATCH_BLOCK = 64;
+
+/**
+ * @brief Structure-of-arrays view of up to BATCH_BLOCK headers.
+ * Lanes past the end of the batch have lengthOk == 0 and always fail.
+ */
+struct HeaderColumns
+{
+  alignas(32) uint8_t idLo[BATCH_BLOCK];
+  alignas(32) uint8_t idHi[BATCH_BLOCK];
+  alignas(32) uint8_t total[BATCH_BLOCK];
+  alignas(32) uint8_t index[BATCH_BLOCK];
+  alignas(32) uint8_t size[BATCH_BLOCK];
+  alignas(32) uint8_t flags[BATCH_BLOCK];
+  alignas(32) uint8_t version[BATCH_BLOCK];
+  alignas(32) uint8_t lengthOk[BATCH_BLOCK];
+};
+
+void gatherHeaders(const FrameArena &frames, size_t base, size_t count, size_t minLength, HeaderColumns &cols)
+{
+  for (size_t lane = 0; lane < BATCH_BLOCK; lane++)
   {
-    return ValidationError(ValidationError::Type::INVALID_TOTAL_CHUNKS,
-                           "totalChunks must be >= 1");
+    if (lane >= count)
+    {
+      cols.lengthOk[lane] = 0;
+      continue;
+    }
+    const uint8_t *frame = frames.slot(base + lane);
+    cols.idLo[lane] = frame[offsetof(PacketHeader, messageId)];
+    cols.idHi[lane] = frame[offsetof(PacketHeader, messageId) + 1];
+    cols.total[lane] = frame[offsetof(PacketHeader, totalChunks)];
+    cols.index[lane] = frame[offsetof(PacketHeader, chunkIndex)];
+    cols.size[lane] = frame[offsetof(PacketHeader, payloadSize)];
+    cols.flags[lane] = frame[offsetof(PacketHeader, flags)];
+    cols.version[lane] = frame[offsetof(PacketHeader, protocolVersion)];
+    // Full frame, or compact frame ending right after the valid payload and the CRC.
+    size_t length = frames.meta(base + lane).length;
+    bool lengthOk = length >= minLength || length == HEADER_SIZE + cols.size[lane] + CRC_SIZE;
+    cols.lengthOk[lane] = lengthOk ? 0xFF : 0x00;
   }
+}
 
-  // Check chunkIndex within bounds
-  if (header.chunkIndex >= header.totalChunks)
+uint64_t checkHeadersScalar(const HeaderColumns &cols, uint8_t version)
+{
+  uint64_t mask = 0;
+  for (size_t lane = 0; lane < BATCH_BLOCK; lane++)
   {
-    return ValidationError(
-        ValidationError::Type::INVALID_CHUNK_INDEX,
-        "chunkIndex (" + std::to_string(header.chunkIndex) +
-            ") >= totalChunks (" + std::to_string(header.totalChunks) + ")");
+    uint8_t total = cols.total[lane];
+    uint8_t index = cols.index[lane];
+    uint8_t size = cols.size[lane];
+    bool isFirst = index == 0;
+    bool isLast = index == static_cast<uint8_t>(total - 1);
+    bool hasSom = (cols.flags[lane] & PACKET_FLAG_SOM) != 0;
+    bool hasEom = (cols.flags[lane] & PACKET_FLAG_EOM) != 0;
+
+    bool ok = (cols.lengthOk[lane] != 0) &
+              (cols.version[lane] == version) &
+              ((cols.idLo[lane] | cols.idHi[lane]) != 0) &
+              (total != 0) &
+              (index < total) &
+              (size <= LORA_MAX_PAYLOAD_SIZE) &
+              (isLast | (size != 0)) &
+              (isFirst == hasSom) &
+              (isLast == hasEom);
+    mask |= static_cast<uint64_t>(ok) << lane;
   }
+  return mask;
+}
 
-  // Check payloadSize within bounds
-  if (header.payloadSize > LORA_MAX_PAYLOAD_SIZE)
+#ifdef LMP_BATCH_X86
+__attribute__((target("sse2"))) uint64_t checkHeadersSse2(const HeaderColumns &cols, uint8_t version)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i one = _mm_set1_epi8(1);
+  const __m128i supported = _mm_set1_epi8(static_cast<char>(version));
+  const __m128i maxPayload = _mm_set1_epi8(static_cast<char>(LORA_MAX_PAYLOAD_SIZE));
+  const __m128i somBit = _mm_set1_epi8(PACKET_FLAG_SOM);
+  const __m128i eomBit = _mm_set1_epi8(PACKET_FLAG_EOM);
+
+  uint64_t mask = 0;
+  for (size_t lane = 0; lane < BATCH_BLOCK; lane += 16)
   {
-    return ValidationError(
-        ValidationError::Type::INVALID_PAYLOAD_SIZE,
-        "payloadSize (" + std::to_string(header.payloadSize) +
-            ") > LORA_MAX_PAYLOAD_SIZE (" +
-            std::to_string(LORA_MAX_PAYLOAD_SIZE) + ")");
+    auto load = [lane](const uint8_t *column)
+    { return _mm_load_si128(reinterpret_cast<const __m128i *>(column + lane)); };
+
+    __m128i total = load(cols.total);
+    __m128i index = load(cols.index);
+    __m128i size = load(cols.size);
+    __m128i flags = load(cols.flags);
+
+    __m128i ok = _mm_and_si128(load(cols.lengthOk), _mm_cmpeq_epi8(load(cols.version), supported));
+    ok = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_or_si128(load(cols.idLo), load(cols.idHi)), zero), ok);
+    ok = _mm_andnot_si128(_mm_cmpeq_epi8(total, zero), ok);
+    // index < total  <=>  max(index, total) != index (unsigned)
+    ok = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_max_epu8(index, total), index), ok);
+    // size <= LORA_MAX_PAYLOAD_SIZE  <=>  min(size, max) == size (unsigned)
+    ok = _mm_and_si128(_mm_cmpeq_epi8(_mm_min_epu8(size, maxPayload), size), ok);
+
+    __m128i isFirst = _mm_cmpeq_epi8(index, zero);
+    __m128i isLast = _mm_cmpeq_epi8(index, _mm_sub_epi8(total, one));
+    // Non-final chunks carry the (non-zero) chunk size of their message.
+    ok = _mm_andnot_si128(_mm_andnot_si128(isLast, _mm_cmpeq_epi8(size, zero)), ok);
+
+    __m128i hasSom = _mm_cmpeq_epi8(_mm_and_si128(flags, somBit), somBit);
+    __m128i hasEom = _mm_cmpeq_epi8(_mm_and_si128(flags, eomBit), eomBit);
+    ok = _mm_andnot_si128(_mm_xor_si128(isFirst, hasSom), ok);
+    ok = _mm_andnot_si128(_mm_xor_si128(isLast, hasEom), ok);
+
+    mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(ok))) << lane;
   }
+  return mask;
+}
 
-  // Logical check: if not the last chunk, payload must be full
-  bool isLastChunk = (header.chunkIndex == header.totalChunks - 1);
-  if (!isLastChunk && header.payloadSize != LORA_MAX_PAYLOAD_SIZE)
+__attribute__((target("avx2"))) uint64_t checkHeadersAvx2(const HeaderColumns &cols, uint8_t version)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi8(1);
+  const __m256i supported = _mm256_set1_epi8(static_cast<char>(version));
+  const __m256i maxPayload = _mm256_set1_epi8(static_cast<char>(LORA_MAX_PAYLOAD_SIZE));
+  const __m256i somBit = _mm256_set1_epi8(PACKET_FLAG_SOM);
+  const __m256i eomBit = _mm256_set1_epi8(PACKET_FLAG_EOM);
+
+  uint64_t mask = 0;
+  for (size_t lane = 0; lane < BATCH_BLOCK; lane += 32)
   {
-    return ValidationError(
-        ValidationError::Type::INVALID_PAYLOAD_SIZE,
-        "Non-final chunk must have full payload (" +
-            std::to_string(LORA_MAX_PAYLOAD_SIZE) + " bytes), got " +
-            std::to_string(header.payloadSize));
+    auto load = [lane](const uint8_t *column) __attribute__((target("avx2")))
+    { return _mm256_load_si256(reinterpret_cast<const __m256i *>(column + lane)); };
+
+    __m256i total = load(cols.total);
+    __m256i index = load(cols.index);
+    __m256i size = load(cols.size);
+    __m256i flags = load(cols.flags);
+
+    __m256i ok = _mm256_and_si256(load(cols.lengthOk), _mm256_cmpeq_epi8(load(cols.version), supported));
+    ok = _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_or_si256(load(cols.idLo), load(cols.idHi)), zero), ok);
+    ok = _mm256_andnot_si256(_mm256_cmpeq_epi8(total, zero), ok);
+    ok = _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(index, total), index), ok);
+    ok = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(size, maxPayload), size), ok);
+
+    __m256i isFirst = _mm256_cmpeq_epi8(index, zero);
+    __m256i isLast = _mm256_cmpeq_epi8(index, _mm256_sub_epi8(total, one));
+    ok = _mm256_andnot_si256(_mm256_andnot_si256(isLast, _mm256_cmpeq_epi8(size, zero)), ok);
+
+    __m256i hasSom = _mm256_cmpeq_epi8(_mm256_and_si256(flags, somBit), somBit);
+    __m256i hasEom = _mm256_cmpeq_epi8(_mm256_and_si256(flags, eomBit), eomBit);
+    ok = _mm256_andnot_si256(_mm256_xor_si256(isFirst, hasSom), ok);
+    ok = _mm256_andnot_si256(_mm256_xor_si256(isLast, hasEom), ok);
+
+    mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(ok))) << lane;
   }
-
-  return std::nullopt;
+  return mask;
 }
+#endif  // LMP_BATCH_X86
 
-std::optional<ValidationError> PacketValidator::validateFlags(
-    const PacketHeader &header)
-{
-  bool isFirstChunk = (header.chunkIndex == 0);
-  bool isLastChunk = (header.chunkIndex == header.totalChunks - 1);
+using HeaderCheckFn = uint64_t (*)(const HeaderColumns &, uint8_t);
 
-  bool hasSOM = (header.flags & PACKET_FLAG_SOM) != 0;
-  bool hasEOM = (header.flags & PACKET_FLAG_EOM) != 0;
+HeaderCheckFn selectHeaderCheck()
+{
+#ifdef LMP_BATCH_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return checkHeadersAvx2;
+  if (__builtin_cpu_supports("sse2"))
+    return checkHeadersSse2;
+#endif
+  return checkHeadersScalar;
+}
+}  // namespace
 
-  // First chunk must have SOM flag
-  if (isFirstChunk && !hasSOM)
-  {
-    return ValidationError(ValidationError::Type::INVALID_SOM_FLAG,
-                           "Chunk 0 must have SOM (Start of Message) flag set");
-  }
+template class BasicPacketValidator<DefaultProfile>;
 
-  // Non-first chunk must not have SOM flag
-  if (!isFirstChunk && hasSOM)
-  {
-    return ValidationError(
-        ValidationError::Type::INVALID_SOM_FLAG,
-        "Only chunk 0 can have SOM (Start of Message) flag");
-  }
+size_t PacketValidator::validateBatch(const FrameArena &frames, uint64_t *crcCandidates)
+{
+  static const HeaderCheckFn checkHeaders = selectHeaderCheck();
 
-  // Last chunk must have EOM flag
-  if (isLastChunk && !hasEOM)
+  HeaderColumns cols;
+  size_t candidates = 0;
+  for (size_t base = 0; base < frames.size(); base += BATCH_BLOCK)
   {
-    return ValidationError(ValidationError::Type::INVALID_EOM_FLAG,
-                           "Final chunk must have EOM (End of Message) flag set");
-  }
+    size_t count = frames.size() - base < BATCH_BLOCK ? frames.size() - base : BATCH_BLOCK;
+    gatherHeaders(frames, base, count, MIN_PACKET_SIZE, cols);
 
-  // Non-last chunk must not have EOM flag
-  if (!isLastChunk && hasEOM)
-  {
-    return ValidationError(
-        ValidationError::Type::INVALID_EOM_FLAG,
-        "Only the final chunk can have EOM (End of Message) flag");
+    uint64_t mask = checkHeaders(cols, SUPPORTED_PROTOCOL_VERSION);
+    crcCandidates[base / BATCH_BLOCK] = mask;
+    candidates += static_cast<size_t>(__builtin_popcountll(mask));
   }
-
-  return std::nullopt;
+  return candidates;
 }
 
-std::optional<ValidationError> PacketValidator::validateCRC(
-    const Packet &packet, uint16_t receivedCrc)
+bool PacketValidator::plausibleHeader(const uint8_t *header)
 {
-  // Create a copy to calculate CRC
-  Packet tempPacket = packet;
-  tempPacket.crc = 0;  // Clear CRC field before calculation
-  tempPacket.calculateCRC();
-
-  // Compare calculated CRC with received CRC
-  if (tempPacket.crc != receivedCrc)
-  {
-    return ValidationError(
-        ValidationError::Type::CRC_MISMATCH,
-        "CRC mismatch: expected 0x" + std::string(4, '0') + ", received 0x" +
-            std::string(4, '0'));
-  }
-
-  return std::nullopt;
+  uint8_t total = header[offsetof(PacketHeader, totalChunks)];
+  uint8_t index = header[offsetof(PacketHeader, chunkIndex)];
+  uint8_t size = header[offsetof(PacketHeader, payloadSize)];
+  uint8_t flags = header[offsetof(PacketHeader, flags)];
+  bool isFirst = index == 0;
+  bool isLast = index == static_cast<uint8_t>(total - 1);
+
+  return header[offsetof(PacketHeader, protocolVersion)] == SUPPORTED_PROTOCOL_VERSION &&
+         (header[offsetof(PacketHeader, messageId)] | header[offsetof(PacketHeader, messageId) + 1]) != 0 &&
+         total != 0 && index < total &&
+         size <= LORA_MAX_PAYLOAD_SIZE && (isLast || size != 0) &&
+         isFirst == ((flags & PACKET_FLAG_SOM) != 0) &&
+         isLast == ((flags & PACKET_FLAG_EOM) != 0);
 }
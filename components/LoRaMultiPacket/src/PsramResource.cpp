@@ -0,0 +1,62 @@
+#include "PsramResource.hpp"
+
+#ifdef ESP_PLATFORM
+#include <cstdlib>
+#include <new>
+
+#include "esp_heap_caps.h"
+#endif
+
+bool PsramResource::available()
+{
+#ifdef ESP_PLATFORM
+  return heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0;
+#else
+  return false;
+#endif
+}
+
+#ifdef ESP_PLATFORM
+
+void *PsramResource::do_allocate(size_t bytes, size_t alignment)
+{
+  void *p = heap_caps_aligned_alloc(alignment, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (p != nullptr)
+  {
+    psramAllocations_.fetch_add(1, std::memory_order_relaxed);
+    return p;
+  }
+
+  p = heap_caps_aligned_alloc(alignment, bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (p == nullptr)
+  {
+#if defined(__cpp_exceptions)
+    throw std::bad_alloc();
+#else
+    abort();
+#endif
+  }
+  fallbackAllocations_.fetch_add(1, std::memory_order_relaxed);
+  return p;
+}
+
+void PsramResource::do_deallocate(void *p, size_t, size_t)
+{
+  // heap_caps_free() releases blocks of either region.
+  heap_caps_free(p);
+}
+
+#else
+
+void *PsramResource::do_allocate(size_t bytes, size_t alignment)
+{
+  fallbackAllocations_.fetch_add(1, std::memory_order_relaxed);
+  return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void PsramResource::do_deallocate(void *p, size_t bytes, size_t alignment)
+{
+  std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+#endif  // ESP_PLATFORM
@@ -0,0 +1,471 @@
+#include "ReassemblyJournal.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if !defined(ESP_PLATFORM) && (defined(__unix__) || defined(__APPLE__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LMP_JOURNAL_MMAP 1
+#endif
+
+#ifdef ESP_PLATFORM
+#include "esp_partition.h"
+#endif
+
+namespace
+{
+void putLe16(uint8_t *out, uint16_t value)
+{
+  out[0] = static_cast<uint8_t>(value);
+  out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void putLe32(uint8_t *out, uint32_t value)
+{
+  for (size_t i = 0; i < 4; i++)
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint16_t getLe16(const uint8_t *in)
+{
+  return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+uint32_t getLe32(const uint8_t *in)
+{
+  uint32_t value = 0;
+  for (size_t i = 0; i < 4; i++)
+    value |= static_cast<uint32_t>(in[i]) << (8 * i);
+  return value;
+}
+
+size_t roundUp(size_t value, size_t multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+}  // namespace
+
+// ============================================================================
+// MmapJournalStorage
+// ============================================================================
+
+MmapJournalStorage::~MmapJournalStorage()
+{
+  close();
+}
+
+bool MmapJournalStorage::open(const char *path, size_t size)
+{
+  close();
+#ifdef LMP_JOURNAL_MMAP
+  if (path == nullptr || size == 0)
+    return false;
+
+  int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+  {
+    ::close(fd);
+    return false;
+  }
+  size_t existing = static_cast<size_t>(st.st_size);
+  if (existing < size && ::ftruncate(fd, static_cast<off_t>(size)) != 0)
+  {
+    ::close(fd);
+    return false;
+  }
+
+  void *mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);  // The mapping keeps the file referenced.
+  if (mapping == MAP_FAILED)
+    return false;
+
+  data_ = static_cast<uint8_t *>(mapping);
+  size_ = size;
+
+  // ftruncate() extends with zeros; the journal expects erased (0xFF) bytes.
+  if (existing < size)
+    std::memset(data_ + existing, 0xFF, size - existing);
+  return true;
+#else
+  (void)path;
+  (void)size;
+  return false;
+#endif
+}
+
+void MmapJournalStorage::close()
+{
+#ifdef LMP_JOURNAL_MMAP
+  if (data_ != nullptr)
+  {
+    ::msync(data_, size_, MS_SYNC);
+    ::munmap(data_, size_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+bool MmapJournalStorage::read(size_t offset, void *data, size_t length) const
+{
+  if (data_ == nullptr || offset > size_ || length > size_ - offset)
+    return false;
+  std::memcpy(data, data_ + offset, length);
+  return true;
+}
+
+bool MmapJournalStorage::write(size_t offset, const void *data, size_t length)
+{
+  if (data_ == nullptr || offset > size_ || length > size_ - offset)
+    return false;
+  std::memcpy(data_ + offset, data, length);
+  return true;
+}
+
+bool MmapJournalStorage::erase(size_t offset, size_t length)
+{
+  if (data_ == nullptr || offset > size_ || length > size_ - offset)
+    return false;
+  std::memset(data_ + offset, 0xFF, length);
+  return true;
+}
+
+void MmapJournalStorage::sync()
+{
+#ifdef LMP_JOURNAL_MMAP
+  if (data_ != nullptr)
+    ::msync(data_, size_, MS_ASYNC);
+#endif
+}
+
+// ============================================================================
+// PartitionJournalStorage
+// ============================================================================
+
+bool PartitionJournalStorage::open(const char *label)
+{
+#ifdef ESP_PLATFORM
+  const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+  if (partition == nullptr)
+    return false;
+
+  partition_ = partition;
+  size_ = partition->size;
+  eraseBlockSize_ = partition->erase_size;
+  return true;
+#else
+  (void)label;
+  return false;
+#endif
+}
+
+bool PartitionJournalStorage::read(size_t offset, void *data, size_t length) const
+{
+#ifdef ESP_PLATFORM
+  return partition_ != nullptr &&
+         esp_partition_read(static_cast<const esp_partition_t *>(partition_), offset, data, length) == ESP_OK;
+#else
+  (void)offset;
+  (void)data;
+  (void)length;
+  return false;
+#endif
+}
+
+bool PartitionJournalStorage::write(size_t offset, const void *data, size_t length)
+{
+#ifdef ESP_PLATFORM
+  return partition_ != nullptr &&
+         esp_partition_write(static_cast<const esp_partition_t *>(partition_), offset, data, length) == ESP_OK;
+#else
+  (void)offset;
+  (void)data;
+  (void)length;
+  return false;
+#endif
+}
+
+bool PartitionJournalStorage::erase(size_t offset, size_t length)
+{
+#ifdef ESP_PLATFORM
+  return partition_ != nullptr &&
+         esp_partition_erase_range(static_cast<const esp_partition_t *>(partition_), offset, length) == ESP_OK;
+#else
+  (void)offset;
+  (void)length;
+  return false;
+#endif
+}
+
+// ============================================================================
+// ReassemblyJournal
+// ============================================================================
+
+ReassemblyJournal::ReassemblyJournal(JournalStorage &storage, size_t chunkStride, size_t maxChunks)
+    : storage_(storage),
+      chunkStride_(chunkStride),
+      maxChunks_(maxChunks),
+      payloadOffset_(roundUp(SLOT_HEADER_SIZE + 2 * maxChunks, 16)),
+      slotSize_(roundUp(payloadOffset_ + maxChunks * chunkStride, std::max<size_t>(storage.eraseBlockSize(), 1))),
+      slotCount_(storage.size() / slotSize_)
+{
+  states_.resize(slotCount_, SlotState::Free);
+  for (size_t slot = 0; slot < slotCount_; slot++)
+  {
+    uint8_t word[4];
+    if (!storage_.read(slotOffset(slot), word, sizeof(word)))
+    {
+      states_[slot] = SlotState::Retired;
+      continue;
+    }
+    uint32_t state = getLe32(word);
+    if (state == SLOT_ACTIVE)
+      states_[slot] = SlotState::Active;
+    else if (state != 0xFFFFFFFFu)
+      states_[slot] = SlotState::Retired;  // Retired, or a state word cut short.
+  }
+}
+
+size_t ReassemblyJournal::activeSlots() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<size_t>(std::count(states_.begin(), states_.end(), SlotState::Active));
+}
+
+size_t ReassemblyJournal::retiredSlots() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<size_t>(std::count(states_.begin(), states_.end(), SlotState::Retired));
+}
+
+std::vector<ReassemblyJournal::Record> ReassemblyJournal::records() const
+{
+  std::vector<Record> records;
+  for (size_t slot = 0; slot < slotCount_; slot++)
+  {
+    uint8_t header[SLOT_HEADER_SIZE];
+    if (state(slot) != SlotState::Active || !storage_.read(slotOffset(slot), header, sizeof(header)))
+      continue;
+
+    Record record;
+    record.slot = slot;
+    record.sourceId = getLe32(header + 4);
+    record.messageId = getLe16(header + 8);
+    record.totalChunks = getLe16(header + 10);
+    records.push_back(record);
+  }
+  return records;
+}
+
+std::optional<uint16_t> ReassemblyJournal::chunkSize(size_t slot, size_t chunkIndex) const
+{
+  uint8_t entry[2];
+  if (slot >= slotCount_ || chunkIndex >= maxChunks_ || !storage_.read(sizeEntryOffset(slot, chunkIndex), entry, 2))
+    return std::nullopt;
+
+  uint16_t size = getLe16(entry);
+  if (size == MISSING || size > chunkStride_)
+    return std::nullopt;
+  return size;
+}
+
+bool ReassemblyJournal::readChunk(size_t slot, size_t chunkIndex, uint8_t *output, size_t size) const
+{
+  if (slot >= slotCount_ || chunkIndex >= maxChunks_ || size > chunkStride_)
+    return false;
+  return storage_.read(slotOffset(slot) + payloadOffset_ + chunkIndex * chunkStride_, output, size);
+}
+
+std::optional<size_t> ReassemblyJournal::open(uint32_t sourceId, uint16_t messageId, uint16_t totalChunks)
+{
+  if (totalChunks == 0 || totalChunks > maxChunks_)
+    return std::nullopt;
+
+  // Blank slots only: erasing one is maintain()'s job, off the receive path.
+  std::optional<size_t> chosen;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t slot = 0; slot < slotCount_ && !chosen.has_value(); slot++)
+    {
+      if (states_[slot] == SlotState::Free && headerErased(slot))
+        chosen = slot;
+      else if (states_[slot] == SlotState::Free)
+        states_[slot] = SlotState::Retired;
+    }
+    if (!chosen.has_value())
+      return std::nullopt;
+    states_[*chosen] = SlotState::Active;  // Claimed; committed by the state word below.
+  }
+
+  // Identity first, state word last: an interrupted open() leaves a slot that is not active.
+  uint8_t header[SLOT_HEADER_SIZE];
+  std::memset(header, 0xFF, sizeof(header));
+  putLe32(header + 4, sourceId);
+  putLe16(header + 8, messageId);
+  putLe16(header + 10, totalChunks);
+  size_t offset = slotOffset(*chosen);
+  putLe32(header, SLOT_ACTIVE);
+  if (!writeAt(offset + 4, header + 4, sizeof(header) - 4) || !writeAt(offset, header, 4))
+  {
+    setState(*chosen, SlotState::Retired);
+    return std::nullopt;
+  }
+  return chosen;
+}
+
+bool ReassemblyJournal::append(size_t slot, size_t chunkIndex, const uint8_t *payload, uint16_t size)
+{
+  if (slot >= slotCount_ || state(slot) != SlotState::Active || chunkIndex >= maxChunks_ || size > chunkStride_)
+    return false;
+  if (chunkSize(slot, chunkIndex).has_value())
+    return true;  // Already journaled: flash bytes are written once.
+
+  // Payload first, size entry last: the entry commits the chunk.
+  if (size > 0 && !writeAt(slotOffset(slot) + payloadOffset_ + chunkIndex * chunkStride_, payload, size))
+    return false;
+  uint8_t entry[2];
+  putLe16(entry, size);
+  return writeAt(sizeEntryOffset(slot, chunkIndex), entry, 2);
+}
+
+void ReassemblyJournal::retire(size_t slot)
+{
+  if (slot >= slotCount_ || state(slot) != SlotState::Active)
+    return;
+
+  uint8_t word[4] = {0, 0, 0, 0};
+  writeAt(slotOffset(slot), word, sizeof(word));
+  setState(slot, SlotState::Retired);
+}
+
+size_t ReassemblyJournal::maintain(size_t maxSlots)
+{
+  size_t erased = 0;
+  for (size_t slot = 0; slot < slotCount_ && erased < maxSlots; slot++)
+  {
+    // Claim the slot, erase it unlocked: open() keeps serving the receive path meanwhile.
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (states_[slot] != SlotState::Retired)
+        continue;
+      states_[slot] = SlotState::Erasing;
+    }
+    bool blank = eraseSlot(slot);
+    setState(slot, blank ? SlotState::Free : SlotState::Retired);
+    if (blank)
+      erased++;
+  }
+  return erased;
+}
+
+bool ReassemblyJournal::writeAt(size_t offset, const void *data, size_t length)
+{
+  if (storage_.write(offset, data, length))
+    return true;
+  storageErrors_++;
+  return false;
+}
+
+bool ReassemblyJournal::eraseSlot(size_t slot)
+{
+  size_t block = std::max<size_t>(storage_.eraseBlockSize(), 1);
+  size_t offset = slotOffset(slot);
+  for (size_t end = slotSize_; end > 0; end -= block)
+  {
+    if (!storage_.erase(offset + end - block, block))
+    {
+      storageErrors_++;
+      return false;
+    }
+  }
+  return true;
+}
+
+ReassemblyJournal::SlotState ReassemblyJournal::state(size_t slot) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return states_[slot];
+}
+
+void ReassemblyJournal::setState(size_t slot, SlotState state)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  states_[slot] = state;
+}
+
+bool ReassemblyJournal::headerErased(size_t slot) const
+{
+  uint8_t header[SLOT_HEADER_SIZE];
+  if (!storage_.read(slotOffset(slot), header, sizeof(header)))
+    return false;
+  return std::all_of(header, header + sizeof(header), [](uint8_t byte) { return byte == 0xFF; });
+}
+
+// ============================================================================
+// ChunkRequest
+// ============================================================================
+
+size_t ChunkRequest::coveredChunks() const
+{
+  size_t remaining = firstChunk < totalChunks ? totalChunks - firstChunk : 0;
+  return chunkCount == 0 ? remaining : std::min<size_t>(chunkCount, remaining);
+}
+
+void ChunkRequest::encode(uint8_t *out) const
+{
+  out[0] = TYPE;
+  putLe16(out + 1, messageId);
+  out[3] = totalChunks;
+  out[4] = firstChunk;
+  std::memset(out + BITMAP_OFFSET, 0, encodedSize() - BITMAP_OFFSET);
+  for (size_t i = 0; i < coveredChunks(); i++)
+  {
+    if (missing.test(firstChunk + i))
+      out[BITMAP_OFFSET + i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+  }
+}
+
+size_t ChunkRequest::maxChunksFor(size_t maxPayloadSize)
+{
+  if (maxPayloadSize <= BITMAP_OFFSET)
+    return 0;
+  return std::min<size_t>((maxPayloadSize - BITMAP_OFFSET) * 8, DefaultProfile::MAX_CHUNKS);
+}
+
+std::optional<ChunkRequest> ChunkRequest::decode(const Packet &packet)
+{
+  const auto &header = packet.header;
+  if ((header.flags & PACKET_FLAG_CONTROL) == 0 || header.totalChunks != 1 || header.payloadSize <= BITMAP_OFFSET ||
+      packet.payload.data[0] != TYPE)
+  {
+    return std::nullopt;
+  }
+
+  const uint8_t *in = packet.payload.data;
+  ChunkRequest request;
+  request.messageId = getLe16(in + 1);
+  request.totalChunks = in[3];
+  request.firstChunk = in[4];
+  if (request.firstChunk >= request.totalChunks)
+    return std::nullopt;
+
+  // The bitmap length gives the range; its last byte may be partly unused.
+  size_t bitmapChunks = (header.payloadSize - BITMAP_OFFSET) * 8;
+  request.chunkCount = static_cast<uint16_t>(std::min<size_t>(bitmapChunks, request.totalChunks - request.firstChunk));
+  if (header.payloadSize != request.encodedSize())
+    return std::nullopt;
+
+  for (size_t i = 0; i < request.coveredChunks(); i++)
+  {
+    if ((in[BITMAP_OFFSET + i / 8] >> (i % 8)) & 1u)
+      request.missing.set(request.firstChunk + i);
+  }
+  return request;
+}
@@ -0,0 +1,173 @@
+#include "ShardedReassembler.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+#include "PacketParser.hpp"
+
+ShardedReassembler::ShardedReassembler(const ShardedReassemblerConfig &config, MessageCallback onMessage)
+    : config_(config), onMessage_(std::move(onMessage))
+{
+  if (config_.shardCount == 0)
+    config_.shardCount = 1;
+
+  shards_.reserve(config_.shardCount);
+  for (size_t i = 0; i < config_.shardCount; i++)
+  {
+    shards_.push_back(std::make_unique<Shard>(config_));
+  }
+}
+
+ShardedReassembler::~ShardedReassembler()
+{
+  stop();
+}
+
+void ShardedReassembler::start()
+{
+  if (running_.exchange(true))
+    return;
+
+  for (auto &shard : shards_)
+  {
+    Shard *s = shard.get();
+    s->worker = std::thread([this, s]
+                            { workerLoop(*s); });
+  }
+}
+
+void ShardedReassembler::stop()
+{
+  if (!running_.exchange(false))
+    return;
+
+  // Workers drain their queue before observing running_ == false.
+  for (auto &shard : shards_)
+  {
+    if (shard->worker.joinable())
+      shard->worker.join();
+  }
+}
+
+bool ShardedReassembler::submit(uint32_t sourceId, const uint8_t *frame, size_t length, uint32_t timestampMs)
+{
+  if (frame == nullptr || length < sizeof(uint16_t) || length > MAX_PACKET_SIZE)
+    return false;
+
+  // messageId is the first header field (little endian); route before parsing
+  // so that validation and CRC run on the worker, not on the ingest thread.
+  uint16_t messageId = static_cast<uint16_t>(frame[0] | (frame[1] << 8));
+  Shard &shard = *shards_[shardFor(sourceId, messageId)];
+
+  IngressFrame ingress;
+  ingress.sourceId = sourceId;
+  ingress.timestampMs = timestampMs;
+  ingress.length = static_cast<uint16_t>(length);
+  std::memcpy(ingress.bytes, frame, length);
+
+  if (!shard.queue.push(ingress))
+  {
+    shard.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  shard.submitted.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void ShardedReassembler::flush() const
+{
+  for (const auto &shard : shards_)
+  {
+    while (shard->processed.load(std::memory_order_acquire) < shard->submitted.load(std::memory_order_acquire))
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+size_t ShardedReassembler::shardFor(uint32_t sourceId, uint16_t messageId) const
+{
+  // 64-bit finalizer (splitmix64) so that consecutive IDs spread evenly.
+  uint64_t h = (static_cast<uint64_t>(sourceId) << 16) | messageId;
+  h ^= h >> 30;
+  h *= 0xBF58476D1CE4E5B9ull;
+  h ^= h >> 27;
+  h *= 0x94D049BB133111EBull;
+  h ^= h >> 31;
+  return static_cast<size_t>(h % shards_.size());
+}
+
+ShardedReassembler::Stats ShardedReassembler::stats() const
+{
+  Stats total;
+  for (const auto &shard : shards_)
+  {
+    total.framesSubmitted += shard->submitted.load(std::memory_order_relaxed);
+    total.framesDropped += shard->dropped.load(std::memory_order_relaxed);
+    total.framesRejected += shard->rejected.load(std::memory_order_relaxed);
+    total.messagesCompleted += shard->completed.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void ShardedReassembler::workerLoop(Shard &shard)
+{
+  IngressFrame frame;
+  unsigned idleSpins = 0;
+
+  for (;;)
+  {
+    if (shard.queue.pop(frame))
+    {
+      idleSpins = 0;
+      handleFrame(shard, frame);
+      shard.processed.fetch_add(1, std::memory_order_release);
+      continue;
+    }
+
+    if (!running_.load(std::memory_order_acquire))
+    {
+      // Producers are expected to have stopped; pick up any late frame once more.
+      if (!shard.queue.pop(frame))
+        break;
+      handleFrame(shard, frame);
+      shard.processed.fetch_add(1, std::memory_order_release);
+      continue;
+    }
+
+    // Spin briefly, then back off so idle shards do not burn a core.
+    if (++idleSpins < 64)
+    {
+      std::this_thread::yield();
+    }
+    else
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+}
+
+void ShardedReassembler::handleFrame(Shard &shard, const IngressFrame &frame)
+{
+  auto packet = PacketParser::parse(frame.bytes, frame.length);
+  if (!packet.has_value())
+  {
+    shard.rejected.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  auto message = shard.reassembler.processPacket(packet.value(), frame.timestampMs, frame.sourceId);
+  if (message.has_value())
+  {
+    shard.completed.fetch_add(1, std::memory_order_relaxed);
+    if (onMessage_)
+      onMessage_(frame.sourceId, packet->header.messageId, std::move(message.value()));
+  }
+
+  if (frame.timestampMs - shard.lastPruneMs >= config_.pruneIntervalMs)
+  {
+    shard.reassembler.pruneStalled(frame.timestampMs);
+    shard.lastPruneMs = frame.timestampMs;
+  }
+}
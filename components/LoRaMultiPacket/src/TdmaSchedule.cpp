@@ -0,0 +1,109 @@
+#include "TdmaSchedule.hpp"
+
+#include <algorithm>
+
+namespace
+{
+uint32_t airtimeMs(const LoRaModulation &modulation, size_t length)
+{
+  return static_cast<uint32_t>((LoRaAirtime::timeOnAirUs(modulation, length) + 999) / 1000);
+}
+}  // namespace
+
+void TdmaBeacon::encode(uint32_t networkTimeMs, uint8_t *out)
+{
+  out[0] = TYPE;
+  for (size_t i = 0; i < 4; i++)
+    out[1 + i] = static_cast<uint8_t>(networkTimeMs >> (8 * i));
+}
+
+std::optional<uint32_t> TdmaBeacon::decode(const Packet &packet)
+{
+  const auto &header = packet.header;
+  if ((header.flags & PACKET_FLAG_CONTROL) == 0 || header.totalChunks != 1 || header.payloadSize != SIZE ||
+      packet.payload.data[0] != TYPE)
+  {
+    return std::nullopt;
+  }
+
+  uint32_t networkTimeMs = 0;
+  for (size_t i = 0; i < 4; i++)
+    networkTimeMs |= static_cast<uint32_t>(packet.payload.data[1 + i]) << (8 * i);
+  return networkTimeMs;
+}
+
+TdmaSchedule::TdmaSchedule(const TdmaConfig &config, const LoRaModulation &modulation)
+    : config_(config), modulation_(modulation)
+{
+  config_.slotCount = std::min<uint8_t>(std::max<uint8_t>(config_.slotCount, 1), 32);
+  uint32_t framesPerSlot = std::max<uint8_t>(config_.framesPerSlot, 1);
+  slotMs_ = config_.slotMs != 0 ? config_.slotMs
+                                : framesPerSlot * airtimeMs(modulation_, MAX_TX_PACKET_SIZE) + config_.guardMs;
+  slotMs_ = std::max<uint32_t>(slotMs_, 1);
+}
+
+void TdmaSchedule::synchronize(uint32_t currentTimestampMs, uint32_t networkTimeMs)
+{
+  offsetMs_ = networkTimeMs - currentTimestampMs;
+  synced_ = true;
+  lastSyncMs_ = currentTimestampMs;
+  synchronizations_++;
+}
+
+bool TdmaSchedule::onBeacon(const Packet &packet, uint32_t currentTimestampMs, size_t frameLength)
+{
+  std::optional<uint32_t> sentAt = TdmaBeacon::decode(packet);
+  if (!sentAt.has_value())
+    return false;
+  if (!timeMaster())
+    synchronize(currentTimestampMs, *sentAt + airtimeMs(modulation_, frameLength));
+  return true;
+}
+
+bool TdmaSchedule::synchronized(uint32_t currentTimestampMs) const
+{
+  if (timeMaster())
+    return true;
+  return synced_ && (config_.holdoverMs == 0 || currentTimestampMs - lastSyncMs_ <= config_.holdoverMs);
+}
+
+uint8_t TdmaSchedule::slotAt(uint32_t currentTimestampMs) const
+{
+  return static_cast<uint8_t>((networkTimeMs(currentTimestampMs) / slotMs_) % config_.slotCount);
+}
+
+bool TdmaSchedule::fitsSlot(uint32_t airtimeUs) const
+{
+  return (static_cast<uint64_t>(airtimeUs) + 999) / 1000 + config_.guardMs <= slotMs_;
+}
+
+uint32_t TdmaSchedule::waitTimeMs(uint32_t airtimeUs, uint32_t currentTimestampMs) const
+{
+  if (!fitsSlot(airtimeUs))
+    return UINT32_MAX;
+  if (!synchronized(currentTimestampMs))
+    return slotMs_;
+
+  uint32_t position = networkTimeMs(currentTimestampMs) % slotMs_;
+  uint8_t slot = slotAt(currentTimestampMs);
+  uint32_t frameMs = (airtimeUs + 999) / 1000;
+  if (ownsSlot(slot) && position + frameMs + config_.guardMs <= slotMs_)
+    return 0;
+
+  for (uint32_t ahead = 1; ahead <= config_.slotCount; ahead++)
+  {
+    if (ownsSlot(static_cast<uint8_t>((slot + ahead) % config_.slotCount)))
+      return (slotMs_ - position) + (ahead - 1) * slotMs_;
+  }
+  return superframeMs();  // No slot owned: never transmits.
+}
+
+bool TdmaSchedule::beaconDue(uint32_t currentTimestampMs) const
+{
+  return timeMaster() && (!lastBeaconMs_.has_value() || currentTimestampMs - *lastBeaconMs_ >= config_.beaconIntervalMs);
+}
+
+void TdmaSchedule::beaconQueued(uint32_t currentTimestampMs)
+{
+  lastBeaconMs_ = currentTimestampMs;
+}
@@ -0,0 +1,378 @@
+#include "TxEngine.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "PacketSerializer.hpp"
+
+TxEngine::TxEngine(RadioTransmitter &radio, const TxEngineConfig &config)
+    : radio_(radio),
+      modulation_(config.modulation),
+      criticalReserveUs_(config.criticalReserveUs),
+      queue_(config.queueCapacity),
+      scheduler_(config.maxActiveMessages),
+      compactFrames_(config.compactFrames),
+      maxTransmitAttempts_(config.maxTransmitAttempts),
+      announcementRepeats_(config.linkAnnouncementRepeats > 0 ? config.linkAnnouncementRepeats : 1),
+      retainLimit_(config.retainedMessages)
+{
+  link_.spreadingFactor = config.modulation.spreadingFactor;
+  link_.bandwidthHz = config.modulation.bandwidthHz;
+  link_.codingRate = config.modulation.codingRate;
+  if (config.airtimeBudget.has_value())
+    budget_.emplace(*config.airtimeBudget);
+  if (config.tdma.has_value())
+    tdma_.emplace(*config.tdma, config.modulation);
+}
+
+bool TxEngine::enqueue(std::vector<uint8_t> &&message, uint16_t messageId, const TxOptions &options)
+{
+  if (message.empty() || PacketSerializer::chunksFor(message.size()) > DefaultProfile::MAX_CHUNKS)
+    return false;
+  if (options.chunkPayloadSize != 0 && !PacketSerializer::validChunkSize(message.size(), options.chunkPayloadSize))
+    return false;
+
+  TxMessage entry;
+  entry.data = std::move(message);
+  entry.messageId = messageId;
+  entry.options = options;
+  if (!queue_.push(std::move(entry)))
+  {
+    messagesRefused_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  queued_.fetch_add(1, std::memory_order_relaxed);
+  messagesQueued_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool TxEngine::enqueue(const uint8_t *data, size_t length, uint16_t messageId, const TxOptions &options)
+{
+  if (data == nullptr)
+    return false;
+  return enqueue(std::vector<uint8_t>(data, data + length), messageId, options);
+}
+
+void TxEngine::poll(uint32_t currentTimestampMs)
+{
+  // 1. Complete the frame on air.
+  if (onAir_ && txDone_.exchange(false, std::memory_order_acquire))
+  {
+    radio_.finishTransmit();
+    onAir_ = false;
+    scheduler_.commit(onAirChunk_);
+    onFrameDone(onAirChunk_, true);
+  }
+
+  admit(currentTimestampMs);
+
+  if (onAir_)
+  {
+    // Still on air: make sure the next frame is ready when it ends.
+    if (!staged_)
+      stageNext(currentTimestampMs);
+    return;
+  }
+
+  // 2. Radio free: start the staged frame first, unless it has to give way.
+  if (staged_ && scheduler_.shouldPreempt(stagedChunk_, currentTimestampMs))
+  {
+    scheduler_.requeue(stagedChunk_);
+    staged_ = false;
+  }
+  if (!staged_ && !stageNext(currentTimestampMs))
+    return;
+
+  // Never exceed the duty cycle: the frame waits for credit instead.
+  uint32_t airtimeUs = LoRaAirtime::timeOnAirUs(modulation_, stagedLength_);
+  if (budget_.has_value() && budget_->availableUs(currentTimestampMs) < requiredAirtimeUs())
+  {
+    framesDeferred_++;
+    return;
+  }
+
+  // Only inside one of our slots, and only if the frame ends before the guard time.
+  if (tdma_.has_value())
+  {
+    if (!tdma_->fitsSlot(airtimeUs))
+    {
+      // It would run into the next node's slot, in every slot.
+      framesTooLong_++;
+      dropStaged();
+      return;
+    }
+    if (tdma_->waitTimeMs(airtimeUs, currentTimestampMs) > 0)
+    {
+      slotWaits_++;
+      return;
+    }
+    if (TdmaBeacon::decode(stagedChunk_.packet).has_value())
+    {
+      TdmaBeacon::encode(tdma_->networkTimeMs(currentTimestampMs), stagedChunk_.packet.payload.data);
+      stagedChunk_.packet.calculateCRC();
+      serializeStaged();
+    }
+  }
+
+  if (!radio_.startTransmit(buffers_[stagedBuffer_], stagedLength_))
+  {
+    // Keep the frame staged and retry on the next poll(), unless the radio keeps refusing it.
+    radioErrors_++;
+    if (maxTransmitAttempts_ != 0 && ++stagedAttempts_ >= maxTransmitAttempts_)
+      dropStaged();
+    return;
+  }
+  if (budget_.has_value())
+    budget_->tryConsume(airtimeUs, currentTimestampMs);
+  airtimeUs_ += airtimeUs;
+  onAir_ = true;
+  onAirChunk_ = stagedChunk_;
+  staged_ = false;
+  stagedBuffer_ ^= 1;
+
+  // 3. Serialize frame N+1 while frame N is on air.
+  stageNext(currentTimestampMs);
+}
+
+bool TxEngine::resendChunks(uint16_t messageId, size_t totalChunks, const ChunkSet &chunks)
+{
+  // Newest first: message IDs wrap around.
+  for (auto it = retained_.rbegin(); it != retained_.rend(); ++it)
+  {
+    if (it->messageId != messageId ||
+        PacketSerializer::chunksFor(it->data.size(), it->options.chunkPayloadSize) != totalChunks)
+    {
+      continue;
+    }
+
+    TxOptions options = it->options;
+    options.chunks = chunks;
+    for (size_t i = totalChunks; i < chunks.size(); i++)
+      options.chunks->reset(i);
+    if (options.chunks->none() || !enqueue(std::vector<uint8_t>(it->data), messageId, options))
+      return false;
+    resends_++;
+    return true;
+  }
+  return false;
+}
+
+bool TxEngine::requestLinkChange(const LinkProfile &profile)
+{
+  if (profile.spreadingFactor < 5 || profile.spreadingFactor > 12 || profile.codingRate < 5 ||
+      profile.codingRate > 8 || profile.bandwidthHz == 0 || profile.chunkPayloadSize == 0 ||
+      profile.chunkPayloadSize > LORA_MAX_PAYLOAD_SIZE)
+  {
+    return false;
+  }
+
+  // The TDMA slot length is fixed network-wide: the profile's frames must fit it.
+  size_t frameLength = compactFrames_ ? HEADER_SIZE + profile.chunkPayloadSize + CRC_SIZE : MAX_TX_PACKET_SIZE;
+  if (tdma_.has_value() && !tdma_->fitsSlot(LoRaAirtime::timeOnAirUs(profile.modulation(modulation_), frameLength)))
+    return false;
+
+  requestedLink_ = profile;
+  return true;
+}
+
+void TxEngine::admit(uint32_t currentTimestampMs)
+{
+  queueAnnouncements();
+  queueBeacon(currentTimestampMs);
+  while (!scheduler_.full() && queue_.pop(incoming_))
+  {
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    if (incoming_.options.chunkPayloadSize == 0)
+    {
+      // The link's chunk size, unless the message would need more chunks than the header can count.
+      size_t chunkSize = std::max<size_t>(link_.chunkPayloadSize, PacketSerializer::minChunkSize(incoming_.data.size()));
+      incoming_.options.chunkPayloadSize = static_cast<uint16_t>(chunkSize);
+    }
+
+    // Whole messages only: a resend is already a copy of a retained one.
+    bool retain = retainLimit_ > 0 && !incoming_.options.control && !incoming_.options.chunks.has_value();
+    std::vector<uint8_t> copy;
+    if (retain)
+      copy = incoming_.data;
+    if (scheduler_.add(std::move(incoming_.data), incoming_.messageId, incoming_.options).has_value() && retain)
+    {
+      if (retained_.size() >= retainLimit_)
+        retained_.pop_front();
+      retained_.push_back(TxMessage{std::move(copy), incoming_.messageId, incoming_.options});
+    }
+  }
+}
+
+void TxEngine::queueAnnouncements()
+{
+  if (!announcing_.has_value() && requestedLink_.has_value())
+  {
+    announcing_ = requestedLink_;
+    requestedLink_.reset();
+    announcementsToQueue_ = announcementRepeats_;
+  }
+
+  TxOptions options;
+  options.priority = TxPriority::Critical;
+  options.control = true;
+  while (announcementsToQueue_ > 0 && !scheduler_.full())
+  {
+    std::vector<uint8_t> payload(LinkAnnouncement::SIZE);
+    LinkAnnouncement::encode(*announcing_, payload.data());
+    scheduler_.add(std::move(payload), LinkAnnouncement::MESSAGE_ID, options);
+    announcementsToQueue_--;
+    announcementsInFlight_++;
+  }
+}
+
+void TxEngine::queueBeacon(uint32_t currentTimestampMs)
+{
+  if (!tdma_.has_value() || beaconInFlight_ || scheduler_.full() || !tdma_->beaconDue(currentTimestampMs))
+    return;
+
+  // Stamped with the network time when it goes on air.
+  TxOptions options;
+  options.priority = TxPriority::Critical;
+  options.control = true;
+  std::vector<uint8_t> payload(TdmaBeacon::SIZE);
+  TdmaBeacon::encode(0, payload.data());
+  scheduler_.add(std::move(payload), LinkAnnouncement::MESSAGE_ID, options);
+  tdma_->beaconQueued(currentTimestampMs);
+  beaconInFlight_ = true;
+}
+
+void TxEngine::onFrameDone(const TxChunk &chunk, bool sent)
+{
+  if (sent)
+    framesSent_++;
+
+  if (beaconInFlight_ && TdmaBeacon::decode(chunk.packet).has_value())
+  {
+    beaconInFlight_ = false;
+    if (sent)
+      beaconsSent_++;
+    return;
+  }
+
+  const auto &header = chunk.packet.header;
+  if ((header.flags & PACKET_FLAG_CONTROL) == 0 || header.messageId != LinkAnnouncement::MESSAGE_ID ||
+      announcementsInFlight_ == 0)
+  {
+    if (chunk.last && sent)
+      messagesSent_++;
+    return;
+  }
+
+  // A dropped copy counts down too: the other copies have had their chance.
+  announcementsInFlight_--;
+  if (announcementsInFlight_ > 0 || announcementsToQueue_ > 0)
+    return;
+
+  // Every copy is out with the old settings: the receiver has had its chance to follow.
+  LoRaModulation modulation = announcing_->modulation(modulation_);
+  if (radio_.setModulation(modulation))
+  {
+    modulation_ = modulation;
+    link_ = *announcing_;
+    if (tdma_.has_value())
+      tdma_->setModulation(modulation);
+    linkChanges_++;
+  }
+  else
+  {
+    // The receiver may have switched anyway; both ends meet again on the fallback profile.
+    radioErrors_++;
+  }
+  announcing_.reset();
+  queueAnnouncements();
+}
+
+bool TxEngine::stageNext(uint32_t currentTimestampMs)
+{
+  std::optional<TxChunk> chunk = scheduler_.next(currentTimestampMs);
+  if (!chunk.has_value())
+    return false;
+
+  stagedChunk_ = *chunk;
+  serializeStaged();
+  staged_ = true;
+  stagedAttempts_ = 0;
+  return true;
+}
+
+void TxEngine::dropStaged()
+{
+  framesDropped_++;
+  staged_ = false;
+  scheduler_.commit(stagedChunk_);
+  onFrameDone(stagedChunk_, false);
+}
+
+void TxEngine::serializeStaged()
+{
+  if (compactFrames_)
+  {
+    stagedLength_ = PacketSerializer::serializeCompact(stagedChunk_.packet, buffers_[stagedBuffer_]);
+  }
+  else
+  {
+    PacketSerializer::serialize(stagedChunk_.packet, buffers_[stagedBuffer_]);
+    stagedLength_ = MAX_TX_PACKET_SIZE;
+  }
+}
+
+uint64_t TxEngine::requiredAirtimeUs() const
+{
+  uint64_t airtimeUs = LoRaAirtime::timeOnAirUs(modulation_, stagedLength_);
+  return stagedChunk_.priority == TxPriority::Critical ? airtimeUs : airtimeUs + criticalReserveUs_;
+}
+
+uint32_t TxEngine::nextTransmitDelayMs(uint32_t currentTimestampMs) const
+{
+  if (onAir_ || !staged_)
+    return 0;
+  uint32_t delayMs = 0;
+  if (budget_.has_value())
+    delayMs = budget_->waitTimeMs(requiredAirtimeUs(), currentTimestampMs);
+  if (tdma_.has_value())
+  {
+    // A frame that never fits is dropped by the next poll().
+    uint32_t airtimeUs = LoRaAirtime::timeOnAirUs(modulation_, stagedLength_);
+    if (!tdma_->fitsSlot(airtimeUs))
+      return 0;
+    delayMs = std::max(delayMs, tdma_->waitTimeMs(airtimeUs, currentTimestampMs));
+  }
+  return delayMs;
+}
+
+uint64_t TxEngine::remainingAirtimeUs(uint32_t currentTimestampMs) const
+{
+  return budget_.has_value() ? budget_->availableUs(currentTimestampMs) : UINT64_MAX;
+}
+
+bool TxEngine::idle() const
+{
+  return !onAir_ && !staged_ && scheduler_.empty() && queued_.load(std::memory_order_relaxed) == 0 &&
+         !linkChangePending();
+}
+
+TxEngine::Stats TxEngine::stats() const
+{
+  Stats stats;
+  stats.messagesQueued = messagesQueued_.load(std::memory_order_relaxed);
+  stats.messagesRefused = messagesRefused_.load(std::memory_order_relaxed);
+  stats.messagesSent = messagesSent_;
+  stats.framesSent = framesSent_;
+  stats.messagesExpired = scheduler_.expiredMessages();
+  stats.radioErrors = radioErrors_;
+  stats.framesDropped = framesDropped_;
+  stats.framesTooLong = framesTooLong_;
+  stats.framesDeferred = framesDeferred_;
+  stats.airtimeUs = airtimeUs_;
+  stats.linkChanges = linkChanges_;
+  stats.slotWaits = slotWaits_;
+  stats.beaconsSent = beaconsSent_;
+  stats.resends = resends_;
+  return stats;
+}
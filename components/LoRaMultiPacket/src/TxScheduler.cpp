@@ -0,0 +1,166 @@
+#include "TxScheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "PacketSerializer.hpp"
+
+TxScheduler::TxScheduler(size_t maxMessages)
+    : maxMessages_(maxMessages)
+{
+  messages_.reserve(maxMessages);
+}
+
+std::optional<uint32_t> TxScheduler::add(std::vector<uint8_t> &&data, uint16_t messageId, const TxOptions &options)
+{
+  size_t chunkSize = options.chunkPayloadSize != 0 ? options.chunkPayloadSize : LORA_MAX_PAYLOAD_SIZE;
+  if (full() || data.empty() || !PacketSerializer::validChunkSize(data.size(), chunkSize))
+    return std::nullopt;
+
+  Entry entry;
+  entry.chunkSize = chunkSize;
+  entry.totalChunks = PacketSerializer::chunksFor(data.size(), chunkSize);
+  for (size_t i = 0; i < entry.totalChunks; i++)
+    entry.selected.set(i);
+  if (options.chunks.has_value())
+    entry.selected &= *options.chunks;
+  entry.selectedChunks = entry.selected.count();
+  if (entry.selectedChunks == 0)
+    return std::nullopt;
+  skipUnselected(entry);
+
+  entry.data = std::move(data);
+  entry.messageId = messageId;
+  entry.options = options;
+  entry.ticket = nextTicket_++;
+  entry.lastServed = serveCounter_;
+  messages_.push_back(std::move(entry));
+  return messages_.back().ticket;
+}
+
+std::optional<TxChunk> TxScheduler::next(uint32_t currentTimestampMs)
+{
+  dropExpired(currentTimestampMs);
+
+  Entry *best = nullptr;
+  for (Entry &entry : messages_)
+  {
+    if (entry.pickedChunks >= entry.selectedChunks)
+      continue;  // Every chunk already picked, waiting for commit().
+    if (best == nullptr || before(entry, *best, currentTimestampMs))
+      best = &entry;
+  }
+  if (best == nullptr)
+    return std::nullopt;
+
+  TxChunk chunk;
+  chunk.packet = PacketSerializer::chunkPacket(best->data.data(), best->data.size(), best->messageId, best->nextChunk,
+                                              best->chunkSize);
+  if (best->options.control)
+  {
+    chunk.packet.header.flags |= PACKET_FLAG_CONTROL;
+    chunk.packet.calculateCRC();
+  }
+  chunk.ticket = best->ticket;
+  chunk.priority = best->options.priority;
+  chunk.last = best->pickedChunks + 1 == best->selectedChunks;
+  best->pickedChunks++;
+  best->nextChunk++;
+  skipUnselected(*best);
+  best->lastServed = ++serveCounter_;
+  return chunk;
+}
+
+void TxScheduler::commit(const TxChunk &chunk)
+{
+  Entry *entry = find(chunk.ticket);
+  if (entry == nullptr)
+    return;
+
+  entry->committedChunks++;
+  if (entry->committedChunks >= entry->selectedChunks)
+    messages_.erase(messages_.begin() + (entry - messages_.data()));
+}
+
+void TxScheduler::requeue(const TxChunk &chunk)
+{
+  Entry *entry = find(chunk.ticket);
+  if (entry != nullptr && entry->pickedChunks > entry->committedChunks)
+  {
+    // The staged chunk is always the last one picked from its message.
+    entry->pickedChunks--;
+    entry->nextChunk = chunk.packet.header.chunkIndex;
+  }
+}
+
+bool TxScheduler::shouldPreempt(const TxChunk &chunk, uint32_t currentTimestampMs) const
+{
+  const Entry *own = find(chunk.ticket);
+  if (own == nullptr || expired(*own, currentTimestampMs))
+    return true;
+
+  for (const Entry &entry : messages_)
+  {
+    if (entry.pickedChunks < entry.selectedChunks && entry.options.priority < chunk.priority &&
+        !expired(entry, currentTimestampMs))
+      return true;
+  }
+  return false;
+}
+
+TxScheduler::Entry *TxScheduler::find(uint32_t ticket)
+{
+  for (Entry &entry : messages_)
+  {
+    if (entry.ticket == ticket)
+      return &entry;
+  }
+  return nullptr;
+}
+
+const TxScheduler::Entry *TxScheduler::find(uint32_t ticket) const
+{
+  return const_cast<TxScheduler *>(this)->find(ticket);
+}
+
+void TxScheduler::dropExpired(uint32_t currentTimestampMs)
+{
+  auto end = std::remove_if(messages_.begin(), messages_.end(), [&](const Entry &entry)
+                            { return entry.pickedChunks == entry.committedChunks && expired(entry, currentTimestampMs); });
+  expiredMessages_ += static_cast<uint64_t>(messages_.end() - end);
+  messages_.erase(end, messages_.end());
+}
+
+bool TxScheduler::expired(const Entry &entry, uint32_t currentTimestampMs)
+{
+  // Wrap-safe comparison of millisecond timestamps.
+  return entry.options.deadlineMs.has_value() &&
+         static_cast<int32_t>(currentTimestampMs - *entry.options.deadlineMs) > 0;
+}
+
+void TxScheduler::skipUnselected(Entry &entry)
+{
+  while (entry.nextChunk < entry.totalChunks && !entry.selected.test(entry.nextChunk))
+    entry.nextChunk++;
+}
+
+bool TxScheduler::before(const Entry &a, const Entry &b, uint32_t currentTimestampMs)
+{
+  if (a.options.priority != b.options.priority)
+    return a.options.priority < b.options.priority;
+
+  bool aDeadline = a.options.deadlineMs.has_value();
+  bool bDeadline = b.options.deadlineMs.has_value();
+  if (aDeadline != bDeadline)
+    return aDeadline;
+
+  if (aDeadline)
+  {
+    int32_t aLeft = static_cast<int32_t>(*a.options.deadlineMs - currentTimestampMs);
+    int32_t bLeft = static_cast<int32_t>(*b.options.deadlineMs - currentTimestampMs);
+    if (aLeft != bLeft)
+      return aLeft < bLeft;
+  }
+
+  return a.lastServed < b.lastServed;
+}
@@ -0,0 +1,96 @@
+#include "UartTransport.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+// Offset of PacketHeader::payloadSize in the serialized header.
+constexpr size_t PAYLOAD_SIZE_OFFSET = offsetof(PacketHeader, payloadSize);
+}  // namespace
+
+UartTransport::UartTransport(WriteFn write, ReadFn read, const UartTransportConfig &config)
+    : write_(std::move(write)), read_(std::move(read)), config_(config)
+{
+}
+
+bool UartTransport::startTransmit(const uint8_t *frame, size_t length)
+{
+  if (transmitting_ || frame == nullptr || length < HEADER_SIZE + CRC_SIZE)
+    return false;
+
+  size_t payloadSize = frame[PAYLOAD_SIZE_OFFSET];
+  size_t compactLength = HEADER_SIZE + payloadSize + CRC_SIZE;
+  if (payloadSize > LORA_MAX_PAYLOAD_SIZE || compactLength > length || compactLength > config_.maxFrameSize)
+    return false;
+
+  bool written;
+  if (compactLength == length)
+  {
+    written = write_(frame, length);
+  }
+  else
+  {
+    // Full frame: drop the padding, the CRC does not cover it.
+    uint8_t compact[MAX_PACKET_SIZE];
+    std::memcpy(compact, frame, HEADER_SIZE + payloadSize);
+    std::memcpy(compact + HEADER_SIZE + payloadSize, frame + length - CRC_SIZE, CRC_SIZE);
+    written = write_(compact, compactLength);
+  }
+  if (!written)
+    return false;
+
+  transmitting_ = true;
+  transmitStartMs_ = now_;
+  transmitDurationMs_ = (LoRaAirtime::timeOnAirUs(config_.modulation, compactLength) + 999) / 1000 + config_.interFrameGapMs;
+  return true;
+}
+
+void UartTransport::poll(uint32_t currentTimestampMs)
+{
+  now_ = currentTimestampMs;
+
+  if (transmitting_ && currentTimestampMs - transmitStartMs_ >= transmitDurationMs_)
+  {
+    transmitting_ = false;
+    transmitDone();
+  }
+
+  // Gives up a truncated frame; complete frames received after it still come out.
+  if (decoder_.pendingBytes() > 0 && currentTimestampMs - lastByteMs_ > config_.rxIdleTimeoutMs)
+  {
+    decoder_.flush();
+    deliverDecoded(lastByteMs_);
+  }
+
+  size_t count;
+  while ((count = read_(rx_, sizeof(rx_))) > 0)
+  {
+    lastByteMs_ = currentTimestampMs;
+    decoder_.push(rx_, count);
+    deliverDecoded(currentTimestampMs);
+  }
+}
+
+void UartTransport::deliverDecoded(uint32_t timestampMs)
+{
+  while (auto view = decoder_.next())
+  {
+    FrameMeta meta;
+    meta.timestampMs = timestampMs;
+    meta.length = static_cast<uint16_t>(view->length);
+    deliverFrame(view->frame, view->length, meta);
+  }
+}
+
+UartTransport::Stats UartTransport::stats() const
+{
+  const FrameStreamDecoder::Stats &decoder = decoder_.stats();
+  Stats stats;
+  stats.framesReceived = decoder.framesDecoded;
+  stats.bytesReceived = decoder.bytesReceived;
+  stats.bytesDiscarded = decoder.bytesDiscarded;
+  stats.crcErrors = decoder.crcErrors;
+  return stats;
+}
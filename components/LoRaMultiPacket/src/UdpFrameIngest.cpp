@@ -0,0 +1,188 @@
+#include "UdpFrameIngest.hpp"
+
+#ifdef __linux__
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+UdpFrameIngest::~UdpFrameIngest()
+{
+  close();
+}
+
+bool UdpFrameIngest::open(uint16_t port, const char *bindAddress, int receiveBufferBytes)
+{
+  close();
+
+  fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd_ < 0)
+    return false;
+
+  // Best effort: the kernel may clamp this to net.core.rmem_max.
+  ::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &receiveBufferBytes, sizeof(receiveBufferBytes));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  if (::inet_pton(AF_INET, bindAddress, &addr.sin_addr) != 1 ||
+      ::bind(fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+  {
+    close();
+    return false;
+  }
+
+  socklen_t len = sizeof(addr);
+  ::getsockname(fd_, reinterpret_cast<sockaddr *>(&addr), &len);
+  port_ = ntohs(addr.sin_port);
+  return true;
+}
+
+void UdpFrameIngest::close()
+{
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  port_ = 0;
+}
+
+int UdpFrameIngest::receiveBatch(FrameArena &arena, uint32_t timestampMs, int timeoutMs)
+{
+  arena.clear();
+  if (fd_ < 0 || arena.capacity() == 0)
+    return -1;
+
+  if (timeoutMs != 0)
+  {
+    pollfd pfd{fd_, POLLIN, 0};
+    int ready = ::poll(&pfd, 1, timeoutMs);
+    if (ready == 0)
+      return 0;
+    if (ready < 0)
+      return errno == EINTR ? 0 : -1;
+  }
+
+  if (boundArena_ != &arena || messages_.size() != arena.capacity())
+    bindArena(arena);
+
+  int received = ::recvmmsg(fd_, messages_.data(), static_cast<unsigned>(messages_.size()), MSG_DONTWAIT, nullptr);
+  if (received < 0)
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+
+  for (int i = 0; i < received; i++)
+  {
+    const mmsghdr &msg = messages_[i];
+    FrameMeta &meta = arena.meta(i);
+    meta.sourceId = ntohl(addresses_[i].sin_addr.s_addr);
+    meta.timestampMs = timestampMs;
+    meta.length = (msg.msg_hdr.msg_flags & MSG_TRUNC) ? 0 : static_cast<uint16_t>(msg.msg_len);
+    meta.rssi = 0.0f;
+    meta.snr = 0.0f;
+
+    // recvmmsg() updates msg_namelen in place; restore it for the next call.
+    messages_[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+  }
+
+  arena.setSize(static_cast<size_t>(received));
+  return received;
+}
+
+void UdpFrameIngest::bindArena(FrameArena &arena)
+{
+  size_t n = arena.capacity();
+  messages_.assign(n, mmsghdr{});
+  iovecs_.assign(n, iovec{});
+  addresses_.assign(n, sockaddr_in{});
+
+  for (size_t i = 0; i < n; i++)
+  {
+    iovecs_[i].iov_base = arena.slot(i);
+    iovecs_[i].iov_len = MAX_PACKET_SIZE;
+
+    msghdr &hdr = messages_[i].msg_hdr;
+    hdr.msg_name = &addresses_[i];
+    hdr.msg_namelen = sizeof(sockaddr_in);
+    hdr.msg_iov = &iovecs_[i];
+    hdr.msg_iovlen = 1;
+  }
+  boundArena_ = &arena;
+}
+
+UdpFrameSender::~UdpFrameSender()
+{
+  close();
+}
+
+bool UdpFrameSender::open(const char *destAddress, uint16_t destPort)
+{
+  close();
+
+  dest_ = sockaddr_in{};
+  dest_.sin_family = AF_INET;
+  dest_.sin_port = htons(destPort);
+  if (::inet_pton(AF_INET, destAddress, &dest_.sin_addr) != 1)
+    return false;
+
+  fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  return fd_ >= 0;
+}
+
+void UdpFrameSender::close()
+{
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+bool UdpFrameSender::send(const uint8_t *frame, size_t length)
+{
+  if (fd_ < 0)
+    return false;
+  ssize_t sent = ::sendto(fd_, frame, length, 0, reinterpret_cast<const sockaddr *>(&dest_), sizeof(dest_));
+  return sent == static_cast<ssize_t>(length);
+}
+
+int UdpFrameSender::sendBatch(const FrameArena &arena)
+{
+  if (fd_ < 0)
+    return -1;
+
+  size_t n = arena.size();
+  messages_.resize(n);
+  iovecs_.resize(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    iovecs_[i].iov_base = const_cast<uint8_t *>(arena.slot(i));
+    iovecs_[i].iov_len = arena.meta(i).length;
+
+    msghdr &hdr = messages_[i].msg_hdr;
+    hdr = msghdr{};
+    hdr.msg_name = &dest_;
+    hdr.msg_namelen = sizeof(dest_);
+    hdr.msg_iov = &iovecs_[i];
+    hdr.msg_iovlen = 1;
+  }
+
+  size_t done = 0;
+  while (done < n)
+  {
+    int sent = ::sendmmsg(fd_, messages_.data() + done, static_cast<unsigned>(n - done), 0);
+    if (sent < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return done > 0 ? static_cast<int>(done) : -1;
+    }
+    done += static_cast<size_t>(sent);
+  }
+  return static_cast<int>(done);
+}
+
+#endif  // __linux__
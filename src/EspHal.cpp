@@ -153,12 +153,39 @@ long EspHal::pulseIn(uint32_t pin, uint32_t state, unsigned long timeout)
   return 0;
 }
 
+// Trampolino: il servizio ISR GPIO passa un argomento, le callback RadioLib non ne hanno.
+static void IRAM_ATTR gpioIsrTrampoline(void *arg)
+{
+  reinterpret_cast<void (*)(void)>(arg)();
+}
+
 void EspHal::attachInterrupt(uint32_t interruptNum, void (*interruptCb)(void), uint32_t mode)
 {
-  // Polling mode, interrupt non usati
+  // Installato una sola volta; ESP_ERR_INVALID_STATE se gia' presente.
+  esp_err_t err = gpio_install_isr_service(0);
+  if (err != ESP_OK && err != ESP_ERR_INVALID_STATE)
+  {
+    ESP_LOGE(TAG, "gpio_install_isr_service fallito: %d", err);
+    return;
+  }
+
+  gpio_int_type_t type = GPIO_INTR_ANYEDGE;
+  if (mode == RISING)
+  {
+    type = GPIO_INTR_POSEDGE;
+  }
+  else if (mode == FALLING)
+  {
+    type = GPIO_INTR_NEGEDGE;
+  }
+
+  gpio_set_intr_type((gpio_num_t)interruptNum, type);
+  gpio_isr_handler_add((gpio_num_t)interruptNum, gpioIsrTrampoline, reinterpret_cast<void *>(interruptCb));
+  gpio_intr_enable((gpio_num_t)interruptNum);
 }
 
 void EspHal::detachInterrupt(uint32_t interruptNum)
 {
-  // Polling mode
+  gpio_isr_handler_remove((gpio_num_t)interruptNum);
+  gpio_set_intr_type((gpio_num_t)interruptNum, GPIO_INTR_DISABLE);
 }
\ No newline at end of file
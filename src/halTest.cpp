@@ -17,10 +17,25 @@
 # define HAL_TEST_RECV // Uncomment to test HAL for the Receiver module.
 */
 
+/*
+# define HAL_TEST_ENDPOINT // Uncomment (alone) to test RadioLibTransport + LinkEndpoint: flash two boards,
+                           // each sends a message every 5 s and logs the ones it receives.
+*/
+
+/*
+# define HAL_TEST_CAPTURE // Uncomment (with HAL_TEST_RECV) to record received frames to /spiffs/rx.lmpcap.
+                          // Requires a "spiffs" partition; replay on host with tools/frame_replay.
+*/
+
  #ifdef HAL_TEST_TRANS
 #include <RadioLib.h>
 
+#include <cstdio>
+#include <vector>
+
 #include "EspHal.hpp"
+#include "RadioTransmitter.hpp"
+#include "TxEngine.hpp"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -33,6 +48,31 @@ EspHal *hal = new EspHal(HELTEC_LORA_SCK, HELTEC_LORA_MISO, HELTEC_LORA_MOSI);
 // 2. Istanziamo il modulo SX1262 usando l'HAL e i pin di controllo (NSS, DIO1, RST, BUSY)
 SX1262 radio = new Module(hal, HELTEC_LORA_NSS, HELTEC_LORA_DIO1, HELTEC_LORA_RST, HELTEC_LORA_BUSY);
 
+// Motore TX asincrono: serializza il frame N+1 mentre il frame N e' in aria.
+// Banda EU868 g1 (868.0-868.6 MHz): duty cycle 1%, calcolato sul tempo in aria di ogni frame.
+static TxEngineConfig makeTxConfig()
+{
+  TxEngineConfig config;
+  config.modulation.spreadingFactor = 9;  // Default di radio.begin()
+  config.modulation.bandwidthHz = 125000;
+  config.modulation.codingRate = 7;
+  config.airtimeBudget = AirtimeBudgetConfig();
+  return config;
+}
+
+static RadioLibTransmitter<SX1262> transmitter(radio);
+static TxEngine txEngine(transmitter, makeTxConfig());
+static TaskHandle_t txTask = nullptr;
+
+// ISR di fine trasmissione (DIO1): segnala il motore e sveglia il task TX.
+static void IRAM_ATTR onTransmitDone(void)
+{
+  txEngine.onTransmitDone();
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(txTask, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
 extern "C" void app_main(void)
 {
   ESP_LOGI(TAG, "=== TEST HAL INIZIATO ===");
@@ -61,24 +101,44 @@ extern "C" void app_main(void)
       vTaskDelay(1000);
   }
 
-  // 5. Loop di test trasmissione
+  txTask = xTaskGetCurrentTaskHandle();
+  radio.setPacketSentAction(onTransmitDone);
+
+  // 5. Loop di test trasmissione: un messaggio multi-chunk ogni 2 s, i chunk
+  // vengono concatenati dal motore senza attese tra un frame e l'altro.
+  uint16_t messageId = 1;
+  TickType_t nextMessage = xTaskGetTickCount();
   while (true)
   {
-    ESP_LOGI(TAG, "Tentativo di invio pacchetto RAW...");
-
-    // Invio semplice stringa (senza il tuo protocollo custom)
-    state = radio.transmit("Test HAL OK!");
-
-    if (state == RADIOLIB_ERR_NONE)
+    if (xTaskGetTickCount() >= nextMessage)
     {
-      ESP_LOGI(TAG, "TX Completata con successo!");
+      std::vector<uint8_t> message(600);
+      snprintf(reinterpret_cast<char *>(message.data()), message.size(), "Test HAL OK! msg %u", messageId);
+
+      // enqueue() non blocca: se la coda e' piena il messaggio viene rifiutato (backpressure).
+      if (txEngine.enqueue(std::move(message), messageId))
+      {
+        messageId++;
+      }
+      else
+      {
+        ESP_LOGW(TAG, "Coda TX piena");
+      }
+      nextMessage = xTaskGetTickCount() + pdMS_TO_TICKS(2000);
     }
-    else
+
+    uint32_t nowMs = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+    txEngine.poll(nowMs);
+
+    // Attende l'ISR di fine TX, il prossimo messaggio o il credito di airtime
+    // necessario al frame in attesa: niente pause manuali con vTaskDelay.
+    uint32_t waitMs = txEngine.nextTransmitDelayMs(nowMs);
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs > 0 && waitMs < 100 ? waitMs : 100));
+    if (waitMs > 0)
     {
-      ESP_LOGE(TAG, "Errore TX: %d", state);
+      ESP_LOGI(TAG, "Duty cycle: prossimo frame tra %u ms (budget %llu us)", (unsigned)waitMs,
+               (unsigned long long)txEngine.remainingAirtimeUs(nowMs));
     }
-
-    vTaskDelay(pdMS_TO_TICKS(2000));
   }
 }
 #endif
@@ -87,19 +147,41 @@ extern "C" void app_main(void)
 #ifdef HAL_TEST_RECV
 #include <RadioLib.h>
 
+#include <cstdio>
 #include <cstring>
 
 #include "EspHal.hpp"
+#include "LinkAdaptation.hpp"
+#include "PacketParser.hpp"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
+#ifdef HAL_TEST_CAPTURE
+#include "FrameCapture.hpp"
+#include "esp_spiffs.h"
+#endif
+
 static const char *TAG = "HalTestRX";
 
 // 1. Istanziamo l'HAL e il Modulo
 EspHal *hal = new EspHal(HELTEC_LORA_SCK, HELTEC_LORA_MISO, HELTEC_LORA_MOSI);
 SX1262 radio = new Module(hal, HELTEC_LORA_NSS, HELTEC_LORA_DIO1, HELTEC_LORA_RST, HELTEC_LORA_BUSY);
 
+// Segue i cambi di SF/BW annunciati dal trasmettitore (LinkAnnouncement).
+// Profilo iniziale = default di radio.begin(); fallback = gradino più robusto della scala.
+static LinkFollower linkFollower(LinkProfile{9, 125000, 7, 192}, LinkAdaptationConfig().ladder.back(), 60000);
+
+static void applyLinkProfile(const LinkProfile &profile)
+{
+  radio.setSpreadingFactor(profile.spreadingFactor);
+  radio.setBandwidth(profile.bandwidthHz / 1000.0f);
+  radio.setCodingRate(profile.codingRate);
+  ESP_LOGI(TAG, "Nuovo profilo: SF%u, BW %u Hz, CR 4/%u", (unsigned)profile.spreadingFactor,
+           (unsigned)profile.bandwidthHz, (unsigned)profile.codingRate);
+}
+
 extern "C" void app_main(void)
 {
   ESP_LOGI(TAG, "=== TEST RICEVITORE (BYTE ARRAY) ===");
@@ -126,6 +208,25 @@ extern "C" void app_main(void)
       vTaskDelay(1000);
   }
 
+#ifdef HAL_TEST_CAPTURE
+  // 4b. Cattura binaria dei frame su SPIFFS (append-only, leggibile anche se interrotta)
+  esp_vfs_spiffs_conf_t spiffsConf = {};
+  spiffsConf.base_path = "/spiffs";
+  spiffsConf.max_files = 2;
+  spiffsConf.format_if_mount_failed = true;
+  FILE *captureFile = nullptr;
+  if (esp_vfs_spiffs_register(&spiffsConf) == ESP_OK)
+  {
+    captureFile = fopen("/spiffs/rx.lmpcap", "wb");
+  }
+  CaptureWriter capture([captureFile](const uint8_t *data, size_t length)
+                        { return captureFile != nullptr && fwrite(data, 1, length, captureFile) == length; });
+  if (captureFile == nullptr || !capture.begin())
+  {
+    ESP_LOGE(TAG, "Cattura non disponibile (partizione spiffs?)");
+  }
+#endif
+
   // 5. Loop di Ricezione
   uint8_t rxBuffer[256];  // Buffer statico per i dati grezzi
 
@@ -147,10 +248,32 @@ extern "C" void app_main(void)
 
       ESP_LOGI(TAG, "RSSI: %.2f dBm", radio.getRSSI());
       ESP_LOGI(TAG, "SNR:  %.2f dB", radio.getSNR());
+
+      uint32_t nowMs = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+      auto packet = PacketParser::parse(rxBuffer, len);
+      if (packet.has_value() && linkFollower.onPacket(*packet, nowMs) == LinkEvent::Changed)
+      {
+        applyLinkProfile(linkFollower.current());
+      }
+
+#ifdef HAL_TEST_CAPTURE
+      FrameMeta meta;
+      meta.timestampMs = nowMs;
+      meta.rssi = radio.getRSSI();
+      meta.snr = radio.getSNR();
+      if (capture.write(rxBuffer, len, meta) && capture.recordCount() % 16 == 0)
+      {
+        fflush(captureFile);  // Limita la perdita di dati in caso di reset
+      }
+#endif
     }
     else if (state == RADIOLIB_ERR_RX_TIMEOUT)
     {
-      // Timeout: normale, riproviamo
+      // Timeout: normale, riproviamo (dopo un lungo silenzio si torna al profilo di fallback)
+      if (linkFollower.checkTimeout(static_cast<uint32_t>(esp_timer_get_time() / 1000)))
+      {
+        applyLinkProfile(linkFollower.current());
+      }
     }
     else if (state == RADIOLIB_ERR_CRC_MISMATCH)
     {
@@ -164,4 +287,92 @@ extern "C" void app_main(void)
     vTaskDelay(pdMS_TO_TICKS(10));
   }
 }
-#endif
\ No newline at end of file
+#endif
+
+
+#ifdef HAL_TEST_ENDPOINT
+#include <RadioLib.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "EspHal.hpp"
+#include "LinkEndpoint.hpp"
+#include "RadioLibTransport.hpp"
+#include "esp_log.h"
+#include "esp_mac.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "HalTest";
+
+EspHal *hal = new EspHal(HELTEC_LORA_SCK, HELTEC_LORA_MISO, HELTEC_LORA_MOSI);
+SX1262 radio = new Module(hal, HELTEC_LORA_NSS, HELTEC_LORA_DIO1, HELTEC_LORA_RST, HELTEC_LORA_BUSY);
+
+// Trasporto + endpoint: TX, RX, riassemblaggio e pulizia delle sessioni in un unico oggetto.
+static RadioLibTransport<SX1262> transport(radio);
+static TaskHandle_t radioTask = nullptr;
+
+// ISR DIO1 (fine TX o pacchetto ricevuto): solo un flag e la sveglia del task radio.
+static void IRAM_ATTR onDio1(void)
+{
+  transport.onInterrupt();
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(radioTask, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+extern "C" void app_main(void)
+{
+  ESP_LOGI(TAG, "=== TEST ENDPOINT INIZIATO ===");
+
+  gpio_reset_pin(HELTEC_POWER_CTRL);
+  gpio_set_direction(HELTEC_POWER_CTRL, GPIO_MODE_OUTPUT);
+  gpio_set_level(HELTEC_POWER_CTRL, 0);  // LOW = Acceso
+  vTaskDelay(pdMS_TO_TICKS(100));
+
+  int state = radio.begin(868.0);
+  if (state != RADIOLIB_ERR_NONE)
+  {
+    ESP_LOGE(TAG, "FALLITO. Codice errore: %d", state);
+    while (true)
+      vTaskDelay(1000);
+  }
+
+  radioTask = xTaskGetCurrentTaskHandle();
+  radio.setDio1Action(onDio1);
+
+  LinkEndpointConfig config;
+  config.tx.airtimeBudget = AirtimeBudgetConfig();  // EU868 g1: duty cycle 1%
+  static LinkEndpoint link(transport, config);
+  link.onMessage([](uint32_t, uint16_t messageId, std::vector<uint8_t> &&message)
+                 { ESP_LOGI(TAG, "Messaggio %u ricevuto (%u byte): %.32s", messageId, (unsigned)message.size(),
+                            reinterpret_cast<const char *>(message.data())); });
+  transport.begin();
+
+  // Le ultime cifre del MAC distinguono le due schede nei messaggi.
+  uint8_t mac[6];
+  esp_read_mac(mac, ESP_MAC_WIFI_STA);
+
+  TickType_t nextMessage = xTaskGetTickCount();
+  unsigned sent = 0;
+  while (true)
+  {
+    if (xTaskGetTickCount() >= nextMessage)
+    {
+      std::vector<uint8_t> message(400, 0);
+      snprintf(reinterpret_cast<char *>(message.data()), message.size(), "Endpoint %02X%02X msg %u", mac[4], mac[5], sent);
+      if (link.send(std::move(message)).has_value())
+        sent++;
+      nextMessage = xTaskGetTickCount() + pdMS_TO_TICKS(5000);
+    }
+
+    uint32_t nowMs = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+    link.poll(nowMs);
+
+    uint32_t waitMs = link.engine().nextTransmitDelayMs(nowMs);
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs > 0 && waitMs < 100 ? waitMs : 100));
+  }
+}
+#endif
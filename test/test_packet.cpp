@@ -2,15 +2,46 @@
 
 #include <unity.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>  // for memcmp
+#include <deque>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
 #include <vector>
 
+#include "AirtimeBudget.hpp"
+#include "BatchReceiver.hpp"
+#include "BondedTransport.hpp"
+#include "BulkPacketizer.hpp"
+#include "ChannelSimulator.hpp"
+#include "Crc16.hpp"
+#include "FrameArena.hpp"
+#include "FrameCapture.hpp"
+#include "FrameRelay.hpp"
+#include "FrameStreamDecoder.hpp"
+#include "LinkAdaptation.hpp"
+#include "LinkEndpoint.hpp"
+#include "LoopbackTransport.hpp"
+#include "LoRaAirtime.hpp"
+#include "MessageBufferPool.hpp"
 #include "Packet.hpp"
 #include "PacketDeserializer.hpp"
+#include "PacketLog.hpp"
 #include "PacketParser.hpp"
 #include "PacketReassembler.hpp"
 #include "PacketSerializer.hpp"
 #include "PacketValidator.hpp"
+#include "PsramResource.hpp"
+#include "ReassemblyJournal.hpp"
+#include "ShardedReassembler.hpp"
+#include "StreamingReassembler.hpp"
+#include "TdmaSchedule.hpp"
+#include "TxEngine.hpp"
+#include "TypedReassembler.hpp"
+#include "UartTransport.hpp"
+#include "UdpFrameIngest.hpp"
 
 void setUp(void)
 {
@@ -49,6 +80,45 @@ static void test_crc_changes_on_payload_modification(void)
   TEST_ASSERT_NOT_EQUAL(p1.crc, p2.crc);
 }
 
+/**
+ * @brief Verifies the Modbus CRC-16 check value and bit-exactness of all kernels.
+ */
+static void test_crc16_kernels_bit_exact(void)
+{
+  const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  TEST_ASSERT_EQUAL_HEX16(0x4B37, Crc16::compute(check, sizeof(check)));
+
+  ChannelSimulator rng;
+  std::vector<uint8_t> data(2048);
+  for (auto &b : data)
+    b = static_cast<uint8_t>(rng.nextRandom());
+
+  // Lengths around the slicing and folding boundaries, odd alignments, random seeds.
+  for (size_t len = 0; len < 600; ++len)
+  {
+    uint16_t init = static_cast<uint16_t>(rng.nextRandom());
+    const uint8_t *p = data.data() + (len % 13);
+    TEST_ASSERT_EQUAL_HEX16(Crc16::updateBitwise(init, p, len), Crc16::update(init, p, len));
+  }
+  TEST_ASSERT_EQUAL_HEX16(Crc16::updateBitwise(0xFFFF, data.data(), data.size()), Crc16::compute(data.data(), data.size()));
+
+  // Multi-stream over uneven lengths and a partial final group.
+  const size_t streams = 19;
+  const uint8_t *ptrs[streams];
+  size_t lengths[streams];
+  uint16_t crcs[streams];
+  for (size_t i = 0; i < streams; ++i)
+  {
+    ptrs[i] = data.data() + i * 37;
+    lengths[i] = (i * 53) % 260;
+  }
+  Crc16::computeMulti(ptrs, lengths, streams, crcs);
+  for (size_t i = 0; i < streams; ++i)
+  {
+    TEST_ASSERT_EQUAL_HEX16(Crc16::updateBitwise(0xFFFF, ptrs[i], lengths[i]), crcs[i]);
+  }
+}
+
 /**
  * @brief Verifies splitting a large vector into multiple packets and reassembling them.
  */
@@ -352,12 +422,2894 @@ static void test_reassembler_pruning(void)
   TEST_ASSERT_FALSE(res.has_value());
 }
 
+/**
+ * @brief Verifies that a dead short session is dropped after a few expected gaps.
+ */
+static void test_reassembler_prune_stalled_short_message(void)
+{
+  ReassemblerConfig config;
+  config.initialGapMs = 500;
+  PacketReassembler reassembler(config);
+
+  reassembler.processPacket(create_chunk(50, 0, 2, "Half"), 1000);
+
+  // One chunk missing: tolerated silence = 500 * (1 + 1) = 1000 ms.
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.pruneStalled(1900));
+  TEST_ASSERT_EQUAL_size_t(1, reassembler.pendingSessions());
+
+  TEST_ASSERT_EQUAL_size_t(1, reassembler.pruneStalled(2100));
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.pendingSessions());
+}
+
+/**
+ * @brief Verifies that a slow but progressing transfer survives pruneStalled().
+ */
+static void test_reassembler_prune_stalled_keeps_slow_transfer(void)
+{
+  PacketReassembler reassembler;
+  uint32_t time = 0;
+
+  // 10 of 20 chunks, one every 2 s: a fixed 10 s timeout would already have dropped it.
+  for (uint8_t i = 0; i < 10; ++i)
+  {
+    time = i * 2000;
+    reassembler.processPacket(create_chunk(60, i, 20, "x"), time);
+    TEST_ASSERT_EQUAL_size_t(0, reassembler.pruneStalled(time + 1500));
+  }
+
+  // Still plausible after a couple of lost chunks...
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.pruneStalled(time + 6000));
+  // ...but not after a long silence.
+  TEST_ASSERT_EQUAL_size_t(1, reassembler.pruneStalled(time + 20000));
+}
+
+/**
+ * @brief Verifies that lost chunks do not inflate the gap estimate.
+ */
+static void test_reassembler_prune_stalled_normalizes_lost_chunks(void)
+{
+  ReassemblerConfig config;
+  config.minTimeoutMs = 0;
+  PacketReassembler reassembler(config);
+
+  reassembler.processPacket(create_chunk(70, 0, 10, "a"), 0);
+  reassembler.processPacket(create_chunk(70, 1, 10, "b"), 100);
+  // Chunks 2..5 lost: the 500 ms gap counts as 100 ms per chunk.
+  reassembler.processPacket(create_chunk(70, 6, 10, "c"), 600);
+
+  // gap = 100 ms, deviation decays to 37.5 ms -> 250 ms per chunk, 5 gaps tolerated.
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.pruneStalled(600 + 1000));
+  TEST_ASSERT_EQUAL_size_t(1, reassembler.pruneStalled(600 + 1500));
+}
+
+/**
+ * @brief Verifies that the same messageId from two sources is reassembled as two messages.
+ */
+static void test_reassembler_sessions_keyed_by_source(void)
+{
+  PacketReassembler reassembler;
+
+  reassembler.processPacket(create_chunk(80, 0, 2, "A1"), 0, 1);
+  reassembler.processPacket(create_chunk(80, 0, 2, "B1"), 0, 2);
+  TEST_ASSERT_EQUAL_size_t(2, reassembler.pendingSessions());
+
+  auto a = reassembler.processPacket(create_chunk(80, 1, 2, "A2"), 0, 1);
+  auto b = reassembler.processPacket(create_chunk(80, 1, 2, "B2"), 0, 2);
+  TEST_ASSERT_TRUE(a.has_value());
+  TEST_ASSERT_TRUE(b.has_value());
+  TEST_ASSERT_EQUAL_MEMORY("A1A2", a->data(), 4);
+  TEST_ASSERT_EQUAL_MEMORY("B1B2", b->data(), 4);
+}
+
+/**
+ * @brief Verifies that a chunk whose geometry disagrees with its session is discarded.
+ */
+static void test_reassembler_rejects_mismatched_geometry(void)
+{
+  PacketReassembler reassembler;
+  reassembler.processPacket(create_chunk(81, 0, 2, "A"), 0);
+
+  auto res = reassembler.processPacket(create_chunk(81, 4, 5, "B"), 0);
+  TEST_ASSERT_FALSE(res.has_value());
+  TEST_ASSERT_EQUAL_size_t(1, reassembler.pendingSessions());
+}
+
+/**
+ * @brief Verifies delivery into pooled buffers and that leases return them to the pool.
+ */
+static void test_reassembler_delivers_into_pool(void)
+{
+  MessageBufferPool pool(2, 64);
+  PacketReassembler reassembler;
+
+  auto lease1 = reassembler.processPacketInto(create_chunk(90, 0, 1, "first"), 0, pool);
+  auto lease2 = reassembler.processPacketInto(create_chunk(91, 0, 1, "second"), 0, pool);
+  TEST_ASSERT_TRUE(lease1.has_value());
+  TEST_ASSERT_TRUE(lease2.has_value());
+  TEST_ASSERT_EQUAL_size_t(5, lease1->size());
+  TEST_ASSERT_EQUAL_MEMORY("second", lease2->data(), 6);
+  TEST_ASSERT_EQUAL_size_t(0, pool.available());
+
+  // Pool exhausted: the completed message is dropped and counted.
+  TEST_ASSERT_FALSE(reassembler.processPacketInto(create_chunk(92, 0, 1, "third"), 0, pool).has_value());
+  TEST_ASSERT_EQUAL_size_t(1, reassembler.undeliveredMessages());
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.pendingSessions());
+
+  // Moving a lease keeps the buffer; destroying it returns the buffer.
+  MessageLease kept = std::move(*lease1);
+  lease1.reset();
+  TEST_ASSERT_EQUAL_size_t(0, pool.available());
+  TEST_ASSERT_EQUAL_MEMORY("first", kept.data(), 5);
+  kept.release();
+  TEST_ASSERT_EQUAL_size_t(1, pool.available());
+
+  auto lease3 = reassembler.processPacketInto(create_chunk(93, 0, 1, "fourth"), 0, pool);
+  TEST_ASSERT_TRUE(lease3.has_value());
+  TEST_ASSERT_EQUAL_MEMORY("fourth", lease3->data(), 6);
+}
+
+/**
+ * @brief Verifies delivery into a caller-supplied span, including the too-small case.
+ */
+static void test_reassembler_delivers_into_span(void)
+{
+  PacketReassembler reassembler;
+  uint8_t out[LORA_MAX_PAYLOAD_SIZE + 10];
+
+  std::vector<uint8_t> message(LORA_MAX_PAYLOAD_SIZE + 10, 0x5A);
+  auto packets = PacketSerializer::splitVectorToPackets(message, 94);
+  TEST_ASSERT_FALSE(reassembler.processPacketInto(packets[1], 0, out, sizeof(out)).has_value());
+  auto length = reassembler.processPacketInto(packets[0], 0, out, sizeof(out));
+  TEST_ASSERT_TRUE(length.has_value());
+  TEST_ASSERT_EQUAL_size_t(message.size(), *length);
+  TEST_ASSERT_EQUAL_MEMORY(message.data(), out, message.size());
+
+  auto small = PacketSerializer::splitVectorToPackets(message, 95);
+  reassembler.processPacketInto(small[0], 0, out, 16);
+  TEST_ASSERT_FALSE(reassembler.processPacketInto(small[1], 0, out, 16).has_value());
+  TEST_ASSERT_EQUAL_size_t(1, reassembler.undeliveredMessages());
+}
+
+/**
+ * @brief Memory resource that counts the allocations it forwards to new/delete.
+ */
+class CountingResource : public std::pmr::memory_resource
+{
+ public:
+  size_t allocations = 0;
+  size_t live = 0;
+  size_t lastBytes = 0;
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override
+  {
+    allocations++;
+    live++;
+    lastBytes = bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override
+  {
+    live--;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+/**
+ * @brief Verifies that sessions, chunks and results come from the supplied resources only.
+ */
+static void test_reassembler_uses_memory_resources(void)
+{
+  CountingResource sessions, chunks, messages, fallback;
+  std::pmr::memory_resource *previous = std::pmr::set_default_resource(&fallback);
+
+  {
+    PacketReassembler reassembler(ReassemblerConfig{}, ReassemblerResources{&sessions, &chunks});
+    std::vector<uint8_t> message(600, 0x3C);
+    auto packets = PacketSerializer::splitBufferToPackets(message.data(), message.size(), 96, messages);
+    TEST_ASSERT_EQUAL_size_t(1, messages.allocations);
+
+    std::optional<std::pmr::vector<uint8_t>> result;
+    for (const auto &p : packets)
+      result = reassembler.processPacketInto(p, 0, messages);
+
+    TEST_ASSERT_TRUE(result.has_value());
+    TEST_ASSERT_TRUE(result->get_allocator().resource() == &messages);
+    TEST_ASSERT_EQUAL_MEMORY(message.data(), result->data(), message.size());
+    TEST_ASSERT_EQUAL_size_t(2, sessions.allocations);  // map node + per-chunk state
+    TEST_ASSERT_EQUAL_size_t(1, chunks.allocations);    // one contiguous body
+    TEST_ASSERT_EQUAL_size_t(0, sessions.live);
+    TEST_ASSERT_EQUAL_size_t(0, chunks.live);
+  }
+
+  std::pmr::set_default_resource(previous);
+  TEST_ASSERT_EQUAL_size_t(0, fallback.allocations);
+}
+
+/**
+ * @brief Verifies that bodies are tiered by size and that messages with short chunks still reassemble.
+ */
+static void test_reassembler_large_messages_use_psram_tier(void)
+{
+  CountingResource internal;
+  PsramResource psram;
+  ReassemblerResources resources;
+  resources.chunks = &internal;
+  resources.largeChunks = &psram;
+  resources.largeMessageThreshold = 4 * LORA_MAX_PAYLOAD_SIZE;
+  PacketReassembler reassembler(ReassemblerConfig{}, resources);
+
+  // Small message: internal RAM.
+  auto small = reassembler.processPacket(create_chunk(97, 0, 1, "ctl"), 0);
+  TEST_ASSERT_TRUE(small.has_value());
+  TEST_ASSERT_EQUAL_size_t(1, internal.allocations);
+
+  // Large message, delivered out of order: PSRAM tier (regular heap on host).
+  std::vector<uint8_t> image(5 * LORA_MAX_PAYLOAD_SIZE - 7);
+  for (size_t i = 0; i < image.size(); i++)
+    image[i] = static_cast<uint8_t>(i * 31);
+  auto packets = PacketSerializer::splitVectorToPackets(image, 98);
+  std::optional<std::vector<uint8_t>> result;
+  for (size_t i = packets.size(); i-- > 0;)
+    result = reassembler.processPacket(packets[i], 0);
+
+  TEST_ASSERT_TRUE(result.has_value());
+  TEST_ASSERT_EQUAL_size_t(image.size(), result->size());
+  TEST_ASSERT_EQUAL_MEMORY(image.data(), result->data(), image.size());
+  TEST_ASSERT_EQUAL_size_t(1, internal.allocations);
+  TEST_ASSERT_EQUAL_size_t(1, psram.psramAllocations() + psram.fallbackAllocations());
+  TEST_ASSERT_EQUAL_size_t(0, internal.live);
+
+  // Messages with a smaller chunk size are compacted on delivery.
+  reassembler.processPacket(create_chunk(99, 1, 3, "BB"), 0);
+  reassembler.processPacket(create_chunk(99, 0, 3, "AA"), 0);
+  auto compact = reassembler.processPacket(create_chunk(99, 2, 3, "C"), 0);
+  TEST_ASSERT_TRUE(compact.has_value());
+  TEST_ASSERT_EQUAL_size_t(5, compact->size());
+  TEST_ASSERT_EQUAL_MEMORY("AABBC", compact->data(), 5);
+
+  // Bodies are sized and tiered by the real chunk size: 20 chunks of 32 bytes stay in internal RAM.
+  std::vector<uint8_t> telemetry(19 * 32 + 5);
+  for (size_t i = 0; i < telemetry.size(); i++)
+    telemetry[i] = static_cast<uint8_t>(i * 3);
+  auto shortChunks = PacketSerializer::splitVectorToPackets(telemetry, 100, 32);
+  TEST_ASSERT_EQUAL_size_t(20, shortChunks.size());
+  size_t internalBefore = internal.allocations;
+  size_t psramBefore = psram.psramAllocations() + psram.fallbackAllocations();
+  TEST_ASSERT_FALSE(reassembler.processPacket(shortChunks.back(), 0).has_value());  // The final chunk first.
+  TEST_ASSERT_EQUAL_size_t(internalBefore, internal.allocations);
+  for (size_t i = 0; i + 1 < shortChunks.size(); i++)
+    result = reassembler.processPacket(shortChunks[i], 0);
+  TEST_ASSERT_TRUE(result.has_value() && *result == telemetry);
+  TEST_ASSERT_EQUAL_size_t(internalBefore + 1, internal.allocations);
+  TEST_ASSERT_EQUAL_size_t(20 * 32, internal.lastBytes);
+  TEST_ASSERT_EQUAL_size_t(psramBefore, psram.psramAllocations() + psram.fallbackAllocations());
+}
+
+// ============================================================================
+// ChannelSimulator & ShardedReassembler Tests
+// ============================================================================
+
+/**
+ * @brief Verifies that duplicated and reordered frames still reassemble.
+ */
+static void test_simulator_duplicates_and_reordering(void)
+{
+  ChannelModel model;
+  model.duplicateProbability = 0.3;
+  model.reorderWindow = 4;
+  model.seed = 7;
+  ChannelSimulator channel(model);
+
+  std::vector<uint8_t> data(1500);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i * 7);
+  channel.transmitMessage(1, PacketSerializer::splitVectorToPackets(data, 90), 0, 100);
+
+  PacketReassembler reassembler;
+  std::optional<std::vector<uint8_t>> message;
+  SimulatedFrame frame;
+  while (channel.receive(frame))
+  {
+    auto packet = PacketParser::parse(frame.bytes, frame.length);
+    TEST_ASSERT_TRUE(packet.has_value());
+    auto res = reassembler.processPacket(packet.value(), frame.timestampMs, frame.sourceId);
+    if (res.has_value())
+      message = res;
+  }
+
+  TEST_ASSERT_TRUE(message.has_value());
+  TEST_ASSERT_EQUAL_size_t(data.size(), message->size());
+  TEST_ASSERT_EQUAL_MEMORY(data.data(), message->data(), data.size());
+}
+
+/**
+ * @brief Verifies that the sharded engine reassembles interleaved traffic from many sources.
+ */
+static void test_sharded_reassembler_multi_source(void)
+{
+  const uint32_t sources = 16;
+  const uint16_t messagesPerSource = 8;
+
+  std::mutex mutex;
+  size_t completed = 0;
+  bool contentOk = true;
+
+  ShardedReassemblerConfig config;
+  config.shardCount = 4;
+  ShardedReassembler engine(config, [&](uint32_t sourceId, uint16_t messageId, std::vector<uint8_t> &&message)
+                            {
+    std::lock_guard<std::mutex> lock(mutex);
+    completed++;
+    // Every message is filled with a byte derived from its (source, id) pair.
+    uint8_t expected = static_cast<uint8_t>(sourceId * 31 + messageId);
+    contentOk = contentOk && message.size() == 600;
+    for (uint8_t b : message)
+      contentOk = contentOk && b == expected; });
+
+  ChannelModel model;
+  model.reorderWindow = 8;
+  ChannelSimulator channel(model);
+  for (uint16_t id = 1; id <= messagesPerSource; ++id)
+  {
+    for (uint32_t src = 0; src < sources; ++src)
+    {
+      std::vector<uint8_t> data(600, static_cast<uint8_t>(src * 31 + id));
+      channel.transmitMessage(src, PacketSerializer::splitVectorToPackets(data, id), 0);
+    }
+  }
+
+  engine.start();
+  SimulatedFrame frame;
+  while (channel.receive(frame))
+  {
+    TEST_ASSERT_TRUE(engine.submit(frame.sourceId, frame.bytes, frame.length, frame.timestampMs));
+  }
+  engine.flush();
+  engine.stop();
+
+  TEST_ASSERT_EQUAL_size_t(sources * messagesPerSource, completed);
+  TEST_ASSERT_TRUE(contentOk);
+  TEST_ASSERT_EQUAL_UINT64(sources * messagesPerSource, engine.stats().messagesCompleted);
+  TEST_ASSERT_EQUAL_UINT64(0, engine.stats().framesRejected);
+}
+
+// ============================================================================
+// Batch Ingest Tests
+// ============================================================================
+
+/**
+ * @brief Verifies that parseBatch flags exactly the valid frames of a batch.
+ */
+static void test_parser_parse_batch_mask(void)
+{
+  FrameArena arena(4);
+  uint8_t frame[MAX_PACKET_SIZE];
+  auto packets = PacketSerializer::splitVectorToPackets(std::vector<uint8_t>(300, 0x5A), 9);
+
+  PacketSerializer::serialize(packets[0], frame);
+  arena.push(frame, sizeof(Packet), FrameMeta());
+  frame[HEADER_SIZE] ^= 0x01;  // corrupt payload -> CRC mismatch
+  arena.push(frame, sizeof(Packet), FrameMeta());
+  arena.push(frame, 10, FrameMeta());  // too short
+  PacketSerializer::serialize(packets[1], frame);
+  arena.push(frame, sizeof(Packet), FrameMeta());
+
+  Packet parsed[4];
+  uint64_t mask = 0;
+  TEST_ASSERT_EQUAL_size_t(2, PacketParser::parseBatch(arena, parsed, &mask));
+  TEST_ASSERT_EQUAL_HEX8(0x09, (uint8_t)mask);
+  TEST_ASSERT_EQUAL_UINT8(1, parsed[3].header.chunkIndex);
+}
+
+/**
+ * @brief Verifies that validateBatch agrees with validate() on randomly mutated headers.
+ */
+static void test_validator_batch_matches_scalar(void)
+{
+  ChannelSimulator rng;
+  const size_t frames = 1000;  // several blocks plus a partial one
+  FrameArena arena(frames);
+  std::vector<Packet> reference(frames);
+
+  auto valid = PacketSerializer::splitVectorToPackets(std::vector<uint8_t>(700, 0x11), 3);
+  for (size_t i = 0; i < frames; ++i)
+  {
+    Packet p = valid[i % valid.size()];
+    uint8_t *header = reinterpret_cast<uint8_t *>(&p.header);
+    // Mutate zero, one or two header bytes towards interesting values.
+    for (uint64_t k = rng.nextRandom() % 3; k > 0; --k)
+    {
+      static const uint8_t values[] = {0, 1, 2, 3, 245, 246, 247, 255};
+      header[rng.nextRandom() % HEADER_SIZE] = values[rng.nextRandom() % sizeof(values)];
+    }
+    reference[i] = p;
+
+    uint8_t frame[MAX_PACKET_SIZE];
+    PacketSerializer::serialize(p, frame);
+    arena.push(frame, (i % 97 == 0) ? 100 : sizeof(Packet), FrameMeta());
+  }
+
+  std::vector<uint64_t> mask(batchMaskWords(frames));
+  PacketValidator::validateBatch(arena, mask.data());
+
+  size_t accepted = 0;
+  for (size_t i = 0; i < frames; ++i)
+  {
+    auto err = PacketValidator::validate(reference[i]);
+    bool expected = (i % 97 != 0) && (!err.has_value() || err->type == ValidationError::Type::CRC_MISMATCH);
+    bool actual = (mask[i / 64] >> (i % 64)) & 1;
+    TEST_ASSERT_EQUAL(expected, actual);
+    accepted += actual ? 1 : 0;
+  }
+  // Sanity: the mutation mix produces both outcomes.
+  TEST_ASSERT_TRUE(accepted > 0 && accepted < frames);
+}
+
+#ifdef __linux__
+/**
+ * @brief Verifies the recvmmsg ingest path end to end over loopback.
+ */
+static void test_udp_ingest_loopback_batch(void)
+{
+  UdpFrameIngest ingest;
+  TEST_ASSERT_TRUE(ingest.open(0, "127.0.0.1"));
+
+  UdpFrameSender sender;
+  TEST_ASSERT_TRUE(sender.open("127.0.0.1", ingest.port()));
+
+  std::vector<uint8_t> data(700);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i);
+  FrameArena outgoing(8);
+  for (const auto &p : PacketSerializer::splitVectorToPackets(data, 77))
+  {
+    uint8_t frame[MAX_PACKET_SIZE];
+    PacketSerializer::serialize(p, frame);
+    outgoing.push(frame, sizeof(Packet), FrameMeta());
+  }
+  TEST_ASSERT_EQUAL_INT(3, sender.sendBatch(outgoing));
+
+  std::vector<uint8_t> message;
+  BatchReceiver receiver(16, ReassemblerConfig(), [&](uint32_t sourceId, uint16_t messageId, std::vector<uint8_t> &&m)
+                         {
+    TEST_ASSERT_EQUAL_HEX32(0x7F000001, sourceId);
+    TEST_ASSERT_EQUAL_UINT16(77, messageId);
+    message = std::move(m); });
+
+  FrameArena arena(16);
+  size_t received = 0;
+  while (received < 3)
+  {
+    int n = ingest.receiveBatch(arena, 1234, 1000);
+    TEST_ASSERT_TRUE(n > 0);
+    received += static_cast<size_t>(n);
+    TEST_ASSERT_EQUAL_UINT32(1234, arena.meta(0).timestampMs);
+    receiver.process(arena);
+  }
+
+  TEST_ASSERT_EQUAL_size_t(data.size(), message.size());
+  TEST_ASSERT_EQUAL_MEMORY(data.data(), message.data(), data.size());
+}
+#endif
+
+// ============================================================================
+// Frame Capture Tests
+// ============================================================================
+
+/**
+ * @brief Writes 'count' frames (timestamps 0, 10, 20, ...) into an in-memory capture.
+ */
+static std::vector<uint8_t> make_capture(size_t count, uint32_t indexStride, bool finish)
+{
+  std::vector<uint8_t> bytes;
+  CaptureWriter writer([&bytes](const uint8_t *data, size_t length)
+                       {
+    bytes.insert(bytes.end(), data, data + length);
+    return true; },
+                       indexStride);
+  writer.begin();
+  for (size_t i = 0; i < count; ++i)
+  {
+    Packet p = create_chunk(static_cast<uint16_t>(i + 1), 0, 1, "capture");
+    p.header.flags = PACKET_FLAG_SOM | PACKET_FLAG_EOM;
+    p.calculateCRC();
+    uint8_t frame[MAX_PACKET_SIZE];
+    PacketSerializer::serialize(p, frame);
+
+    FrameMeta meta;
+    meta.timestampMs = static_cast<uint32_t>(i * 10);
+    meta.sourceId = 42;
+    meta.rssi = -97.5f;
+    meta.snr = 6.2f;
+    writer.write(frame, sizeof(Packet), meta);
+  }
+  if (finish)
+    writer.finish();
+  return bytes;
+}
+
+/**
+ * @brief Verifies capture round trip, metadata and indexed seek.
+ */
+static void test_capture_round_trip_and_seek(void)
+{
+  std::vector<uint8_t> bytes = make_capture(100, 16, true);
+
+  CaptureReader reader;
+  TEST_ASSERT_TRUE(reader.openBuffer(bytes.data(), bytes.size()));
+  TEST_ASSERT_TRUE(reader.hasIndex());
+  TEST_ASSERT_EQUAL_UINT64(100, reader.recordCount());
+
+  CaptureRecord record;
+  size_t count = 0;
+  while (reader.next(record))
+  {
+    TEST_ASSERT_EQUAL_UINT32(count * 10, record.meta.timestampMs);
+    TEST_ASSERT_EQUAL_UINT32(42, record.meta.sourceId);
+    TEST_ASSERT_TRUE(record.meta.rssi < -97.4f && record.meta.rssi > -97.6f);
+    auto packet = PacketParser::parse(record.frame, record.meta.length);
+    TEST_ASSERT_TRUE(packet.has_value());
+    TEST_ASSERT_EQUAL_UINT16(count + 1, packet->header.messageId);
+    count++;
+  }
+  TEST_ASSERT_EQUAL_size_t(100, count);
+
+  reader.seek(555);
+  TEST_ASSERT_TRUE(reader.next(record));
+  TEST_ASSERT_EQUAL_UINT32(560, record.meta.timestampMs);
+}
+
+/**
+ * @brief Verifies that a capture cut short (no footer, truncated record) is still readable.
+ */
+static void test_capture_truncated_is_readable(void)
+{
+  std::vector<uint8_t> bytes = make_capture(10, 4, false);
+  bytes.resize(bytes.size() - 20);  // power loss in the middle of the last record
+
+  CaptureReader reader;
+  TEST_ASSERT_TRUE(reader.openBuffer(bytes.data(), bytes.size()));
+  TEST_ASSERT_FALSE(reader.hasIndex());
+  TEST_ASSERT_EQUAL_UINT64(9, reader.recordCount());
+
+  reader.seek(50);
+  CaptureRecord record;
+  TEST_ASSERT_TRUE(reader.next(record));
+  TEST_ASSERT_EQUAL_UINT32(50, record.meta.timestampMs);
+}
+
+// ============================================================================
+// PacketLog Tests
+// ============================================================================
+
+/**
+ * @brief Verifies that records keep header, CRC and a truncated payload, and format later.
+ */
+static void test_packet_log_records_and_formats(void)
+{
+  PacketLog log(8);
+  Packet p = create_chunk(0x1234, 2, 5, "0123456789ABCDEFGHIJ");
+  p.header.flags = PACKET_FLAG_ACK_REQ;
+  p.calculateCRC();
+
+  TEST_ASSERT_TRUE(log.record(p, 777, PacketLogEvent::Rx));
+
+  uint8_t frame[MAX_PACKET_SIZE];
+  PacketSerializer::serialize(p, frame);
+  frame[HEADER_SIZE] ^= 0xFF;
+  TEST_ASSERT_TRUE(log.record(frame, sizeof(Packet), 778, PacketLogEvent::RxRejected));
+
+  std::vector<PacketLogRecord> records;
+  TEST_ASSERT_EQUAL_size_t(2, log.drain([&records](const PacketLogRecord &r)
+                                        { records.push_back(r); }));
+  TEST_ASSERT_EQUAL_size_t(2, records.size());
+
+  const PacketLogRecord &rx = records[0];
+  TEST_ASSERT_EQUAL_UINT32(777, rx.timestampMs);
+  TEST_ASSERT_EQUAL_UINT16(0x1234, rx.header.messageId);
+  TEST_ASSERT_EQUAL_UINT16(p.crc, rx.crc);
+  TEST_ASSERT_EQUAL_UINT8(PACKET_LOG_PAYLOAD_BYTES, rx.payloadBytes);
+  TEST_ASSERT_EQUAL_MEMORY("0123456789ABCDEF", rx.payload, PACKET_LOG_PAYLOAD_BYTES);
+
+  const PacketLogRecord &rej = records[1];
+  TEST_ASSERT_TRUE(rej.event == PacketLogEvent::RxRejected);
+  TEST_ASSERT_EQUAL_UINT16(p.crc, rej.crc);
+  TEST_ASSERT_EQUAL_UINT8('0' ^ 0xFF, rej.payload[0]);
+
+  char line[160];
+  PacketLog::format(rx, line, sizeof(line));
+  TEST_ASSERT_NOT_NULL(std::strstr(line, "RX"));
+  TEST_ASSERT_NOT_NULL(std::strstr(line, "id=4660 chunk=3/5 len=20 flags=0x04"));
+  TEST_ASSERT_NOT_NULL(std::strstr(line, "| 30 31 32 33"));
+  TEST_ASSERT_NOT_NULL(std::strstr(line, "46 ..."));
+
+  // Truncation never overruns the buffer.
+  char small[24];
+  size_t n = PacketLog::format(rx, small, sizeof(small));
+  TEST_ASSERT_TRUE(n < sizeof(small));
+  TEST_ASSERT_EQUAL_size_t(n, std::strlen(small));
+}
+
+/**
+ * @brief Verifies that a full ring drops and counts records instead of blocking.
+ */
+static void test_packet_log_drops_when_full(void)
+{
+  PacketLog log(4);
+  Packet p = create_chunk(1, 0, 1, "x");
+  for (int i = 0; i < 6; i++)
+  {
+    log.record(p, static_cast<uint32_t>(i), PacketLogEvent::Tx);
+  }
+  TEST_ASSERT_EQUAL_UINT32(2, log.dropped());
+
+  uint32_t first = 0;
+  size_t drained = log.drain([&first](const PacketLogRecord &r)
+                             { first = first == 0 ? r.timestampMs + 1 : first; },
+                             1);
+  TEST_ASSERT_EQUAL_size_t(1, drained);
+  TEST_ASSERT_EQUAL_UINT32(1, first);  // timestamp 0: oldest record kept
+  TEST_ASSERT_EQUAL_size_t(3, log.drain(nullptr));
+  TEST_ASSERT_TRUE(log.record(p, 9, PacketLogEvent::Tx));
+
+  // Records 0-3 were numbered 0-3; the next one skips the 2 dropped.
+  uint8_t sequence = 0;
+  log.drain([&sequence](const PacketLogRecord &r) { sequence = r.sequence; });
+  TEST_ASSERT_EQUAL_UINT8(6, sequence);
+}
+
+/**
+ * @brief Verifies that records of concurrent producers drain with consecutive sequence numbers.
+ */
+static void test_packet_log_sequence_with_concurrent_producers(void)
+{
+  const size_t perProducer = 2000;
+  PacketLog log(2 * perProducer);
+  Packet p = create_chunk(1, 0, 1, "x");
+
+  auto produce = [&](PacketLogEvent event) {
+    for (size_t i = 0; i < perProducer; i++)
+      log.record(p, static_cast<uint32_t>(i), event);
+  };
+  std::thread tx(produce, PacketLogEvent::Tx);
+  std::thread rx(produce, PacketLogEvent::Rx);
+  tx.join();
+  rx.join();
+
+  size_t count = 0;
+  size_t outOfSequence = 0;
+  log.drain([&](const PacketLogRecord &r) {
+    if (r.sequence != static_cast<uint8_t>(count))
+      outOfSequence++;
+    count++;
+  });
+  TEST_ASSERT_EQUAL_size_t(2 * perProducer, count);
+  TEST_ASSERT_EQUAL_size_t(0, outOfSequence);
+}
+
+// ============================================================================
+// Protocol Profile Tests
+// ============================================================================
+
+using SmallProfile = E220Profile<64>;
+using LargeProfile = WideFrameProfile<1024>;
+
+static_assert(sizeof(BasicPacket<SmallProfile>) == 64, "E220 packet must fill its sub-packet");
+static_assert(SmallProfile::MAX_PAYLOAD_SIZE == 64 - HEADER_SIZE - CRC_SIZE, "Unexpected E220 payload size");
+static_assert(sizeof(BasicPacket<LargeProfile>) == 1024, "Wide packet must fill its frame");
+static_assert(LargeProfile::MAX_PAYLOAD_SIZE == 1024 - sizeof(WidePacketHeader) - sizeof(uint32_t), "Unexpected wide payload size");
+
+/**
+ * @brief Splits, serializes, parses and reassembles 'message' with the given profile.
+ */
+template <typename Profile>
+static std::optional<std::vector<uint8_t>> round_trip(const std::vector<uint8_t> &message, size_t expectedChunks)
+{
+  auto packets = BasicPacketSerializer<Profile>::splitVectorToPackets(message, 7);
+  TEST_ASSERT_EQUAL_size_t(expectedChunks, packets.size());
+
+  BasicPacketReassembler<Profile> reassembler;
+  std::optional<std::vector<uint8_t>> result;
+  // Reverse order to exercise out-of-order insertion.
+  for (size_t i = packets.size(); i-- > 0;)
+  {
+    uint8_t frame[Profile::FRAME_SIZE];
+    BasicPacketSerializer<Profile>::serialize(packets[i], frame);
+    auto parsed = BasicPacketParser<Profile>::parse(frame, sizeof(frame));
+    TEST_ASSERT_TRUE(parsed.has_value());
+    result = reassembler.processPacket(*parsed, 0);
+  }
+  return result;
+}
+
+/**
+ * @brief Verifies a message round trip with small E220 sub-packet frames.
+ */
+static void test_profile_small_frames_round_trip(void)
+{
+  std::vector<uint8_t> message(300);
+  for (size_t i = 0; i < message.size(); i++)
+    message[i] = static_cast<uint8_t>(i * 13);
+
+  auto result = round_trip<SmallProfile>(message, (300 + SmallProfile::MAX_PAYLOAD_SIZE - 1) / SmallProfile::MAX_PAYLOAD_SIZE);
+  TEST_ASSERT_TRUE(result.has_value());
+  TEST_ASSERT_EQUAL_MEMORY(message.data(), result->data(), message.size());
+}
+
+/**
+ * @brief Verifies wide headers (payload > 255 bytes) and the CRC-32 profile.
+ */
+static void test_profile_wide_frames_crc32(void)
+{
+  const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  TEST_ASSERT_EQUAL_HEX32(0xCBF43926, Crc32::compute(check, sizeof(check)));
+
+  std::vector<uint8_t> message(3000);
+  for (size_t i = 0; i < message.size(); i++)
+    message[i] = static_cast<uint8_t>(i ^ (i >> 8));
+
+  auto result = round_trip<LargeProfile>(message, 3);
+  TEST_ASSERT_TRUE(result.has_value());
+  TEST_ASSERT_EQUAL_size_t(message.size(), result->size());
+  TEST_ASSERT_EQUAL_MEMORY(message.data(), result->data(), message.size());
+
+  auto packets = BasicPacketSerializer<LargeProfile>::splitVectorToPackets(message, 7);
+  TEST_ASSERT_EQUAL_UINT16(LargeProfile::MAX_PAYLOAD_SIZE, packets[0].header.payloadSize);
+  std::vector<uint8_t> frame(LargeProfile::FRAME_SIZE);
+  BasicPacketSerializer<LargeProfile>::serialize(packets[1], frame.data());
+  frame[LargeProfile::HEADER_SIZE + 500] ^= 0x01;
+  TEST_ASSERT_FALSE(BasicPacketParser<LargeProfile>::parse(frame.data(), frame.size()).has_value());
+}
+
+// ============================================================================
+// Typed Serialization Tests
+// ============================================================================
+
+struct TelemetryFrame
+{
+  uint32_t sequence;
+  float samples[120];
+  uint16_t status;
+};
+
+/**
+ * @brief Verifies split<T>() geometry and the typed receive path.
+ */
+static void test_typed_split_and_reassemble(void)
+{
+  TelemetryFrame sent{};
+  sent.sequence = 0xA5A5F00D;
+  for (size_t i = 0; i < 120; i++)
+    sent.samples[i] = static_cast<float>(i) * 0.5f;
+  sent.status = 0x0102;
+
+  auto packets = PacketSerializer::split(sent, 9);
+  static_assert(std::tuple_size<decltype(packets)>::value == (sizeof(TelemetryFrame) + LORA_MAX_PAYLOAD_SIZE - 1) / LORA_MAX_PAYLOAD_SIZE,
+                "Chunk count is fixed at compile time");
+
+  // Same packets as the runtime splitter.
+  auto reference = PacketSerializer::splitBufferToPackets(reinterpret_cast<const uint8_t *>(&sent), sizeof(sent), 9);
+  TEST_ASSERT_EQUAL_size_t(reference.size(), packets.size());
+  for (size_t i = 0; i < packets.size(); i++)
+    TEST_ASSERT_EQUAL_MEMORY(&reference[i], &packets[i], sizeof(Packet));
+
+  TypedReassembler<TelemetryFrame> receiver;
+  std::optional<TelemetryFrame> received;
+  for (size_t i = packets.size(); i-- > 0;)
+  {
+    TEST_ASSERT_FALSE(received.has_value());
+    received = receiver.processPacket(packets[i], 0);
+  }
+  TEST_ASSERT_TRUE(received.has_value());
+  TEST_ASSERT_EQUAL_MEMORY(&sent, &*received, sizeof(sent));
+  TEST_ASSERT_EQUAL_size_t(0, receiver.pendingSessions());
+}
+
+/**
+ * @brief Verifies that chunks of a message with a different size are rejected.
+ */
+static void test_typed_reassembler_rejects_other_types(void)
+{
+  struct Small
+  {
+    uint8_t bytes[10];
+  };
+  Small other{};
+  auto packets = PacketSerializer::split(other, 9);
+
+  TypedReassembler<TelemetryFrame> receiver;
+  TEST_ASSERT_FALSE(receiver.processPacket(packets[0], 0).has_value());
+  TEST_ASSERT_EQUAL_size_t(0, receiver.pendingSessions());
+
+  TypedReassembler<Small> smallReceiver;
+  auto result = smallReceiver.processPacket(packets[0], 0);
+  TEST_ASSERT_TRUE(result.has_value());
+}
+
+// ============================================================================
+// Transmit Path Tests
+// ============================================================================
+
+/**
+ * @brief Radio double that records started frames; completion is signalled by the test.
+ */
+class FakeRadio : public RadioTransmitter
+{
+ public:
+  std::vector<std::vector<uint8_t>> frames;
+  bool accept = true;
+  bool onAir = false;
+  LoRaModulation modulation;
+
+  bool startTransmit(const uint8_t *frame, size_t length) override
+  {
+    if (!accept || onAir)
+      return false;
+    frames.emplace_back(frame, frame + length);
+    onAir = true;
+    return true;
+  }
+
+  void finishTransmit() override { onAir = false; }
+
+  bool setModulation(const LoRaModulation &settings) override
+  {
+    modulation = settings;
+    return true;
+  }
+};
+
+/**
+ * @brief Verifies that the next frame is staged while one is on air and chained on TX done.
+ */
+static void test_tx_engine_double_buffered_chaining(void)
+{
+  FakeRadio radio;
+  TxEngine engine(radio);
+
+  std::vector<uint8_t> first(2 * LORA_MAX_PAYLOAD_SIZE + 3);
+  for (size_t i = 0; i < first.size(); i++)
+    first[i] = static_cast<uint8_t>(i);
+  TEST_ASSERT_TRUE(engine.enqueue(first.data(), first.size(), 11));
+  TEST_ASSERT_TRUE(engine.enqueue(std::vector<uint8_t>{'h', 'i'}, 12));
+
+  engine.poll(0);
+  TEST_ASSERT_EQUAL_size_t(1, radio.frames.size());
+  TEST_ASSERT_TRUE(engine.transmitting());
+
+  // No TX done yet: nothing new is started.
+  engine.poll(0);
+  TEST_ASSERT_EQUAL_size_t(1, radio.frames.size());
+
+  while (!engine.idle())
+  {
+    engine.onTransmitDone();
+    engine.poll(0);
+  }
+  TEST_ASSERT_EQUAL_size_t(4, radio.frames.size());
+  TEST_ASSERT_EQUAL_size_t(4, engine.stats().framesSent);
+  TEST_ASSERT_EQUAL_size_t(2, engine.stats().messagesSent);
+
+  PacketReassembler reassembler;
+  std::vector<std::vector<uint8_t>> messages;
+  for (const auto &frame : radio.frames)
+  {
+    TEST_ASSERT_EQUAL_size_t(MAX_TX_PACKET_SIZE, frame.size());
+    auto packet = PacketParser::parse(frame.data(), frame.size());
+    TEST_ASSERT_TRUE(packet.has_value());
+    if (auto message = reassembler.processPacket(*packet, 0))
+      messages.push_back(*message);
+  }
+  // Same priority class: chunks are interleaved, so the short message completes first.
+  TEST_ASSERT_EQUAL_size_t(2, messages.size());
+  TEST_ASSERT_EQUAL_MEMORY("hi", messages[0].data(), 2);
+  TEST_ASSERT_EQUAL_size_t(first.size(), messages[1].size());
+  TEST_ASSERT_EQUAL_MEMORY(first.data(), messages[1].data(), first.size());
+}
+
+/**
+ * @brief Verifies backpressure on a full queue and retry after a radio error.
+ */
+static void test_tx_engine_backpressure_and_retry(void)
+{
+  FakeRadio radio;
+  TxEngineConfig config;
+  config.queueCapacity = 2;
+  TxEngine engine(radio, config);
+
+  uint8_t byte = 0x42;
+  TEST_ASSERT_TRUE(engine.enqueue(&byte, 1, 1));
+  TEST_ASSERT_TRUE(engine.enqueue(&byte, 1, 2));
+  TEST_ASSERT_FALSE(engine.enqueue(&byte, 1, 3));
+  TEST_ASSERT_FALSE(engine.enqueue(std::vector<uint8_t>{}, 4));
+  TEST_ASSERT_EQUAL_size_t(1, engine.stats().messagesRefused);
+
+  radio.accept = false;
+  engine.poll(0);
+  TEST_ASSERT_FALSE(engine.transmitting());
+  TEST_ASSERT_EQUAL_size_t(1, engine.stats().radioErrors);
+
+  // The staged frame is retried; the queue has room again once it is dequeued.
+  radio.accept = true;
+  engine.poll(0);
+  TEST_ASSERT_TRUE(engine.transmitting());
+  TEST_ASSERT_TRUE(engine.enqueue(&byte, 1, 3));
+
+  while (!engine.idle())
+  {
+    engine.onTransmitDone();
+    engine.poll(0);
+  }
+  TEST_ASSERT_EQUAL_size_t(3, radio.frames.size());
+  TEST_ASSERT_EQUAL_size_t(3, engine.stats().messagesSent);
+
+  // A frame the radio keeps refusing is dropped after maxTransmitAttempts; the next one goes out.
+  TxEngineConfig dropConfig;
+  dropConfig.maxTransmitAttempts = 3;
+  FakeRadio refusing;
+  TxEngine dropping(refusing, dropConfig);
+  TEST_ASSERT_TRUE(dropping.enqueue(&byte, 1, 5));
+  TEST_ASSERT_TRUE(dropping.enqueue(&byte, 1, 6));
+  refusing.accept = false;
+  for (int i = 0; i < 3; i++)
+    dropping.poll(0);
+  TEST_ASSERT_EQUAL_UINT64(1, dropping.stats().framesDropped);
+  refusing.accept = true;
+  while (!dropping.idle())
+  {
+    dropping.poll(0);
+    dropping.onTransmitDone();
+  }
+  TEST_ASSERT_EQUAL_size_t(1, refusing.frames.size());
+  auto sent = PacketParser::parse(refusing.frames[0].data(), refusing.frames[0].size());
+  TEST_ASSERT_TRUE(sent.has_value());
+  TEST_ASSERT_EQUAL_UINT16(6, sent->header.messageId);
+  TEST_ASSERT_EQUAL_UINT64(1, dropping.stats().messagesSent);
+  TEST_ASSERT_EQUAL_UINT64(3, dropping.stats().radioErrors);
+}
+
+/**
+ * @brief Returns the message ID carried by a raw frame.
+ */
+static uint16_t frame_message_id(const std::vector<uint8_t> &frame)
+{
+  auto packet = PacketParser::parse(frame.data(), frame.size());
+  return packet.has_value() ? packet->header.messageId : 0;
+}
+
+/**
+ * @brief Verifies priority classes, round-robin interleaving and deadline handling.
+ */
+static void test_tx_scheduler_priorities_and_deadlines(void)
+{
+  TxScheduler scheduler;
+  std::vector<uint8_t> bulk(3 * LORA_MAX_PAYLOAD_SIZE, 0xB0);
+  std::vector<uint8_t> small(2 * LORA_MAX_PAYLOAD_SIZE, 0x5A);
+
+  TxOptions bulkOptions;
+  bulkOptions.priority = TxPriority::Bulk;
+  TEST_ASSERT_TRUE(scheduler.add(std::vector<uint8_t>(bulk), 1, bulkOptions));
+  TEST_ASSERT_TRUE(scheduler.add(std::vector<uint8_t>(bulk), 2, bulkOptions));
+
+  // Same class: chunks of the two transfers alternate.
+  std::vector<uint16_t> order;
+  for (int i = 0; i < 2; i++)
+  {
+    auto chunk = scheduler.next(0);
+    order.push_back(chunk->packet.header.messageId);
+    scheduler.commit(*chunk);
+  }
+
+  // A critical message overtakes both at the next frame.
+  TxOptions critical;
+  critical.priority = TxPriority::Critical;
+  TEST_ASSERT_TRUE(scheduler.add(std::vector<uint8_t>(small), 3, critical));
+  auto staged = scheduler.next(0);
+  TEST_ASSERT_EQUAL_UINT16(3, staged->packet.header.messageId);
+
+  // Preempting a staged chunk returns it to its message.
+  TEST_ASSERT_FALSE(scheduler.shouldPreempt(*staged, 0));
+  scheduler.requeue(*staged);
+  while (auto chunk = scheduler.next(0))
+  {
+    order.push_back(chunk->packet.header.messageId);
+    scheduler.commit(*chunk);
+  }
+  const uint16_t expected[] = {1, 2, 3, 3, 1, 2, 1, 2};
+  TEST_ASSERT_EQUAL_size_t(8, order.size());
+  for (size_t i = 0; i < order.size(); i++)
+    TEST_ASSERT_EQUAL_UINT16(expected[i], order[i]);
+  TEST_ASSERT_TRUE(scheduler.empty());
+
+  // Earliest deadline first; expired messages are dropped unsent.
+  TxOptions late, soon;
+  late.deadlineMs = 500;
+  soon.deadlineMs = 100;
+  scheduler.add(std::vector<uint8_t>(small), 10, late);
+  scheduler.add(std::vector<uint8_t>(small), 11, soon);
+  scheduler.add(std::vector<uint8_t>(small), 12, TxOptions());
+  auto first = scheduler.next(50);
+  TEST_ASSERT_EQUAL_UINT16(11, first->packet.header.messageId);
+  TEST_ASSERT_TRUE(scheduler.shouldPreempt(*first, 150));
+  scheduler.requeue(*first);
+  auto afterExpiry = scheduler.next(150);
+  TEST_ASSERT_EQUAL_UINT16(10, afterExpiry->packet.header.messageId);
+  TEST_ASSERT_EQUAL_size_t(1, scheduler.expiredMessages());
+}
+
+/**
+ * @brief Verifies that a staged bulk frame gives way to a critical message in the engine.
+ */
+static void test_tx_engine_preempts_staged_frame(void)
+{
+  FakeRadio radio;
+  TxEngine engine(radio);
+
+  TxOptions bulk;
+  bulk.priority = TxPriority::Bulk;
+  TEST_ASSERT_TRUE(engine.enqueue(std::vector<uint8_t>(4 * LORA_MAX_PAYLOAD_SIZE, 0xB0), 20, bulk));
+  engine.poll(0);  // bulk #0 on air, bulk #1 staged
+
+  TxOptions critical;
+  critical.priority = TxPriority::Critical;
+  critical.deadlineMs = 1000;
+  TEST_ASSERT_TRUE(engine.enqueue(std::vector<uint8_t>{'!', '!'}, 21, critical));
+
+  TxOptions stale;
+  stale.deadlineMs = 5;
+  TEST_ASSERT_TRUE(engine.enqueue(std::vector<uint8_t>{'x'}, 22, stale));
+
+  uint32_t now = 10;
+  while (!engine.idle())
+  {
+    engine.onTransmitDone();
+    engine.poll(now++);
+  }
+
+  TEST_ASSERT_EQUAL_size_t(5, radio.frames.size());
+  TEST_ASSERT_EQUAL_UINT16(20, frame_message_id(radio.frames[0]));
+  TEST_ASSERT_EQUAL_UINT16(21, frame_message_id(radio.frames[1]));
+  for (size_t i = 2; i < radio.frames.size(); i++)
+    TEST_ASSERT_EQUAL_UINT16(20, frame_message_id(radio.frames[i]));
+  TEST_ASSERT_EQUAL_size_t(2, engine.stats().messagesSent);
+  TEST_ASSERT_EQUAL_size_t(1, engine.stats().messagesExpired);
+}
+
+/**
+ * @brief Verifies time on air against reference values of the SX126x formula.
+ */
+static void test_lora_airtime_reference_values(void)
+{
+  LoRaModulation m;
+  m.codingRate = 5;
+  m.spreadingFactor = 7;
+  TEST_ASSERT_EQUAL_UINT32(399616, LoRaAirtime::timeOnAirUs(m, 255));  // 390.25 symbols of 1.024 ms
+  TEST_ASSERT_FALSE(LoRaAirtime::lowDataRateOptimize(m));
+
+  m.spreadingFactor = 12;  // 32.768 ms symbols: LDRO on
+  TEST_ASSERT_TRUE(LoRaAirtime::lowDataRateOptimize(m));
+  TEST_ASSERT_EQUAL_UINT32(2465792, LoRaAirtime::timeOnAirUs(m, 51));
+
+  m.spreadingFactor = 5;  // 6.25-symbol preamble overhead
+  TEST_ASSERT_EQUAL_UINT32(137536, LoRaAirtime::timeOnAirUs(m, 255));
+
+  // Longer frames, slower settings: never shorter.
+  LoRaModulation d;
+  TEST_ASSERT_TRUE(LoRaAirtime::timeOnAirUs(d, 255) > LoRaAirtime::timeOnAirUs(d, 200));
+  d.bandwidthHz = 250000;
+  TEST_ASSERT_TRUE(LoRaAirtime::timeOnAirUs(d, 255) < LoRaAirtime::timeOnAirUs(LoRaModulation(), 255));
+}
+
+/**
+ * @brief Verifies token bucket refill, wait time and cap with a fake clock.
+ */
+static void test_airtime_budget_token_bucket(void)
+{
+  AirtimeBudgetConfig config;  // 1%
+  config.burstUs = 500000;
+  config.initialUs = 500000;
+  AirtimeBudget budget(config);
+
+  uint32_t now = 0xFFFFF000;  // Refill must survive the millis() wrap.
+  TEST_ASSERT_TRUE(budget.tryConsume(399616, now));
+  TEST_ASSERT_EQUAL_UINT32(100384, static_cast<uint32_t>(budget.availableUs(now)));
+  TEST_ASSERT_FALSE(budget.tryConsume(399616, now));
+
+  // 1% duty cycle: the missing 299232 us take 29924 ms to earn.
+  uint32_t wait = budget.waitTimeMs(399616, now);
+  TEST_ASSERT_EQUAL_UINT32(29924, wait);
+  TEST_ASSERT_FALSE(budget.tryConsume(399616, now + wait - 1));
+  TEST_ASSERT_TRUE(budget.tryConsume(399616, now + wait));
+  TEST_ASSERT_EQUAL_UINT32(2 * 399616, static_cast<uint32_t>(budget.consumedUs()));
+
+  // Credit is capped at the burst size; frames above it never fit.
+  TEST_ASSERT_EQUAL_UINT32(500000, static_cast<uint32_t>(budget.availableUs(now + 3600000)));
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, budget.waitTimeMs(500001, now));
+}
+
+/**
+ * @brief Verifies that the engine defers frames to respect the duty cycle and keeps the critical reserve.
+ */
+static void test_tx_engine_duty_cycle_pacing(void)
+{
+  const uint64_t frameUs = LoRaAirtime::timeOnAirUs(LoRaModulation(), MAX_TX_PACKET_SIZE);
+
+  FakeRadio radio;
+  TxEngineConfig config;
+  config.airtimeBudget = AirtimeBudgetConfig();
+  config.airtimeBudget->burstUs = 2 * frameUs;
+  config.airtimeBudget->initialUs = 2 * frameUs;
+  config.criticalReserveUs = frameUs;
+  TxEngine engine(radio, config);
+
+  TxOptions bulk;
+  bulk.priority = TxPriority::Bulk;
+  engine.enqueue(std::vector<uint8_t>(3 * LORA_MAX_PAYLOAD_SIZE, 0xB0), 30, bulk);
+
+  engine.poll(0);
+  TEST_ASSERT_EQUAL_size_t(1, radio.frames.size());
+  TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(frameUs), static_cast<uint32_t>(engine.remainingAirtimeUs(0)));
+
+  // Only the critical reserve is left: the next bulk frame waits.
+  engine.onTransmitDone();
+  engine.poll(1);
+  TEST_ASSERT_EQUAL_size_t(1, radio.frames.size());
+  TEST_ASSERT_EQUAL_size_t(1, engine.stats().framesDeferred);
+  uint32_t delay = engine.nextTransmitDelayMs(1);
+  TEST_ASSERT_TRUE(delay > 0);
+
+  // A critical message may use the reserve and overtakes the waiting frame.
+  TxOptions critical;
+  critical.priority = TxPriority::Critical;
+  engine.enqueue(std::vector<uint8_t>{'!'}, 31, critical);
+  engine.poll(2);
+  TEST_ASSERT_EQUAL_size_t(2, radio.frames.size());
+  TEST_ASSERT_EQUAL_UINT16(31, frame_message_id(radio.frames[1]));
+
+  // From then on bulk frames go out exactly when the budget allows.
+  uint32_t now = 2;
+  while (!engine.idle())
+  {
+    engine.onTransmitDone();
+    engine.poll(now);
+    size_t sent = radio.frames.size();
+    uint32_t wait = engine.nextTransmitDelayMs(now);
+    if (wait > 0)
+    {
+      engine.poll(now + wait - 1);
+      TEST_ASSERT_EQUAL_size_t(sent, radio.frames.size());
+      now += wait;
+    }
+  }
+  TEST_ASSERT_EQUAL_size_t(4, radio.frames.size());
+  TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(4 * frameUs), static_cast<uint32_t>(engine.stats().airtimeUs));
+  // Long-run rate: never above 1% of elapsed time plus the initial burst.
+  TEST_ASSERT_TRUE(engine.stats().airtimeUs <= 2 * frameUs + static_cast<uint64_t>(now) * 10);
+}
+
+/**
+ * @brief Builds the packet of a TdmaBeacon carrying 'networkTimeMs'.
+ */
+static Packet tdma_beacon_packet(uint32_t networkTimeMs)
+{
+  std::vector<uint8_t> payload(TdmaBeacon::SIZE);
+  TdmaBeacon::encode(networkTimeMs, payload.data());
+  Packet packet = PacketSerializer::splitVectorToPackets(payload, LinkAnnouncement::MESSAGE_ID)[0];
+  packet.header.flags |= PACKET_FLAG_CONTROL;
+  packet.calculateCRC();
+  return packet;
+}
+
+/**
+ * @brief Verifies slot arithmetic, guard time, synchronization and holdover of a TdmaSchedule.
+ */
+static void test_tdma_schedule_slots_and_sync(void)
+{
+  TdmaConfig config;
+  config.slotCount = 4;
+  config.slotMask = 1u << 2;
+  config.slotMs = 100;
+  config.guardMs = 10;
+  config.holdoverMs = 1000;
+  TdmaSchedule schedule(config);
+
+  // A follower stays silent until it has a time reference.
+  TEST_ASSERT_FALSE(schedule.synchronized(0));
+  TEST_ASSERT_EQUAL_UINT32(100, schedule.waitTimeMs(5000, 0));
+
+  // Local 50 is network 1000: start of slot 2 of a superframe.
+  schedule.synchronize(50, 1000);
+  TEST_ASSERT_EQUAL_UINT8(2, schedule.slotAt(50));
+  TEST_ASSERT_EQUAL_UINT32(0, schedule.waitTimeMs(5000, 50));
+  TEST_ASSERT_EQUAL_UINT32(0, schedule.waitTimeMs(5000, 135));     // Ends at 90 + 5 + guard 10 = slot end.
+  TEST_ASSERT_EQUAL_UINT32(313, schedule.waitTimeMs(5000, 137));   // Would end in the guard: next superframe.
+  TEST_ASSERT_EQUAL_UINT32(150, schedule.waitTimeMs(5000, 300));   // Slot 0, position 50.
+  // Longer than a slot (guard included): never starts, it would run into the next slot.
+  TEST_ASSERT_TRUE(schedule.fitsSlot(90000));
+  TEST_ASSERT_FALSE(schedule.fitsSlot(90001));
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, schedule.waitTimeMs(150000, 55));
+
+  // Holdover expired: silent again until the next reference.
+  TEST_ASSERT_TRUE(schedule.synchronized(1050));
+  TEST_ASSERT_FALSE(schedule.synchronized(1051));
+  TEST_ASSERT_EQUAL_UINT32(100, schedule.waitTimeMs(5000, 1051));
+
+  // Beacons: stamped at the start of the frame, the follower adds the frame's time on air.
+  const size_t length = PacketSerializer::compactSize(tdma_beacon_packet(0));
+  uint32_t airtimeMs = (LoRaAirtime::timeOnAirUs(LoRaModulation(), length) + 999) / 1000;
+  TEST_ASSERT_TRUE(schedule.onBeacon(tdma_beacon_packet(70000), 5000, length));
+  TEST_ASSERT_EQUAL_UINT32(70000 + airtimeMs, schedule.networkTimeMs(5000));
+  TEST_ASSERT_EQUAL_UINT64(2, schedule.synchronizations());
+  Packet announcement = tdma_beacon_packet(0);
+  announcement.payload.data[0] = LinkAnnouncement::TYPE;
+  TEST_ASSERT_FALSE(schedule.onBeacon(announcement, 5000, length));
+  Packet data = tdma_beacon_packet(0);
+  data.header.flags &= ~PACKET_FLAG_CONTROL;
+  TEST_ASSERT_FALSE(TdmaBeacon::decode(data).has_value());
+
+  // The time master is its own reference and paces its beacons.
+  config.beaconIntervalMs = 500;
+  TdmaSchedule master(config);
+  TEST_ASSERT_TRUE(master.synchronized(0));
+  TEST_ASSERT_TRUE(master.beaconDue(0));
+  master.beaconQueued(0);
+  TEST_ASSERT_FALSE(master.beaconDue(499));
+  TEST_ASSERT_TRUE(master.beaconDue(500));
+  TEST_ASSERT_TRUE(master.onBeacon(tdma_beacon_packet(123), 10, length));
+  TEST_ASSERT_EQUAL_UINT32(10, master.networkTimeMs(10));
+}
+
+/**
+ * @brief Verifies that a beacon master and a follower with an unrelated clock share the channel without overlap.
+ */
+static void test_tx_engine_tdma_slots_and_beacons(void)
+{
+  const uint32_t followerClockOffset = 123457;  // Follower's local time = network time + offset.
+  auto frameMs = [](size_t length) { return (LoRaAirtime::timeOnAirUs(LoRaModulation(), length) + 999) / 1000; };
+
+  TdmaConfig plan;
+  plan.slotCount = 2;
+  plan.framesPerSlot = 2;
+  TxEngineConfig masterConfig;
+  masterConfig.tdma = plan;
+  masterConfig.tdma->slotMask = 1u << 0;
+  masterConfig.tdma->beaconIntervalMs = 60000;
+  TxEngineConfig followerConfig;
+  followerConfig.tdma = plan;
+  followerConfig.tdma->slotMask = 1u << 1;
+
+  FakeRadio masterRadio, followerRadio;
+  TxEngine master(masterRadio, masterConfig), follower(followerRadio, followerConfig);
+  const uint32_t slotMs = master.tdma()->slotMs();
+  TEST_ASSERT_EQUAL_UINT32(2 * frameMs(MAX_TX_PACKET_SIZE) + plan.guardMs, slotMs);
+
+  master.enqueue(std::vector<uint8_t>(5 * LORA_MAX_PAYLOAD_SIZE, 0x11), 1);
+  follower.enqueue(std::vector<uint8_t>(5 * LORA_MAX_PAYLOAD_SIZE, 0x22), 2);
+
+  // (network start, network end) of every frame of each node.
+  std::vector<std::pair<uint32_t, uint32_t>> masterFrames, followerFrames;
+  uint32_t firstSyncMs = 0;
+  for (uint32_t now = 0; now < 20 * slotMs && (master.stats().messagesSent == 0 || !follower.idle()); now++)
+  {
+    if (masterRadio.onAir && now == masterFrames.back().second)
+    {
+      master.onTransmitDone();
+      const auto &frame = masterRadio.frames.back();
+      auto packet = PacketParser::parse(frame.data(), frame.size());
+      TEST_ASSERT_TRUE(packet.has_value());
+      if (follower.tdma()->onBeacon(*packet, now + followerClockOffset, frame.size()) && firstSyncMs == 0)
+        firstSyncMs = now;
+    }
+    if (followerRadio.onAir && now == followerFrames.back().second)
+      follower.onTransmitDone();
+
+    size_t sent = masterRadio.frames.size();
+    master.poll(now);
+    if (masterRadio.frames.size() > sent)
+      masterFrames.emplace_back(now, now + frameMs(masterRadio.frames.back().size()));
+    sent = followerRadio.frames.size();
+    follower.poll(now + followerClockOffset);
+    if (followerRadio.frames.size() > sent)
+      followerFrames.emplace_back(now, now + frameMs(followerRadio.frames.back().size()));
+  }
+
+  // The first frame of the master is its beacon, stamped with the network time it started at.
+  TEST_ASSERT_EQUAL_size_t(6, masterRadio.frames.size());
+  auto beacon = PacketParser::parse(masterRadio.frames[0].data(), masterRadio.frames[0].size());
+  TEST_ASSERT_EQUAL_UINT32(0, TdmaBeacon::decode(*beacon).value());
+  TEST_ASSERT_EQUAL_UINT64(1, master.stats().beaconsSent);
+  TEST_ASSERT_EQUAL_UINT64(1, master.stats().messagesSent);
+  TEST_ASSERT_EQUAL_size_t(5, followerRadio.frames.size());
+  TEST_ASSERT_TRUE(follower.stats().slotWaits > 0);
+
+  // Every frame inside its owner's slot, ending before the guard; the follower only after its first beacon.
+  for (const auto &frame : masterFrames)
+  {
+    TEST_ASSERT_EQUAL_UINT32(0, (frame.first / slotMs) % 2);
+    TEST_ASSERT_TRUE(frame.second - frame.first / slotMs * slotMs + plan.guardMs <= slotMs);
+  }
+  for (const auto &frame : followerFrames)
+  {
+    TEST_ASSERT_TRUE(frame.first >= firstSyncMs);
+    TEST_ASSERT_EQUAL_UINT32(1, (frame.first / slotMs) % 2);
+    TEST_ASSERT_TRUE(frame.second - frame.first / slotMs * slotMs + plan.guardMs <= slotMs);
+  }
+}
+
+/**
+ * @brief Verifies that frames too long for a TDMA slot are dropped and link profiles that would produce them refused.
+ */
+static void test_tx_engine_tdma_refuses_oversized_frames(void)
+{
+  auto frameMs = [](size_t length) { return (LoRaAirtime::timeOnAirUs(LoRaModulation(), length) + 999) / 1000; };
+
+  TxEngineConfig config;
+  config.compactFrames = true;
+  config.tdma = TdmaConfig();
+  config.tdma->slotCount = 1;
+  config.tdma->slotMask = 1u << 0;
+  config.tdma->beaconIntervalMs = 60000;
+  config.tdma->slotMs = frameMs(MAX_TX_PACKET_SIZE) + config.tdma->guardMs - 1;  // A full frame misses by 1 ms.
+  FakeRadio radio;
+  TxEngine engine(radio, config);
+
+  TEST_ASSERT_TRUE(engine.enqueue(std::vector<uint8_t>(LORA_MAX_PAYLOAD_SIZE, 0x11), 1));
+  TEST_ASSERT_TRUE(engine.enqueue(std::vector<uint8_t>(10, 0x22), 2));
+  for (uint32_t now = 0; now < 100 * config.tdma->slotMs && !engine.idle(); now++)
+  {
+    if (radio.onAir)
+      engine.onTransmitDone();
+    engine.poll(now);
+  }
+
+  // The beacon and the short message go out; the full frame is dropped instead of overrunning the slot.
+  TxEngine::Stats stats = engine.stats();
+  TEST_ASSERT_TRUE(engine.idle());
+  TEST_ASSERT_EQUAL_size_t(2, radio.frames.size());
+  TEST_ASSERT_EQUAL_UINT64(1, stats.framesTooLong);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.framesDropped);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.messagesSent);
+  auto sent = PacketParser::parse(radio.frames[1].data(), radio.frames[1].size());
+  TEST_ASSERT_EQUAL_UINT16(2, sent->header.messageId);
+
+  // A slower profile whose frames would not fit the slot is refused; a faster one is accepted.
+  TEST_ASSERT_FALSE(engine.requestLinkChange(LinkProfile{12, 125000, 8, LORA_MAX_PAYLOAD_SIZE}));
+  TEST_ASSERT_TRUE(engine.requestLinkChange(LinkProfile{7, 250000, 5, 64}));
+}
+
+// ============================================================================
+// Link Adaptation Tests
+// ============================================================================
+
+/**
+ * @brief Verifies the announcement encoding and the follower's change and fallback handling.
+ */
+static void test_link_announcement_and_follower(void)
+{
+  const LinkProfile fast{7, 250000, 5, LORA_MAX_PAYLOAD_SIZE};
+  const LinkProfile robust{12, 125000, 8, 64};
+
+  std::vector<uint8_t> payload(LinkAnnouncement::SIZE);
+  LinkAnnouncement::encode(robust, payload.data());
+  auto packets = PacketSerializer::splitVectorToPackets(payload, LinkAnnouncement::MESSAGE_ID);
+  TEST_ASSERT_EQUAL_size_t(1, packets.size());
+
+  // Without the control flag the same bytes are application data.
+  TEST_ASSERT_FALSE(LinkAnnouncement::decode(packets[0]).has_value());
+  packets[0].header.flags |= PACKET_FLAG_CONTROL;
+  packets[0].calculateCRC();
+  auto decoded = LinkAnnouncement::decode(packets[0]);
+  TEST_ASSERT_TRUE(decoded.has_value());
+  TEST_ASSERT_TRUE(*decoded == robust);
+
+  LinkFollower follower(fast, robust, 10000);
+  auto data = PacketSerializer::splitVectorToPackets(std::vector<uint8_t>{1, 2, 3}, 5);
+  TEST_ASSERT_EQUAL(static_cast<int>(LinkEvent::None), static_cast<int>(follower.onPacket(data[0], 0)));
+
+  LinkAnnouncement::encode(fast, packets[0].payload.data);
+  packets[0].calculateCRC();
+  TEST_ASSERT_EQUAL(static_cast<int>(LinkEvent::Control), static_cast<int>(follower.onPacket(packets[0], 100)));
+
+  LinkProfile medium{9, 125000, 7, 192};
+  LinkAnnouncement::encode(medium, packets[0].payload.data);
+  packets[0].calculateCRC();
+  TEST_ASSERT_EQUAL(static_cast<int>(LinkEvent::Changed), static_cast<int>(follower.onPacket(packets[0], 200)));
+  TEST_ASSERT_TRUE(follower.current() == medium);
+
+  // Silence: both ends meet again on the fallback profile.
+  TEST_ASSERT_FALSE(follower.checkTimeout(10200));
+  TEST_ASSERT_TRUE(follower.checkTimeout(10201));
+  TEST_ASSERT_TRUE(follower.current() == robust);
+  TEST_ASSERT_FALSE(follower.checkTimeout(30000));
+}
+
+/**
+ * @brief Closed loop over the simulator: the link speeds up, protects itself when the SNR drops and recovers.
+ *
+ * The receiver only hears frames sent with the settings its LinkFollower is
+ * tuned to, so every change has to go through the in-band announcement.
+ */
+static void test_link_adaptation_closed_loop(void)
+{
+  LinkAdaptationConfig linkConfig;
+  LinkAdaptationController controller(linkConfig);
+  const LinkProfile &fallback = linkConfig.ladder.back();
+  LinkFollower follower(controller.current(), fallback, 60000);
+
+  FakeRadio radio;
+  TxEngineConfig txConfig;
+  txConfig.modulation = controller.current().modulation();
+  radio.modulation = txConfig.modulation;
+  TxEngine engine(radio, txConfig);
+
+  ChannelModel model;
+  model.seed = 41;
+  ChannelSimulator channel(model);
+
+  struct Phase
+  {
+    double snrDb;
+    uint32_t durationMs;
+    size_t delivered = 0;
+    size_t sent = 0;
+    size_t lastIndex = 0;
+  };
+  Phase phases[] = {{8.0, 120000}, {-12.0, 900000}, {8.0, 900000}};
+
+  uint32_t now = 0;
+  uint16_t messageId = 1;
+  for (Phase &phase : phases)
+  {
+    channel.model().snrDb = phase.snrDb;
+    const uint32_t end = now + phase.durationMs;
+    while (static_cast<int32_t>(end - now) > 0)
+    {
+      if (engine.stats().messagesQueued - engine.stats().messagesSent < 2)
+        engine.enqueue(std::vector<uint8_t>(3 * LORA_MAX_PAYLOAD_SIZE, 0x41), messageId++);
+
+      engine.poll(now);
+      if (!radio.onAir)
+      {
+        now += 10;
+        continue;
+      }
+
+      const std::vector<uint8_t> &frame = radio.frames.back();
+      LoRaModulation onAir = radio.modulation;
+      channel.transmit(1, frame.data(), frame.size(), now, onAir);
+      now += static_cast<uint32_t>(LoRaAirtime::timeOnAirUs(onAir, frame.size()) / 1000) + 1;
+      engine.onTransmitDone();
+
+      SimulatedFrame received;
+      bool heard = false;
+      while (channel.receive(received))
+      {
+        // A receiver tuned to other settings does not even detect the preamble.
+        LoRaModulation tuned = follower.current().modulation();
+        if (tuned.spreadingFactor != onAir.spreadingFactor || tuned.bandwidthHz != onAir.bandwidthHz)
+          continue;
+        auto packet = PacketParser::parse(received.bytes, received.length);
+        TEST_ASSERT_TRUE(packet.has_value());
+        follower.onPacket(*packet, now);
+        heard = true;
+      }
+      follower.checkTimeout(now);
+
+      LinkSample sample;
+      sample.delivered = heard;
+      sample.snrDb = received.snrDb;
+      controller.onFeedback(sample, now);
+      phase.sent++;
+      phase.delivered += heard ? 1 : 0;
+
+      if (auto profile = controller.update(now))
+        TEST_ASSERT_TRUE(engine.requestLinkChange(*profile));
+    }
+    engine.poll(now);
+    phase.lastIndex = controller.currentIndex();
+
+    // Both ends agree at the end of every phase.
+    TEST_ASSERT_FALSE(engine.linkChangePending());
+    TEST_ASSERT_TRUE(engine.linkProfile() == controller.current());
+    TEST_ASSERT_TRUE(follower.current() == engine.linkProfile());
+  }
+
+  // Good link: fastest rung. Bad link: a robust rung that still leaves margin.
+  TEST_ASSERT_EQUAL_size_t(0, phases[0].lastIndex);
+  TEST_ASSERT_TRUE(controller.requiredSnrDb(linkConfig.ladder[phases[1].lastIndex].spreadingFactor) < -12.0f);
+  TEST_ASSERT_TRUE(phases[1].lastIndex >= 5);
+  TEST_ASSERT_EQUAL_size_t(0, phases[2].lastIndex);
+
+  // Robustness while degraded, throughput once recovered.
+  TEST_ASSERT_TRUE(phases[1].delivered * 10 >= phases[1].sent * 8);
+  TEST_ASSERT_TRUE(phases[2].delivered > 5 * phases[1].delivered);
+  TEST_ASSERT_TRUE(engine.stats().linkChanges >= 4);
+}
+
+// ============================================================================
+// Chunk Size Tests
+// ============================================================================
+
+/**
+ * @brief Verifies sender-chosen chunk sizes through serializer, compact frames, parser and reassembler.
+ */
+static void test_custom_chunk_size_round_trip(void)
+{
+  std::vector<uint8_t> message(1001);
+  for (size_t i = 0; i < message.size(); i++)
+    message[i] = static_cast<uint8_t>(i * 7);
+
+  auto packets = PacketSerializer::splitVectorToPackets(message, 42, 100);
+  TEST_ASSERT_EQUAL_size_t(11, packets.size());
+  TEST_ASSERT_EQUAL_size_t(11, PacketSerializer::chunksFor(message.size(), 100));
+  TEST_ASSERT_EQUAL_UINT8(100, packets[9].header.payloadSize);
+  TEST_ASSERT_EQUAL_UINT8(1, packets[10].header.payloadSize);
+
+  // Compact frames end after the valid payload; reversed to exercise out-of-order insertion.
+  PacketReassembler reassembler;
+  std::optional<std::vector<uint8_t>> result;
+  uint8_t frame[MAX_PACKET_SIZE];
+  for (size_t i = packets.size(); i-- > 0;)
+  {
+    size_t length = PacketSerializer::serializeCompact(packets[i], frame);
+    TEST_ASSERT_EQUAL_size_t(HEADER_SIZE + packets[i].header.payloadSize + CRC_SIZE, length);
+    auto parsed = PacketParser::parse(frame, length);
+    TEST_ASSERT_TRUE(parsed.has_value());
+    TEST_ASSERT_FALSE(PacketParser::parse(frame, length - 1).has_value());
+    result = reassembler.processPacket(*parsed, 0);
+  }
+  TEST_ASSERT_TRUE(result.has_value());
+  TEST_ASSERT_EQUAL_size_t(message.size(), result->size());
+  TEST_ASSERT_EQUAL_MEMORY(message.data(), result->data(), message.size());
+
+  // Full-length frames of the same packets are still accepted, also mixed in a batch.
+  FrameArena arena(packets.size());
+  for (size_t i = 0; i < packets.size(); i++)
+  {
+    if (i % 2 == 0)
+    {
+      arena.push(frame, PacketSerializer::serializeCompact(packets[i], frame), FrameMeta());
+    }
+    else
+    {
+      PacketSerializer::serialize(packets[i], frame);
+      arena.push(frame, sizeof(Packet), FrameMeta());
+    }
+  }
+  std::vector<Packet> parsed(packets.size());
+  uint64_t mask = 0;
+  TEST_ASSERT_EQUAL_size_t(packets.size(), PacketParser::parseBatch(arena, parsed.data(), &mask));
+  for (size_t i = 0; i < packets.size(); i++)
+    TEST_ASSERT_EQUAL_MEMORY(&packets[i], &parsed[i], sizeof(Packet));
+
+  // Chunk sizes the header cannot describe produce nothing.
+  TEST_ASSERT_EQUAL_size_t(0, PacketSerializer::splitVectorToPackets(message, 42, 0).size());
+  TEST_ASSERT_EQUAL_size_t(0, PacketSerializer::splitVectorToPackets(message, 42, LORA_MAX_PAYLOAD_SIZE + 1).size());
+  TEST_ASSERT_EQUAL_size_t(0, PacketSerializer::splitVectorToPackets(message, 42, 3).size());
+  TEST_ASSERT_EQUAL_size_t(4, PacketSerializer::minChunkSize(message.size()));
+}
+
+/**
+ * @brief Verifies that chunks disagreeing with their message's chunk size are rejected.
+ */
+static void test_reassembler_enforces_chunk_size(void)
+{
+  PacketReassembler reassembler;
+
+  // Final chunk first: it bounds the chunk size until a non-final chunk fixes it.
+  TEST_ASSERT_FALSE(reassembler.processPacket(create_chunk(7, 3, 4, "DDD"), 0).has_value());
+  TEST_ASSERT_FALSE(reassembler.processPacket(create_chunk(7, 1, 4, "BB"), 0).has_value());
+  TEST_ASSERT_FALSE(reassembler.processPacket(create_chunk(7, 0, 4, "AAAA"), 0).has_value());
+  TEST_ASSERT_FALSE(reassembler.processPacket(create_chunk(7, 1, 4, "BBB"), 0).has_value());
+  TEST_ASSERT_FALSE(reassembler.processPacket(create_chunk(7, 1, 4, "BBBBB"), 0).has_value());
+  TEST_ASSERT_FALSE(reassembler.processPacket(create_chunk(7, 1, 4, "BBBB"), 0).has_value());
+  auto message = reassembler.processPacket(create_chunk(7, 2, 4, "CCCC"), 0);
+  TEST_ASSERT_TRUE(message.has_value());
+  TEST_ASSERT_EQUAL_size_t(15, message->size());
+  TEST_ASSERT_EQUAL_MEMORY("AAAABBBBCCCCDDD", message->data(), 15);
+
+  // Validator: short non-final chunks are legal, empty ones are not.
+  Packet empty = create_chunk(8, 0, 2, "");
+  empty.header.flags = PACKET_FLAG_SOM;
+  empty.calculateCRC();
+  TEST_ASSERT_TRUE(PacketValidator::validate(empty).has_value());
+  Packet shortChunk = create_chunk(8, 0, 2, "x");
+  shortChunk.header.flags = PACKET_FLAG_SOM;
+  shortChunk.calculateCRC();
+  TEST_ASSERT_FALSE(PacketValidator::validate(shortChunk).has_value());
+}
+
+/**
+ * @brief At a high bit-error rate, small compact frames deliver more payload per byte on air.
+ */
+static void test_small_chunks_improve_goodput_at_high_ber(void)
+{
+  auto goodput = [](size_t chunkSize)
+  {
+    ChannelModel model;
+    model.bitErrorRate = 1e-3;
+    model.seed = 42;
+    ChannelSimulator channel(model);
+
+    std::vector<uint8_t> message(240 * 20, 0x42);
+    auto packets = PacketSerializer::splitVectorToPackets(message, 3, chunkSize);
+    size_t airBytes = 0;
+    uint8_t frame[MAX_PACKET_SIZE];
+    for (int round = 0; round < 10; round++)
+    {
+      for (const auto &packet : packets)
+      {
+        size_t length = PacketSerializer::serializeCompact(packet, frame);
+        channel.transmit(1, frame, length, 0);
+        airBytes += length;
+      }
+    }
+
+    size_t payloadBytes = 0;
+    for (const auto &received : channel.drain())
+    {
+      if (auto packet = PacketParser::parse(received.bytes, received.length))
+        payloadBytes += packet->header.payloadSize;
+    }
+    return static_cast<double>(payloadBytes) / static_cast<double>(airBytes);
+  };
+
+  double large = goodput(LORA_MAX_PAYLOAD_SIZE);
+  double small = goodput(48);
+  // (1 - 1e-3)^(8 * 255) ~ 13 % of full frames survive, (1 - 1e-3)^(8 * 57) ~ 63 % of small ones.
+  TEST_ASSERT_TRUE(large < 0.2);
+  TEST_ASSERT_TRUE(small > 2.5 * large);
+}
+
+/**
+ * @brief Verifies that TxEngine sends compact frames sized by the message's or the link's chunk size.
+ */
+static void test_tx_engine_compact_frames_follow_chunk_size(void)
+{
+  FakeRadio radio;
+  TxEngineConfig config;
+  config.compactFrames = true;
+  TxEngine engine(radio, config);
+
+  TxOptions explicitSize;
+  explicitSize.chunkPayloadSize = 64;
+  TEST_ASSERT_TRUE(engine.enqueue(std::vector<uint8_t>(150, 0x11), 1, explicitSize));
+  explicitSize.chunkPayloadSize = 1;
+  TEST_ASSERT_FALSE(engine.enqueue(std::vector<uint8_t>(300, 0x11), 2, explicitSize));
+
+  // Messages without an explicit size use the link profile current when they are admitted.
+  TEST_ASSERT_TRUE(engine.requestLinkChange(LinkProfile{9, 125000, 7, 100}));
+  auto drain = [&]()
+  {
+    engine.poll(0);
+    while (!engine.idle())
+    {
+      engine.onTransmitDone();
+      engine.poll(0);
+    }
+  };
+  drain();
+  TEST_ASSERT_EQUAL_UINT16(100, engine.linkProfile().chunkPayloadSize);
+  TEST_ASSERT_TRUE(engine.enqueue(std::vector<uint8_t>(250, 0x22), 3));
+  drain();
+
+  std::vector<size_t> dataFrames;
+  for (const auto &frame : radio.frames)
+  {
+    auto packet = PacketParser::parse(frame.data(), frame.size());
+    TEST_ASSERT_TRUE(packet.has_value());
+    TEST_ASSERT_EQUAL_size_t(PacketSerializer::compactSize(*packet), frame.size());
+    if ((packet->header.flags & PACKET_FLAG_CONTROL) == 0)
+      dataFrames.push_back(packet->header.payloadSize);
+  }
+  const size_t expected[] = {64, 64, 22, 100, 100, 50};
+  TEST_ASSERT_EQUAL_size_t(6, dataFrames.size());
+  for (size_t i = 0; i < dataFrames.size(); i++)
+    TEST_ASSERT_EQUAL_size_t(expected[i], dataFrames[i]);
+}
+
+// ============================================================================
+// Transport & Endpoint Tests
+// ============================================================================
+
+/**
+ * @brief Verifies messages both ways between two LinkEndpoints over a duplicating, reordering loopback link.
+ */
+static void test_link_endpoint_loopback_round_trip(void)
+{
+  ChannelModel model;
+  model.duplicateProbability = 0.2;
+  model.reorderWindow = 3;
+  model.latencyMs = 5;
+  LoopbackTransport a(1, model), b(2, model);
+  LoopbackTransport::connect(a, b);
+
+  LinkEndpoint alice(a), bob(b);
+  std::vector<std::pair<uint32_t, std::vector<uint8_t>>> atBob, atAlice;
+  bob.onMessage([&](uint32_t source, uint16_t, std::vector<uint8_t> &&message)
+                { atBob.emplace_back(source, std::move(message)); });
+  alice.onMessage([&](uint32_t source, uint16_t, std::vector<uint8_t> &&message)
+                  { atAlice.emplace_back(source, std::move(message)); });
+  size_t controlFrames = 0;
+  bob.onControl([&](const Packet &packet, const FrameMeta &meta)
+                {
+                  TEST_ASSERT_TRUE(LinkAnnouncement::decode(packet).has_value());
+                  TEST_ASSERT_EQUAL_UINT32(1, meta.sourceId);
+                  controlFrames++;
+                });
+
+  std::vector<std::vector<uint8_t>> sent;
+  for (size_t i = 0; i < 4; i++)
+  {
+    sent.emplace_back(100 + i * 300, static_cast<uint8_t>(0x10 + i));
+    auto id = alice.send(sent.back().data(), sent.back().size());
+    TEST_ASSERT_TRUE(id.has_value());
+    TEST_ASSERT_NOT_EQUAL(0, *id);
+  }
+  TEST_ASSERT_TRUE(bob.send(std::vector<uint8_t>(700, 0x77)).has_value());
+  TEST_ASSERT_TRUE(alice.engine().requestLinkChange(LinkProfile{7, 250000, 5, 246}));
+
+  uint32_t now = 0;
+  for (; now < 1000 && (atBob.size() < sent.size() || atAlice.empty() || !alice.idle()); now++)
+  {
+    alice.poll(now);
+    bob.poll(now);
+  }
+
+  // Duplicates are absorbed by the reassembler, reordering within a message is harmless.
+  TEST_ASSERT_EQUAL_size_t(sent.size(), atBob.size());
+  for (const auto &received : atBob)
+  {
+    TEST_ASSERT_EQUAL_UINT32(1, received.first);
+    bool found = false;
+    for (const auto &message : sent)
+      found = found || received.second == message;
+    TEST_ASSERT_TRUE(found);
+  }
+  TEST_ASSERT_EQUAL_size_t(1, atAlice.size());
+  TEST_ASSERT_EQUAL_UINT32(2, atAlice[0].first);
+  TEST_ASSERT_EQUAL_size_t(700, atAlice[0].second.size());
+
+  TEST_ASSERT_EQUAL_size_t(2, controlFrames);
+  TEST_ASSERT_EQUAL(7, a.modulation().spreadingFactor);
+  LinkEndpoint::Stats stats = bob.stats();
+  TEST_ASSERT_EQUAL_UINT64(0, stats.framesRejected);
+  TEST_ASSERT_EQUAL_UINT64(sent.size(), stats.messagesReceived);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.tx.messagesSent);
+}
+
+/**
+ * @brief Verifies UART sub-packet sizing, compact writes, TX-done timing and recovery from a truncated frame.
+ */
+static void test_uart_transport_framing_and_sub_packets(void)
+{
+  // One direction of a UART link between two serial modules, as an in-memory byte pipe.
+  std::deque<uint8_t> wire;
+  std::vector<size_t> writes;
+  auto write = [&](const uint8_t *data, size_t length)
+  {
+    writes.push_back(length);
+    wire.insert(wire.end(), data, data + length);
+    return true;
+  };
+  auto read = [&](uint8_t *buffer, size_t capacity)
+  {
+    size_t count = std::min(capacity, wire.size());
+    std::copy(wire.begin(), wire.begin() + count, buffer);
+    wire.erase(wire.begin(), wire.begin() + count);
+    return count;
+  };
+  auto noInput = [](uint8_t *, size_t) { return size_t(0); };
+
+  // E220 with 64-byte sub-packets: chunks are sized to fit and sent compact.
+  UartTransportConfig config;
+  config.maxFrameSize = 64;
+  config.modulation.spreadingFactor = 7;
+  config.modulation.bandwidthHz = 500000;
+  config.interFrameGapMs = 10;
+  UartTransport tx(write, noInput, config), rx([](const uint8_t *, size_t) { return true; }, read, config);
+  LinkEndpoint sender(tx), receiver(rx);
+  std::vector<std::vector<uint8_t>> received;
+  receiver.onMessage([&](uint32_t, uint16_t, std::vector<uint8_t> &&message)
+                     { received.push_back(std::move(message)); });
+
+  std::vector<uint8_t> message(300);
+  for (size_t i = 0; i < message.size(); i++)
+    message[i] = static_cast<uint8_t>(i * 7);
+  TEST_ASSERT_TRUE(sender.send(std::vector<uint8_t>(message)).has_value());
+
+  uint32_t now = 0;
+  for (; now < 1000 && received.empty(); now++)
+  {
+    sender.poll(now);
+    receiver.poll(now);
+  }
+  for (; !sender.idle(); now++)
+    sender.poll(now);
+  TEST_ASSERT_EQUAL_size_t(1, received.size());
+  TEST_ASSERT_TRUE(received[0] == message);
+  TEST_ASSERT_EQUAL_size_t(6, writes.size());  // ceil(300 / 55) chunks
+  for (size_t length : writes)
+    TEST_ASSERT_TRUE(length <= 64);
+
+  // A full-length frame is compacted on write.
+  auto packets = PacketSerializer::splitBufferToPackets(message.data(), 20, 9);
+  uint8_t full[MAX_TX_PACKET_SIZE];
+  PacketSerializer::serialize(packets[0], full);
+  TEST_ASSERT_TRUE(tx.startTransmit(full, sizeof(full)));
+  TEST_ASSERT_EQUAL_size_t(HEADER_SIZE + 20 + CRC_SIZE, writes.back());
+  TEST_ASSERT_FALSE(tx.startTransmit(full, sizeof(full)));  // Still on air.
+
+  // Reported sent after the compact frame's time on air plus the gap.
+  uint32_t sentMs = now - 1 + (LoRaAirtime::timeOnAirUs(config.modulation, HEADER_SIZE + 20 + CRC_SIZE) + 999) / 1000 +
+                    config.interFrameGapMs;
+  TEST_ASSERT_TRUE(sentMs > now - 1 + config.interFrameGapMs);
+  tx.poll(sentMs - 1);
+  TEST_ASSERT_FALSE(tx.startTransmit(full, sizeof(full)));
+  tx.poll(sentMs);
+  TEST_ASSERT_TRUE(tx.startTransmit(full, sizeof(full)));
+  wire.clear();
+
+  // Impossible header, then a truncated frame followed by silence: both dropped.
+  const uint8_t garbage[HEADER_SIZE] = {1, 0, 1, 0, 0xFF, 0, 1};
+  wire.insert(wire.end(), garbage, garbage + sizeof(garbage));
+  receiver.poll(now++);
+  uint8_t compact[MAX_TX_PACKET_SIZE];
+  size_t length = PacketSerializer::serializeCompact(packets[0], compact);
+  wire.insert(wire.end(), compact, compact + 10);
+  receiver.poll(now);
+  now += config.rxIdleTimeoutMs + 1;
+  receiver.poll(now);
+  TEST_ASSERT_EQUAL_UINT64(sizeof(garbage) + 10, rx.stats().bytesDiscarded);
+
+  // The stream is in sync again: the next frame goes through.
+  wire.insert(wire.end(), compact, compact + length);
+  receiver.poll(now);
+  TEST_ASSERT_EQUAL_size_t(2, received.size());
+  TEST_ASSERT_EQUAL_size_t(20, received[1].size());
+  TEST_ASSERT_EQUAL_UINT64(0, receiver.stats().framesRejected);
+}
+
+/**
+ * @brief Verifies that the stream decoder finds frames between noise and skips corrupted ones.
+ */
+static void test_frame_stream_decoder_resynchronizes(void)
+{
+  // Stream: compact frames of various chunk sizes, separated by noise; every third frame corrupted.
+  ChannelSimulator rng;
+  std::vector<uint8_t> stream;
+  std::vector<std::vector<uint8_t>> expected;
+  for (uint16_t id = 1; id <= 60; id++)
+  {
+    size_t noise = rng.nextRandom() % 40;
+    for (size_t i = 0; i < noise; i++)
+      stream.push_back(static_cast<uint8_t>(rng.nextRandom()));
+
+    std::vector<uint8_t> data(1 + rng.nextRandom() % 300, static_cast<uint8_t>(id));
+    auto packets = PacketSerializer::splitVectorToPackets(data, id, 1 + id % 200);
+    for (const Packet &packet : packets)
+    {
+      uint8_t frame[MAX_TX_PACKET_SIZE];
+      size_t length = PacketSerializer::serializeCompact(packet, frame);
+      if (id % 3 == 0)
+        frame[length / 2] ^= 0x10;
+      else
+        expected.emplace_back(frame, frame + length);
+      stream.insert(stream.end(), frame, frame + length);
+    }
+  }
+
+  // Same stream cut into fragments of 1 byte, random sizes and one block.
+  const size_t maxFragments[] = {1, 97, stream.size()};
+  for (size_t maxFragment : maxFragments)
+  {
+    FrameStreamDecoder decoder;
+    std::vector<std::vector<uint8_t>> decoded;
+    size_t inPlace = 0;
+    for (size_t pos = 0; pos < stream.size();)
+    {
+      size_t length = maxFragment == stream.size()
+                          ? stream.size()
+                          : std::min(stream.size() - pos, 1 + static_cast<size_t>(rng.nextRandom() % maxFragment));
+      const uint8_t *fragment = stream.data() + pos;
+      decoder.push(fragment, length);
+      while (auto view = decoder.next())
+      {
+        decoded.emplace_back(view->frame, view->frame + view->length);
+        inPlace += view->frame >= fragment && view->frame + view->length <= fragment + length;
+        TEST_ASSERT_TRUE(PacketParser::parse(view->frame, view->length).has_value());
+      }
+      pos += length;
+    }
+
+    TEST_ASSERT_EQUAL_size_t(expected.size(), decoded.size());
+    for (size_t i = 0; i < expected.size() && i < decoded.size(); i++)
+      TEST_ASSERT_TRUE(expected[i] == decoded[i]);
+
+    const FrameStreamDecoder::Stats &stats = decoder.stats();
+    TEST_ASSERT_EQUAL_UINT64(stream.size(), stats.bytesReceived);
+    TEST_ASSERT_EQUAL_UINT64(expected.size(), stats.framesDecoded);
+    TEST_ASSERT_EQUAL_UINT64(decoded.size() - inPlace, stats.framesCopied);
+    if (maxFragment == stream.size())
+      TEST_ASSERT_EQUAL_UINT64(0, stats.framesCopied);
+    TEST_ASSERT_TRUE(stats.crcErrors > 0);
+
+    size_t frameBytes = 0;
+    for (const auto &frame : expected)
+      frameBytes += frame.size();
+    TEST_ASSERT_EQUAL_UINT64(stream.size() - frameBytes, stats.bytesDiscarded + decoder.pendingBytes());
+  }
+
+  // A view converts to the Packet the parser would build.
+  auto packets = PacketSerializer::splitBufferToPackets(stream.data(), 30, 5);
+  uint8_t frame[MAX_TX_PACKET_SIZE];
+  size_t length = PacketSerializer::serializeCompact(packets[0], frame);
+
+  // Noise that looks like a 200-byte frame, then two real frames; the fragment boundary falls
+  // inside the first one. The fake candidate pulls both real frames into the carry buffer.
+  std::vector<uint8_t> tricky = {7, 0, 1, 0, 200, PACKET_FLAG_SOM | PACKET_FLAG_EOM, 1};
+  tricky.insert(tricky.end(), frame, frame + length);
+  tricky.insert(tricky.end(), frame, frame + length);
+  tricky.resize(tricky.size() + 200, 0);
+  FrameStreamDecoder splitDecoder;
+  size_t found = 0;
+  splitDecoder.push(tricky.data(), 20);
+  while (splitDecoder.next())
+    found++;
+  splitDecoder.push(tricky.data() + 20, tricky.size() - 20);
+  while (auto view = splitDecoder.next())
+  {
+    TEST_ASSERT_EQUAL_size_t(length, view->length);
+    found++;
+  }
+  TEST_ASSERT_EQUAL_size_t(2, found);
+
+  FrameStreamDecoder decoder;
+  decoder.push(frame, length);
+  auto view = decoder.next();
+  TEST_ASSERT_TRUE(view.has_value());
+  TEST_ASSERT_EQUAL_UINT16(5, view->messageId());
+  TEST_ASSERT_EQUAL_size_t(30, view->payloadSize());
+  Packet packet = view->toPacket();
+  TEST_ASSERT_EQUAL_MEMORY(&packets[0], &packet, sizeof(Packet));
+  TEST_ASSERT_FALSE(decoder.next().has_value());
+
+  // A truncated 200-byte frame, a complete frame held behind it, then the line goes idle:
+  // only the truncated frame is given up.
+  std::vector<uint8_t> body(200, 0x3C);
+  uint8_t truncated[MAX_TX_PACKET_SIZE], complete[MAX_TX_PACKET_SIZE];
+  PacketSerializer::serializeCompact(PacketSerializer::splitVectorToPackets(body, 11)[0], truncated);
+  size_t completeLength =
+      PacketSerializer::serializeCompact(PacketSerializer::splitBufferToPackets(body.data(), 31, 12)[0], complete);
+  std::deque<uint8_t> wire(truncated, truncated + 30);
+  wire.insert(wire.end(), complete, complete + completeLength);
+  UartTransport uart([](const uint8_t *, size_t) { return true; },
+                     [&wire](uint8_t *buffer, size_t capacity)
+                     {
+                       size_t count = std::min(capacity, wire.size());
+                       std::copy(wire.begin(), wire.begin() + count, buffer);
+                       wire.erase(wire.begin(), wire.begin() + count);
+                       return count;
+                     });
+  std::vector<uint16_t> ids;
+  uart.setReceiveCallback([&ids](const uint8_t *data, size_t size, const FrameMeta &)
+                          { ids.push_back(PacketParser::parse(data, size)->header.messageId); });
+  uart.poll(0);
+  TEST_ASSERT_TRUE(ids.empty());
+  uart.poll(UartTransportConfig().rxIdleTimeoutMs + 1);
+  TEST_ASSERT_EQUAL_size_t(1, ids.size());
+  TEST_ASSERT_EQUAL_UINT16(12, ids[0]);
+  TEST_ASSERT_EQUAL_UINT64(30, uart.stats().bytesDiscarded);
+}
+
+/**
+ * @brief Sends 'message' from a bond of radios to a bond of radios (pair i on its own channel, modulation[i]).
+ * @return Simulated milliseconds until the receiver had the message, 0 if it never did.
+ */
+static uint32_t bonded_transfer_ms(const std::vector<uint8_t> &message, const std::vector<BondMemberConfig> &radios,
+                                   std::vector<BondedTransport::MemberStats> *senderStats = nullptr)
+{
+  std::deque<LoopbackTransport> senders, receivers;
+  std::vector<ITransport *> senderMembers, receiverMembers;
+  for (const BondMemberConfig &radio : radios)
+  {
+    // Every radio of a node answers to the node's address.
+    senders.emplace_back(1);
+    receivers.emplace_back(2);
+    LoopbackTransport::connect(senders.back(), receivers.back());
+    for (LoopbackTransport *transport : {&senders.back(), &receivers.back()})
+    {
+      transport->setSimulateAirtime(true);
+      transport->setModulation(radio.modulation);
+    }
+    senderMembers.push_back(&senders.back());
+    receiverMembers.push_back(&receivers.back());
+  }
+  BondedTransport senderBond(senderMembers, radios), receiverBond(receiverMembers, radios);
+  LinkEndpoint sender(senderBond), receiver(receiverBond);
+
+  std::vector<uint8_t> received;
+  uint32_t receivedMs = 0;
+  receiver.onMessage([&](uint32_t source, uint16_t, std::vector<uint8_t> &&data)
+                     {
+                       TEST_ASSERT_EQUAL_UINT32(1, source);
+                       received = std::move(data);
+                     });
+  TEST_ASSERT_TRUE(sender.send(message.data(), message.size()).has_value());
+  for (uint32_t now = 0; now < 60000 && received.empty(); now++)
+  {
+    sender.poll(now);
+    receiver.poll(now);
+    receivedMs = now;
+  }
+
+  TEST_ASSERT_TRUE(received == message);
+  TEST_ASSERT_EQUAL_UINT64(0, receiver.stats().framesRejected);
+  if (senderStats != nullptr)
+  {
+    senderStats->clear();
+    for (size_t i = 0; i < senderBond.memberCount(); i++)
+      senderStats->push_back(senderBond.memberStats(i));
+  }
+  return received.empty() ? 0 : receivedMs;
+}
+
+/**
+ * @brief Verifies that a bond stripes a message across its radios by speed and budget and the receiver merges it.
+ */
+static void test_bonded_transport_stripes_across_radios(void)
+{
+  std::vector<uint8_t> message(30 * LORA_MAX_PAYLOAD_SIZE);
+  for (size_t i = 0; i < message.size(); i++)
+    message[i] = static_cast<uint8_t>(i * 13);
+
+  BondMemberConfig fast;
+  fast.modulation.spreadingFactor = 7;
+  fast.modulation.bandwidthHz = 250000;
+
+  // Identical radios: the transfer time divides by the radio count.
+  std::vector<BondedTransport::MemberStats> stats;
+  uint32_t one = bonded_transfer_ms(message, {fast});
+  uint32_t two = bonded_transfer_ms(message, {fast, fast}, &stats);
+  uint32_t three = bonded_transfer_ms(message, {fast, fast, fast});
+  TEST_ASSERT_TRUE(one > 0 && two > 0 && three > 0);
+  TEST_ASSERT_TRUE(two * 100 <= one * 55);
+  TEST_ASSERT_TRUE(three * 100 <= one * 37);
+  TEST_ASSERT_EQUAL_UINT64(15, stats[0].framesSent);
+  TEST_ASSERT_EQUAL_UINT64(15, stats[1].framesSent);
+
+  // A slower radio carries a share in proportion to its speed and still shortens the transfer.
+  BondMemberConfig slow = fast;
+  slow.modulation.spreadingFactor = 9;
+  TEST_ASSERT_TRUE(bonded_transfer_ms(message, {slow, fast}, &stats) < one);
+  TEST_ASSERT_EQUAL_UINT64(30, stats[0].framesSent + stats[1].framesSent);
+  TEST_ASSERT_TRUE(stats[1].framesSent > 2 * stats[0].framesSent);
+  TEST_ASSERT_TRUE(stats[0].framesSent > 0);
+
+  // A radio whose sub-band budget runs out leaves the rest to the others.
+  BondMemberConfig limited = fast;
+  uint64_t frameUs = LoRaAirtime::timeOnAirUs(fast.modulation, MAX_TX_PACKET_SIZE);
+  limited.airtimeBudget = AirtimeBudgetConfig();
+  limited.airtimeBudget->initialUs = 4 * frameUs;
+  limited.airtimeBudget->burstUs = 4 * frameUs;
+  bonded_transfer_ms(message, {limited, fast}, &stats);
+  TEST_ASSERT_EQUAL_UINT64(4, stats[0].framesSent);
+  TEST_ASSERT_EQUAL_UINT64(26, stats[1].framesSent);
+  TEST_ASSERT_EQUAL_UINT64(4 * frameUs, stats[0].airtimeUs);
+}
+
+/**
+ * @brief LoopbackTransport counting the retunes made while its frame is still on air.
+ */
+class RetuneCheckingTransport : public LoopbackTransport
+{
+ public:
+  using LoopbackTransport::LoopbackTransport;
+
+  size_t retunesOnAir = 0;
+
+  bool startTransmit(const uint8_t *frame, size_t length) override
+  {
+    uint32_t airtimeMs = (LoRaAirtime::timeOnAirUs(modulation(), length) + 999) / 1000;
+    if (!LoopbackTransport::startTransmit(frame, length))
+      return false;
+    endMs_ = now_ + airtimeMs;
+    return true;
+  }
+
+  bool setModulation(const LoRaModulation &modulation) override
+  {
+    if (static_cast<int32_t>(now_ - endMs_) < 0)
+      retunesOnAir++;
+    return LoopbackTransport::setModulation(modulation);
+  }
+
+  void poll(uint32_t currentTimestampMs) override
+  {
+    now_ = currentTimestampMs;
+    LoopbackTransport::poll(currentTimestampMs);
+  }
+
+ private:
+  uint32_t now_ = 0;
+  uint32_t endMs_ = 0;
+};
+
+/**
+ * @brief Verifies that a link change on a bond retunes each radio only once its frame has left the air.
+ */
+static void test_bonded_transport_link_change_waits_for_air(void)
+{
+  LoRaModulation initial;
+  initial.spreadingFactor = 9;
+  initial.bandwidthHz = 125000;
+  RetuneCheckingTransport a(1), b(1);
+  LoopbackTransport peerA(2), peerB(2);
+  LoopbackTransport::connect(a, peerA);
+  LoopbackTransport::connect(b, peerB);
+  for (LoopbackTransport *transport : {static_cast<LoopbackTransport *>(&a), static_cast<LoopbackTransport *>(&b),
+                                       &peerA, &peerB})
+  {
+    transport->setSimulateAirtime(true);
+    transport->setModulation(initial);
+  }
+  BondedTransport senderBond({&a, &b}, {{initial, {}}, {initial, {}}});
+  BondedTransport receiverBond({&peerA, &peerB}, {{initial, {}}, {initial, {}}});
+  LinkEndpoint sender(senderBond), receiver(receiverBond);
+
+  std::vector<std::vector<uint8_t>> received;
+  size_t announcements = 0;
+  receiver.onMessage([&](uint32_t, uint16_t, std::vector<uint8_t> &&data) { received.push_back(std::move(data)); });
+  receiver.onControl([&](const Packet &packet, const FrameMeta &)
+                     {
+                       if (LinkAnnouncement::decode(packet).has_value())
+                         announcements++;
+                     });
+
+  std::vector<uint8_t> before(4 * LORA_MAX_PAYLOAD_SIZE, 0x5A), after(3 * LORA_MAX_PAYLOAD_SIZE, 0xA5);
+  TEST_ASSERT_TRUE(sender.send(before.data(), before.size()).has_value());
+  TEST_ASSERT_TRUE(sender.engine().requestLinkChange(LinkProfile{7, 250000, 5, 246}));
+  uint32_t now = 0;
+  for (; now < 20000 && (received.empty() || senderBond.transmitting()); now++)
+  {
+    sender.poll(now);
+    receiver.poll(now);
+  }
+  TEST_ASSERT_TRUE(sender.send(after.data(), after.size()).has_value());
+  for (; now < 40000 && received.size() < 2; now++)
+  {
+    sender.poll(now);
+    receiver.poll(now);
+  }
+
+  TEST_ASSERT_EQUAL_size_t(0, a.retunesOnAir);
+  TEST_ASSERT_EQUAL_size_t(0, b.retunesOnAir);
+  TEST_ASSERT_EQUAL(7, a.modulation().spreadingFactor);
+  TEST_ASSERT_EQUAL(7, b.modulation().spreadingFactor);
+  TEST_ASSERT_EQUAL_UINT64(1, sender.stats().tx.linkChanges);
+  TEST_ASSERT_EQUAL_UINT64(0, senderBond.stats().modulationErrors);
+  TEST_ASSERT_EQUAL_size_t(2, announcements);
+  TEST_ASSERT_EQUAL_size_t(2, received.size());
+  TEST_ASSERT_TRUE(received[0] == before);
+  TEST_ASSERT_TRUE(received[1] == after);
+}
+
+// ============================================================================
+// Streaming Reassembly Tests
+// ============================================================================
+
+/**
+ * @brief Verifies in-order delivery of contiguous ranges from a reordered, duplicating stream.
+ */
+static void test_streaming_reassembler_delivers_in_order_ranges(void)
+{
+  std::vector<uint8_t> image(12000);
+  for (size_t i = 0; i < image.size(); i++)
+    image[i] = static_cast<uint8_t>(i * 13 + (i >> 8));
+  auto packets = PacketSerializer::splitVectorToPackets(image, 42, 100);
+
+  // Bounded reordering: every group of 6 chunks arrives reversed, every 7th chunk twice.
+  std::vector<Packet> arrivals;
+  for (size_t group = 0; group < packets.size(); group += 6)
+  {
+    for (size_t i = std::min(packets.size(), group + 6); i > group; i--)
+    {
+      arrivals.push_back(packets[i - 1]);
+      if ((i - 1) % 7 == 0)
+        arrivals.push_back(packets[i - 1]);
+    }
+  }
+
+  std::vector<uint8_t> streamed;
+  size_t calls = 0;
+  size_t framesAtFirstData = 0;
+  size_t framesProcessed = 0;
+  bool completed = false;
+  StreamingReassemblerConfig config;
+  config.windowChunks = 16;
+  StreamingReassembler reassembler(config,
+                                   [&](uint32_t source, uint16_t id, size_t offset, const uint8_t *data, size_t length,
+                                       bool complete)
+                                   {
+                                     TEST_ASSERT_EQUAL_UINT32(3, source);
+                                     TEST_ASSERT_EQUAL_UINT16(42, id);
+                                     TEST_ASSERT_EQUAL_size_t(streamed.size(), offset);
+                                     TEST_ASSERT_FALSE(completed);
+                                     if (calls++ == 0)
+                                       framesAtFirstData = framesProcessed;
+                                     streamed.insert(streamed.end(), data, data + length);
+                                     completed = complete;
+                                   });
+
+  size_t maxBuffered = 0;
+  for (const Packet &packet : arrivals)
+  {
+    framesProcessed++;
+    reassembler.processPacket(packet, static_cast<uint32_t>(framesProcessed * 10), 3);
+    maxBuffered = std::max(maxBuffered, reassembler.bufferedChunks());
+  }
+
+  TEST_ASSERT_TRUE(completed);
+  TEST_ASSERT_TRUE(streamed == image);
+  TEST_ASSERT_TRUE(framesAtFirstData < 8);  // Data flows from the start of the transfer.
+  TEST_ASSERT_TRUE(calls < packets.size());  // Buffered runs are released in one call.
+  TEST_ASSERT_TRUE(maxBuffered <= 6);        // Bounded by the reordering, not by the message.
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.pendingSessions());
+  TEST_ASSERT_EQUAL_UINT64(1, reassembler.stats().messagesCompleted);
+  TEST_ASSERT_TRUE(reassembler.stats().chunksDuplicate > 0);
+}
+
+/**
+ * @brief Verifies the out-of-order window limit and the abort report of a stalled stream.
+ */
+static void test_streaming_reassembler_window_and_abort(void)
+{
+  std::vector<uint8_t> data(2000, 0x5C);
+  auto packets = PacketSerializer::splitVectorToPackets(data, 7, 50);  // 40 chunks
+
+  size_t delivered = 0;
+  std::vector<std::pair<uint16_t, size_t>> aborted;
+  StreamingReassemblerConfig config;
+  config.windowChunks = 8;
+  config.maxConcurrentMessages = 1;
+  StreamingReassembler reassembler(
+      config, [&](uint32_t, uint16_t, size_t, const uint8_t *, size_t length, bool) { delivered += length; },
+      [&](uint32_t, uint16_t id, size_t deliveredBytes) { aborted.emplace_back(id, deliveredBytes); });
+
+  // Final chunk first, then chunk 3 is lost: the stream stops at 150 bytes.
+  TEST_ASSERT_TRUE(reassembler.processPacket(packets.back(), 0));
+  for (size_t i = 0; i < 3; i++)
+    TEST_ASSERT_TRUE(reassembler.processPacket(packets[i], 1));
+  for (size_t i = 4; i < 11; i++)
+    TEST_ASSERT_TRUE(reassembler.processPacket(packets[i], 2));
+  TEST_ASSERT_FALSE(reassembler.processPacket(packets[11], 2));  // 3 + 8: beyond the window
+  TEST_ASSERT_FALSE(reassembler.processPacket(packets[5], 2));   // already buffered
+  TEST_ASSERT_EQUAL_size_t(150, delivered);
+  TEST_ASSERT_EQUAL_size_t(8, reassembler.bufferedChunks());
+  TEST_ASSERT_EQUAL_UINT64(1, reassembler.stats().chunksOutOfWindow);
+
+  // Every slot busy: another message is refused; a single-chunk one needs no slot.
+  auto other = PacketSerializer::splitVectorToPackets(data, 8, 100);
+  TEST_ASSERT_FALSE(reassembler.processPacket(other[0], 3));
+  auto single = PacketSerializer::splitBufferToPackets(data.data(), 10, 9);
+  TEST_ASSERT_TRUE(reassembler.processPacket(single[0], 3));
+  TEST_ASSERT_EQUAL_size_t(160, delivered);
+
+  // The gap never fills: the idle session is aborted with what was delivered.
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.prune(500, 1000));
+  TEST_ASSERT_EQUAL_size_t(1, reassembler.prune(2000, 1000));
+  TEST_ASSERT_EQUAL_size_t(1, aborted.size());
+  TEST_ASSERT_EQUAL_UINT16(7, aborted[0].first);
+  TEST_ASSERT_EQUAL_size_t(150, aborted[0].second);
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.bufferedChunks());
+
+  // With the chunk filling the gap, buffered chunks and the final chunk follow at once.
+  delivered = 0;
+  TEST_ASSERT_TRUE(reassembler.processPacket(packets.back(), 3000));
+  for (size_t i = 1; i < 8; i++)
+    TEST_ASSERT_TRUE(reassembler.processPacket(packets[i], 3000));
+  TEST_ASSERT_EQUAL_size_t(0, delivered);
+  TEST_ASSERT_TRUE(reassembler.processPacket(packets[0], 3000));
+  TEST_ASSERT_EQUAL_size_t(400, delivered);
+  for (size_t i = 8; i + 1 < packets.size(); i++)
+    TEST_ASSERT_TRUE(reassembler.processPacket(packets[i], 3000));
+  TEST_ASSERT_EQUAL_size_t(data.size(), delivered);
+  TEST_ASSERT_EQUAL_UINT64(2, reassembler.stats().messagesCompleted);
+  TEST_ASSERT_FALSE(reassembler.processPacket(packets[0], 3000));  // Late duplicate of a completed message.
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.pendingSessions());
+}
+
+/**
+ * @brief Verifies that every reassembler ignores control frames instead of delivering them as messages.
+ */
+static void test_reassemblers_ignore_control_frames(void)
+{
+  struct Small
+  {
+    uint8_t bytes[10];
+  };
+  Small value{};
+  Packet control = PacketSerializer::split(value, LinkAnnouncement::MESSAGE_ID)[0];
+  control.header.flags |= PACKET_FLAG_CONTROL;
+  control.calculateCRC();
+
+  PacketReassembler reassembler;
+  TEST_ASSERT_FALSE(reassembler.processPacket(control, 0).has_value());
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.pendingSessions());
+
+  TypedReassembler<Small> typed;
+  TEST_ASSERT_FALSE(typed.processPacket(control, 0).has_value());
+  TEST_ASSERT_EQUAL_size_t(0, typed.pendingSessions());
+
+  size_t calls = 0;
+  StreamingReassembler streaming(StreamingReassemblerConfig(),
+                                 [&](uint32_t, uint16_t, size_t, const uint8_t *, size_t, bool) { calls++; });
+  TEST_ASSERT_FALSE(streaming.processPacket(control, 0));
+  TEST_ASSERT_EQUAL_size_t(0, calls);
+  TEST_ASSERT_EQUAL_UINT64(1, streaming.stats().controlFrames);
+
+  // The same frame without the flag is an ordinary message.
+  control.header.flags &= ~PACKET_FLAG_CONTROL;
+  TEST_ASSERT_TRUE(reassembler.processPacket(control, 0).has_value());
+  TEST_ASSERT_TRUE(typed.processPacket(control, 0).has_value());
+  TEST_ASSERT_TRUE(streaming.processPacket(control, 0));
+  TEST_ASSERT_EQUAL_size_t(1, calls);
+}
+
+// ============================================================================
+// Relay Tests
+// ============================================================================
+
+/**
+ * @brief Verifies that frames cross two relays as they arrive, without waiting for whole messages.
+ */
+static void test_frame_relay_cut_through_two_hops(void)
+{
+  // rocket -> relay1 -> relay2 -> ground, one link per hop, frames lasting their time on air.
+  LoRaModulation modulation;
+  modulation.spreadingFactor = 7;
+  modulation.bandwidthHz = 250000;
+  ChannelModel echoes;
+  echoes.duplicateProbability = 0.3;
+  LoopbackTransport rocketRadio(1), relay1Up(2, echoes), relay1Down(3), relay2Up(4), relay2Down(5), groundRadio(6);
+  for (LoopbackTransport *radio : {&rocketRadio, &relay1Up, &relay1Down, &relay2Up, &relay2Down, &groundRadio})
+  {
+    radio->setSimulateAirtime(true);
+    radio->setModulation(modulation);
+  }
+  LoopbackTransport::connect(rocketRadio, relay1Up);
+  LoopbackTransport::connect(relay1Down, relay2Up);
+  LoopbackTransport::connect(relay2Down, groundRadio);
+
+  FrameRelay relay1(relay1Up, relay1Down), relay2(relay2Up, relay2Down);
+  size_t observed = 0;
+  relay2.setFrameObserver([&](const Packet &packet, const FrameMeta &meta, FrameRelay::Verdict verdict)
+                          {
+                            TEST_ASSERT_EQUAL(FrameRelay::Verdict::Forwarded, verdict);
+                            TEST_ASSERT_EQUAL_UINT8(1, packetHops(packet.header.flags));
+                            TEST_ASSERT_EQUAL_UINT32(3, meta.sourceId);
+                            observed++;
+                          });
+
+  PacketReassembler reassembler{ReassemblerConfig()};
+  std::vector<std::vector<uint8_t>> atGround;
+  size_t groundFrames = 0;
+  uint32_t now = 0, groundDoneMs = 0;
+  groundRadio.setReceiveCallback([&](const uint8_t *frame, size_t length, const FrameMeta &meta)
+                                 {
+                                   auto packet = PacketParser::parse(frame, length);
+                                   TEST_ASSERT_TRUE(packet.has_value());
+                                   TEST_ASSERT_EQUAL_UINT8(2, packetHops(packet->header.flags));
+                                   groundFrames++;
+                                   auto message = reassembler.processPacket(*packet, meta.timestampMs, meta.sourceId);
+                                   if (message.has_value())
+                                   {
+                                     atGround.push_back(std::move(*message));
+                                     groundDoneMs = meta.timestampMs;
+                                   }
+                                 });
+
+  LinkEndpoint rocket(rocketRadio);
+  std::vector<uint8_t> telemetry(1500);
+  for (size_t i = 0; i < telemetry.size(); i++)
+    telemetry[i] = static_cast<uint8_t>(i * 7);
+  TEST_ASSERT_TRUE(rocket.send(telemetry.data(), telemetry.size()).has_value());
+
+  uint32_t rocketDoneMs = 0;
+  for (; now < 20000 && (atGround.empty() || !relay1.idle() || !relay2.idle()); now++)
+  {
+    rocket.poll(now);
+    if (rocketDoneMs == 0 && rocket.idle())
+      rocketDoneMs = now;
+    relay1.poll(now);
+    relay2.poll(now);
+    groundRadio.poll(now);
+  }
+
+  TEST_ASSERT_EQUAL_size_t(1, atGround.size());
+  TEST_ASSERT_TRUE(atGround[0] == telemetry);
+  size_t chunks = PacketSerializer::chunksFor(telemetry.size());
+  TEST_ASSERT_EQUAL_UINT64(chunks, rocketRadio.framesSent());
+  TEST_ASSERT_EQUAL_size_t(chunks, groundFrames);
+  TEST_ASSERT_EQUAL_size_t(chunks, observed);
+
+  // Echoes are absorbed by the first relay and never reach the second one.
+  FrameRelay::Stats first = relay1.stats(), second = relay2.stats();
+  TEST_ASSERT_TRUE(first.duplicates > 0);
+  TEST_ASSERT_EQUAL_UINT64(chunks + first.duplicates, first.framesReceived);
+  TEST_ASSERT_EQUAL_UINT64(chunks, first.framesForwarded);
+  TEST_ASSERT_EQUAL_UINT64(0, second.duplicates);
+  TEST_ASSERT_EQUAL_UINT64(chunks, second.framesForwarded);
+  TEST_ASSERT_EQUAL_UINT32(0, second.residenceMsMax);
+
+  // Cut-through: the message lands about two frame times after the rocket finished,
+  // where store-and-forward would add twice the whole message airtime.
+  uint32_t frameMs = (LoRaAirtime::timeOnAirUs(modulation, MAX_PACKET_SIZE) + 999) / 1000;
+  TEST_ASSERT_TRUE(rocketDoneMs > 0);
+  TEST_ASSERT_TRUE(groundDoneMs - rocketDoneMs <= 2 * frameMs + 5);
+}
+
+/**
+ * @brief Verifies the relay's verdicts: forwarded, duplicate, queue full, hop limit, control and invalid frames.
+ */
+static void test_frame_relay_verdicts(void)
+{
+  LoopbackTransport up(1), down(2), sink(3);
+  LoopbackTransport::connect(down, sink);
+  RelayConfig config;
+  config.maxHops = 1;
+  config.queueFrames = 1;
+  FrameRelay relay(up, down, config);
+  FrameMeta meta;
+  meta.sourceId = 9;
+
+  std::vector<uint8_t> data(300, 0x5A);
+  auto packets = PacketSerializer::splitVectorToPackets(data, 42);
+  uint8_t frames[2][MAX_PACKET_SIZE];
+  size_t lengths[2];
+  for (size_t i = 0; i < 2; i++)
+    lengths[i] = PacketSerializer::serializeCompact(packets[i], frames[i]);
+
+  TEST_ASSERT_EQUAL(FrameRelay::Verdict::Forwarded, relay.onFrame(frames[0], lengths[0], meta));
+  TEST_ASSERT_EQUAL(FrameRelay::Verdict::Duplicate, relay.onFrame(frames[0], lengths[0], meta));
+  // Queue full: the frame is not remembered, a retransmission can still be forwarded.
+  TEST_ASSERT_EQUAL(FrameRelay::Verdict::QueueFull, relay.onFrame(frames[1], lengths[1], meta));
+  relay.poll(0);
+  relay.poll(1);
+  TEST_ASSERT_TRUE(relay.idle());
+  TEST_ASSERT_EQUAL(FrameRelay::Verdict::Forwarded, relay.onFrame(frames[1], lengths[1], meta));
+  relay.poll(2);
+  relay.poll(3);
+
+  // Forwarded frames keep their layout and carry one more hop, with a valid CRC.
+  std::vector<Packet> forwarded;
+  sink.setReceiveCallback([&](const uint8_t *frame, size_t length, const FrameMeta &)
+                          {
+                            TEST_ASSERT_EQUAL_size_t(lengths[forwarded.size()], length);
+                            auto packet = PacketParser::parse(frame, length);
+                            TEST_ASSERT_TRUE(packet.has_value());
+                            forwarded.push_back(*packet);
+                          });
+  sink.poll(4);
+  TEST_ASSERT_EQUAL_size_t(2, forwarded.size());
+  TEST_ASSERT_EQUAL_UINT8(1, packetHops(forwarded[0].header.flags));
+  TEST_ASSERT_EQUAL_UINT8(packets[0].header.flags, forwarded[0].header.flags & ~PACKET_HOPS_MASK);
+
+  // Already relayed once: over the limit of this relay. Control frames stay on their hop.
+  uint8_t relayed[MAX_PACKET_SIZE];
+  size_t relayedLength = PacketSerializer::serializeCompact(forwarded[0], relayed);
+  TEST_ASSERT_EQUAL(FrameRelay::Verdict::HopLimit, relay.onFrame(relayed, relayedLength, meta));
+  std::vector<uint8_t> announcement(LinkAnnouncement::SIZE);
+  LinkAnnouncement::encode(LinkProfile{7, 250000, 5, LORA_MAX_PAYLOAD_SIZE}, announcement.data());
+  Packet controlPacket = PacketSerializer::splitVectorToPackets(announcement, LinkAnnouncement::MESSAGE_ID)[0];
+  controlPacket.header.flags |= PACKET_FLAG_CONTROL;
+  controlPacket.calculateCRC();
+  uint8_t control[MAX_PACKET_SIZE];
+  size_t controlLength = PacketSerializer::serializeCompact(controlPacket, control);
+  TEST_ASSERT_EQUAL(FrameRelay::Verdict::Control, relay.onFrame(control, controlLength, meta));
+  relayed[0] ^= 0x01;
+  TEST_ASSERT_EQUAL(FrameRelay::Verdict::Invalid, relay.onFrame(relayed, relayedLength, meta));
+
+  FrameRelay::Stats stats = relay.stats();
+  TEST_ASSERT_EQUAL_UINT64(7, stats.framesReceived);
+  TEST_ASSERT_EQUAL_UINT64(2, stats.framesForwarded);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.duplicates);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.queueDrops);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.hopLimit);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.control);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.invalid);
+}
+
+// ============================================================================
+// Resumable Transfer Tests
+// ============================================================================
+
+#ifndef ESP_PLATFORM
+/**
+ * @brief Verifies that journaled sessions survive a restart with their chunks and missing-chunk lists.
+ */
+static void test_reassembly_journal_restores_sessions(void)
+{
+  const char *path = "/tmp/lmp_test_journal.bin";
+  std::remove(path);
+
+  std::vector<uint8_t> large(2000), small(900, 0x3C), done(300, 0x11);
+  for (size_t i = 0; i < large.size(); i++)
+    large[i] = static_cast<uint8_t>(i * 7);
+  auto largePackets = PacketSerializer::splitVectorToPackets(large, 7);
+  auto smallPackets = PacketSerializer::splitVectorToPackets(small, 8);
+  auto donePackets = PacketSerializer::splitVectorToPackets(done, 9);
+
+  {
+    MmapJournalStorage storage;
+    TEST_ASSERT_TRUE(storage.open(path, 256 * 1024));
+    ReassemblyJournal journal(storage);
+    TEST_ASSERT_EQUAL_size_t(4, journal.slotCount());
+    ReassemblerConfig config;
+    config.journalMinChunks = 3;
+    PacketReassembler reassembler(config);
+    TEST_ASSERT_EQUAL_size_t(0, reassembler.attachJournal(&journal, 0));
+
+    for (size_t i = 0; i < largePackets.size(); i++)
+    {
+      if (i != 2 && i != 5)
+        TEST_ASSERT_FALSE(reassembler.processPacket(largePackets[i], 10, 1).has_value());
+    }
+    for (size_t i = 0; i + 1 < smallPackets.size(); i++)
+      TEST_ASSERT_FALSE(reassembler.processPacket(smallPackets[i], 20, 2).has_value());
+    for (size_t i = 0; i < donePackets.size(); i++)
+      reassembler.processPacket(donePackets[i], 30, 1);
+    TEST_ASSERT_FALSE(reassembler.processPacket(create_chunk(99, 0, 4, ""), 40, 1).has_value());  // Rejected: empty.
+
+    // The two partial messages are in the journal; the short and the rejected ones never went to it.
+    TEST_ASSERT_EQUAL_size_t(2, journal.activeSlots());
+    TEST_ASSERT_EQUAL_size_t(0, journal.retiredSlots());
+    TEST_ASSERT_EQUAL_UINT64(0, journal.storageErrors());
+  }  // Restart: reassembler, journal and mapping are gone.
+
+  MmapJournalStorage storage;
+  TEST_ASSERT_TRUE(storage.open(path, 256 * 1024));
+  ReassemblyJournal journal(storage);
+  TEST_ASSERT_EQUAL_size_t(2, journal.records().size());
+
+  ReassemblerConfig config;
+  config.initialGapMs = 100;
+  PacketReassembler reassembler(config);
+  TEST_ASSERT_EQUAL_size_t(2, reassembler.attachJournal(&journal, 50000));
+
+  auto pending = reassembler.pendingMessages();
+  TEST_ASSERT_EQUAL_size_t(2, pending.size());
+  for (const auto &message : pending)
+  {
+    if (message.messageId == 7)
+    {
+      TEST_ASSERT_EQUAL_UINT32(1, message.sourceId);
+      TEST_ASSERT_EQUAL_size_t(largePackets.size(), message.totalChunks);
+      TEST_ASSERT_EQUAL_size_t(2, message.missingChunks.size());
+      TEST_ASSERT_EQUAL_size_t(2, message.missingChunks[0]);
+      TEST_ASSERT_EQUAL_size_t(5, message.missingChunks[1]);
+    }
+    else
+    {
+      TEST_ASSERT_EQUAL_UINT16(8, message.messageId);
+      TEST_ASSERT_EQUAL_UINT32(2, message.sourceId);
+      TEST_ASSERT_EQUAL_size_t(1, message.missingChunks.size());
+      TEST_ASSERT_EQUAL_size_t(smallPackets.size() - 1, message.missingChunks[0]);
+    }
+  }
+
+  // Restored sessions wait for the resend instead of being declared stalled.
+  TEST_ASSERT_EQUAL_size_t(0, reassembler.pruneStalled(55000));
+
+  // Only the missing chunks are needed to complete both messages.
+  TEST_ASSERT_FALSE(reassembler.processPacket(largePackets[5], 56000, 1).has_value());
+  auto largeOut = reassembler.processPacket(largePackets[2], 56001, 1);
+  auto smallOut = reassembler.processPacket(smallPackets.back(), 56002, 2);
+  TEST_ASSERT_TRUE(largeOut.has_value() && *largeOut == large);
+  TEST_ASSERT_TRUE(smallOut.has_value() && *smallOut == small);
+  TEST_ASSERT_EQUAL_size_t(0, journal.activeSlots());
+
+  // Retired slots are only reused once maintain() has erased them.
+  TEST_ASSERT_EQUAL_size_t(2, journal.retiredSlots());
+  TEST_ASSERT_TRUE(journal.open(3, 20, 10).has_value());
+  TEST_ASSERT_TRUE(journal.open(3, 21, 10).has_value());
+  TEST_ASSERT_FALSE(journal.open(3, 22, 10).has_value());
+  TEST_ASSERT_EQUAL_size_t(1, journal.maintain(1));
+  TEST_ASSERT_EQUAL_size_t(1, journal.maintain());
+  TEST_ASSERT_EQUAL_size_t(0, journal.retiredSlots());
+  TEST_ASSERT_TRUE(journal.open(3, 22, 10).has_value());
+  TEST_ASSERT_EQUAL_UINT64(0, journal.storageErrors());
+
+  storage.close();
+  std::remove(path);
+}
+
+/**
+ * @brief Verifies the ChunkRequest round trip: a restarted receiver gets only its missing chunks again.
+ */
+static void test_chunk_request_resends_only_missing_chunks(void)
+{
+  const char *path = "/tmp/lmp_test_resume.bin";
+  std::remove(path);
+
+  ChannelModel lossy;
+  lossy.lossProbability = 0.3;
+  lossy.seed = 3;
+  LoopbackTransport ground(1), rocket(2), groundAfterRestart(3);
+  LinkEndpointConfig senderConfig;
+  senderConfig.tx.retainedMessages = 2;
+  LinkEndpoint sender(rocket, senderConfig);
+
+  std::vector<uint8_t> image(4000);
+  for (size_t i = 0; i < image.size(); i++)
+    image[i] = static_cast<uint8_t>(i ^ (i >> 5));
+
+  MmapJournalStorage storage;
+  TEST_ASSERT_TRUE(storage.open(path, 128 * 1024));
+  ReassemblyJournal journal(storage);
+  size_t missing = 0;
+  uint32_t now = 0;
+  {
+    LoopbackTransport lossyGround(1, lossy);
+    LoopbackTransport::connect(rocket, lossyGround);
+    LinkEndpoint receiver(lossyGround);
+    receiver.reassembler().attachJournal(&journal, now);
+    TEST_ASSERT_TRUE(sender.send(std::vector<uint8_t>(image)).has_value());
+    for (; now < 1000 && !sender.idle(); now++)
+    {
+      sender.poll(now);
+      receiver.poll(now);
+    }
+    receiver.poll(now);
+
+    auto pending = receiver.reassembler().pendingMessages();
+    TEST_ASSERT_EQUAL_size_t(1, pending.size());
+    missing = pending[0].missingChunks.size();
+    TEST_ASSERT_TRUE(missing > 0 && missing < pending[0].totalChunks);
+  }  // The ground station goes down mid-transfer.
+
+  LoopbackTransport::connect(rocket, groundAfterRestart);
+  LinkEndpoint receiver(groundAfterRestart);
+  std::vector<uint8_t> delivered;
+  receiver.onMessage([&](uint32_t, uint16_t, std::vector<uint8_t> &&message) { delivered = std::move(message); });
+  TEST_ASSERT_EQUAL_size_t(1, receiver.reassembler().attachJournal(&journal, now));
+  TEST_ASSERT_EQUAL_size_t(1, receiver.requestMissingChunks());
+
+  uint64_t framesBefore = sender.stats().tx.framesSent;
+  for (uint32_t end = now + 1000; now < end && delivered.empty(); now++)
+  {
+    receiver.poll(now);
+    sender.poll(now);
+  }
+
+  TEST_ASSERT_TRUE(delivered == image);
+  LinkEndpoint::Stats senderStats = sender.stats();
+  TEST_ASSERT_EQUAL_UINT64(1, senderStats.chunkRequests);
+  TEST_ASSERT_EQUAL_UINT64(1, senderStats.chunkResends);
+  TEST_ASSERT_EQUAL_UINT64(1, senderStats.tx.resends);
+  TEST_ASSERT_EQUAL_UINT64(missing, senderStats.tx.framesSent - framesBefore);
+  TEST_ASSERT_EQUAL_size_t(0, journal.activeSlots());
+
+  storage.close();
+  std::remove(path);
+}
+#endif
+
+/**
+ * @brief Verifies that a sender retaining another message under the requested ID does not answer the request.
+ */
+static void test_chunk_request_ignored_by_other_sender(void)
+{
+  // Two nodes in range of one receiver: both number their first message 1.
+  LoopbackTransport alice(1), aliceListener(3), bob(2), bobListener(3);
+  LoopbackTransport::connect(alice, aliceListener);
+  LoopbackTransport::connect(bob, bobListener);
+  LinkEndpointConfig config;
+  config.tx.retainedMessages = 1;
+  LinkEndpoint aliceEndpoint(alice, config), bobEndpoint(bob, config);
+  size_t aliceChunks = 0;
+  aliceListener.setReceiveCallback([&aliceChunks](const uint8_t *, size_t, const FrameMeta &) { aliceChunks++; });
+
+  TEST_ASSERT_EQUAL_UINT16(1, aliceEndpoint.send(std::vector<uint8_t>(500, 0xA1)).value());
+  TEST_ASSERT_EQUAL_UINT16(1, bobEndpoint.send(std::vector<uint8_t>(2000, 0xB2)).value());
+  uint32_t now = 0;
+  for (; now < 1000 && !(aliceEndpoint.idle() && bobEndpoint.idle()); now++)
+  {
+    aliceEndpoint.poll(now);
+    bobEndpoint.poll(now);
+    aliceListener.poll(now);
+  }
+  TEST_ASSERT_EQUAL_size_t(3, aliceChunks);
+
+  // The receiver asks for chunk 0 of its 3-chunk message 1; both senders hear it.
+  ChunkRequest request;
+  request.messageId = 1;
+  request.totalChunks = 3;
+  request.missing.set(0);
+  std::vector<uint8_t> payload(request.encodedSize());
+  request.encode(payload.data());
+  Packet packet = PacketSerializer::splitVectorToPackets(payload, LinkAnnouncement::MESSAGE_ID)[0];
+  packet.header.flags |= PACKET_FLAG_CONTROL;
+  packet.calculateCRC();
+  uint8_t frame[MAX_TX_PACKET_SIZE];
+  size_t length = PacketSerializer::serializeCompact(packet, frame);
+  TEST_ASSERT_TRUE(aliceListener.startTransmit(frame, length));
+  TEST_ASSERT_TRUE(bobListener.startTransmit(frame, length));
+  for (uint32_t end = now + 100; now < end; now++)
+  {
+    aliceEndpoint.poll(now);
+    bobEndpoint.poll(now);
+    aliceListener.poll(now);
+    bobListener.poll(now);
+  }
+
+  TEST_ASSERT_EQUAL_UINT64(1, aliceEndpoint.stats().chunkResends);
+  TEST_ASSERT_EQUAL_size_t(4, aliceChunks);
+  TEST_ASSERT_EQUAL_UINT64(1, bobEndpoint.stats().chunkRequests);
+  TEST_ASSERT_EQUAL_UINT64(0, bobEndpoint.stats().chunkResends);
+
+  // Bob still answers requests for his own message.
+  TEST_ASSERT_TRUE(bobEndpoint.engine().resendChunks(1, PacketSerializer::chunksFor(2000), request.missing));
+  TEST_ASSERT_FALSE(bobEndpoint.engine().resendChunks(1, 3, request.missing));
+}
+
+/**
+ * @brief Verifies that a ChunkRequest too large for a 32-byte UART sub-packet is split by chunk range.
+ */
+static void test_chunk_request_split_for_short_frames(void)
+{
+  // Both directions of a UART link between E220 modules with 32-byte sub-packets.
+  std::deque<uint8_t> up, down;
+  size_t writes = 0, longestWrite = 0;
+  auto writer = [&](std::deque<uint8_t> &wire, bool lossy)
+  {
+    return [&wire, &writes, &longestWrite, lossy](const uint8_t *data, size_t length)
+    {
+      // Frames 3 and 180 of the transfer are lost: one missing chunk in each request range.
+      size_t frame = writes++;
+      longestWrite = std::max(longestWrite, length);
+      if (!lossy || (frame != 3 && frame != 180))
+        wire.insert(wire.end(), data, data + length);
+      return true;
+    };
+  };
+  auto reader = [](std::deque<uint8_t> &wire)
+  {
+    return [&wire](uint8_t *buffer, size_t capacity)
+    {
+      size_t count = std::min(capacity, wire.size());
+      std::copy(wire.begin(), wire.begin() + count, buffer);
+      wire.erase(wire.begin(), wire.begin() + count);
+      return count;
+    };
+  };
+  UartTransportConfig config;
+  config.maxFrameSize = 32;
+  config.modulation.spreadingFactor = 7;
+  config.modulation.bandwidthHz = 500000;
+  config.interFrameGapMs = 2;
+  UartTransport rocketUart(writer(down, true), reader(up), config), groundUart(writer(up, false), reader(down), config);
+  LinkEndpointConfig rocketConfig;
+  rocketConfig.tx.retainedMessages = 1;
+  LinkEndpoint rocket(rocketUart, rocketConfig), ground(groundUart);
+  std::vector<uint8_t> delivered;
+  ground.onMessage([&](uint32_t, uint16_t, std::vector<uint8_t> &&message) { delivered = std::move(message); });
+
+  std::vector<uint8_t> image(200 * 23);
+  for (size_t i = 0; i < image.size(); i++)
+    image[i] = static_cast<uint8_t>(i * 11);
+  TEST_ASSERT_TRUE(rocket.send(std::vector<uint8_t>(image)).has_value());
+  uint32_t now = 0;
+  for (; now < 5000 && !rocket.idle(); now++)
+  {
+    rocket.poll(now);
+    ground.poll(now);
+  }
+  ground.poll(now);
+  TEST_ASSERT_TRUE(delivered.empty());
+
+  // 23-byte payloads hold a 144-chunk bitmap: two requests for 200 chunks.
+  TEST_ASSERT_EQUAL_size_t(144, ChunkRequest::maxChunksFor(23));
+  TEST_ASSERT_EQUAL_size_t(2, ground.requestMissingChunks());
+  for (uint32_t end = now + 1000; now < end && delivered.empty(); now++)
+  {
+    ground.poll(now);
+    rocket.poll(now);
+  }
+
+  TEST_ASSERT_TRUE(delivered == image);
+  TEST_ASSERT_TRUE(longestWrite <= 32);
+  LinkEndpoint::Stats rocketStats = rocket.stats();
+  TEST_ASSERT_EQUAL_UINT64(2, rocketStats.chunkRequests);
+  TEST_ASSERT_EQUAL_UINT64(2, rocketStats.chunkResends);
+  TEST_ASSERT_EQUAL_UINT64(0, ground.stats().tx.framesDropped);
+  TEST_ASSERT_EQUAL_UINT64(0, ground.stats().tx.radioErrors);
+}
+
+// ============================================================================
+// Bulk Packetization Tests
+// ============================================================================
+
+/**
+ * @brief Verifies that parallel bulk packetization matches the PacketSerializer frame for frame.
+ */
+static void test_bulk_packetizer_matches_serializer(void)
+{
+  // Two full messages and a partial one, in full and compact frames.
+  std::vector<uint8_t> upload(2 * DefaultProfile::MAX_CHUNKS * 100 + 1234);
+  for (size_t i = 0; i < upload.size(); i++)
+    upload[i] = static_cast<uint8_t>((i * 31) ^ (i >> 9));
+
+  for (bool compact : {false, true})
+  {
+    BulkPacketizerConfig config;
+    config.threadCount = 3;
+    config.framesPerTask = 7;
+    config.chunkPayloadSize = 100;
+    config.firstMessageId = 0xFFFE;
+    config.compactFrames = compact;
+    BulkPacketizer packetizer(config);
+    TEST_ASSERT_EQUAL_size_t(3, packetizer.threadCount());
+    TEST_ASSERT_EQUAL_size_t(3, BulkPacketizer::messagesFor(upload.size(), 100));
+
+    size_t frames = BulkPacketizer::framesFor(upload.size(), 100);
+    FrameArena tooSmall(frames - 1);
+    TEST_ASSERT_EQUAL_size_t(0, packetizer.packetize(upload.data(), upload.size(), tooSmall));
+
+    FrameArena arena(frames);
+    TEST_ASSERT_EQUAL_size_t(frames, packetizer.packetize(upload.data(), upload.size(), arena));
+    TEST_ASSERT_EQUAL_size_t(frames, arena.size());
+
+    // Message IDs wrap past 0xFFFF without using 0 or the control ID.
+    const uint16_t ids[] = {0xFFFE, 1, 2};
+    size_t frame = 0;
+    for (size_t message = 0; message < 3; message++)
+    {
+      size_t offset = message * DefaultProfile::MAX_CHUNKS * 100;
+      size_t length = std::min<size_t>(DefaultProfile::MAX_CHUNKS * 100, upload.size() - offset);
+      for (const Packet &packet : PacketSerializer::splitBufferToPackets(upload.data() + offset, length, ids[message], 100))
+      {
+        uint8_t expected[MAX_PACKET_SIZE];
+        size_t expectedLength = compact ? PacketSerializer::serializeCompact(packet, expected) : MAX_TX_PACKET_SIZE;
+        if (!compact)
+          PacketSerializer::serialize(packet, expected);
+        TEST_ASSERT_EQUAL_UINT16(expectedLength, arena.meta(frame).length);
+        TEST_ASSERT_EQUAL_MEMORY(expected, arena.slot(frame), expectedLength);
+        frame++;
+      }
+    }
+    TEST_ASSERT_EQUAL_size_t(frames, frame);
+  }
+
+#ifndef ESP_PLATFORM
+  // Same bytes from a memory-mapped file.
+  const char *path = "/tmp/lmp_test_upload.bin";
+  FILE *file = std::fopen(path, "wb");
+  TEST_ASSERT_NOT_NULL(file);
+  TEST_ASSERT_EQUAL_size_t(upload.size(), std::fwrite(upload.data(), 1, upload.size(), file));
+  std::fclose(file);
+
+  BulkPacketizer packetizer;
+  FrameArena fromMemory(BulkPacketizer::framesFor(upload.size()));
+  FrameArena fromFile(BulkPacketizer::framesFor(upload.size()));
+  TEST_ASSERT_EQUAL_size_t(fromMemory.capacity(), packetizer.packetize(upload.data(), upload.size(), fromMemory));
+  TEST_ASSERT_EQUAL_size_t(fromFile.capacity(), packetizer.packetizeFile(path, fromFile));
+  for (size_t i = 0; i < fromFile.size(); i++)
+    TEST_ASSERT_EQUAL_MEMORY(fromMemory.slot(i), fromFile.slot(i), MAX_TX_PACKET_SIZE);
+  std::remove(path);
+  TEST_ASSERT_EQUAL_size_t(0, packetizer.packetizeFile(path, fromFile));
+#endif
+}
+
 int main(void)
 {
   UNITY_BEGIN();
 
   // Existing Tests
   RUN_TEST(test_crc_changes_on_payload_modification);
+  RUN_TEST(test_crc16_kernels_bit_exact);
   RUN_TEST(test_split_and_reassemble);
   RUN_TEST(test_packet_flags_multipacket);
   RUN_TEST(test_packet_flags_single_packet);
@@ -373,6 +3325,92 @@ int main(void)
   RUN_TEST(test_reassembler_unordered_flow);
   RUN_TEST(test_reassembler_duplicates_ignored);
   RUN_TEST(test_reassembler_pruning);
+  RUN_TEST(test_reassembler_prune_stalled_short_message);
+  RUN_TEST(test_reassembler_prune_stalled_keeps_slow_transfer);
+  RUN_TEST(test_reassembler_prune_stalled_normalizes_lost_chunks);
+  RUN_TEST(test_reassembler_sessions_keyed_by_source);
+  RUN_TEST(test_reassembler_rejects_mismatched_geometry);
+  RUN_TEST(test_reassembler_delivers_into_pool);
+  RUN_TEST(test_reassembler_delivers_into_span);
+  RUN_TEST(test_reassembler_uses_memory_resources);
+  RUN_TEST(test_reassembler_large_messages_use_psram_tier);
+
+  // Simulator & Sharded Engine Tests
+  RUN_TEST(test_simulator_duplicates_and_reordering);
+  RUN_TEST(test_sharded_reassembler_multi_source);
+
+  // Batch Ingest Tests
+  RUN_TEST(test_parser_parse_batch_mask);
+  RUN_TEST(test_validator_batch_matches_scalar);
+#ifdef __linux__
+  RUN_TEST(test_udp_ingest_loopback_batch);
+#endif
+
+  // Frame Capture Tests
+  RUN_TEST(test_capture_round_trip_and_seek);
+  RUN_TEST(test_capture_truncated_is_readable);
+
+  // PacketLog Tests
+  RUN_TEST(test_packet_log_records_and_formats);
+  RUN_TEST(test_packet_log_drops_when_full);
+  RUN_TEST(test_packet_log_sequence_with_concurrent_producers);
+
+  // Protocol Profile Tests
+  RUN_TEST(test_profile_small_frames_round_trip);
+  RUN_TEST(test_profile_wide_frames_crc32);
+
+  // Typed Serialization Tests
+  RUN_TEST(test_typed_split_and_reassemble);
+  RUN_TEST(test_typed_reassembler_rejects_other_types);
+
+  // Transmit Path Tests
+  RUN_TEST(test_tx_engine_double_buffered_chaining);
+  RUN_TEST(test_tx_engine_backpressure_and_retry);
+  RUN_TEST(test_tx_scheduler_priorities_and_deadlines);
+  RUN_TEST(test_tx_engine_preempts_staged_frame);
+  RUN_TEST(test_lora_airtime_reference_values);
+  RUN_TEST(test_airtime_budget_token_bucket);
+  RUN_TEST(test_tx_engine_duty_cycle_pacing);
+  RUN_TEST(test_tdma_schedule_slots_and_sync);
+  RUN_TEST(test_tx_engine_tdma_slots_and_beacons);
+  RUN_TEST(test_tx_engine_tdma_refuses_oversized_frames);
+
+  // Link Adaptation Tests
+  RUN_TEST(test_link_announcement_and_follower);
+  RUN_TEST(test_link_adaptation_closed_loop);
+
+  // Chunk Size Tests
+  RUN_TEST(test_custom_chunk_size_round_trip);
+  RUN_TEST(test_reassembler_enforces_chunk_size);
+  RUN_TEST(test_small_chunks_improve_goodput_at_high_ber);
+  RUN_TEST(test_tx_engine_compact_frames_follow_chunk_size);
+
+  // Transport & Endpoint Tests
+  RUN_TEST(test_link_endpoint_loopback_round_trip);
+  RUN_TEST(test_uart_transport_framing_and_sub_packets);
+  RUN_TEST(test_frame_stream_decoder_resynchronizes);
+  RUN_TEST(test_bonded_transport_stripes_across_radios);
+  RUN_TEST(test_bonded_transport_link_change_waits_for_air);
+
+  // Streaming Reassembly Tests
+  RUN_TEST(test_streaming_reassembler_delivers_in_order_ranges);
+  RUN_TEST(test_streaming_reassembler_window_and_abort);
+  RUN_TEST(test_reassemblers_ignore_control_frames);
+
+  // Relay Tests
+  RUN_TEST(test_frame_relay_cut_through_two_hops);
+  RUN_TEST(test_frame_relay_verdicts);
+
+  // Resumable Transfer Tests
+#ifndef ESP_PLATFORM
+  RUN_TEST(test_reassembly_journal_restores_sessions);
+  RUN_TEST(test_chunk_request_resends_only_missing_chunks);
+#endif
+  RUN_TEST(test_chunk_request_split_for_short_frames);
+  RUN_TEST(test_chunk_request_ignored_by_other_sender);
+
+  // Bulk Packetization Tests
+  RUN_TEST(test_bulk_packetizer_matches_serializer);
 
   return UNITY_END();
 }
@@ -0,0 +1,131 @@
+/**
+ * @file bench_bulk_packetize.cpp
+ * @brief Host benchmark: BulkPacketizer throughput by input size and thread count.
+ *
+ * For each upload size, writes a file of pseudo-random bytes, then packetizes
+ * it into a preallocated FrameArena:
+ *   - sequential: PacketSerializer::splitBufferToPackets() per message, each
+ *     Packet serialized into the arena (the former upload path);
+ *   - BulkPacketizer::packetizeFile() with 1, 2, 4, ... threads.
+ * Reports MB/s of input, frames/s and the speed-up over the sequential path.
+ * The file is read once beforehand so every run starts from the page cache.
+ *
+ * Usage: bench_bulk_packetize [maxMB] [maxThreads] [repeats]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "BulkPacketizer.hpp"
+#include "FrameArena.hpp"
+#include "PacketSerializer.hpp"
+
+namespace
+{
+const char *FILE_PATH = "/tmp/lmp_bench_upload.bin";
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point begin)
+{
+  return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+std::vector<uint8_t> makeUpload(size_t size)
+{
+  std::vector<uint8_t> data(size);
+  uint32_t state = 0x12345678u;
+  for (uint8_t &byte : data)
+  {
+    state = state * 1664525u + 1013904223u;
+    byte = static_cast<uint8_t>(state >> 24);
+  }
+  return data;
+}
+
+size_t sequential(const std::vector<uint8_t> &upload, FrameArena &arena)
+{
+  arena.clear();
+  size_t messageBytes = DefaultProfile::MAX_CHUNKS * LORA_MAX_PAYLOAD_SIZE;
+  uint16_t messageId = 1;
+  for (size_t offset = 0; offset < upload.size(); offset += messageBytes)
+  {
+    size_t length = std::min(messageBytes, upload.size() - offset);
+    for (const Packet &packet : PacketSerializer::splitBufferToPackets(upload.data() + offset, length, messageId))
+    {
+      size_t index = arena.size();
+      PacketSerializer::serialize(packet, arena.slot(index));
+      arena.meta(index).length = MAX_TX_PACKET_SIZE;
+      arena.setSize(index + 1);
+    }
+    messageId = messageId == 0xFFFE ? 1 : messageId + 1;
+  }
+  return arena.size();
+}
+
+template <typename Run>
+double bestOf(size_t repeats, Run &&run)
+{
+  double best = 1e30;
+  for (size_t i = 0; i < repeats; i++)
+  {
+    Clock::time_point begin = Clock::now();
+    run();
+    best = std::min(best, seconds(begin));
+  }
+  return best;
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  size_t maxMB = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+  size_t maxThreads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+  size_t repeats = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 3;
+
+  std::printf("Frames of %zu bytes (%zu payload), best of %zu runs, %u hardware threads\n\n", MAX_TX_PACKET_SIZE,
+              LORA_MAX_PAYLOAD_SIZE, repeats, std::thread::hardware_concurrency());
+  std::printf("%8s %10s %12s %10s %14s %10s\n", "MB", "threads", "MB/s", "ms", "frames/s", "speed-up");
+
+  for (size_t mb = 1; mb <= maxMB; mb *= 4)
+  {
+    std::vector<uint8_t> upload = makeUpload(mb << 20);
+    FILE *file = std::fopen(FILE_PATH, "wb");
+    if (file == nullptr || std::fwrite(upload.data(), 1, upload.size(), file) != upload.size())
+    {
+      std::fprintf(stderr, "Cannot write %s\n", FILE_PATH);
+      return 1;
+    }
+    std::fclose(file);
+
+    size_t frames = BulkPacketizer::framesFor(upload.size());
+    FrameArena arena(frames);
+
+    double baseline = bestOf(repeats, [&] { sequential(upload, arena); });
+    std::printf("%8zu %10s %12.0f %10.2f %14.0f %9.2fx\n", mb, "seq", upload.size() / baseline / 1e6,
+                baseline * 1e3, frames / baseline, 1.0);
+
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+      BulkPacketizerConfig config;
+      config.threadCount = threads;
+      BulkPacketizer packetizer(config);
+      packetizer.packetizeFile(FILE_PATH, arena);  // Warm the page cache and the workers.
+
+      double elapsed = bestOf(repeats, [&] {
+        if (packetizer.packetizeFile(FILE_PATH, arena) != frames)
+          std::fprintf(stderr, "packetizeFile failed\n");
+      });
+      std::printf("%8zu %10zu %12.0f %10.2f %14.0f %9.2fx\n", mb, threads, upload.size() / elapsed / 1e6,
+                  elapsed * 1e3, frames / elapsed, baseline / elapsed);
+    }
+    std::printf("\n");
+  }
+
+  std::remove(FILE_PATH);
+  return 0;
+}
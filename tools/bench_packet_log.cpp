@@ -0,0 +1,86 @@
+/**
+ * @file bench_packet_log.cpp
+ * @brief Host benchmark: cost of logging a packet on the hot path.
+ *
+ * Compares, per full-size packet:
+ *   - the former printPacket() payload formatting (one snprintf and one
+ *     std::string append per byte), without the actual output;
+ *   - PacketLog::formatHex() of the full payload (current printPacket());
+ *   - PacketLog::record(), i.e. what the RX/TX path pays with deferred logging;
+ *   - PacketLog::format(), the deferred cost paid later by the consumer.
+ *
+ * Usage: bench_packet_log [iterations]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "PacketLog.hpp"
+
+namespace
+{
+volatile size_t sink = 0;
+
+template <typename Fn>
+double nanosecondsPerCall(size_t iterations, Fn &&fn)
+{
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++)
+    fn(i);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  return seconds * 1e9 / static_cast<double>(iterations);
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+  Packet packet;
+  packet.header.messageId = 42;
+  packet.header.totalChunks = 4;
+  packet.header.chunkIndex = 1;
+  packet.header.payloadSize = LORA_MAX_PAYLOAD_SIZE;
+  for (size_t i = 0; i < LORA_MAX_PAYLOAD_SIZE; i++)
+    packet.payload.data[i] = static_cast<uint8_t>(i * 7);
+  packet.calculateCRC();
+
+  double legacy = nanosecondsPerCall(iterations / 10, [&](size_t)
+                                     {
+    char tmp[8];
+    std::string line;
+    for (int i = 0; i < packet.header.payloadSize; i++)
+    {
+      std::snprintf(tmp, sizeof(tmp), "%02X ", packet.payload.data[i]);
+      line += tmp;
+    }
+    sink = sink + line.size(); });
+
+  double hex = nanosecondsPerCall(iterations, [&](size_t)
+                                  {
+    char line[LORA_MAX_PAYLOAD_SIZE * 3 + 1];
+    sink = sink + PacketLog::formatHex(packet.payload.data, packet.header.payloadSize, line, sizeof(line)); });
+
+  // Ring large enough to never drop; drained outside the timed loop.
+  PacketLog log(iterations);
+  double record = nanosecondsPerCall(iterations, [&](size_t i)
+                                     { sink = sink + log.record(packet, static_cast<uint32_t>(i), PacketLogEvent::Rx); });
+
+  PacketLogRecord sample{};
+  log.drain([&sample](const PacketLogRecord &r)
+            { sample = r; });
+  double format = nanosecondsPerCall(iterations, [&](size_t)
+                                     {
+    char line[160];
+    sink = sink + PacketLog::format(sample, line, sizeof(line)); });
+
+  std::printf("%-44s %10s\n", "per 246-byte packet", "ns");
+  std::printf("%-44s %10.1f\n", "legacy printPacket payload (snprintf/byte)", legacy);
+  std::printf("%-44s %10.1f\n", "printPacket payload (formatHex)", hex);
+  std::printf("%-44s %10.1f\n", "PacketLog::record() (hot path)", record);
+  std::printf("%-44s %10.1f\n", "PacketLog::format() (deferred)", format);
+  std::printf("\nhot-path speed-up vs legacy: %.0fx (dropped %u)\n", legacy / record, log.dropped());
+  return 0;
+}
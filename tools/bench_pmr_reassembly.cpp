@@ -0,0 +1,142 @@
+/**
+ * @file bench_pmr_reassembly.cpp
+ * @brief Host benchmark: PacketReassembler cost per packet by memory resource.
+ *
+ * Replays the same interleaved multi-source traffic through a
+ * PacketReassembler whose session and chunk storage come from:
+ *   - new_delete_resource() (the previous behaviour),
+ *   - an unsynchronized_pool_resource,
+ *   - a monotonic_buffer_resource released whenever no session is pending.
+ * Reports ns/packet and the number of allocations reaching the upstream heap.
+ *
+ * Usage: bench_pmr_reassembly [messages] [sources] [messageSize]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <vector>
+
+#include "PacketReassembler.hpp"
+#include "PacketSerializer.hpp"
+
+namespace
+{
+/**
+ * @brief Forwards to new/delete and counts the calls that reach it.
+ */
+class CountingResource : public std::pmr::memory_resource
+{
+ public:
+  size_t allocations = 0;
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override
+  {
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+/**
+ * @brief Round-robins the chunks of 'sources' concurrent messages, like several transmitters sharing a channel.
+ */
+std::vector<Packet> generateTraffic(size_t messages, uint32_t sources, size_t messageSize, std::vector<uint32_t> &sourceIds)
+{
+  std::vector<Packet> frames;
+  std::vector<uint8_t> data(messageSize);
+  for (size_t base = 0; base < messages; base += sources)
+  {
+    std::vector<std::vector<Packet>> batch;
+    for (uint32_t src = 0; src < sources && base + src < messages; src++)
+    {
+      std::fill(data.begin(), data.end(), static_cast<uint8_t>(base + src));
+      batch.push_back(PacketSerializer::splitVectorToPackets(data, static_cast<uint16_t>(base / sources % 65535 + 1)));
+    }
+    for (size_t chunk = 0; chunk < batch[0].size(); chunk++)
+    {
+      for (uint32_t src = 0; src < batch.size(); src++)
+      {
+        frames.push_back(batch[src][chunk]);
+        sourceIds.push_back(src);
+      }
+    }
+  }
+  return frames;
+}
+
+enum class Mode
+{
+  NewDelete,
+  Pool,
+  Monotonic
+};
+
+double runOnce(Mode mode, const std::vector<Packet> &frames, const std::vector<uint32_t> &sourceIds,
+               size_t &upstreamAllocations, size_t &completed)
+{
+  CountingResource upstream;
+  std::pmr::unsynchronized_pool_resource pool(&upstream);
+  std::pmr::monotonic_buffer_resource arena(64 * 1024, &upstream);
+
+  std::pmr::memory_resource *resource = &upstream;
+  if (mode == Mode::Pool)
+    resource = &pool;
+  else if (mode == Mode::Monotonic)
+    resource = &arena;
+
+  PacketReassembler reassembler(ReassemblerConfig{}, ReassemblerResources{resource, resource});
+  std::pmr::unsynchronized_pool_resource messagePool;
+  completed = 0;
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < frames.size(); i++)
+  {
+    if (reassembler.processPacketInto(frames[i], 0, messagePool, sourceIds[i]))
+    {
+      completed++;
+      if (mode == Mode::Monotonic && reassembler.pendingSessions() == 0)
+        arena.release();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  upstreamAllocations = upstream.allocations;
+  return std::chrono::duration<double, std::nano>(end - begin).count() / frames.size();
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  size_t messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+  uint32_t sources = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 8;
+  size_t messageSize = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1000;
+
+  std::vector<uint32_t> sourceIds;
+  std::vector<Packet> frames = generateTraffic(messages, sources, messageSize, sourceIds);
+  std::printf("%zu messages of %zu bytes from %u interleaved sources, %zu packets\n\n", messages, messageSize, sources,
+              frames.size());
+
+  const struct
+  {
+    Mode mode;
+    const char *name;
+  } modes[] = {{Mode::NewDelete, "new/delete"}, {Mode::Pool, "unsynchronized_pool"}, {Mode::Monotonic, "monotonic+release"}};
+
+  std::printf("%-22s %12s %12s %20s\n", "resource", "ns/packet", "messages", "upstream allocs");
+  for (const auto &m : modes)
+  {
+    size_t allocations = 0;
+    size_t completed = 0;
+    double ns = runOnce(m.mode, frames, sourceIds, allocations, completed);
+    std::printf("%-22s %12.1f %12zu %20zu\n", m.name, ns, completed, allocations);
+  }
+  return 0;
+}
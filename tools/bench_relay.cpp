@@ -0,0 +1,249 @@
+/**
+ * @file bench_relay.cpp
+ * @brief Host benchmark: multi-hop delivery latency, cut-through FrameRelay vs store-and-forward.
+ *
+ * A chain source -> N relays -> sink is built from LoopbackTransports that
+ * simulate LoRa time on air (SF7 / 250 kHz), one link per hop. Messages are
+ * sent one at a time and timed on the simulated clock, first through
+ * FrameRelay nodes (frames forwarded as they arrive), then through relays
+ * that reassemble each message with a LinkEndpoint and send it again.
+ * Reports the per-hop frame latency, the end-to-end message latency and
+ * delivery ratio of both, and the relay's CPU cost per forwarded frame.
+ *
+ * Usage: bench_relay [hops] [messageSize] [lossProbability]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "FrameRelay.hpp"
+#include "LinkEndpoint.hpp"
+#include "LoopbackTransport.hpp"
+#include "PacketSerializer.hpp"
+
+namespace
+{
+constexpr size_t MESSAGES = 50;
+constexpr uint32_t GIVE_UP_MS = 60000;
+
+struct Result
+{
+  size_t delivered = 0;
+  double meanMs = 0.0;
+  uint32_t maxMs = 0;
+  double hopMs = 0.0;  ///< Mean frame latency from one relay to the next (cut-through only).
+};
+
+LoRaModulation benchModulation()
+{
+  LoRaModulation modulation;
+  modulation.spreadingFactor = 7;
+  modulation.bandwidthHz = 250000;
+  return modulation;
+}
+
+/**
+ * @brief One link per hop: links[2 * i] transmits towards links[2 * i + 1].
+ */
+std::vector<std::unique_ptr<LoopbackTransport>> buildChain(size_t hops, double loss)
+{
+  ChannelModel model;
+  model.lossProbability = loss;
+  std::vector<std::unique_ptr<LoopbackTransport>> links;
+  for (size_t i = 0; i <= hops; i++)
+  {
+    model.seed = i + 1;
+    links.push_back(std::make_unique<LoopbackTransport>(static_cast<uint32_t>(2 * i + 1)));
+    links.push_back(std::make_unique<LoopbackTransport>(static_cast<uint32_t>(2 * i + 2), model));
+    LoopbackTransport::connect(*links[2 * i], *links[2 * i + 1]);
+  }
+  for (auto &link : links)
+  {
+    link->setSimulateAirtime(true);
+    link->setModulation(benchModulation());
+  }
+  return links;
+}
+
+LinkEndpointConfig endpointConfig()
+{
+  LinkEndpointConfig config;
+  config.reassembler.maxConcurrentMessages = 4;
+  return config;
+}
+
+template <typename PollRelays>
+Result runMessages(LinkEndpoint &source, LinkEndpoint &sink, size_t messageSize, PollRelays pollRelays)
+{
+  Result result;
+  bool delivered = false;
+  sink.onMessage([&](uint32_t, uint16_t, std::vector<uint8_t> &&) { delivered = true; });
+
+  std::vector<uint8_t> payload(messageSize, 0x5A);
+  uint32_t now = 0;
+  uint64_t totalMs = 0;
+  for (size_t m = 0; m < MESSAGES; m++)
+  {
+    delivered = false;
+    uint32_t sentAt = now;
+    source.send(payload.data(), payload.size());
+    for (; !delivered && now - sentAt < GIVE_UP_MS; now++)
+    {
+      source.poll(now);
+      pollRelays(now);
+      sink.poll(now);
+    }
+    if (delivered)
+    {
+      uint32_t latency = now - 1 - sentAt;
+      result.delivered++;
+      totalMs += latency;
+      result.maxMs = std::max(result.maxMs, latency);
+    }
+    // Let the chain drain (lost messages leave frames in flight) before the next message.
+    for (uint32_t end = now + 2000; now != end; now++)
+    {
+      source.poll(now);
+      pollRelays(now);
+      sink.poll(now);
+    }
+  }
+  result.meanMs = result.delivered ? static_cast<double>(totalMs) / result.delivered : 0.0;
+  return result;
+}
+
+Result runCutThrough(size_t hops, size_t messageSize, double loss)
+{
+  auto links = buildChain(hops, loss);
+  std::vector<std::unique_ptr<FrameRelay>> relays;
+  // First arrival of each (messageId, chunk) at each relay, for the per-hop latency.
+  std::map<std::pair<uint16_t, uint8_t>, std::vector<uint32_t>> arrivals;
+  for (size_t i = 0; i < hops; i++)
+  {
+    relays.push_back(std::make_unique<FrameRelay>(*links[2 * i + 1], *links[2 * i + 2]));
+    relays.back()->setFrameObserver([&arrivals, hops, i](const Packet &packet, const FrameMeta &meta, FrameRelay::Verdict verdict)
+                                    {
+      if (verdict != FrameRelay::Verdict::Forwarded)
+        return;
+      auto &times = arrivals[{packet.header.messageId, packet.header.chunkIndex}];
+      times.resize(hops, UINT32_MAX);
+      times[i] = meta.timestampMs; });
+  }
+
+  LinkEndpoint source(*links.front(), endpointConfig()), sink(*links.back(), endpointConfig());
+  Result result = runMessages(source, sink, messageSize,
+                              [&](uint32_t now)
+                              {
+                                for (auto &relay : relays)
+                                  relay->poll(now);
+                              });
+
+  uint64_t hopTotal = 0, hopCount = 0;
+  for (const auto &entry : arrivals)
+  {
+    for (size_t i = 1; i < entry.second.size(); i++)
+    {
+      if (entry.second[i - 1] != UINT32_MAX && entry.second[i] != UINT32_MAX)
+      {
+        hopTotal += entry.second[i] - entry.second[i - 1];
+        hopCount++;
+      }
+    }
+  }
+  result.hopMs = hopCount ? static_cast<double>(hopTotal) / hopCount : 0.0;
+  return result;
+}
+
+Result runStoreAndForward(size_t hops, size_t messageSize, double loss)
+{
+  auto links = buildChain(hops, loss);
+  std::vector<std::unique_ptr<LinkEndpoint>> nodes;
+  for (size_t i = 0; i < hops; i++)
+  {
+    nodes.push_back(std::make_unique<LinkEndpoint>(*links[2 * i + 1], endpointConfig()));
+    nodes.push_back(std::make_unique<LinkEndpoint>(*links[2 * i + 2], endpointConfig()));
+    LinkEndpoint *downlink = nodes.back().get();
+    nodes[nodes.size() - 2]->onMessage([downlink](uint32_t, uint16_t, std::vector<uint8_t> &&message)
+                                       { downlink->send(std::move(message)); });
+  }
+
+  LinkEndpoint source(*links.front(), endpointConfig()), sink(*links.back(), endpointConfig());
+  return runMessages(source, sink, messageSize,
+                     [&](uint32_t now)
+                     {
+                       for (auto &node : nodes)
+                         node->poll(now);
+                     });
+}
+
+/**
+ * @brief Wall-clock cost of FrameRelay::onFrame() + forwarding, per frame.
+ */
+double relayNsPerFrame(size_t messageSize)
+{
+  LoopbackTransport up(1), down(2), sink(3);
+  LoopbackTransport::connect(down, sink);
+  RelayConfig config;
+  config.flowCount = 16;
+  FrameRelay relay(up, down, config);
+
+  std::vector<uint8_t> payload(messageSize, 0xA5);
+  std::vector<std::vector<uint8_t>> frames;
+  for (uint16_t id = 1; id <= 64; id++)
+  {
+    for (const Packet &packet : PacketSerializer::splitVectorToPackets(payload, id))
+    {
+      frames.emplace_back(MAX_PACKET_SIZE);
+      frames.back().resize(PacketSerializer::serializeCompact(packet, frames.back().data()));
+    }
+  }
+
+  constexpr size_t ROUNDS = 200;
+  FrameMeta meta;
+  meta.sourceId = 7;
+  uint32_t now = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t round = 0; round < ROUNDS; round++)
+  {
+    // A new source per round so that frames are forwarded again, not dropped as duplicates.
+    meta.sourceId++;
+    for (const auto &frame : frames)
+    {
+      meta.timestampMs = now;
+      relay.onFrame(frame.data(), frame.size(), meta);
+      relay.poll(now++);
+      relay.poll(now++);
+      sink.poll(now);
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  return seconds * 1e9 / static_cast<double>(relay.stats().framesForwarded);
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  size_t hops = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2;
+  size_t messageSize = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+  double loss = argc > 3 ? std::strtod(argv[3], nullptr) : 0.0;
+  hops = std::min<size_t>(std::max<size_t>(hops, 1), RelayConfig().maxHops);
+
+  uint32_t frameMs = (LoRaAirtime::timeOnAirUs(benchModulation(), MAX_PACKET_SIZE) + 999) / 1000;
+  std::printf("%zu relays, %zu messages of %zu bytes (%zu frames of %u ms), frame loss %.1f %% per hop\n\n", hops,
+              MESSAGES, messageSize, PacketSerializer::chunksFor(messageSize), frameMs, loss * 100.0);
+  std::printf("%-18s %10s %12s %12s %10s\n", "mode", "delivered", "mean ms", "max ms", "hop ms");
+
+  Result cut = runCutThrough(hops, messageSize, loss);
+  std::printf("%-18s %10zu %12.1f %12u %10.1f\n", "cut-through", cut.delivered, cut.meanMs, cut.maxMs, cut.hopMs);
+  Result stored = runStoreAndForward(hops, messageSize, loss);
+  std::printf("%-18s %10zu %12.1f %12u %10s\n", "store-and-forward", stored.delivered, stored.meanMs, stored.maxMs, "-");
+
+  std::printf("\nrelay CPU: %.0f ns per forwarded frame\n", relayNsPerFrame(messageSize));
+  return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file bench_stream_decoder.cpp
+ * @brief Host benchmark: FrameStreamDecoder throughput on a UART-like byte stream.
+ *
+ * Builds a stream of compact frames interleaved with random noise, with a
+ * share of corrupted frames, and decodes it in fragments of several sizes
+ * (UART FIFO threshold, driver buffer, DMA ring half). Reports MB/s,
+ * frames/s, how many frames were returned in place (zero-copy), and the
+ * margin over the E220's fastest UART line rate (115200 baud, 8N1).
+ *
+ * Usage: bench_stream_decoder [streamMB] [noisePercent] [corruptPercent]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "ChannelSimulator.hpp"
+#include "FrameStreamDecoder.hpp"
+#include "PacketSerializer.hpp"
+
+namespace
+{
+constexpr double UART_BYTES_PER_SECOND = 115200.0 / 10.0;  // 8N1: 10 bits per byte
+
+std::vector<uint8_t> buildStream(size_t targetBytes, unsigned noisePercent, unsigned corruptPercent, size_t &frames)
+{
+  ChannelSimulator rng;
+  std::vector<uint8_t> stream;
+  stream.reserve(targetBytes + MAX_TX_PACKET_SIZE);
+  std::vector<uint8_t> data(LORA_MAX_PAYLOAD_SIZE * 4);
+  uint16_t messageId = 1;
+  frames = 0;
+
+  while (stream.size() < targetBytes)
+  {
+    // Noise in proportion to the frame bytes that follow.
+    size_t chunkSize = 32 + rng.nextRandom() % (LORA_MAX_PAYLOAD_SIZE - 31);
+    auto packets = PacketSerializer::splitVectorToPackets(data, messageId, chunkSize);
+    for (const Packet &packet : packets)
+    {
+      uint8_t frame[MAX_TX_PACKET_SIZE];
+      size_t length = PacketSerializer::serializeCompact(packet, frame);
+      size_t noise = length * noisePercent / 100;
+      for (size_t i = 0; i < noise; i++)
+        stream.push_back(static_cast<uint8_t>(rng.nextRandom()));
+      if (rng.nextRandom() % 100 < corruptPercent)
+        frame[rng.nextRandom() % length] ^= 0x04;
+      else
+        frames++;
+      stream.insert(stream.end(), frame, frame + length);
+    }
+    messageId = static_cast<uint16_t>(messageId % 65534 + 1);
+  }
+  return stream;
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  size_t streamMB = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+  unsigned noisePercent = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 10;
+  unsigned corruptPercent = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10)) : 5;
+
+  size_t expectedFrames = 0;
+  std::vector<uint8_t> stream = buildStream(streamMB << 20, noisePercent, corruptPercent, expectedFrames);
+  std::printf("%.1f MB stream, %zu intact frames, %u %% noise, %u %% corrupted frames\n\n", stream.size() / 1e6,
+              expectedFrames, noisePercent, corruptPercent);
+
+  std::printf("%10s %10s %14s %10s %12s %16s\n", "fragment", "MB/s", "frames/s", "decoded", "zero-copy", "x UART 115200");
+  const size_t fragments[] = {32, 120, 1024, 4096};
+  for (size_t fragment : fragments)
+  {
+    FrameStreamDecoder decoder;
+    uint64_t checksum = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos < stream.size(); pos += fragment)
+    {
+      size_t length = stream.size() - pos < fragment ? stream.size() - pos : fragment;
+      decoder.push(stream.data() + pos, length);
+      while (auto view = decoder.next())
+        checksum += view->payloadSize();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    const FrameStreamDecoder::Stats &stats = decoder.stats();
+    double bytesPerSecond = stream.size() / seconds;
+    std::printf("%10zu %10.1f %14.0f %10llu %11.1f%% %16.0f\n", fragment, bytesPerSecond / 1e6,
+                stats.framesDecoded / seconds, (unsigned long long)stats.framesDecoded,
+                100.0 * (stats.framesDecoded - stats.framesCopied) / (stats.framesDecoded ? stats.framesDecoded : 1),
+                bytesPerSecond / UART_BYTES_PER_SECOND);
+    if (checksum == 0)
+      std::printf("(no frames decoded)\n");
+  }
+  return 0;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file bench_tdma.cpp
+ * @brief Host benchmark: aggregate goodput of N nodes sharing one channel, ALOHA vs TDMA.
+ *
+ * N sensor nodes send multi-chunk messages to one gateway over a simulated
+ * shared channel: every node hears every other, and any two frames that
+ * overlap in time are both lost (no capture effect, no clock drift). Each
+ * node offers the same load (Poisson message arrivals); the total offered
+ * load grows with N.
+ *
+ * - ALOHA: LinkEndpoints send as soon as a message is queued. One lost
+ *   chunk loses the whole message, so goodput collapses as N grows.
+ * - TDMA: the gateway is the time master (slot 0, TdmaBeacons); node i owns
+ *   slot i + 1, each slot long enough for one whole message. Nodes transmit
+ *   only after their first beacon and only in their slot.
+ *
+ * Reports, per node count, the offered load (fraction of channel time), the
+ * messages delivered and the goodput at the gateway for both modes.
+ *
+ * Usage: bench_tdma [maxNodes] [messageSize] [simSeconds] [loadPerNode]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ITransport.hpp"
+#include "LinkEndpoint.hpp"
+#include "LoRaAirtime.hpp"
+#include "PacketSerializer.hpp"
+
+namespace
+{
+/**
+ * @brief Broadcast channel: frames overlapping in time destroy each other.
+ */
+class SharedChannel
+{
+ public:
+  class Port : public ITransport
+  {
+   public:
+    Port(SharedChannel &channel, uint32_t address) : channel_(channel), address_(address) {}
+
+    bool startTransmit(const uint8_t *frame, size_t length) override
+    {
+      if (transmitting_ || length == 0 || length > MAX_PACKET_SIZE)
+        return false;
+      transmitting_ = true;
+      channel_.transmit(*this, frame, length);
+      return true;
+    }
+
+    bool setModulation(const LoRaModulation &modulation) override
+    {
+      modulation_ = modulation;
+      return true;
+    }
+
+    void poll(uint32_t currentTimestampMs) override
+    {
+      if (done_)
+      {
+        done_ = false;
+        transmitting_ = false;
+        transmitDone();
+      }
+      for (const auto &frame : inbox_)
+      {
+        FrameMeta meta;
+        meta.sourceId = frame.first;
+        meta.timestampMs = currentTimestampMs;
+        meta.length = static_cast<uint16_t>(frame.second.size());
+        deliverFrame(frame.second.data(), frame.second.size(), meta);
+      }
+      inbox_.clear();
+    }
+
+   private:
+    friend class SharedChannel;
+    SharedChannel &channel_;
+    uint32_t address_;
+    LoRaModulation modulation_;
+    bool transmitting_ = false;
+    bool done_ = false;
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> inbox_;
+  };
+
+  Port &join(uint32_t address)
+  {
+    ports_.push_back(std::make_unique<Port>(*this, address));
+    return *ports_.back();
+  }
+
+  /**
+   * @brief Ends the transmissions due at 'currentTimestampMs': senders are told, intact frames delivered.
+   */
+  void advance(uint32_t currentTimestampMs)
+  {
+    now_ = currentTimestampMs;
+    for (size_t i = 0; i < onAir_.size();)
+    {
+      Transmission &tx = onAir_[i];
+      if (tx.endMs > currentTimestampMs)
+      {
+        i++;
+        continue;
+      }
+      tx.sender->done_ = true;
+      if (tx.collided)
+      {
+        collisions_++;
+      }
+      else
+      {
+        for (auto &port : ports_)
+        {
+          if (port.get() != tx.sender)
+            port->inbox_.emplace_back(tx.sender->address_, tx.frame);
+        }
+      }
+      onAir_[i] = std::move(onAir_.back());
+      onAir_.pop_back();
+    }
+  }
+
+  uint64_t collisions() const { return collisions_; }
+
+ private:
+  struct Transmission
+  {
+    Port *sender;
+    uint32_t endMs;
+    std::vector<uint8_t> frame;
+    bool collided;
+  };
+
+  std::vector<std::unique_ptr<Port>> ports_;
+  std::vector<Transmission> onAir_;
+  uint32_t now_ = 0;
+  uint64_t collisions_ = 0;
+
+  void transmit(Port &sender, const uint8_t *frame, size_t length)
+  {
+    uint32_t airtimeMs = static_cast<uint32_t>((LoRaAirtime::timeOnAirUs(sender.modulation_, length) + 999) / 1000);
+    bool collided = false;
+    for (Transmission &other : onAir_)
+    {
+      other.collided = true;
+      collided = true;
+    }
+    onAir_.push_back(Transmission{&sender, now_ + airtimeMs, std::vector<uint8_t>(frame, frame + length), collided});
+  }
+};
+
+struct Result
+{
+  uint64_t offered = 0;
+  uint64_t delivered = 0;
+  uint64_t collisions = 0;
+  double goodputBps = 0.0;
+};
+
+LoRaModulation benchModulation()
+{
+  LoRaModulation modulation;
+  modulation.spreadingFactor = 7;
+  modulation.bandwidthHz = 250000;
+  return modulation;
+}
+
+Result run(size_t nodes, size_t messageSize, uint32_t simMs, double loadPerNode, bool tdma)
+{
+  const LoRaModulation modulation = benchModulation();
+  const size_t chunks = PacketSerializer::chunksFor(messageSize);
+  const double messageAirtimeMs = chunks * LoRaAirtime::timeOnAirUs(modulation, MAX_TX_PACKET_SIZE) / 1000.0;
+
+  TdmaConfig plan;
+  plan.slotCount = static_cast<uint8_t>(nodes + 1);
+  plan.framesPerSlot = static_cast<uint8_t>(chunks);
+
+  SharedChannel channel;
+  LinkEndpointConfig gatewayConfig;
+  gatewayConfig.tx.modulation = modulation;
+  gatewayConfig.reassembler.maxConcurrentMessages = 2 * nodes + 2;
+  if (tdma)
+  {
+    gatewayConfig.tx.tdma = plan;
+    gatewayConfig.tx.tdma->slotMask = 1u << 0;
+    gatewayConfig.tx.tdma->beaconIntervalMs = 30000;
+    // A message started late in a slot finishes in the next superframe: keep its session that long.
+    gatewayConfig.reassembler.minTimeoutMs = 2 * TdmaSchedule(plan, modulation).superframeMs();
+  }
+  SharedChannel::Port &gatewayPort = channel.join(0);
+  gatewayPort.setModulation(modulation);
+  LinkEndpoint gateway(gatewayPort, gatewayConfig);
+
+  Result result;
+  uint64_t deliveredBytes = 0;
+  gateway.onMessage([&](uint32_t, uint16_t, std::vector<uint8_t> &&message)
+                    {
+    result.delivered++;
+    deliveredBytes += message.size(); });
+
+  std::vector<std::unique_ptr<LinkEndpoint>> sensors;
+  for (size_t i = 0; i < nodes; i++)
+  {
+    LinkEndpointConfig config;
+    config.tx.modulation = modulation;
+    if (tdma)
+    {
+      config.tx.tdma = plan;
+      config.tx.tdma->slotMask = 1u << (i + 1);
+      config.tx.maxActiveMessages = 1;  // One whole message per slot rather than chunks of several.
+    }
+    SharedChannel::Port &port = channel.join(static_cast<uint32_t>(i + 1));
+    port.setModulation(modulation);
+    sensors.push_back(std::make_unique<LinkEndpoint>(port, config));
+  }
+
+  // Poisson arrivals: each node offers 'loadPerNode' of the channel time.
+  std::mt19937 rng(12345);
+  std::exponential_distribution<double> interArrivalMs(loadPerNode / messageAirtimeMs);
+  std::vector<double> nextMessageMs(nodes);
+  for (double &next : nextMessageMs)
+    next = interArrivalMs(rng);
+  std::vector<uint8_t> message(messageSize, 0x5A);
+
+  for (uint32_t now = 0; now < simMs; now++)
+  {
+    channel.advance(now);
+    for (size_t i = 0; i < nodes; i++)
+    {
+      while (nextMessageMs[i] <= now)
+      {
+        result.offered++;
+        sensors[i]->send(message.data(), message.size());  // Refused when the queue is full: offered, never delivered.
+        nextMessageMs[i] += interArrivalMs(rng);
+      }
+      sensors[i]->poll(now);
+    }
+    gateway.poll(now);
+  }
+
+  result.collisions = channel.collisions();
+  result.goodputBps = deliveredBytes * 8.0 * 1000.0 / simMs;
+  return result;
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  size_t maxNodes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16;
+  size_t messageSize = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+  uint32_t simMs = static_cast<uint32_t>((argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 600) * 1000);
+  double loadPerNode = argc > 4 ? std::strtod(argv[4], nullptr) : 0.125;
+  maxNodes = std::min<size_t>(std::max<size_t>(maxNodes, 1), 31);
+
+  const LoRaModulation modulation = benchModulation();
+  const size_t chunks = PacketSerializer::chunksFor(messageSize);
+  const double frameMs = LoRaAirtime::timeOnAirUs(modulation, MAX_TX_PACKET_SIZE) / 1000.0;
+  // Channel capacity: back-to-back full frames carrying LORA_MAX_PAYLOAD_SIZE bytes each.
+  const double capacityBps = LORA_MAX_PAYLOAD_SIZE * 8.0 * 1000.0 / frameMs;
+  std::printf("%zu-byte messages (%zu frames of %.0f ms), %.1f %% offered load per node, %u s, capacity %.0f bit/s\n\n",
+              messageSize, chunks, frameMs, loadPerNode * 100.0, simMs / 1000, capacityBps);
+  std::printf("%6s %9s | %9s %10s %11s | %9s %10s %11s\n", "nodes", "offered", "aloha msg", "bit/s", "collisions",
+              "tdma msg", "bit/s", "collisions");
+
+  for (size_t nodes = 1; nodes <= maxNodes; nodes *= 2)
+  {
+    Result aloha = run(nodes, messageSize, simMs, loadPerNode, false);
+    Result tdma = run(nodes, messageSize, simMs, loadPerNode, true);
+    std::printf("%6zu %8.0f%% | %4llu/%-4llu %10.0f %11llu | %4llu/%-4llu %10.0f %11llu\n", nodes,
+                nodes * loadPerNode * 100.0, (unsigned long long)aloha.delivered, (unsigned long long)aloha.offered,
+                aloha.goodputBps, (unsigned long long)aloha.collisions, (unsigned long long)tdma.delivered,
+                (unsigned long long)tdma.offered, tdma.goodputBps, (unsigned long long)tdma.collisions);
+  }
+  return 0;
+}
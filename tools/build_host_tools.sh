@@ -0,0 +1,30 @@
+#!/usr/bin/env bash
+# Builds the host-side tools and benchmarks in tools/ against the library sources.
+# Usage: tools/build_host_tools.sh [tool_name ...]   (default: all tools)
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+BUILD_DIR="$ROOT_DIR/.host_tools_build"
+mkdir -p "$BUILD_DIR"
+
+LIB_SOURCES=("$ROOT_DIR"/components/LoRaMultiPacket/src/*.cpp)
+
+if [ "$#" -gt 0 ]; then
+  TOOLS=("$@")
+else
+  TOOLS=()
+  for src in "$ROOT_DIR"/tools/*.cpp; do
+    TOOLS+=("$(basename "$src" .cpp)")
+  done
+fi
+
+for tool in "${TOOLS[@]}"; do
+  echo "Building $tool..."
+  g++ -std=c++17 -O2 -pthread \
+    -I"$ROOT_DIR/components/LoRaMultiPacket/include" \
+    "${LIB_SOURCES[@]}" \
+    "$ROOT_DIR/tools/$tool.cpp" \
+    -o "$BUILD_DIR/$tool"
+done
+
+echo "Tools written to $BUILD_DIR"
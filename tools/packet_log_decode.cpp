@@ -0,0 +1,66 @@
+/**
+ * @file packet_log_decode.cpp
+ * @brief Host decoder for raw PacketLog records.
+ *
+ * Reads a stream of 32-byte PacketLogRecord structs (e.g. a device draining
+ * its PacketLog to a UART or file with fwrite) and prints one text line per
+ * record, flagging sequence gaps caused by records dropped on the device.
+ * A sequence number going backwards (a log written before records were
+ * numbered in ring order, where producers could race) is reported as
+ * reordering, not as 255 lost records.
+ *
+ * Usage: packet_log_decode [file]   (default: stdin)
+ */
+
+#include <cstdio>
+
+#include "PacketLog.hpp"
+
+int main(int argc, char **argv)
+{
+  FILE *in = argc > 1 ? std::fopen(argv[1], "rb") : stdin;
+  if (in == nullptr)
+  {
+    std::perror(argv[1]);
+    return 1;
+  }
+
+  PacketLogRecord record;
+  char line[160];
+  size_t count = 0;
+  unsigned lost = 0;
+  bool first = true;
+  uint8_t expected = 0;
+
+  while (std::fread(&record, sizeof(record), 1, in) == 1)
+  {
+    int8_t difference = static_cast<int8_t>(record.sequence - expected);
+    if (!first && difference < 0)
+    {
+      // A gap reported earlier was this record, late.
+      std::printf("-- record out of order --\n");
+      if (lost > 0)
+        lost--;
+      PacketLog::format(record, line, sizeof(line));
+      std::puts(line);
+      count++;
+      continue;
+    }
+    if (!first && difference > 0)
+    {
+      std::printf("-- %u record(s) dropped on device --\n", static_cast<unsigned>(difference));
+      lost += static_cast<unsigned>(difference);
+    }
+    first = false;
+    expected = static_cast<uint8_t>(record.sequence + 1);
+
+    PacketLog::format(record, line, sizeof(line));
+    std::puts(line);
+    count++;
+  }
+
+  std::fprintf(stderr, "%zu records decoded, %u dropped (mod 256)\n", count, lost);
+  if (in != stdin)
+    std::fclose(in);
+  return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file udp_capture.cpp
+ * @brief Records gateway traffic from the host UDP ingest into a capture file.
+ *
+ * Listens with UdpFrameIngest and appends every received batch to a capture
+ * (see FrameCapture.hpp) until the frame limit is reached or no frame arrived
+ * for the idle timeout. The result can be replayed with frame_replay.
+ *
+ * Usage: udp_capture <port> <out.lmpcap> [maxFrames] [idleTimeoutMs]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "FrameArena.hpp"
+#include "FrameCapture.hpp"
+#include "UdpFrameIngest.hpp"
+
+int main(int argc, char **argv)
+{
+  if (argc < 3)
+  {
+    std::fprintf(stderr, "Usage: %s <port> <out.lmpcap> [maxFrames] [idleTimeoutMs]\n", argv[0]);
+    return 1;
+  }
+  uint16_t port = static_cast<uint16_t>(std::strtoul(argv[1], nullptr, 10));
+  size_t maxFrames = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 0;
+  int idleTimeoutMs = argc > 4 ? std::atoi(argv[4]) : 5000;
+
+  FILE *out = std::fopen(argv[2], "wb");
+  if (out == nullptr)
+  {
+    std::fprintf(stderr, "Cannot create %s\n", argv[2]);
+    return 1;
+  }
+  CaptureWriter writer([out](const uint8_t *data, size_t length)
+                       { return std::fwrite(data, 1, length, out) == length; });
+
+  UdpFrameIngest ingest;
+  if (!ingest.open(port) || !writer.begin())
+  {
+    std::fprintf(stderr, "Cannot listen on UDP port %u\n", (unsigned)port);
+    return 1;
+  }
+  std::printf("Capturing UDP port %u into %s...\n", (unsigned)ingest.port(), argv[2]);
+
+  FrameArena arena(64);
+  auto start = std::chrono::steady_clock::now();
+  for (;;)
+  {
+    auto now = std::chrono::steady_clock::now();
+    uint32_t timestampMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count());
+    int n = ingest.receiveBatch(arena, timestampMs, idleTimeoutMs);
+    if (n <= 0)
+      break;
+    if (!writer.writeBatch(arena))
+    {
+      std::fprintf(stderr, "Write error\n");
+      break;
+    }
+    if (maxFrames != 0 && writer.recordCount() >= maxFrames)
+      break;
+  }
+
+  writer.finish();
+  std::fclose(out);
+  std::printf("Captured %llu frames (%llu bytes)\n", (unsigned long long)writer.recordCount(),
+              (unsigned long long)writer.bytesWritten());
+  return 0;
+}
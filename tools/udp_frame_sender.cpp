@@ -0,0 +1,78 @@
+/**
+ * @file udp_frame_sender.cpp
+ * @brief Local gateway emulator: sends serialized frames as UDP datagrams.
+ *
+ * Splits synthetic messages with PacketSerializer and forwards every frame
+ * as one datagram, in sendmmsg() batches, to a UdpFrameIngest listener.
+ * Useful to exercise the host ingest path over loopback without radios.
+ *
+ * Usage: udp_frame_sender <host> <port> [messages] [messageSize] [framesPerSecond]
+ *        framesPerSecond = 0 sends as fast as possible.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "FrameArena.hpp"
+#include "PacketSerializer.hpp"
+#include "UdpFrameIngest.hpp"
+
+int main(int argc, char **argv)
+{
+  if (argc < 3)
+  {
+    std::fprintf(stderr, "Usage: %s <host> <port> [messages] [messageSize] [framesPerSecond]\n", argv[0]);
+    return 1;
+  }
+
+  const char *host = argv[1];
+  uint16_t port = static_cast<uint16_t>(std::strtoul(argv[2], nullptr, 10));
+  size_t messages = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1000;
+  size_t messageSize = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 1000;
+  double framesPerSecond = argc > 5 ? std::strtod(argv[5], nullptr) : 0.0;
+
+  UdpFrameSender sender;
+  if (!sender.open(host, port))
+  {
+    std::fprintf(stderr, "Cannot open UDP socket towards %s:%u\n", host, (unsigned)port);
+    return 1;
+  }
+
+  FrameArena batch(64);
+  std::vector<uint8_t> data(messageSize);
+  size_t framesSent = 0;
+  auto begin = std::chrono::steady_clock::now();
+
+  for (size_t m = 0; m < messages; m++)
+  {
+    for (size_t i = 0; i < data.size(); i++)
+      data[i] = static_cast<uint8_t>(m + i);
+
+    for (const auto &packet : PacketSerializer::splitVectorToPackets(data, static_cast<uint16_t>(m % 65535 + 1)))
+    {
+      uint8_t frame[MAX_PACKET_SIZE];
+      PacketSerializer::serialize(packet, frame);
+      batch.push(frame, sizeof(Packet), FrameMeta());
+
+      if (batch.full())
+      {
+        framesSent += static_cast<size_t>(std::max(0, sender.sendBatch(batch)));
+        batch.clear();
+      }
+    }
+
+    if (framesPerSecond > 0.0)
+    {
+      auto due = begin + std::chrono::duration<double>((framesSent + batch.size()) / framesPerSecond);
+      std::this_thread::sleep_until(due);
+    }
+  }
+  framesSent += static_cast<size_t>(std::max(0, sender.sendBatch(batch)));
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  std::printf("Sent %zu frames (%zu messages) in %.3f s (%.0f frames/s)\n", framesSent, messages, seconds, framesSent / seconds);
+  return 0;
+}